@@ -189,6 +189,33 @@ void BSP_LED_Init(Led_TypeDef Led)
   HAL_GPIO_WritePin(LED_PORT[Led], LED_PIN[Led], GPIO_PIN_RESET);
 }
 
+/**
+  * @brief  Configures the GPIO of a set of LEDs, all in one go.
+  * @param  Mask LEDs to configure, an OR of LEDx_PIN / LEDn_PIN values,
+  *         e.g. LEDS_ALL_PINS.  The LEDs are left off.
+  * @retval None
+  */
+void BSP_LED_InitMask(uint32_t Mask)
+{
+  GPIO_InitTypeDef  GPIO_InitStruct;
+
+  Mask &= LEDS_ALL_PINS;
+
+  /* Enable the GPIO_LED Clock, one for all the LEDs */
+  LED3_GPIO_CLK_ENABLE();
+
+  /* Off before the pins become outputs */
+  BSP_LED_OffMask(Mask);
+
+  /* Configure the GPIO_LED pins */
+  GPIO_InitStruct.Pin = Mask;
+  GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
+  GPIO_InitStruct.Pull = GPIO_PULLUP;
+  GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
+
+  HAL_GPIO_Init(LEDS_GPIO_PORT, &GPIO_InitStruct);
+}
+
 /**
   * @brief  Turns selected LED On.
   * @param  Led Specifies the Led to be set on. 
@@ -205,7 +232,7 @@ void BSP_LED_Init(Led_TypeDef Led)
   */
 void BSP_LED_On(Led_TypeDef Led)
 {
-  HAL_GPIO_WritePin(LED_PORT[Led], LED_PIN[Led], GPIO_PIN_SET); 
+  LL_GPIO_SetOutputPin(LED_PORT[Led], LED_PIN[Led]);
 }
 
 /**
@@ -224,7 +251,7 @@ void BSP_LED_On(Led_TypeDef Led)
   */
 void BSP_LED_Off(Led_TypeDef Led)
 {
-  HAL_GPIO_WritePin(LED_PORT[Led], LED_PIN[Led], GPIO_PIN_RESET); 
+  LL_GPIO_ResetOutputPin(LED_PORT[Led], LED_PIN[Led]);
 }
 
 /**
@@ -243,7 +270,7 @@ void BSP_LED_Off(Led_TypeDef Led)
   */
 void BSP_LED_Toggle(Led_TypeDef Led)
 {
-  HAL_GPIO_TogglePin(LED_PORT[Led], LED_PIN[Led]);
+  LL_GPIO_TogglePin(LED_PORT[Led], LED_PIN[Led]);
 }
 
 
@@ -52,6 +52,7 @@
  
 /* Includes ------------------------------------------------------------------*/
 #include "stm32f3xx_hal.h"
+#include "stm32f3xx_ll_gpio.h"
    
 /** @defgroup STM32F3_DISCOVERY_Common STM32F3-DISCOVERY Common
   * @{
@@ -196,6 +197,22 @@ typedef enum
                                          ((__LED__) == LED9) ? LED9_GPIO_CLK_DISABLE() :\
                                          ((__LED__) == LED10) ? LED10_GPIO_CLK_DISABLE() : 0 )
 
+/* The eight LEDs are all on one port, so any subset of them can be driven
+   with a single write of its BSRR register: see BSP_LED_WriteMask() */
+#define LEDS_GPIO_PORT                   GPIOE
+#define LEDS_ALL_PINS                    (LED3_PIN | LED4_PIN | LED5_PIN | LED6_PIN |\
+                                          LED7_PIN | LED8_PIN | LED9_PIN | LED10_PIN)
+
+/* Pin of an LED, a constant when __LED__ is one (no LED_PIN[] lookup) */
+#define LEDx_PIN(__LED__)               (((__LED__) == LED3) ? LED3_PIN :\
+                                         ((__LED__) == LED4) ? LED4_PIN :\
+                                         ((__LED__) == LED5) ? LED5_PIN :\
+                                         ((__LED__) == LED6) ? LED6_PIN :\
+                                         ((__LED__) == LED7) ? LED7_PIN :\
+                                         ((__LED__) == LED8) ? LED8_PIN :\
+                                         ((__LED__) == LED9) ? LED9_PIN :\
+                                         ((__LED__) == LED10) ? LED10_PIN : 0U )
+
 /**
   * @}
   */ 
@@ -343,9 +360,86 @@ void      BSP_LED_Init(Led_TypeDef Led);
 void      BSP_LED_On(Led_TypeDef Led);
 void      BSP_LED_Off(Led_TypeDef Led);
 void      BSP_LED_Toggle(Led_TypeDef Led);
+void      BSP_LED_InitMask(uint32_t Mask);
 void      BSP_PB_Init(Button_TypeDef Button, ButtonMode_TypeDef ButtonMode);
 uint32_t  BSP_PB_GetState(Button_TypeDef Button);
 
+/**
+  * @brief  Turns some LEDs on and others off with one atomic store.
+  * @param  OnMask  LEDs to turn on, an OR of LEDx_PIN / LEDn_PIN values.
+  * @param  OffMask LEDs to turn off; an LED in both masks is turned on.
+  * @note   The LEDs not in either mask are left as they are, even if another
+  *         task or interrupt changes them at the same time.
+  * @retval None
+  */
+__STATIC_INLINE void BSP_LED_WriteMask(uint32_t OnMask, uint32_t OffMask)
+{
+  WRITE_REG(LEDS_GPIO_PORT->BSRR, ((OffMask & LEDS_ALL_PINS) << 16U) | (OnMask & LEDS_ALL_PINS));
+}
+
+/**
+  * @brief  Shows a pattern on the eight LEDs with one atomic store.
+  * @param  Mask LEDs to turn on, every other LED is turned off.
+  * @retval None
+  */
+__STATIC_INLINE void BSP_LED_SetMask(uint32_t Mask)
+{
+  BSP_LED_WriteMask(Mask, ~Mask);
+}
+
+/**
+  * @brief  Turns a set of LEDs on.
+  * @param  Mask LEDs to turn on, an OR of LEDx_PIN / LEDn_PIN values.
+  * @retval None
+  */
+__STATIC_INLINE void BSP_LED_OnMask(uint32_t Mask)
+{
+  LL_GPIO_SetOutputPin(LEDS_GPIO_PORT, Mask & LEDS_ALL_PINS);
+}
+
+/**
+  * @brief  Turns a set of LEDs off.
+  * @param  Mask LEDs to turn off, an OR of LEDx_PIN / LEDn_PIN values.
+  * @retval None
+  */
+__STATIC_INLINE void BSP_LED_OffMask(uint32_t Mask)
+{
+  LL_GPIO_ResetOutputPin(LEDS_GPIO_PORT, Mask & LEDS_ALL_PINS);
+}
+
+/**
+  * @brief  Toggles a set of LEDs.
+  * @param  Mask LEDs to toggle, an OR of LEDx_PIN / LEDn_PIN values.
+  * @note   ODR is read and the result written to BSRR, so the other LEDs are
+  *         never written, but two callers toggling the same LED may race.
+  * @retval None
+  */
+__STATIC_INLINE void BSP_LED_ToggleMask(uint32_t Mask)
+{
+  LL_GPIO_TogglePin(LEDS_GPIO_PORT, Mask & LEDS_ALL_PINS);
+}
+
+/**
+  * @brief  Single LED versions of the above: with a constant Led they compile
+  *         to one store, cheap enough to use LEDs as logic analyser probes.
+  * @param  Led Specifies the Led, one of LED3 .. LED10.
+  * @retval None
+  */
+__STATIC_INLINE void BSP_LED_OnFast(Led_TypeDef Led)
+{
+  LL_GPIO_SetOutputPin(LEDS_GPIO_PORT, LEDx_PIN(Led));
+}
+
+__STATIC_INLINE void BSP_LED_OffFast(Led_TypeDef Led)
+{
+  LL_GPIO_ResetOutputPin(LEDS_GPIO_PORT, LEDx_PIN(Led));
+}
+
+__STATIC_INLINE void BSP_LED_ToggleFast(Led_TypeDef Led)
+{
+  LL_GPIO_TogglePin(LEDS_GPIO_PORT, LEDx_PIN(Led));
+}
+
 /**
   * @}
   */
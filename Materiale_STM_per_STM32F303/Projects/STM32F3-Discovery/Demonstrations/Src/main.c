@@ -241,14 +241,7 @@ static void Demo(void)
   }
 
   /* Force The Leds to be Off before entring to the USB demo  */
-  BSP_LED_Off(LED3);
-  BSP_LED_Off(LED4);
-  BSP_LED_Off(LED5);
-  BSP_LED_Off(LED7);
-  BSP_LED_Off(LED9);
-  BSP_LED_Off(LED10);
-  BSP_LED_Off(LED8);
-  BSP_LED_Off(LED6);
+  BSP_LED_OffMask(LEDS_ALL_PINS);
 
   /* 5. Wait for User button is released */
   while (BSP_PB_GetState(BUTTON_USER) != KEY_NOT_PRESSED)
@@ -98,14 +98,7 @@ void ACCELERO_MEMS_Test(void)
       HAL_Delay(10);
     }
   }
-    BSP_LED_Off(LED3);
-    BSP_LED_Off(LED6);
-    BSP_LED_Off(LED7);
-    BSP_LED_Off(LED4);
-    BSP_LED_Off(LED10);
-    BSP_LED_Off(LED8);
-    BSP_LED_Off(LED9);
-    BSP_LED_Off(LED5);
+    BSP_LED_OffMask(LEDS_ALL_PINS);
 }
 
 /**
@@ -166,14 +159,7 @@ void GYRO_MEMS_Test(void)
       HAL_Delay(10);
     }
   }
-    BSP_LED_Off(LED3);
-    BSP_LED_Off(LED6);
-    BSP_LED_Off(LED7);
-    BSP_LED_Off(LED4);
-    BSP_LED_Off(LED10);
-    BSP_LED_Off(LED8);
-    BSP_LED_Off(LED9);
-    BSP_LED_Off(LED5);
+    BSP_LED_OffMask(LEDS_ALL_PINS);
 }
 
 /**
@@ -202,10 +188,7 @@ void USB_Test(void)
   {}
 
   /* Turn Off Leds */
-  BSP_LED_Off(LED3);
-  BSP_LED_Off(LED6);
-  BSP_LED_Off(LED7);
-  BSP_LED_Off(LED10);
+  BSP_LED_OffMask(LED3_PIN | LED6_PIN | LED7_PIN | LED10_PIN);
 }
 
 /**
@@ -273,10 +256,7 @@ void USB_Demo(void)
 {
   uint8_t HID_Buffer[4];
 
-  BSP_LED_On(LED3);
-  BSP_LED_On(LED6);
-  BSP_LED_Off(LED10);
-  BSP_LED_Off(LED7);
+  BSP_LED_WriteMask(LED3_PIN | LED6_PIN, LED10_PIN | LED7_PIN);
 
   while ((BSP_PB_GetState(BUTTON_USER) != GPIO_PIN_SET))
   {
@@ -290,14 +270,7 @@ void USB_Demo(void)
   }
 
   /* Turn Off Leds */
-  BSP_LED_Off(LED4);
-  BSP_LED_Off(LED3);
-  BSP_LED_Off(LED5);
-  BSP_LED_Off(LED7);
-  BSP_LED_Off(LED9);
-  BSP_LED_Off(LED10);
-  BSP_LED_Off(LED8);
-  BSP_LED_Off(LED6);
+  BSP_LED_OffMask(LEDS_ALL_PINS);
 }
 
 /**
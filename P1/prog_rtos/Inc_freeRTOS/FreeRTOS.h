@@ -329,6 +329,17 @@ extern "C" {
 	#define traceTASK_SWITCHED_OUT()
 #endif
 
+#ifndef traceISR_ENTER
+	/* Called on entry to the tick interrupt, and by application interrupt
+	handlers that want to be traced. */
+	#define traceISR_ENTER()
+#endif
+
+#ifndef traceISR_EXIT
+	/* Called before returning from an interrupt that called traceISR_ENTER(). */
+	#define traceISR_EXIT()
+#endif
+
 #ifndef traceTASK_PRIORITY_INHERIT
 	/* Called when a task attempts to take a mutex that is already held by a
 	lower priority task.  pxTCBOfMutexHolder is a pointer to the TCB of the task
@@ -374,6 +385,14 @@ extern "C" {
 	#define configCHECK_FOR_STACK_OVERFLOW 0
 #endif
 
+#ifndef configUSE_INTERRUPT_MASK_TIMING
+	#define configUSE_INTERRUPT_MASK_TIMING 0
+#endif
+
+#ifndef configUSE_TRACE_GPIO
+	#define configUSE_TRACE_GPIO 0
+#endif
+
 #ifndef configRECORD_STACK_HIGH_ADDRESS
 	#define configRECORD_STACK_HIGH_ADDRESS 0
 #endif
@@ -460,6 +479,26 @@ extern "C" {
 	#define traceQUEUE_RECEIVE_FAILED( pxQueue )
 #endif
 
+#ifndef traceQUEUE_SPIN_SUCCESS
+	#define traceQUEUE_SPIN_SUCCESS( pxQueue, uxSpins )
+#endif
+
+#ifndef traceQUEUE_SPIN_FAILED
+	#define traceQUEUE_SPIN_FAILED( pxQueue, uxSpins )
+#endif
+
+#ifndef tracePERIODIC_TASK_DEADLINE_MISSED
+	#define tracePERIODIC_TASK_DEADLINE_MISSED( pxPeriodicTask )
+#endif
+
+#ifndef traceTASK_BUDGET_EXHAUSTED
+	#define traceTASK_BUDGET_EXHAUSTED( pxTCB )
+#endif
+
+#ifndef traceTASK_BUDGET_REPLENISHED
+	#define traceTASK_BUDGET_REPLENISHED( pxTCB )
+#endif
+
 #ifndef traceQUEUE_SEND_FROM_ISR
 	#define traceQUEUE_SEND_FROM_ISR( pxQueue )
 #endif
@@ -806,6 +845,202 @@ extern "C" {
 	#define configUSE_TASK_NOTIFICATIONS 1
 #endif
 
+#ifndef configUSE_ADAPTIVE_SEMAPHORE_SPIN
+	#define configUSE_ADAPTIVE_SEMAPHORE_SPIN 0
+#endif
+
+#ifndef configQUEUE_INLINE_COPY_MAX_SIZE
+	/* Queue items up to this size in bytes are copied with inline loads and
+	stores rather than a memcpy() call.  0 copies every item with memcpy(). */
+	#define configQUEUE_INLINE_COPY_MAX_SIZE 32
+#endif
+
+#ifndef configEVENT_GROUP_WAIT_LISTS
+	/* The number of lists the tasks blocked on an event group are spread over,
+	by the lowest bit they wait for, so setting bits only looks at the tasks
+	on the lists of those bits.  A power of two, each list costs a List_t and
+	an EventBits_t per event group.  1 keeps all the tasks on one list. */
+	#define configEVENT_GROUP_WAIT_LISTS 8
+#endif
+
+#ifndef configRESUME_ALL_BATCH_SIZE
+	/* 0 to have xTaskResumeAll() ready all the pending ready tasks and replay
+	all the pended ticks in one critical section.  Otherwise the most tasks
+	readied or tick steps taken per critical section, which bounds the time
+	xTaskResumeAll() keeps interrupts masked after a long scheduler
+	suspension. */
+	#define configRESUME_ALL_BATCH_SIZE 0
+#endif
+
+#ifndef configUSE_POLL_SETS
+	/* 1 to build poll sets (poll_set.h), which cost every queue and stream
+	buffer a pointer and a bit number, and every send a test. */
+	#define configUSE_POLL_SETS 0
+#endif
+
+#ifndef configUSE_TASK_SNAPSHOTS
+	/* 1 to build xTaskTakeSnapshot(), which costs every TCB two pointers. */
+	#define configUSE_TASK_SNAPSHOTS 0
+#endif
+
+#ifndef configMAX_SNAPSHOT_TASKS
+	#define configMAX_SNAPSHOT_TASKS 16
+#endif
+
+#if( ( configUSE_TASK_SNAPSHOTS == 1 ) && ( configUSE_TRACE_FACILITY != 1 ) )
+	#error configUSE_TASK_SNAPSHOTS requires configUSE_TRACE_FACILITY to be set to 1
+#endif
+
+#ifndef configUSE_TASK_RECYCLING
+	/* 1 to keep the memory of deleted tasks created by xTaskCreate() for new
+	tasks of the same stack depth, instead of freeing it. */
+	#define configUSE_TASK_RECYCLING 0
+#endif
+
+#ifndef configTASK_RECYCLE_POOL_SIZE
+	#define configTASK_RECYCLE_POOL_SIZE 4
+#endif
+
+#if( ( configUSE_TASK_RECYCLING == 1 ) && ( ( configSUPPORT_DYNAMIC_ALLOCATION == 0 ) || ( INCLUDE_vTaskDelete == 0 ) ) )
+	#error configUSE_TASK_RECYCLING requires configSUPPORT_DYNAMIC_ALLOCATION and INCLUDE_vTaskDelete to be set to 1
+#endif
+
+#ifndef configSEMAPHORE_SPIN_MIN
+	#define configSEMAPHORE_SPIN_MIN 16
+#endif
+
+#ifndef configSEMAPHORE_SPIN_MAX
+	#define configSEMAPHORE_SPIN_MAX 1000
+#endif
+
+#ifndef configSEMAPHORE_SPIN_ON_MUTEXES
+	/* Only worth enabling when a mutex holder can execute while the task
+	waiting for the mutex spins - for example on a multicore port. */
+	#define configSEMAPHORE_SPIN_ON_MUTEXES 0
+#endif
+
+#ifndef portSPIN_WAIT_HINT
+	#define portSPIN_WAIT_HINT()
+#endif
+
+#ifndef configUSE_PERIODIC_TASKS
+	#define configUSE_PERIODIC_TASKS 0
+#endif
+
+#ifndef configMAX_PERIODIC_TASKS
+	#define configMAX_PERIODIC_TASKS 8
+#endif
+
+#ifndef configPERIODIC_TASK_PRIORITY_POLICY
+	/* 0 = rate monotonic, 1 = deadline monotonic.  See periodic.h. */
+	#define configPERIODIC_TASK_PRIORITY_POLICY 0
+#endif
+
+#ifndef configPERIODIC_TASK_HIGHEST_PRIORITY
+	#define configPERIODIC_TASK_HIGHEST_PRIORITY ( configMAX_PRIORITIES - 1 )
+#endif
+
+#ifndef configPERIODIC_TASK_LOWEST_PRIORITY
+	#define configPERIODIC_TASK_LOWEST_PRIORITY 1
+#endif
+
+#ifndef configUSE_TASK_BUDGETS
+	#define configUSE_TASK_BUDGETS 0
+#endif
+
+#ifndef configMAX_BUDGETED_TASKS
+	#define configMAX_BUDGETED_TASKS 4
+#endif
+
+#ifndef configTASK_BUDGET_DEMOTE_PRIORITY
+	#define configTASK_BUDGET_DEMOTE_PRIORITY 0
+#endif
+
+#ifndef configUSE_TASK_BUDGET_HOOK
+	#define configUSE_TASK_BUDGET_HOOK 0
+#endif
+
+#ifndef configUSE_CCM_HOT_PATHS
+	#define configUSE_CCM_HOT_PATHS 0
+#endif
+
+#ifndef configUSE_CCM_TASK_ALLOCATION
+	#define configUSE_CCM_TASK_ALLOCATION 0
+#endif
+
+#ifndef configTIMER_WHEEL_SLOT_BITS
+	#define configTIMER_WHEEL_SLOT_BITS 4
+#endif
+
+#ifndef configTIMER_WHEEL_LEVELS
+	#define configTIMER_WHEEL_LEVELS 4
+#endif
+
+#ifndef configUSE_TIMER_FAST_CALLBACKS
+	#define configUSE_TIMER_FAST_CALLBACKS 0
+#endif
+
+#ifndef configMAX_HEAP_REGIONS
+	#define configMAX_HEAP_REGIONS 4
+#endif
+
+#ifndef configUSE_MICROSECOND_TIME
+	#define configUSE_MICROSECOND_TIME 0
+#endif
+
+#ifndef configTASK_DELAY_UNTIL_SPIN_US
+	#define configTASK_DELAY_UNTIL_SPIN_US 0
+#endif
+
+/* CCM_FUNCTION marks the functions on the context switch, tick and queue fast
+paths.  They are placed in core coupled memory if the port has it and
+configUSE_CCM_HOT_PATHS is 1. */
+#if( ( configUSE_CCM_HOT_PATHS == 1 ) && defined( portCCM_FUNCTION ) )
+	#define CCM_FUNCTION portCCM_FUNCTION
+#else
+	#define CCM_FUNCTION
+#endif
+
+#ifndef portCONFIGURE_CYCLE_COUNTER
+	#define portCONFIGURE_CYCLE_COUNTER()
+#endif
+
+#if( ( configUSE_TASK_BUDGETS == 1 ) && !defined( portGET_CYCLE_COUNTER ) )
+	#error configUSE_TASK_BUDGETS requires the port to define portGET_CYCLE_COUNTER()
+#endif
+
+#ifndef configTASK_NOTIFICATION_ARRAY_ENTRIES
+	#define configTASK_NOTIFICATION_ARRAY_ENTRIES 1
+#endif
+
+#if configTASK_NOTIFICATION_ARRAY_ENTRIES < 1
+	#error configTASK_NOTIFICATION_ARRAY_ENTRIES must be at least 1
+#endif
+
+#ifndef configJOB_POOL_NOTIFICATION_INDEX
+	/* The notification idle job pool workers, and tasks waiting for the jobs
+	of a job pool, block on. */
+	#define configJOB_POOL_NOTIFICATION_INDEX ( configTASK_NOTIFICATION_ARRAY_ENTRIES - 1 )
+#endif
+
+#if configJOB_POOL_NOTIFICATION_INDEX >= configTASK_NOTIFICATION_ARRAY_ENTRIES
+	#error configJOB_POOL_NOTIFICATION_INDEX must be less than configTASK_NOTIFICATION_ARRAY_ENTRIES
+#endif
+
+#ifndef configPOLL_SET_NOTIFICATION_INDEX
+	/* The notification a task waiting on a poll set blocks on, the one below
+	that of the job pools when there is one. */
+	#if configTASK_NOTIFICATION_ARRAY_ENTRIES > 1
+		#define configPOLL_SET_NOTIFICATION_INDEX ( configTASK_NOTIFICATION_ARRAY_ENTRIES - 2 )
+	#else
+		#define configPOLL_SET_NOTIFICATION_INDEX 0
+	#endif
+#endif
+
+#if configPOLL_SET_NOTIFICATION_INDEX >= configTASK_NOTIFICATION_ARRAY_ENTRIES
+	#error configPOLL_SET_NOTIFICATION_INDEX must be less than configTASK_NOTIFICATION_ARRAY_ENTRIES
+#endif
+
 #ifndef portTICK_TYPE_IS_ATOMIC
 	#define portTICK_TYPE_IS_ATOMIC 0
 #endif
@@ -837,6 +1072,14 @@ extern "C" {
 	#error configSUPPORT_STATIC_ALLOCATION and configSUPPORT_DYNAMIC_ALLOCATION cannot both be 0, but can both be 1.
 #endif
 
+#if( ( configUSE_CCM_TASK_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 0 ) )
+	#error configUSE_CCM_TASK_ALLOCATION requires configSUPPORT_DYNAMIC_ALLOCATION
+#endif
+
+#if( ( configUSE_CCM_TASK_ALLOCATION == 1 ) && !defined( portHEAP_REGION_CCM ) )
+	#error configUSE_CCM_TASK_ALLOCATION requires a port with a CCM heap region
+#endif
+
 #if( ( configUSE_RECURSIVE_MUTEXES == 1 ) && ( configUSE_MUTEXES != 1 ) )
 	#error configUSE_MUTEXES must be set to 1 to use recursive mutexes
 #endif
@@ -1016,8 +1259,8 @@ typedef struct xSTATIC_TCB
 		struct	_reent	xDummy17;
 	#endif
 	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
-		uint32_t 		ulDummy18;
-		uint8_t 		ucDummy19;
+		uint32_t 		ulDummy18[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
+		uint8_t 		ucDummy19[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
 	#endif
 	#if( ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) || ( portUSING_MPU_WRAPPERS == 1 ) )
 		uint8_t			uxDummy20;
@@ -1027,6 +1270,21 @@ typedef struct xSTATIC_TCB
 		uint8_t ucDummy21;
 	#endif
 
+	#if( configUSE_TASK_BUDGETS == 1 )
+		uint32_t		ulDummy22[ 2 ];
+		TickType_t		xDummy23[ 2 ];
+		UBaseType_t		uxDummy24[ 2 ];
+		uint8_t			ucDummy25[ 2 ];
+	#endif
+
+	#if( configUSE_TASK_SNAPSHOTS == 1 )
+		void			*pxDummy26[ 2 ];
+	#endif
+
+	#if( configUSE_TASK_RECYCLING == 1 )
+		uint32_t		ulDummy27;
+	#endif
+
 } StaticTask_t;
 
 /*
@@ -1055,7 +1313,7 @@ typedef struct xSTATIC_QUEUE
 
 	StaticList_t xDummy3[ 2 ];
 	UBaseType_t uxDummy4[ 3 ];
-	uint8_t ucDummy5[ 2 ];
+	uint8_t ucDummy5[ 3 ];
 
 	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 		uint8_t ucDummy6;
@@ -1070,6 +1328,15 @@ typedef struct xSTATIC_QUEUE
 		uint8_t ucDummy9;
 	#endif
 
+	#if ( configUSE_ADAPTIVE_SEMAPHORE_SPIN == 1 )
+		UBaseType_t uxDummy10[ 3 ];
+	#endif
+
+	#if ( configUSE_POLL_SETS == 1 )
+		void *pvDummy11;
+		UBaseType_t uxDummy12;
+	#endif
+
 } StaticQueue_t;
 typedef StaticQueue_t StaticSemaphore_t;
 
@@ -1090,12 +1357,15 @@ typedef StaticQueue_t StaticSemaphore_t;
 typedef struct xSTATIC_EVENT_GROUP
 {
 	TickType_t xDummy1;
-	StaticList_t xDummy2;
+	StaticList_t xDummy2[ configEVENT_GROUP_WAIT_LISTS ];
+	TickType_t xDummy5[ configEVENT_GROUP_WAIT_LISTS + 2 ];
 
 	#if( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t uxDummy3;
 	#endif
 
+	uint8_t ucDummy6;
+
 	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 			uint8_t ucDummy4;
 	#endif
@@ -1121,15 +1391,11 @@ typedef struct xSTATIC_TIMER
 	void				*pvDummy1;
 	StaticListItem_t	xDummy2;
 	TickType_t			xDummy3;
-	UBaseType_t			uxDummy4;
 	void 				*pvDummy5[ 2 ];
 	#if( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t		uxDummy6;
 	#endif
-
-	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
-		uint8_t 		ucDummy7;
-	#endif
+	uint8_t 			ucDummy7;
 
 } StaticTimer_t;
 
@@ -1155,6 +1421,10 @@ typedef struct xSTATIC_STREAM_BUFFER
 	#if ( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t uxDummy4;
 	#endif
+	#if ( configUSE_POLL_SETS == 1 )
+		void *pvDummy5;
+		UBaseType_t uxDummy6;
+	#endif
 } StaticStreamBuffer_t;
 
 /* Message buffers are built on stream buffers. */
@@ -53,29 +53,79 @@
 #define configMAX_PRIORITIES                    ( 7 )
 #define configMINIMAL_STACK_SIZE                ( ( uint16_t ) 128 )
 #define configTOTAL_HEAP_SIZE                   ( ( size_t ) ( 10 * 1024 ) )
+#define configSUPPORT_STATIC_ALLOCATION         1
+/* "make STATIC_ONLY=1" sets this to 0 and leaves the heap out of the build */
+#ifndef configSUPPORT_DYNAMIC_ALLOCATION
+ #define configSUPPORT_DYNAMIC_ALLOCATION       1
+#endif
 #define configMAX_TASK_NAME_LEN                 ( 16 )
 #define configUSE_TRACE_FACILITY                1
-#define configUSE_16_BIT_TICKS                  0
+/* 1 to drive GPIO probes from the trace hooks, see trace_gpio.h */
+#define configUSE_TRACE_GPIO                    0
+/* Test_host/test_tasks.c sets this to 1, so its tick count overflows often */
+#ifndef configUSE_16_BIT_TICKS
+ #define configUSE_16_BIT_TICKS                 0
+#endif
 #define configIDLE_SHOULD_YIELD                 1
 #define configUSE_MUTEXES                       1
 #define configQUEUE_REGISTRY_SIZE               8
-#define configCHECK_FOR_STACK_OVERFLOW          0
+/* "make stack-report" sets this to 2; left at 0 otherwise, so the context
+switches of the timing experiments are not slowed down by the check */
+#ifndef configCHECK_FOR_STACK_OVERFLOW
+ #define configCHECK_FOR_STACK_OVERFLOW         0
+#endif
+/* 1 to time every interrupt masking window (Src/main12_latency.c reports it) */
+#define configUSE_INTERRUPT_MASK_TIMING         0
+/* most tasks readied or ticks caught up per critical section when the
+scheduler is resumed, 0 for no limit */
+#define configRESUME_ALL_BATCH_SIZE             8
+#define configRECORD_STACK_HIGH_ADDRESS         1
+#define configUSE_STATS_FORMATTING_FUNCTIONS    1
 #define configUSE_RECURSIVE_MUTEXES             1
 #define configUSE_MALLOC_FAILED_HOOK            0
 #define configUSE_APPLICATION_TASK_TAG          0
 #define configUSE_COUNTING_SEMAPHORES           1
 #define configGENERATE_RUN_TIME_STATS           0
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES   4
+#define configUSE_ADAPTIVE_SEMAPHORE_SPIN       0
+/* 1 for poll sets, one task waiting on many queues and buffers (poll_set.h);
+Test_host/test_poll_set.c sets this to 1 */
+#ifndef configUSE_POLL_SETS
+ #define configUSE_POLL_SETS                    0
+#endif
+/* 1 for xTaskTakeSnapshot(), cheap periodic copies of the task states */
+#define configUSE_TASK_SNAPSHOTS                1
+#define configMAX_SNAPSHOT_TASKS                12
+/* reuse the TCB and stack of deleted tasks for new tasks of the same stack depth */
+#define configUSE_TASK_RECYCLING                configSUPPORT_DYNAMIC_ALLOCATION
+#define configTASK_RECYCLE_POOL_SIZE            4
+#define configUSE_PERIODIC_TASKS                1
+/* "make TASK_BUDGETS=1" sets this to 1, see Src/main16_task_budgets.c */
+#ifndef configUSE_TASK_BUDGETS
+ #define configUSE_TASK_BUDGETS                 0
+#endif
+#define configUSE_CCM_HOT_PATHS                 1
+#define configUSE_CCM_TASK_ALLOCATION           configSUPPORT_DYNAMIC_ALLOCATION
+#define configUSE_MICROSECOND_TIME              1
+#define configTASK_DELAY_UNTIL_SPIN_US          100
 
 
 /* Co-routine definitions. */
-#define configUSE_CO_ROUTINES                   0
+/* the host test of the co-routines (Test_host/test_croutine.c) sets this to 1 */
+#ifndef configUSE_CO_ROUTINES
+ #define configUSE_CO_ROUTINES                  0
+#endif
 #define configMAX_CO_ROUTINE_PRIORITIES         ( 2 )
 
 /* Software timer definitions. */
-#define configUSE_TIMERS                        0
+/* the host test of the timer wheel (Test_host/test_timers.c) sets this to 1 */
+#ifndef configUSE_TIMERS
+ #define configUSE_TIMERS                       0
+#endif
 #define configTIMER_TASK_PRIORITY               ( 2 )
 #define configTIMER_QUEUE_LENGTH                10
 #define configTIMER_TASK_STACK_DEPTH            ( configMINIMAL_STACK_SIZE * 2 )
+#define configUSE_TIMER_FAST_CALLBACKS          1
 
 /* Set the following definitions to 1 to include the API function, or zero
 to exclude the API function. */
@@ -89,6 +139,7 @@ to exclude the API function. */
 #define INCLUDE_xQueueGetMutexHolder            1
 #define INCLUDE_xTaskGetSchedulerState          1
 #define INCLUDE_eTaskGetState                   1
+#define INCLUDE_uxTaskGetStackHighWaterMark     1
 
 /* Cortex-M specific definitions. */
 #ifdef __NVIC_PRIO_BITS
@@ -128,5 +179,10 @@ header file. */
               to prevent overwriting SysTick_Handler defined within STM32Cube HAL */
 /* #define xPortSysTickHandler SysTick_Handler */
 
+/* GPIO timing probes: defines the trace macros, so it comes last. */
+#if ( configUSE_TRACE_GPIO == 1 ) && ( defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__) )
+ #include "trace_gpio.h"
+#endif
+
 #endif /* FREERTOS_CONFIG_H */
 
@@ -253,6 +253,16 @@ typedef SemaphoreHandle_t osSemaphoreId;
 /// \note CAN BE CHANGED: \b os_pool_cb is implementation specific in every CMSIS-RTOS.
 typedef struct os_pool_cb *osPoolId;
 
+/// Memory pool control block.  Visible so that pools can be allocated statically.
+/// \note CAN BE CHANGED: \b os_pool_cb is implementation specific in every CMSIS-RTOS.
+typedef struct os_pool_cb {
+  void *pool;
+  uint8_t *markers;
+  uint32_t pool_sz;
+  uint32_t item_sz;
+  uint32_t currentIndex;
+} os_pool_cb_t;
+
 /// Message ID identifies the message queue (pointer to a message queue control block).
 /// \note CAN BE CHANGED: \b os_messageQ_cb is implementation specific in every CMSIS-RTOS.
 typedef QueueHandle_t osMessageQId;
@@ -269,6 +279,7 @@ typedef StaticTimer_t              osStaticTimerDef_t;
 typedef StaticSemaphore_t          osStaticMutexDef_t;         
 typedef StaticSemaphore_t          osStaticSemaphoreDef_t;
 typedef StaticQueue_t              osStaticMessageQDef_t;
+typedef struct os_pool_cb          osStaticPoolDef_t;
 
 #endif
 
@@ -289,6 +300,14 @@ typedef struct os_thread_def  {
 #endif
 } osThreadDef_t;
 
+/// Stack usage of a thread, see \ref osThreadGetStats.
+/// \note CAN BE CHANGED: \b os_thread_stats is implementation specific in every CMSIS-RTOS.
+typedef struct os_thread_stats  {
+  uint32_t                 stack_size;     ///< stack size in words; 0 if the kernel does not record it
+  uint32_t                 stack_used_max; ///< most stack ever used in words; 0 if stack_size is 0
+  uint32_t                 stack_free_min; ///< least stack ever free in words (high water mark)
+} osThreadStats_t;
+
 /// Timer Definition structure contains timer parameters.
 /// \note CAN BE CHANGED: \b os_timer_def is implementation specific in every CMSIS-RTOS.
 typedef struct os_timer_def  {
@@ -322,6 +341,10 @@ typedef struct os_pool_def  {
   uint32_t                 pool_sz;    ///< number of items (elements) in the pool
   uint32_t                 item_sz;    ///< size of an item
   void                       *pool;    ///< pointer to memory for pool
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+  uint8_t                 *markers;    ///< block in use markers for static allocation; NULL for dynamic allocation
+  osStaticPoolDef_t  *controlblock;    ///< control block for static allocation; NULL for dynamic allocation
+#endif
 } osPoolDef_t;
 
 /// Definition structure for message queue.
@@ -433,6 +456,25 @@ const osThreadDef_t os_thread_def_##name = \
 #define osThread(name)  \
 &os_thread_def_##name
 
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+/// Define the attributes of a thread together with its stack and control block,
+/// so the thread is created without the heap and its RAM appears in the linker
+/// map as os_thread_stack_<name> and os_thread_cb_<name>.
+/// \param         name          name of the thread function.
+/// \param         priority      initial priority of the thread function.
+/// \param         instances     must be 1, the storage is for one instance.
+/// \param         stacksz       stack size in words, as passed to xTaskCreateStatic.
+#if defined (osObjectsExternal)  // object is external
+#define osThreadStaticAllocDef(name, thread, priority, instances, stacksz)  \
+extern const osThreadDef_t os_thread_def_##name
+#else                            // define the object
+#define osThreadStaticAllocDef(name, thread, priority, instances, stacksz)  \
+static uint32_t os_thread_stack_##name[(stacksz)]; \
+static osStaticThreadDef_t os_thread_cb_##name; \
+osThreadStaticDef(name, thread, priority, instances, stacksz, os_thread_stack_##name, &os_thread_cb_##name)
+#endif
+#endif
+
 /// Create a thread and add it to Active Threads and set it to state READY.
 /// \param[in]     thread_def    thread definition referenced with \ref osThread.
 /// \param[in]     argument      pointer that is passed to the thread function as start argument.
@@ -521,6 +563,20 @@ const osTimerDef_t os_timer_def_##name = \
 #define osTimer(name) \
 &os_timer_def_##name
 
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+/// Define a Timer object together with its control block os_timer_cb_<name>.
+/// \param         name          name of the timer object.
+/// \param         function      name of the timer call back function.
+#if defined (osObjectsExternal)  // object is external
+#define osTimerStaticAllocDef(name, function)  \
+extern const osTimerDef_t os_timer_def_##name
+#else                            // define the object
+#define osTimerStaticAllocDef(name, function)  \
+static osStaticTimerDef_t os_timer_cb_##name; \
+osTimerStaticDef(name, function, &os_timer_cb_##name)
+#endif
+#endif
+
 /// Create a timer.
 /// \param[in]     timer_def     timer object referenced with \ref osTimer.
 /// \param[in]     type          osTimerOnce for one-shot or osTimerPeriodic for periodic behavior.
@@ -605,6 +661,19 @@ const osMutexDef_t os_mutex_def_##name = { 0 }
 #define osMutex(name)  \
 &os_mutex_def_##name
 
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+/// Define a Mutex object together with its control block os_mutex_cb_<name>.
+/// \param         name          name of the mutex object.
+#if defined (osObjectsExternal)  // object is external
+#define osMutexStaticAllocDef(name)  \
+extern const osMutexDef_t os_mutex_def_##name
+#else                            // define the object
+#define osMutexStaticAllocDef(name)  \
+static osStaticMutexDef_t os_mutex_cb_##name; \
+osMutexStaticDef(name, &os_mutex_cb_##name)
+#endif
+#endif
+
 /// Create and Initialize a Mutex object.
 /// \param[in]     mutex_def     mutex definition referenced with \ref osMutex.
 /// \return mutex ID for reference by other functions or NULL in case of error.
@@ -664,6 +733,19 @@ const osSemaphoreDef_t os_semaphore_def_##name = { 0 }
 #define osSemaphore(name)  \
 &os_semaphore_def_##name
 
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+/// Define a Semaphore object together with its control block os_semaphore_cb_<name>.
+/// \param         name          name of the semaphore object.
+#if defined (osObjectsExternal)  // object is external
+#define osSemaphoreStaticAllocDef(name)  \
+extern const osSemaphoreDef_t os_semaphore_def_##name
+#else                            // define the object
+#define osSemaphoreStaticAllocDef(name)  \
+static osStaticSemaphoreDef_t os_semaphore_cb_##name; \
+osSemaphoreStaticDef(name, &os_semaphore_cb_##name)
+#endif
+#endif
+
 /// Create and Initialize a Semaphore object used for managing resources.
 /// \param[in]     semaphore_def semaphore definition referenced with \ref osSemaphore.
 /// \param[in]     count         number of available resources.
@@ -707,10 +789,20 @@ osStatus osSemaphoreDelete (osSemaphoreId semaphore_id);
 #define osPoolDef(name, no, type)   \
 extern const osPoolDef_t os_pool_def_##name
 #else                            // define the object
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+#define osPoolDef(name, no, type)   \
+const osPoolDef_t os_pool_def_##name = \
+{ (no), sizeof(type), NULL, NULL, NULL }
+
+#define osPoolStaticDef(name, no, type, pool, markers, control)   \
+const osPoolDef_t os_pool_def_##name = \
+{ (no), sizeof(type), (pool), (markers), (control) }
+#else //configSUPPORT_STATIC_ALLOCATION == 0
 #define osPoolDef(name, no, type)   \
 const osPoolDef_t os_pool_def_##name = \
 { (no), sizeof(type), NULL }
 #endif
+#endif
 
 /// \brief Access a Memory Pool definition.
 /// \param         name          name of the memory pool
@@ -719,6 +811,25 @@ const osPoolDef_t os_pool_def_##name = \
 #define osPool(name) \
 &os_pool_def_##name
 
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+/// Define a Memory Pool together with its blocks os_pool_m_<name>, its in use
+/// markers os_pool_markers_<name> and its control block os_pool_cb_<name>.
+/// Blocks are rounded up to a multiple of 4 bytes, as in \ref osPoolCreate.
+/// \param         name          name of the memory pool.
+/// \param         no            maximum number of blocks (objects) in the memory pool.
+/// \param         type          data type of a single block (object).
+#if defined (osObjectsExternal)  // object is external
+#define osPoolStaticAllocDef(name, no, type)   \
+extern const osPoolDef_t os_pool_def_##name
+#else                            // define the object
+#define osPoolStaticAllocDef(name, no, type)   \
+static uint32_t os_pool_m_##name[(no) * ((sizeof(type) + 3) / 4)]; \
+static uint8_t os_pool_markers_##name[(no)]; \
+static osStaticPoolDef_t os_pool_cb_##name; \
+osPoolStaticDef(name, no, type, os_pool_m_##name, os_pool_markers_##name, &os_pool_cb_##name)
+#endif
+#endif
+
 /// Create and Initialize a memory pool.
 /// \param[in]     pool_def      memory pool definition referenced with \ref osPool.
 /// \return memory pool ID for reference by other functions or NULL in case of error.
@@ -784,6 +895,23 @@ const osMessageQDef_t os_messageQ_def_##name = \
 #define osMessageQ(name) \
 &os_messageQ_def_##name
 
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+/// Define a Message Queue together with its storage os_messageQ_buffer_<name>
+/// and its control block os_messageQ_cb_<name>.
+/// \param         name          name of the queue.
+/// \param         queue_sz      maximum number of messages in the queue.
+/// \param         type          data type of a single message element (for debugger).
+#if defined (osObjectsExternal)  // object is external
+#define osMessageQStaticAllocDef(name, queue_sz, type)   \
+extern const osMessageQDef_t os_messageQ_def_##name
+#else                            // define the object
+#define osMessageQStaticAllocDef(name, queue_sz, type)   \
+static uint8_t os_messageQ_buffer_##name[(queue_sz) * sizeof(type)]; \
+static osStaticMessageQDef_t os_messageQ_cb_##name; \
+osMessageQStaticDef(name, queue_sz, type, os_messageQ_buffer_##name, &os_messageQ_cb_##name)
+#endif
+#endif
+
 /// Create and Initialize a Message Queue.
 /// \param[in]     queue_def     queue definition referenced with \ref osMessageQ.
 /// \param[in]     thread_id     thread ID (obtained by \ref osThreadCreate or \ref osThreadGetId) or NULL.
@@ -961,6 +1089,17 @@ osStatus osAbortDelay(osThreadId thread_id);
 */
 osStatus osThreadList (uint8_t *buffer);
 
+/**
+* @brief   Get the stack usage of a thread.
+* @param   thread_id   thread ID obtained by \ref osThreadCreate or \ref osThreadGetId.
+* @param   stats       filled with the stack size, the most stack used and the
+*          least stack free since the thread was created.
+* @retval  status code that indicates the execution status of the function.
+* @note    The figures come from the stack painting done at thread creation, so
+*          they are the deepest use seen so far, not a guaranteed worst case.
+*/
+osStatus osThreadGetStats (osThreadId thread_id, osThreadStats_t *stats);
+
 /**
 * @brief  Receive an item from a queue without removing the item from the queue.
 * @param  queue_id  message queue ID obtained with \ref osMessageCreate.
@@ -96,10 +96,22 @@ typedef unsigned long UBaseType_t;
 /* Critical section management. */
 extern void vPortEnterCritical( void );
 extern void vPortExitCritical( void );
-#define portSET_INTERRUPT_MASK_FROM_ISR()		ulPortRaiseBASEPRI()
-#define portCLEAR_INTERRUPT_MASK_FROM_ISR(x)	vPortSetBASEPRI(x)
-#define portDISABLE_INTERRUPTS()				vPortRaiseBASEPRI()
-#define portENABLE_INTERRUPTS()					vPortSetBASEPRI(0)
+#if( configUSE_INTERRUPT_MASK_TIMING == 1 )
+	/* Every window from raising BASEPRI from 0 to setting it back to 0 is timed
+	with the cycle counter, see vPortGetInterruptMaskStats(). */
+	extern void vPortRaiseBASEPRITimed( void );
+	extern uint32_t ulPortRaiseBASEPRITimed( void );
+	extern void vPortSetBASEPRITimed( uint32_t ulNewMaskValue );
+	#define portSET_INTERRUPT_MASK_FROM_ISR()		ulPortRaiseBASEPRITimed()
+	#define portCLEAR_INTERRUPT_MASK_FROM_ISR(x)	vPortSetBASEPRITimed(x)
+	#define portDISABLE_INTERRUPTS()				vPortRaiseBASEPRITimed()
+	#define portENABLE_INTERRUPTS()					vPortSetBASEPRITimed(0)
+#else
+	#define portSET_INTERRUPT_MASK_FROM_ISR()		ulPortRaiseBASEPRI()
+	#define portCLEAR_INTERRUPT_MASK_FROM_ISR(x)	vPortSetBASEPRI(x)
+	#define portDISABLE_INTERRUPTS()				vPortRaiseBASEPRI()
+	#define portENABLE_INTERRUPTS()					vPortSetBASEPRI(0)
+#endif
 #define portENTER_CRITICAL()					vPortEnterCritical()
 #define portEXIT_CRITICAL()						vPortExitCritical()
 
@@ -112,6 +124,56 @@ not necessary for to use this port.  They are defined so the common demo files
 #define portTASK_FUNCTION( vFunction, pvParameters ) void vFunction( void *pvParameters )
 /*-----------------------------------------------------------*/
 
+/* Cycle counter.  The DWT cycle counter counts core clock cycles and is used
+by the kernel where the tick is too coarse. */
+#define portDEMCR_REG				( * ( ( volatile uint32_t * ) 0xe000edfc ) )
+#define portDWT_CTRL_REG			( * ( ( volatile uint32_t * ) 0xe0001000 ) )
+#define portDWT_CYCCNT_REG			( * ( ( volatile uint32_t * ) 0xe0001004 ) )
+#define portDEMCR_TRCENA_BIT		( 1UL << 24UL )
+#define portDWT_CYCCNTENA_BIT		( 1UL << 0UL )
+
+#define portCONFIGURE_CYCLE_COUNTER()											\
+{																				\
+	portDEMCR_REG |= portDEMCR_TRCENA_BIT;										\
+	portDWT_CYCCNT_REG = 0UL;													\
+	portDWT_CTRL_REG |= portDWT_CYCCNTENA_BIT;									\
+}
+#define portGET_CYCLE_COUNTER()		( portDWT_CYCCNT_REG )
+
+#if( configUSE_INTERRUPT_MASK_TIMING == 1 )
+	/* Longest time the kernel kept interrupts at and below
+	configMAX_SYSCALL_INTERRUPT_PRIORITY masked, measured in core clock
+	cycles.  The mask raised by the PendSV handler around the context switch is
+	set in assembly and not included. */
+	typedef struct xPORT_INTERRUPT_MASK_STATS
+	{
+		uint32_t ulMaxCycles;		/* Longest window. */
+		void *pvMaxCaller;			/* Return address of the code that opened the longest window. */
+		uint32_t ulCount;			/* Number of windows measured. */
+		uint64_t ullTotalCycles;	/* Sum of the windows, for the average. */
+	} PortInterruptMaskStats_t;
+
+	/* Copy the statistics to *pxStats, then clear them if xReset is pdTRUE. */
+	extern void vPortGetInterruptMaskStats( PortInterruptMaskStats_t *pxStats, BaseType_t xReset );
+#endif
+/*-----------------------------------------------------------*/
+
+/* Core coupled memory.  The 8K CCM RAM is on the core's instruction and data
+buses with no wait states, so code placed in it avoids the flash wait states.
+It cannot be reached by DMA.  Calls between flash and CCM RAM are out of range
+of a BL instruction and go through linker generated veneers. */
+#define portCCM_FUNCTION			__attribute__( ( section( ".ccmram.text" ) ) )
+
+/* Default heap_5.c regions: the ucHeap array in SRAM, then the part of the CCM
+RAM not used by the .ccmram section, as bounded by the linker script.  Only
+pvPortMallocIn() allocates from the CCM region. */
+#define portHEAP_REGION_SRAM		0
+#define portHEAP_REGION_CCM			1
+extern uint8_t _sccmheap[], _eccmheap[];
+#define portCCM_HEAP_START			( _sccmheap )
+#define portCCM_HEAP_END			( _eccmheap )
+/*-----------------------------------------------------------*/
+
 /* Tickless idle/low power functionality. */
 #ifndef portSUPPRESS_TICKS_AND_SLEEP
 	extern void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime );
@@ -135,9 +197,10 @@ not necessary for to use this port.  They are defined so the common demo files
 		return ucReturn;
 	}
 
-	/* Check the configuration. */
-	#if( configMAX_PRIORITIES > 32 )
-		#error configUSE_PORT_OPTIMISED_TASK_SELECTION can only be set to 1 when configMAX_PRIORITIES is less than or equal to 32.  It is very rare that a system requires more than 10 to 15 difference priorities as tasks that share a priority will time slice.
+	/* Check the configuration.  Up to 32 priorities are held in a single bit
+	map word; above that tasks.c uses a two level bit map of up to 32 words. */
+	#if( configMAX_PRIORITIES > 256 )
+		#error configUSE_PORT_OPTIMISED_TASK_SELECTION can only be set to 1 when configMAX_PRIORITIES is less than or equal to 256.
 	#endif
 
 	/* Store/clear the ready priorities in a bit map. */
@@ -233,6 +296,38 @@ portFORCE_INLINE static void vPortSetBASEPRI( uint32_t ulNewMaskValue )
 }
 /*-----------------------------------------------------------*/
 
+/* Exclusive access, for lock free structures.  ulPortStoreExclusive() only
+stores, and returns 0, if nothing cleared the exclusive monitor since the
+matching ulPortLoadExclusive(); exception entry and exit clear it, so a store
+made between the two by an interrupt or by another task makes it fail. */
+portFORCE_INLINE static uint32_t ulPortLoadExclusive( volatile uint32_t *pulAddress )
+{
+uint32_t ulValue;
+
+	__asm volatile( "ldrex %0, [%1]" : "=r" ( ulValue ) : "r" ( pulAddress ) : "memory" );
+	return ulValue;
+}
+/*-----------------------------------------------------------*/
+
+portFORCE_INLINE static uint32_t ulPortStoreExclusive( volatile uint32_t *pulAddress, uint32_t ulValue )
+{
+uint32_t ulFailed;
+
+	__asm volatile( "strex %0, %2, [%1]" : "=&r" ( ulFailed ) : "r" ( pulAddress ), "r" ( ulValue ) : "memory" );
+	return ulFailed;
+}
+/*-----------------------------------------------------------*/
+
+portFORCE_INLINE static void vPortClearExclusive( void )
+{
+	__asm volatile( "clrex" ::: "memory" );
+}
+/*-----------------------------------------------------------*/
+
+/* Orders the memory accesses before it with the ones after it. */
+#define portMEMORY_BARRIER()	__asm volatile( "dmb" ::: "memory" )
+/*-----------------------------------------------------------*/
+
 
 #ifdef __cplusplus
 }
@@ -54,6 +54,8 @@ typedef struct corCoRoutineControlBlock
 	UBaseType_t 		uxPriority;			/*< The priority of the co-routine in relation to other co-routines. */
 	UBaseType_t 		uxIndex;			/*< Used to distinguish between co-routines when multiple co-routines use the same co-routine function. */
 	uint16_t 			uxState;			/*< Used internally by the co-routine implementation. */
+	volatile uint8_t	ucNotifyState;		/*< Whether the co-routine waits for, or has, a notification. */
+	volatile uint32_t	ulNotifiedValue;	/*< The bits notified since the co-routine last took them. */
 } CRCB_t; /* Co-routine control block.  Note must be identical in size down to uxPriority with TCB_t. */
 
 /**
@@ -62,7 +64,8 @@ typedef struct corCoRoutineControlBlock
  BaseType_t xCoRoutineCreate(
                                  crCOROUTINE_CODE pxCoRoutineCode,
                                  UBaseType_t uxPriority,
-                                 UBaseType_t uxIndex
+                                 UBaseType_t uxIndex,
+                                 CoRoutineHandle_t *pxCreatedCoRoutine
                                );</pre>
  *
  * Create a new co-routine and add it to the list of co-routines that are
@@ -79,6 +82,10 @@ typedef struct corCoRoutineControlBlock
  * execute the same function.  See the example below and the co-routine section
  * of the WEB documentation for further information.
  *
+ * @param pxCreatedCoRoutine Used to pass back the handle of the created
+ * co-routine, to pass to xCoRoutineNotify() or vPollSetBindCoRoutine().  Can
+ * be NULL.
+ *
  * @return pdPASS if the co-routine was successfully created and added to a ready
  * list, otherwise an error code defined with ProjDefs.h.
  *
@@ -113,22 +120,43 @@ typedef struct corCoRoutineControlBlock
  // Function that creates two co-routines.
  void vOtherFunction( void )
  {
- uint8_t ucParameterToPass;
- TaskHandle_t xHandle;
+ UBaseType_t uxIndex;
+ CoRoutineHandle_t xHandles[ 2 ];
 
      // Create two co-routines at priority 0.  The first is given index 0
      // so (from the code above) toggles LED 5 every 200 ticks.  The second
      // is given index 1 so toggles LED 6 every 400 ticks.
      for( uxIndex = 0; uxIndex < 2; uxIndex++ )
      {
-         xCoRoutineCreate( vFlashCoRoutine, 0, uxIndex );
+         xCoRoutineCreate( vFlashCoRoutine, 0, uxIndex, &( xHandles[ uxIndex ] ) );
      }
  }
    </pre>
  * \defgroup xCoRoutineCreate xCoRoutineCreate
  * \ingroup Tasks
  */
-BaseType_t xCoRoutineCreate( crCOROUTINE_CODE pxCoRoutineCode, UBaseType_t uxPriority, UBaseType_t uxIndex );
+BaseType_t xCoRoutineCreate( crCOROUTINE_CODE pxCoRoutineCode, UBaseType_t uxPriority, UBaseType_t uxIndex, CoRoutineHandle_t * const pxCreatedCoRoutine );
+
+/**
+ * croutine. h
+ *<pre>
+ CoRoutineHandle_t xCoRoutineCreateStatic(
+                                 crCOROUTINE_CODE pxCoRoutineCode,
+                                 UBaseType_t uxPriority,
+                                 UBaseType_t uxIndex,
+                                 CRCB_t * const pxCoRoutineBuffer
+                               );</pre>
+ *
+ * As xCoRoutineCreate(), with the control block provided by the application,
+ * so a large number of co-routines can be declared as an array.
+ *
+ * @return The handle of the co-routine, which is pxCoRoutineBuffer, to pass to
+ * xCoRoutineNotify().
+ *
+ * \defgroup xCoRoutineCreateStatic xCoRoutineCreateStatic
+ * \ingroup Tasks
+ */
+CoRoutineHandle_t xCoRoutineCreateStatic( crCOROUTINE_CODE pxCoRoutineCode, UBaseType_t uxPriority, UBaseType_t uxIndex, CRCB_t * const pxCoRoutineBuffer );
 
 
 /**
@@ -145,7 +173,8 @@ BaseType_t xCoRoutineCreate( crCOROUTINE_CODE pxCoRoutineCode, UBaseType_t uxPri
  *
  * If an application comprises of both tasks and co-routines then
  * vCoRoutineSchedule should be called from the idle task (in an idle task
- * hook).
+ * hook), or the co-routines run from a task of their own with
+ * vCoRoutineSchedulerTask().
  *
  * Example usage:
    <pre>
@@ -172,6 +201,31 @@ BaseType_t xCoRoutineCreate( crCOROUTINE_CODE pxCoRoutineCode, UBaseType_t uxPri
  */
 void vCoRoutineSchedule( void );
 
+/**
+ * croutine. h
+ * <pre>
+ void vCoRoutineSchedulerTask( void *pvParameters );</pre>
+ *
+ * Runs the co-routines from a task instead of the idle task: create a task
+ * with this function, or call it at the end of a task's own function.  It
+ * never returns.
+ *
+ * The task runs co-routines, highest priority first, for as long as any is
+ * ready, then blocks until the first delayed co-routine is due or until an
+ * interrupt, a task or another co-routine readies one.  So the co-routines
+ * run at the priority chosen for the task, all on its stack, and cost
+ * nothing while none is ready.
+ *
+ * Only one task may run the co-routines, and vCoRoutineSchedule() must not
+ * be called as well.  The co-routines must be created before the task
+ * starts, or by the co-routines themselves.  The task uses its notification
+ * (index 0) to wait.
+ *
+ * \defgroup vCoRoutineSchedulerTask vCoRoutineSchedulerTask
+ * \ingroup Tasks
+ */
+void vCoRoutineSchedulerTask( void *pvParameters );
+
 /**
  * croutine. h
  * <pre>
@@ -294,6 +348,78 @@ void vCoRoutineSchedule( void );
 	}																					\
 	crSET_STATE0( ( xHandle ) );
 
+/**
+ * croutine. h
+ * <pre>
+ crNOTIFY_WAIT( CoRoutineHandle_t xHandle, TickType_t xTicksToWait, uint32_t *pulValue, BaseType_t *pxResult );</pre>
+ *
+ * Waits up to xTicksToWait for a notification of the calling co-routine,
+ * sent with xCoRoutineNotify() or xCoRoutineNotifyFromISR().  Notifications
+ * are latched: one sent while the co-routine was not waiting is taken
+ * straight away.
+ *
+ * Notifications are how a co-routine waits on the ordinary queues, stream
+ * buffers and message buffers used by tasks: add them to a poll set bound to
+ * the co-routine, see crPOLL_SET_WAIT() in poll_set.h.
+ *
+ * crNOTIFY_WAIT can only be called from the co-routine function itself - not
+ * from within a function called by the co-routine function.
+ *
+ * @param pulValue Set to the bits of all the notifications received, if not
+ * NULL.
+ *
+ * @param pxResult Set to pdPASS if a notification was received, otherwise
+ * pdFAIL.
+ *
+ * \defgroup crNOTIFY_WAIT crNOTIFY_WAIT
+ * \ingroup Tasks
+ */
+#define crNOTIFY_WAIT( xHandle, xTicksToWait, pulValue, pxResult )						\
+{																						\
+	*( pxResult ) = xCoRoutineNotifyWait( ( pulValue ), ( xTicksToWait ) );				\
+	if( *( pxResult ) == errQUEUE_BLOCKED )												\
+	{																					\
+		crSET_STATE0( ( xHandle ) );													\
+		*( pxResult ) = xCoRoutineNotifyWait( ( pulValue ), 0 );						\
+	}																					\
+}
+
+/**
+ * croutine. h
+ * <pre>
+ BaseType_t xCoRoutineNotify( CoRoutineHandle_t xCoRoutine, uint32_t ulValue );
+ BaseType_t xCoRoutineNotifyFromISR( CoRoutineHandle_t xCoRoutine, uint32_t ulValue, BaseType_t * const pxHigherPriorityTaskWoken );</pre>
+ *
+ * Sends a notification to a co-routine, from a task or a co-routine, or from
+ * an interrupt.  ulValue is ORed into the bits the co-routine takes with
+ * crNOTIFY_WAIT().  A co-routine blocked in crNOTIFY_WAIT() is readied.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if the task running
+ * vCoRoutineSchedulerTask() was woken and has a priority above the
+ * interrupted task.
+ *
+ * @return pdPASS.
+ *
+ * \defgroup xCoRoutineNotify xCoRoutineNotify
+ * \ingroup Tasks
+ */
+BaseType_t xCoRoutineNotify( CoRoutineHandle_t xCoRoutine, uint32_t ulValue );
+BaseType_t xCoRoutineNotifyFromISR( CoRoutineHandle_t xCoRoutine, uint32_t ulValue, BaseType_t * const pxHigherPriorityTaskWoken );
+
+/**
+ * croutine. h
+ * <pre>
+ BaseType_t xCoRoutineNotifyStateClear( CoRoutineHandle_t xCoRoutine );</pre>
+ *
+ * Discards a notification that is pending for the co-routine.
+ *
+ * @return pdPASS if a notification was pending, otherwise pdFAIL.
+ *
+ * \defgroup xCoRoutineNotifyStateClear xCoRoutineNotifyStateClear
+ * \ingroup Tasks
+ */
+BaseType_t xCoRoutineNotifyStateClear( CoRoutineHandle_t xCoRoutine );
+
 /**
  * <pre>
  crQUEUE_SEND(
@@ -713,6 +839,15 @@ void vCoRoutineAddToDelayedList( TickType_t xTicksToDelay, List_t *pxEventList )
  */
 BaseType_t xCoRoutineRemoveFromEventList( const List_t *pxEventList );
 
+/*
+ * This function is intended for internal use by the co-routine macros only.
+ * The function should not be used by application writers.
+ *
+ * Takes the notification of the current co-routine, or blocks it for up to
+ * xTicksToWait waiting for one, in which case it returns errQUEUE_BLOCKED.
+ */
+BaseType_t xCoRoutineNotifyWait( uint32_t *pulValue, TickType_t xTicksToWait );
+
 #ifdef __cplusplus
 }
 #endif
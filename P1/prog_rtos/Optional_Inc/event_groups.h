@@ -353,20 +353,15 @@ EventBits_t xEventGroupClearBits( EventGroupHandle_t xEventGroup, const EventBit
 /**
  * event_groups.h
  *<pre>
-	BaseType_t xEventGroupClearBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet );
+	BaseType_t xEventGroupClearBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToClear );
  </pre>
  *
  * A version of xEventGroupClearBits() that can be called from an interrupt.
  *
- * Setting bits in an event group is not a deterministic operation because there
- * are an unknown number of tasks that may be waiting for the bit or bits being
- * set.  FreeRTOS does not allow nondeterministic operations to be performed
- * while interrupts are disabled, so protects event groups that are accessed
- * from tasks by suspending the scheduler rather than disabling interrupts.  As
- * a result event groups cannot be accessed directly from an interrupt service
- * routine.  Therefore xEventGroupClearBitsFromISR() sends a message to the
- * timer task to have the clear operation performed in the context of the timer
- * task.
+ * The bits are cleared directly, unless the interrupt occurred while a task was
+ * using the event group, in which case that task clears them (after setting
+ * any bits set by earlier calls to xEventGroupSetBitsFromISR()) before it
+ * releases the group.
  *
  * @param xEventGroup The event group in which the bits are to be cleared.
  *
@@ -374,9 +369,7 @@ EventBits_t xEventGroupClearBits( EventGroupHandle_t xEventGroup, const EventBit
  * For example, to clear bit 3 only, set uxBitsToClear to 0x08.  To clear bit 3
  * and bit 0 set uxBitsToClear to 0x09.
  *
- * @return If the request to execute the function was posted successfully then
- * pdPASS is returned, otherwise pdFALSE is returned.  pdFALSE will be returned
- * if the timer service queue was full.
+ * @return pdPASS.
  *
  * Example usage:
    <pre>
@@ -390,24 +383,15 @@ EventBits_t xEventGroupClearBits( EventGroupHandle_t xEventGroup, const EventBit
    void anInterruptHandler( void )
    {
 		// Clear bit 0 and bit 4 in xEventGroup.
-		xResult = xEventGroupClearBitsFromISR(
+		xEventGroupClearBitsFromISR(
 							xEventGroup,	 // The event group being updated.
-							BIT_0 | BIT_4 ); // The bits being set.
-
-		if( xResult == pdPASS )
-		{
-			// The message was posted successfully.
-		}
+							BIT_0 | BIT_4 ); // The bits being cleared.
   }
    </pre>
  * \defgroup xEventGroupClearBitsFromISR xEventGroupClearBitsFromISR
  * \ingroup EventGroup
  */
-#if( configUSE_TRACE_FACILITY == 1 )
-	BaseType_t xEventGroupClearBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet ) PRIVILEGED_FUNCTION;
-#else
-	#define xEventGroupClearBitsFromISR( xEventGroup, uxBitsToClear ) xTimerPendFunctionCallFromISR( vEventGroupClearBitsCallback, ( void * ) xEventGroup, ( uint32_t ) uxBitsToClear, NULL )
-#endif
+BaseType_t xEventGroupClearBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToClear ) PRIVILEGED_FUNCTION;
 
 /**
  * event_groups.h
@@ -491,13 +475,15 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup, const EventBits_
  *
  * A version of xEventGroupSetBits() that can be called from an interrupt.
  *
- * Setting bits in an event group is not a deterministic operation because there
- * are an unknown number of tasks that may be waiting for the bit or bits being
- * set.  FreeRTOS does not allow nondeterministic operations to be performed in
- * interrupts or from critical sections.  Therefore xEventGroupSetBitsFromISR()
- * sends a message to the timer task to have the set operation performed in the
- * context of the timer task - where a scheduler lock is used in place of a
- * critical section.
+ * The bits are set, and the tasks waiting for them unblocked, directly from the
+ * interrupt.  The tasks blocked on an event group are held on
+ * configEVENT_GROUP_WAIT_LISTS lists selected by the lowest bit each task waits
+ * for, and only the lists holding tasks that wait for one of the bits being
+ * set are looked at, so the time spent with interrupts masked depends on the
+ * number of tasks waiting for those bits rather than on all the tasks blocked
+ * on the group.  If the interrupt occurred while a task was using the event
+ * group the bits are left for that task, which sets them and unblocks the
+ * waiting tasks before it releases the group.
  *
  * @param xEventGroup The event group in which the bits are to be set.
  *
@@ -505,19 +491,15 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup, const EventBits_
  * For example, to set bit 3 only, set uxBitsToSet to 0x08.  To set bit 3
  * and bit 0 set uxBitsToSet to 0x09.
  *
- * @param pxHigherPriorityTaskWoken As mentioned above, calling this function
- * will result in a message being sent to the timer daemon task.  If the
- * priority of the timer daemon task is higher than the priority of the
- * currently running task (the task the interrupt interrupted) then
- * *pxHigherPriorityTaskWoken will be set to pdTRUE by
- * xEventGroupSetBitsFromISR(), indicating that a context switch should be
+ * @param pxHigherPriorityTaskWoken If setting the bits unblocks a task that
+ * has a priority higher than the currently running task (the task the
+ * interrupt interrupted) then *pxHigherPriorityTaskWoken will be set to pdTRUE
+ * by xEventGroupSetBitsFromISR(), indicating that a context switch should be
  * requested before the interrupt exits.  For that reason
  * *pxHigherPriorityTaskWoken must be initialised to pdFALSE.  See the
- * example code below.
+ * example code below.  It can be NULL.
  *
- * @return If the request to execute the function was posted successfully then
- * pdPASS is returned, otherwise pdFALSE is returned.  pdFALSE will be returned
- * if the timer service queue was full.
+ * @return pdPASS.
  *
  * Example usage:
    <pre>
@@ -530,36 +512,28 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup, const EventBits_
 
    void anInterruptHandler( void )
    {
-   BaseType_t xHigherPriorityTaskWoken, xResult;
+   BaseType_t xHigherPriorityTaskWoken;
 
 		// xHigherPriorityTaskWoken must be initialised to pdFALSE.
 		xHigherPriorityTaskWoken = pdFALSE;
 
 		// Set bit 0 and bit 4 in xEventGroup.
-		xResult = xEventGroupSetBitsFromISR(
+		xEventGroupSetBitsFromISR(
 							xEventGroup,	// The event group being updated.
-							BIT_0 | BIT_4   // The bits being set.
+							BIT_0 | BIT_4,  // The bits being set.
 							&xHigherPriorityTaskWoken );
 
-		// Was the message posted successfully?
-		if( xResult == pdPASS )
-		{
-			// If xHigherPriorityTaskWoken is now set to pdTRUE then a context
-			// switch should be requested.  The macro used is port specific and
-			// will be either portYIELD_FROM_ISR() or portEND_SWITCHING_ISR() -
-			// refer to the documentation page for the port being used.
-			portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
-		}
+		// If xHigherPriorityTaskWoken is now set to pdTRUE then a context
+		// switch should be requested.  The macro used is port specific and
+		// will be either portYIELD_FROM_ISR() or portEND_SWITCHING_ISR() -
+		// refer to the documentation page for the port being used.
+		portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
   }
    </pre>
  * \defgroup xEventGroupSetBitsFromISR xEventGroupSetBitsFromISR
  * \ingroup EventGroup
  */
-#if( configUSE_TRACE_FACILITY == 1 )
-	BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
-#else
-	#define xEventGroupSetBitsFromISR( xEventGroup, uxBitsToSet, pxHigherPriorityTaskWoken ) xTimerPendFunctionCallFromISR( vEventGroupSetBitsCallback, ( void * ) xEventGroup, ( uint32_t ) uxBitsToSet, pxHigherPriorityTaskWoken )
-#endif
+BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
 /**
  * event_groups.h
@@ -0,0 +1,155 @@
+/*
+ * prog_rtos kernel add-on: job pools, worker tasks running short jobs from
+ * per-worker deques, with work stealing.
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Job pools.
+ *
+ * A job pool runs short jobs, a function and its argument, on a fixed set of
+ * worker tasks, so an application that fans work out does not create and
+ * delete a task, with its stack, for every piece of it.
+ *
+ * Every worker has its own deque of jobs.  A job submitted by a worker goes to
+ * the bottom of its own deque and the worker takes its jobs back from the
+ * bottom, newest first, while the data they use is still warm.  A job
+ * submitted by any other task is handed to the workers in turn.  A worker that
+ * runs out of jobs steals the oldest job from the top of another worker's
+ * deque, so one worker blocked in a long job does not hold back the jobs queued
+ * behind it.  Idle workers block on their task notification at index
+ * configJOB_POOL_NOTIFICATION_INDEX, so jobs are free to use the other ones,
+ * and are woken, one for each job submitted, only while some of them are idle.
+ *
+ * Jobs can be counted with a JobCounter_t to wait for all of them to complete.
+ * A worker that waits for a counter runs jobs while it waits instead of
+ * blocking, so jobs can fan out further and wait for their own jobs.
+ *
+ * The deques are protected by critical sections of a few instructions each.
+ */
+
+#ifndef JOB_POOL_H
+#define JOB_POOL_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include job_pool.h"
+#endif
+
+#include "task.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/**
+ * Type by which job pools are referenced.
+ */
+typedef void * JobPoolHandle_t;
+
+/**
+ * Prototype of the functions run as jobs.
+ */
+typedef void (*JobFunction_t)( void *pvArgument );
+
+/*
+ * Counts the jobs submitted with it that have not completed yet.  A counter
+ * is zero initialised, for example "JobCounter_t xCounter = { 0 };", and can
+ * be used again once xJobPoolWait() returned pdPASS for it.  Only one task at
+ * a time may wait for a counter.  The members must not be used directly.
+ */
+typedef struct xJOB_COUNTER
+{
+	volatile UBaseType_t uxPending;
+	volatile TaskHandle_t xWaitingTask;
+} JobCounter_t;
+
+/**
+ * job_pool.h
+ * <pre>JobPoolHandle_t xJobPoolCreate( UBaseType_t uxWorkers, UBaseType_t uxDequeLength, configSTACK_DEPTH_TYPE usStackDepth, UBaseType_t uxPriority );</pre>
+ *
+ * Creates a job pool of uxWorkers worker tasks, of usStackDepth words of stack
+ * each, running at uxPriority.  Each worker can hold uxDequeLength jobs that
+ * have not started yet, which must be a power of two.  uxWorkers must be
+ * between 1 and 32.
+ *
+ * The pool, the deques and the workers are allocated from the heap.
+ *
+ * @return The handle of the pool, or NULL if there was not enough heap.
+ *
+ * \ingroup JobPools
+ */
+JobPoolHandle_t xJobPoolCreate( UBaseType_t uxWorkers,
+								UBaseType_t uxDequeLength,
+								configSTACK_DEPTH_TYPE usStackDepth,
+								UBaseType_t uxPriority ) PRIVILEGED_FUNCTION;
+
+/**
+ * job_pool.h
+ * <pre>void vJobPoolDelete( JobPoolHandle_t xJobPool );</pre>
+ *
+ * Waits for the queued jobs to run and for every worker to go idle, polling
+ * once a tick, then deletes the workers and frees the pool, so no worker is
+ * deleted part way through a job.  No job may be submitted meanwhile, and the
+ * caller must not be one of the workers.
+ *
+ * \ingroup JobPools
+ */
+void vJobPoolDelete( JobPoolHandle_t xJobPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * job_pool.h
+ * <pre>BaseType_t xJobPoolSubmit( JobPoolHandle_t xJobPool, JobFunction_t pxFunction, void *pvArgument, JobCounter_t *pxCounter );</pre>
+ *
+ * Queues a call to pxFunction( pvArgument ) on one of the workers.  The job is
+ * counted in *pxCounter until it completes, unless pxCounter is NULL.  Never
+ * blocks.
+ *
+ * A worker queues the job on its own deque, any other task on the deque of
+ * the next worker in turn.  If that deque is full the job goes to the next one
+ * with space.  Can only be called from a task.
+ *
+ * @return pdPASS if the job was queued, pdFAIL if every deque was full.
+ *
+ * \ingroup JobPools
+ */
+BaseType_t xJobPoolSubmit( JobPoolHandle_t xJobPool,
+						   JobFunction_t pxFunction,
+						   void *pvArgument,
+						   JobCounter_t *pxCounter ) PRIVILEGED_FUNCTION;
+
+/**
+ * job_pool.h
+ * <pre>BaseType_t xJobPoolWait( JobPoolHandle_t xJobPool, JobCounter_t *pxCounter, TickType_t xTicksToWait );</pre>
+ *
+ * Waits up to xTicksToWait for every job counted in *pxCounter to complete.
+ *
+ * Called from a worker of xJobPool, runs the queued jobs, its own first, until
+ * the counter drops to zero, and only blocks once there is nothing left to
+ * run.  The jobs run on the stack of the waiting job, so jobs that wait nest.
+ *
+ * Any other task blocks on its task notification at index
+ * configJOB_POOL_NOTIFICATION_INDEX, the last one by default, which must not be
+ * used for anything else meanwhile.
+ *
+ * @return pdPASS if the jobs completed, pdFAIL if the wait timed out.
+ *
+ * \ingroup JobPools
+ */
+BaseType_t xJobPoolWait( JobPoolHandle_t xJobPool, JobCounter_t *pxCounter, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * job_pool.h
+ * <pre>uint32_t ulJobPoolGetSteals( JobPoolHandle_t xJobPool );</pre>
+ *
+ * @return The number of jobs the workers took from each other's deques.
+ *
+ * \ingroup JobPools
+ */
+uint32_t ulJobPoolGetSteals( JobPoolHandle_t xJobPool ) PRIVILEGED_FUNCTION;
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* JOB_POOL_H */
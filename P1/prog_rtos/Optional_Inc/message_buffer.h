@@ -772,6 +772,63 @@ BaseType_t xMessageBufferReceiveCompletedFromISR( MessageBufferHandle_t xStreamB
  */
 #define xMessageBufferReceiveCompletedFromISR( xMessageBuffer, pxHigherPriorityTaskWoken ) xStreamBufferReceiveCompletedFromISR( ( StreamBufferHandle_t ) xMessageBuffer, pxHigherPriorityTaskWoken )
 
+/**
+ * message_buffer.h
+ *
+<pre>
+size_t xMessageBufferPeek( MessageBufferHandle_t xMessageBuffer, StreamBufferRegions_t * const pxRegions );
+</pre>
+ *
+ * Gives the next message in a message buffer where it is, without copying it
+ * out or removing it, so it can be parsed in place.  The message is then
+ * removed with xMessageBufferConsume() or xMessageBufferConsumeFromISR().
+ *
+ * The message is in pxRegions->pucFirst, unless it wraps around the end of the
+ * storage area, in which case it continues at pxRegions->pucSecond.  A message
+ * buffer sized as a multiple of its messages, each with their
+ * sizeof( size_t ) byte length, never wraps them.
+ *
+ * The function does not block and can be called from a task or an interrupt.
+ * Only the reader may call it.
+ *
+ * @param xMessageBuffer The handle of the message buffer being read.
+ *
+ * @param pxRegions Set to the region(s) holding the message.
+ *
+ * @return The length of the next message, or 0 if the message buffer is
+ * empty.
+ *
+ * \defgroup xMessageBufferPeek xMessageBufferPeek
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferPeek( xMessageBuffer, pxRegions ) xStreamBufferPeekMessage( ( StreamBufferHandle_t ) xMessageBuffer, pxRegions )
+
+/**
+ * message_buffer.h
+ *
+<pre>
+size_t xMessageBufferConsume( MessageBufferHandle_t xMessageBuffer, size_t xMessageLength );
+size_t xMessageBufferConsumeFromISR( MessageBufferHandle_t xMessageBuffer, size_t xMessageLength, BaseType_t *pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * Removes the message returned by xMessageBufferPeek() and unblocks a writer
+ * waiting for space as xMessageBufferReceive() does.  Use
+ * xMessageBufferConsumeFromISR() from an interrupt.
+ *
+ * @param xMessageBuffer The handle of the message buffer being read.
+ *
+ * @param xMessageLength The length returned by xMessageBufferPeek().
+ *
+ * @param pxHigherPriorityTaskWoken As for xMessageBufferReceiveFromISR().
+ *
+ * @return The length of the message removed.
+ *
+ * \defgroup xMessageBufferConsume xMessageBufferConsume
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferConsume( xMessageBuffer, xMessageLength ) xStreamBufferConsume( ( StreamBufferHandle_t ) xMessageBuffer, xMessageLength )
+#define xMessageBufferConsumeFromISR( xMessageBuffer, xMessageLength, pxHigherPriorityTaskWoken ) xStreamBufferConsumeFromISR( ( StreamBufferHandle_t ) xMessageBuffer, xMessageLength, pxHigherPriorityTaskWoken )
+
 #if defined( __cplusplus )
 } /* extern "C" */
 #endif
@@ -0,0 +1,203 @@
+/*
+ * prog_rtos kernel add-on: multi-producer message buffers, where several
+ * writers reserve and commit messages without a lock.
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Multi-producer message buffers.
+ *
+ * A message buffer (message_buffer.h) accepts a single writer, so several
+ * producer tasks must serialise their sends through a mutex or a critical
+ * section.  A multi-producer message buffer accepts any number of writers,
+ * tasks and interrupts alike, without a lock: each writer reserves the space
+ * for its message with a LDREX/STREX loop, fills it concurrently with the
+ * other writers, and commits it.  Committed messages are handed to the single
+ * reader in the order their space was reserved, a message that is committed
+ * before an earlier one is published together with it.
+ *
+ * Every message is stored contiguously, with an 8 byte header, and padded to
+ * 8 bytes, so the reader can also use it in place (xMPMessageBufferPeek()).
+ * Writers never block: a message that does not fit is dropped and counted,
+ * which is what a shared log or telemetry channel wants under heavy fan-in.
+ * Only the reader can block, waiting for a message.
+ *
+ * Every reserved message must be committed: a writer that is suspended
+ * between the two holds back the messages reserved after its own.
+ */
+
+#ifndef MP_MESSAGE_BUFFER_H
+#define MP_MESSAGE_BUFFER_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include mp_message_buffer.h"
+#endif
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/**
+ * Type by which multi-producer message buffers are referenced.
+ */
+typedef void * MPMessageBufferHandle_t;
+
+/*
+ * Memory for a multi-producer message buffer created with
+ * xMPMessageBufferCreateStatic().  The structure has the size of the real one,
+ * its members must not be used.
+ */
+typedef struct xSTATIC_MP_MESSAGE_BUFFER
+{
+	uint32_t ulDummy1[ 4 ];
+	void *pvDummy2[ 2 ];
+	uint32_t ulDummy3[ 2 ];
+} StaticMPMessageBuffer_t;
+
+/* The bytes a message of xLength bytes takes in the buffer. */
+#define mpmbMESSAGE_SIZE( xLength )		( ( size_t ) 8 + ( ( ( size_t ) ( xLength ) + ( size_t ) 7 ) & ~( size_t ) 7 ) )
+
+/**
+ * mp_message_buffer.h
+ * <pre>MPMessageBufferHandle_t xMPMessageBufferCreate( size_t xBufferSizeBytes );</pre>
+ *
+ * Creates a multi-producer message buffer with a storage area of
+ * xBufferSizeBytes allocated from the heap.  xBufferSizeBytes must be a power
+ * of two of at least 16; each message takes mpmbMESSAGE_SIZE() bytes of it.
+ *
+ * @return The handle of the message buffer, or NULL if there was not enough
+ * heap.
+ *
+ * \ingroup MessageBufferManagement
+ */
+MPMessageBufferHandle_t xMPMessageBufferCreate( size_t xBufferSizeBytes ) PRIVILEGED_FUNCTION;
+
+/**
+ * mp_message_buffer.h
+ * <pre>MPMessageBufferHandle_t xMPMessageBufferCreateStatic( size_t xBufferSizeBytes, uint8_t * const pucStorageArea, StaticMPMessageBuffer_t * const pxStaticBuffer );</pre>
+ *
+ * As xMPMessageBufferCreate(), with the storage area and the structure
+ * provided by the application.  pucStorageArea must be 8 byte aligned.
+ *
+ * \ingroup MessageBufferManagement
+ */
+MPMessageBufferHandle_t xMPMessageBufferCreateStatic( size_t xBufferSizeBytes,
+													  uint8_t * const pucStorageArea,
+													  StaticMPMessageBuffer_t * const pxStaticBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * mp_message_buffer.h
+ * <pre>void vMPMessageBufferDelete( MPMessageBufferHandle_t xMessageBuffer );</pre>
+ *
+ * Frees a message buffer created with xMPMessageBufferCreate().  No task may
+ * be using it.
+ *
+ * \ingroup MessageBufferManagement
+ */
+void vMPMessageBufferDelete( MPMessageBufferHandle_t xMessageBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * mp_message_buffer.h
+ * <pre>void *pvMPMessageBufferReserve( MPMessageBufferHandle_t xMessageBuffer, size_t xLength );</pre>
+ *
+ * Reserves the space for a message of xLength bytes.  Can be called from any
+ * task or interrupt, concurrently with other writers.  The message is written
+ * at the returned address, then published with vMPMessageBufferCommit() or
+ * vMPMessageBufferCommitFromISR().
+ *
+ * @return The 8 byte aligned address of the message, or NULL if the message
+ * does not fit in the free space, in which case it is counted as dropped.
+ *
+ * \ingroup MessageBufferManagement
+ */
+void *pvMPMessageBufferReserve( MPMessageBufferHandle_t xMessageBuffer, size_t xLength ) PRIVILEGED_FUNCTION;
+
+/**
+ * mp_message_buffer.h
+ * <pre>void vMPMessageBufferCommit( MPMessageBufferHandle_t xMessageBuffer, void *pvMessage );
+void vMPMessageBufferCommitFromISR( MPMessageBufferHandle_t xMessageBuffer, void *pvMessage, BaseType_t * const pxHigherPriorityTaskWoken );</pre>
+ *
+ * Publishes a message written at an address returned by
+ * pvMPMessageBufferReserve(), and wakes the reader if it is waiting.  Use the
+ * FromISR version from an interrupt.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if the reader was woken and
+ * has a priority above the interrupted task, see xMessageBufferSendFromISR().
+ *
+ * \ingroup MessageBufferManagement
+ */
+void vMPMessageBufferCommit( MPMessageBufferHandle_t xMessageBuffer, void *pvMessage ) PRIVILEGED_FUNCTION;
+void vMPMessageBufferCommitFromISR( MPMessageBufferHandle_t xMessageBuffer, void *pvMessage, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * mp_message_buffer.h
+ * <pre>size_t xMPMessageBufferSend( MPMessageBufferHandle_t xMessageBuffer, const void *pvTxData, size_t xDataLengthBytes );
+size_t xMPMessageBufferSendFromISR( MPMessageBufferHandle_t xMessageBuffer, const void *pvTxData, size_t xDataLengthBytes, BaseType_t * const pxHigherPriorityTaskWoken );</pre>
+ *
+ * Reserves, copies and commits a message in one call.  Never blocks.
+ *
+ * @return xDataLengthBytes, or 0 if the message was dropped.
+ *
+ * \ingroup MessageBufferManagement
+ */
+size_t xMPMessageBufferSend( MPMessageBufferHandle_t xMessageBuffer, const void *pvTxData, size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+size_t xMPMessageBufferSendFromISR( MPMessageBufferHandle_t xMessageBuffer, const void *pvTxData, size_t xDataLengthBytes, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * mp_message_buffer.h
+ * <pre>size_t xMPMessageBufferPeek( MPMessageBufferHandle_t xMessageBuffer, void **ppvMessage, TickType_t xTicksToWait );</pre>
+ *
+ * Gives the oldest published message in place, waiting up to xTicksToWait
+ * for one if the buffer is empty.  The message stays in the buffer until
+ * vMPMessageBufferConsume() is called.  Only the reader may call it; from an
+ * interrupt xTicksToWait must be 0.
+ *
+ * @param ppvMessage Set to the 8 byte aligned address of the message.
+ *
+ * @return The length of the message, or 0 if there is none.
+ *
+ * \ingroup MessageBufferManagement
+ */
+size_t xMPMessageBufferPeek( MPMessageBufferHandle_t xMessageBuffer, void **ppvMessage, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * mp_message_buffer.h
+ * <pre>void vMPMessageBufferConsume( MPMessageBufferHandle_t xMessageBuffer );</pre>
+ *
+ * Removes the message returned by xMPMessageBufferPeek(), making its space
+ * available to the writers.
+ *
+ * \ingroup MessageBufferManagement
+ */
+void vMPMessageBufferConsume( MPMessageBufferHandle_t xMessageBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * mp_message_buffer.h
+ * <pre>size_t xMPMessageBufferReceive( MPMessageBufferHandle_t xMessageBuffer, void *pvRxData, size_t xBufferLengthBytes, TickType_t xTicksToWait );</pre>
+ *
+ * Copies the oldest published message to pvRxData and removes it, waiting up
+ * to xTicksToWait for one.  A message longer than xBufferLengthBytes is left
+ * in the buffer.
+ *
+ * @return The length of the message received, or 0 if none was.
+ *
+ * \ingroup MessageBufferManagement
+ */
+size_t xMPMessageBufferReceive( MPMessageBufferHandle_t xMessageBuffer, void *pvRxData, size_t xBufferLengthBytes, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * mp_message_buffer.h
+ * <pre>uint32_t ulMPMessageBufferGetDropped( MPMessageBufferHandle_t xMessageBuffer );</pre>
+ *
+ * @return The number of messages dropped because they did not fit.
+ *
+ * \ingroup MessageBufferManagement
+ */
+uint32_t ulMPMessageBufferGetDropped( MPMessageBufferHandle_t xMessageBuffer ) PRIVILEGED_FUNCTION;
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* MP_MESSAGE_BUFFER_H */
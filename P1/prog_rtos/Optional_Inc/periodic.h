@@ -0,0 +1,186 @@
+/*
+ * prog_rtos kernel add-on: periodic tasks, given a period, a WCET budget and a
+ * deadline, with their priorities assigned by the kernel.
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#ifndef PERIODIC_H
+#define PERIODIC_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include periodic.h"
+#endif
+
+#include "task.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Periodic tasks are created from a period, a worst case execution time (WCET)
+ * budget and a relative deadline rather than from a priority.  The kernel
+ * assigns priorities within the band configPERIODIC_TASK_LOWEST_PRIORITY to
+ * configPERIODIC_TASK_HIGHEST_PRIORITY, either rate monotonically (shorter
+ * period means higher priority) or deadline monotonically (shorter deadline
+ * means higher priority) depending on configPERIODIC_TASK_PRIORITY_POLICY.
+ *
+ * Each time a periodic task is created, response time analysis is run over the
+ * new task set.  The task is only created if every periodic task, including the
+ * new one, still meets its deadline; otherwise xPeriodicTaskCreate() fails and
+ * the existing tasks are left untouched.  Creating a task can change the
+ * priorities of periodic tasks that already exist.
+ *
+ * The analysis only accounts for interference between periodic tasks.  Time
+ * taken by interrupts, by tasks created with xTaskCreate() at priorities inside
+ * the band, and blocking on shared resources must be folded into the WCET
+ * budgets by the application.
+ *
+ * \defgroup PeriodicTasks PeriodicTasks
+ */
+
+/* Values for configPERIODIC_TASK_PRIORITY_POLICY. */
+#define periodicRATE_MONOTONIC				( 0 )
+#define periodicDEADLINE_MONOTONIC			( 1 )
+
+/* Errors returned by xPeriodicTaskCreate(). */
+#define errPERIODIC_TASK_NOT_SCHEDULABLE	( -6 )
+#define errPERIODIC_TASK_SET_FULL			( -7 )
+
+/*
+ * Prototype of the job function of a periodic task.  The function is called
+ * once per period and must return when the job for that period is complete.
+ */
+typedef void (*PeriodicJobFunction_t)( void * );
+
+/**
+ * periodic.h
+ *
+ * Describes a periodic task.  All times are in ticks.  xDeadline is relative to
+ * the start of each period and must not be greater than xPeriod; a value of 0
+ * means the deadline is equal to the period.  An entry with an xPeriod of 0 is
+ * treated as unused by xPeriodicTaskSetAnalyse().
+ *
+ * When configSUPPORT_STATIC_ALLOCATION is 1, puxStackBuffer (usStackDepth
+ * words) and pxTaskBuffer can point to memory for the task so that it is
+ * created with xTaskCreateStatic().  Leave them NULL to allocate the task from
+ * the heap.
+ *
+ * \ingroup PeriodicTasks
+ */
+typedef struct xPERIODIC_TASK_PARAMETERS
+{
+	PeriodicJobFunction_t pxJobCode;
+	const char *pcName;	/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+	configSTACK_DEPTH_TYPE usStackDepth;
+	void *pvParameters;
+	TickType_t xPeriod;
+	TickType_t xWCET;
+	TickType_t xDeadline;
+	#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+		StackType_t *puxStackBuffer;
+		StaticTask_t *pxTaskBuffer;
+	#endif
+} PeriodicTaskParameters_t;
+
+/**
+ * periodic.h
+ * <pre>BaseType_t xPeriodicTaskCreate( const PeriodicTaskParameters_t * const pxParameters, TaskHandle_t * const pxCreatedTask );</pre>
+ *
+ * configUSE_PERIODIC_TASKS must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * Admit a periodic task.  The task calls pxParameters->pxJobCode once at the
+ * start of every period, measured from the time the task first runs.
+ *
+ * @param pxParameters Description of the task.  The structure is copied, so
+ * it does not need to persist after the call.
+ *
+ * @param pxCreatedTask Used to pass back a handle by which the created task
+ * can be referenced.  Can be NULL.
+ *
+ * @return pdPASS if the task was admitted and created,
+ * errPERIODIC_TASK_NOT_SCHEDULABLE if adding the task would cause a periodic
+ * task to miss its deadline, errPERIODIC_TASK_SET_FULL if
+ * configMAX_PERIODIC_TASKS periodic tasks already exist, or
+ * errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY if the task could not be created.
+ *
+ * \ingroup PeriodicTasks
+ */
+BaseType_t xPeriodicTaskCreate( const PeriodicTaskParameters_t * const pxParameters, TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
+
+/**
+ * periodic.h
+ * <pre>void vPeriodicTaskDelete( TaskHandle_t xTask );</pre>
+ *
+ * Delete a periodic task created by xPeriodicTaskCreate() and release its
+ * entry in the periodic task set.  Pass NULL to delete the calling task.  The
+ * priorities of the remaining periodic tasks are not changed, as removing a
+ * task can only reduce the interference the others suffer.
+ *
+ * Deleting a periodic task with vTaskDelete() releases its entry too; this
+ * function only adds a check that xTask is a periodic task.
+ *
+ * \ingroup PeriodicTasks
+ */
+void vPeriodicTaskDelete( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+/**
+ * periodic.h
+ * <pre>UBaseType_t uxPeriodicTaskGetDeadlineMisses( TaskHandle_t xTask );</pre>
+ *
+ * Returns the number of jobs of the periodic task xTask that completed after
+ * their deadline.  A non-zero value means the WCET budgets used for admission
+ * were too optimistic.
+ *
+ * \ingroup PeriodicTasks
+ */
+UBaseType_t uxPeriodicTaskGetDeadlineMisses( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+/**
+ * periodic.h
+ * <pre>BaseType_t xPeriodicTaskSetAnalyse( const PeriodicTaskParameters_t * const pxTaskSet, const UBaseType_t uxNumberOfEntries, UBaseType_t * const puxPriorities, TickType_t * const pxResponseTimes );</pre>
+ *
+ * The admission test used by xPeriodicTaskCreate(), exposed so a task set can
+ * be sized off line.  The function does not call into the scheduler, so it can
+ * be run on the host against the same FreeRTOSConfig.h as the target.
+ *
+ * Priorities are assigned to the used entries of pxTaskSet according to
+ * configPERIODIC_TASK_PRIORITY_POLICY, then the worst case response time of
+ * each task is computed by the standard fixed priority response time
+ * recurrence, treating tasks of equal priority as interfering with each other.
+ *
+ * @param pxTaskSet Array of task descriptions.
+ *
+ * @param uxNumberOfEntries Number of entries in pxTaskSet.
+ *
+ * @param puxPriorities Array of uxNumberOfEntries entries into which the
+ * assigned priority of each used entry is written.
+ *
+ * @param pxResponseTimes Optional array of uxNumberOfEntries entries into which
+ * the worst case response time of each used entry is written, or portMAX_DELAY
+ * for tasks that cannot meet their deadline.  Can be NULL.
+ *
+ * @return pdPASS if every task meets its deadline, otherwise pdFAIL.
+ *
+ * \ingroup PeriodicTasks
+ */
+BaseType_t xPeriodicTaskSetAnalyse( const PeriodicTaskParameters_t * const pxTaskSet, const UBaseType_t uxNumberOfEntries, UBaseType_t * const puxPriorities, TickType_t * const pxResponseTimes ) PRIVILEGED_FUNCTION;
+
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY INTENDED
+ * FOR USE WHEN IMPLEMENTING A PORT OF THE SCHEDULER AND IS AN API FUNCTION THAT
+ * IS ONLY EXPOSED FOR THE KERNEL.
+ *
+ * Called by vTaskDelete(), from a critical section, to release the periodic
+ * task set entry of xTask if it has one.
+ */
+void vPeriodicTaskRemoveEntry( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PERIODIC_H */
+
@@ -0,0 +1,276 @@
+/*
+ * prog_rtos kernel add-on: poll sets, one task waiting on many queues and
+ * stream or message buffers.
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+/*
+ * Poll sets.
+ *
+ * A poll set lets one task wait for any of up to 32 objects at once, as
+ * select() or poll() do.  Each member owns one bit of the set, which is set
+ * when data arrives in the member, and the task blocked in ulPollSetWait() is
+ * woken with all the bits set since it last looked.  Members can be queues,
+ * semaphores (not mutexes), stream buffers and message buffers, added with
+ * xPollSetAddQueue() and xPollSetAddStreamBuffer(), and bits the application
+ * sets itself with vPollSetSignal(), e.g. from an interrupt, after claiming
+ * them with xPollSetAddBit().
+ *
+ * Unlike a queue set (configUSE_QUEUE_SETS), nothing is queued per item sent
+ * to a member: the readiness of all the members is one word, a send to a
+ * member whose bit is already set costs one test, and the task is woken once
+ * per edge - when a bit goes from clear to set - however many items arrive.
+ * The set therefore does not say how many items a member holds: the task must
+ * receive from each ready member, with a block time of 0, until it is empty.
+ * Once collected, a bit is only set again by data that arrives afterwards.
+ *
+ * A bit can be set for a member that turns out to be empty, for example if
+ * the member was read without waiting on the set first, or reset, so the
+ * receives must not assume success.
+ *
+ * Only one task at a time may wait on a poll set.  The wait uses notification
+ * configPOLL_SET_NOTIFICATION_INDEX of the task, not the default one that
+ * stream buffers and xTaskNotifyGive() use.  Alternatively the set can be bound to
+ * a co-routine, which waits with crPOLL_SET_WAIT().
+ */
+
+#ifndef POLL_SET_H
+#define POLL_SET_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include poll_set.h"
+#endif
+
+#include "queue.h"
+#include "stream_buffer.h"
+
+#if ( configUSE_CO_ROUTINES == 1 )
+	#include "croutine.h"
+#endif
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/**
+ * Type by which poll sets are referenced.
+ */
+typedef void * PollSetHandle_t;
+
+/*
+ * Memory for a poll set created with xPollSetCreateStatic().  The structure
+ * has the size of the real one, its members must not be used.
+ */
+typedef struct xSTATIC_POLL_SET
+{
+	uint32_t ulDummy1[ 2 ];
+	void *pvDummy2;
+	uint8_t ucDummy3;
+	#if ( configUSE_CO_ROUTINES == 1 )
+		void *pvDummy4;
+	#endif
+} StaticPollSet_t;
+
+/* The number of members a poll set can have. */
+#define pollsetMAX_MEMBERS		( 32U )
+
+/**
+ * poll_set.h
+ * <pre>PollSetHandle_t xPollSetCreate( void );</pre>
+ *
+ * Creates an empty poll set, allocated from the heap.
+ *
+ * @return The handle of the poll set, or NULL if there was not enough heap.
+ *
+ * \ingroup PollSet
+ */
+PollSetHandle_t xPollSetCreate( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * poll_set.h
+ * <pre>PollSetHandle_t xPollSetCreateStatic( StaticPollSet_t * const pxStaticPollSet );</pre>
+ *
+ * As xPollSetCreate(), with the memory provided by the application.
+ *
+ * \ingroup PollSet
+ */
+PollSetHandle_t xPollSetCreateStatic( StaticPollSet_t * const pxStaticPollSet ) PRIVILEGED_FUNCTION;
+
+/**
+ * poll_set.h
+ * <pre>void vPollSetDelete( PollSetHandle_t xPollSet );</pre>
+ *
+ * Deletes a poll set.  All the members must have been removed first and no
+ * task may be waiting on it.
+ *
+ * \ingroup PollSet
+ */
+void vPollSetDelete( PollSetHandle_t xPollSet ) PRIVILEGED_FUNCTION;
+
+/**
+ * poll_set.h
+ * <pre>BaseType_t xPollSetAddQueue( PollSetHandle_t xPollSet, QueueHandle_t xQueue, UBaseType_t uxBit );
+BaseType_t xPollSetRemoveQueue( PollSetHandle_t xPollSet, QueueHandle_t xQueue );</pre>
+ *
+ * Makes a queue or a semaphore a member of the poll set, with bit uxBit
+ * (0 to pollsetMAX_MEMBERS - 1), or removes it.  Mutexes cannot be members.
+ * A queue can be a member of one poll set; a queue that already holds items
+ * when it is added sets its bit straight away.  Deleting a queue removes it
+ * from its poll set.
+ *
+ * @return pdPASS, or pdFAIL if the bit is taken or the queue is already a
+ * member of a poll set (add), or is not a member of this one (remove).
+ *
+ * \ingroup PollSet
+ */
+BaseType_t xPollSetAddQueue( PollSetHandle_t xPollSet, QueueHandle_t xQueue, UBaseType_t uxBit ) PRIVILEGED_FUNCTION;
+BaseType_t xPollSetRemoveQueue( PollSetHandle_t xPollSet, QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * poll_set.h
+ * <pre>BaseType_t xPollSetAddStreamBuffer( PollSetHandle_t xPollSet, StreamBufferHandle_t xStreamBuffer, UBaseType_t uxBit );
+BaseType_t xPollSetRemoveStreamBuffer( PollSetHandle_t xPollSet, StreamBufferHandle_t xStreamBuffer );</pre>
+ *
+ * As xPollSetAddQueue() and xPollSetRemoveQueue(), for a stream buffer or a
+ * message buffer.  The bit is set when the buffer holds at least its trigger
+ * level, when a task blocked on it would be woken.
+ *
+ * \ingroup PollSet
+ */
+BaseType_t xPollSetAddStreamBuffer( PollSetHandle_t xPollSet, StreamBufferHandle_t xStreamBuffer, UBaseType_t uxBit ) PRIVILEGED_FUNCTION;
+BaseType_t xPollSetRemoveStreamBuffer( PollSetHandle_t xPollSet, StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * poll_set.h
+ * <pre>BaseType_t xPollSetAddBit( PollSetHandle_t xPollSet, UBaseType_t uxBit );
+void vPollSetRemoveBit( PollSetHandle_t xPollSet, UBaseType_t uxBit );</pre>
+ *
+ * Claims bit uxBit of the poll set for the application to set with
+ * vPollSetSignal(), or gives it back.  Removing a bit also clears it if it is
+ * set.  The functions that add objects use them too.
+ *
+ * @return pdPASS, or pdFAIL if the bit is already taken.
+ *
+ * \ingroup PollSet
+ */
+BaseType_t xPollSetAddBit( PollSetHandle_t xPollSet, UBaseType_t uxBit ) PRIVILEGED_FUNCTION;
+void vPollSetRemoveBit( PollSetHandle_t xPollSet, UBaseType_t uxBit ) PRIVILEGED_FUNCTION;
+
+/**
+ * poll_set.h
+ * <pre>void vPollSetSignal( PollSetHandle_t xPollSet, uint32_t ulBits );
+void vPollSetSignalFromISR( PollSetHandle_t xPollSet, uint32_t ulBits, BaseType_t * const pxHigherPriorityTaskWoken );</pre>
+ *
+ * Sets bits of the poll set, all claimed beforehand, and wakes the waiting
+ * task if any.  Bits that are already set cost nothing more.  Use the FromISR
+ * version from an interrupt.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if the waiting task was
+ * woken and has a priority above the interrupted task, in which case a context
+ * switch should be requested before the interrupt exits.
+ *
+ * \ingroup PollSet
+ */
+void vPollSetSignal( PollSetHandle_t xPollSet, uint32_t ulBits ) PRIVILEGED_FUNCTION;
+void vPollSetSignalFromISR( PollSetHandle_t xPollSet, uint32_t ulBits, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * poll_set.h
+ * <pre>uint32_t ulPollSetWait( PollSetHandle_t xPollSet, TickType_t xTicksToWait );</pre>
+ *
+ * Waits up to xTicksToWait for a bit of the poll set to be set, then returns
+ * and clears all the bits that are set.  Must not be called from an
+ * interrupt, except with xTicksToWait 0.
+ *
+ * Example use:
+ * <pre>
+	for( ;; )
+	{
+		ulReady = ulPollSetWait( xPollSet, portMAX_DELAY );
+
+		if( ( ulReady & ( 1UL << RX_BIT ) ) != 0 )
+		{
+			while( xQueueReceive( xRxQueue, &xItem, 0 ) == pdPASS )
+			{
+				vHandle( &xItem );
+			}
+		}
+
+		if( ( ulReady & ( 1UL << LOG_BIT ) ) != 0 )
+		{
+			while( ( xLength = xMessageBufferReceive( xLog, ucMessage, sizeof( ucMessage ), 0 ) ) != 0 )
+			{
+				vLog( ucMessage, xLength );
+			}
+		}
+	}
+   </pre>
+ *
+ * @return The bits that were set, or 0 if the time expired first.
+ *
+ * \ingroup PollSet
+ */
+uint32_t ulPollSetWait( PollSetHandle_t xPollSet, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * poll_set.h
+ * <pre>uint32_t ulPollSetGetReady( PollSetHandle_t xPollSet );</pre>
+ *
+ * @return The bits of the poll set that are set, without clearing them.
+ *
+ * \ingroup PollSet
+ */
+uint32_t ulPollSetGetReady( PollSetHandle_t xPollSet ) PRIVILEGED_FUNCTION;
+
+#if ( configUSE_CO_ROUTINES == 1 )
+
+	/**
+	 * poll_set.h
+	 * <pre>void vPollSetBindCoRoutine( PollSetHandle_t xPollSet, CoRoutineHandle_t xCoRoutine );</pre>
+	 *
+	 * Has the poll set notify a co-routine (xCoRoutineNotify()) when a bit
+	 * is set, so the co-routine can wait on the set with crPOLL_SET_WAIT()
+	 * instead of a task with ulPollSetWait().  NULL unbinds the set.  This is
+	 * how co-routines wait for the queues, stream buffers and message buffers
+	 * that tasks and interrupts write to.
+	 *
+	 * \ingroup PollSet
+	 */
+	void vPollSetBindCoRoutine( PollSetHandle_t xPollSet, CoRoutineHandle_t xCoRoutine ) PRIVILEGED_FUNCTION;
+
+	/**
+	 * poll_set.h
+	 * <pre>crPOLL_SET_WAIT( CoRoutineHandle_t xHandle, PollSetHandle_t xPollSet, TickType_t xTicksToWait, uint32_t *pulReady );</pre>
+	 *
+	 * The co-routine equivalent of ulPollSetWait(), for a poll set bound to
+	 * the calling co-routine.  Sets *pulReady to the bits that were set, and
+	 * clears them, or to 0 if the time expired or the co-routine received
+	 * another notification first.  Like the other co-routine macros, can only
+	 * be called from the co-routine function itself.
+	 *
+	 * \ingroup PollSet
+	 */
+	#define crPOLL_SET_WAIT( xHandle, xPollSet, xTicksToWait, pulReady )			\
+	{																				\
+		( void ) xCoRoutineNotifyStateClear( ( xHandle ) );							\
+		*( pulReady ) = ulPollSetWait( ( xPollSet ), 0 );							\
+		if( *( pulReady ) == 0UL )													\
+		{																			\
+			if( xCoRoutineNotifyWait( NULL, ( xTicksToWait ) ) == errQUEUE_BLOCKED )	\
+			{																		\
+				crSET_STATE0( ( xHandle ) );										\
+				( void ) xCoRoutineNotifyWait( NULL, 0 );							\
+			}																		\
+			*( pulReady ) = ulPollSetWait( ( xPollSet ), 0 );						\
+		}																			\
+	}
+
+#endif /* configUSE_CO_ROUTINES */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* POLL_SET_H */
@@ -117,8 +117,12 @@ typedef struct HeapRegion
  *
  * pxHeapRegions passes in an array of HeapRegion_t structures - each of which
  * defines a region of memory that can be used as the heap.  The array is
- * terminated by a HeapRegions_t structure that has a size of 0.  The region
- * with the lowest start address must appear first in the array.
+ * terminated by a HeapRegions_t structure that has a size of 0.  Each entry
+ * is managed as a separate region with its own free list and statistics, and
+ * pvPortMalloc() tries the regions in the order they appear in the array.  If
+ * it is not called, heap_5.c uses the port's default regions, of which
+ * pvPortMalloc() only uses portHEAP_REGION_SRAM: the CCM RAM cannot be reached
+ * by DMA, so portHEAP_REGION_CCM is only allocated from by pvPortMallocIn().
  */
 void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions ) PRIVILEGED_FUNCTION;
 
@@ -132,6 +136,28 @@ void vPortInitialiseBlocks( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetMinimumEverFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Region aware allocation, heap_5.c only.  xRegion is the index of the region
+ * in the array passed to vPortDefineHeapRegions(), or one of the port's
+ * portHEAP_REGION_xxx values if the default regions are used.
+ * pvPortMallocIn() only allocates from that region, and returns NULL if the
+ * region does not exist or has no block large enough.  Memory allocated with
+ * pvPortMallocIn() is freed with vPortFree().
+ */
+void *pvPortMallocIn( BaseType_t xRegion, size_t xSize ) PRIVILEGED_FUNCTION;
+size_t xPortGetFreeHeapSizeIn( BaseType_t xRegion ) PRIVILEGED_FUNCTION;
+size_t xPortGetMinimumEverFreeHeapSizeIn( BaseType_t xRegion ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return the number of microseconds that have elapsed since the start of the
+ * current tick period, as measured by the tick timer.  If the timer has
+ * reloaded but the tick interrupt that goes with it has not executed yet then
+ * *pxTickPending is set to pdTRUE and the returned value is measured from the
+ * start of the new tick period, otherwise *pxTickPending is set to pdFALSE.
+ * Only required when configUSE_MICROSECOND_TIME is 1.
+ */
+uint32_t ulPortGetMicrosecondsSinceTick( BaseType_t * const pxTickPending ) PRIVILEGED_FUNCTION;
+
 /*
  * Setup the hardware ready for the scheduler to take control.  This generally
  * sets up a tick interrupt and sets timers for the correct tick frequency.
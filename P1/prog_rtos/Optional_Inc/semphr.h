@@ -1135,6 +1135,22 @@ typedef QueueHandle_t SemaphoreHandle_t;
  */
 #define uxSemaphoreGetCount( xSemaphore ) uxQueueMessagesWaiting( ( QueueHandle_t ) ( xSemaphore ) )
 
+/**
+ * semphr.h
+ * <pre>void vSemaphoreGetSpinStats( SemaphoreHandle_t xSemaphore, QueueSpinStats_t *pxSpinStats );</pre>
+ *
+ * configUSE_ADAPTIVE_SEMAPHORE_SPIN must be set to 1 in FreeRTOSConfig.h for
+ * this macro to be available.
+ *
+ * With adaptive spinning enabled, a task that finds a semaphore unavailable
+ * first polls it for a bounded number of iterations before blocking.  The
+ * bound adapts to how long previous successful spins on the same semaphore
+ * took.  vSemaphoreGetSpinStats() copies the current estimate, and the number
+ * of takes that did and did not succeed by spinning, into *pxSpinStats.
+ *
+ */
+#define vSemaphoreGetSpinStats( xSemaphore, pxSpinStats ) vQueueGetSpinStats( ( QueueHandle_t ) ( xSemaphore ), ( pxSpinStats ) )
+
 #endif /* SEMAPHORE_H */
 
 
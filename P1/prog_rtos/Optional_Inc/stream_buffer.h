@@ -63,6 +63,21 @@ extern "C" {
  */
 typedef void * StreamBufferHandle_t;
 
+/**
+ * The bytes of a stream buffer's storage area that can be read or written in
+ * place, see xStreamBufferGetReadRegions() and xStreamBufferGetWriteRegions().
+ * The bytes are contiguous unless they wrap around the end of the storage
+ * area, in which case they continue at pucSecond.  pucSecond is NULL and
+ * xSecondLength 0 if there is no second region.
+ */
+typedef struct xSTREAM_BUFFER_REGIONS
+{
+	uint8_t *pucFirst;
+	size_t xFirstLength;
+	uint8_t *pucSecond;
+	size_t xSecondLength;
+} StreamBufferRegions_t;
+
 
 /**
  * message_buffer.h
@@ -828,11 +843,148 @@ BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuf
  */
 BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuffer, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferGetReadRegions( StreamBufferHandle_t xStreamBuffer, StreamBufferRegions_t * const pxRegions );
+</pre>
+ *
+ * Describes the data in a stream buffer where it is, so the reader can parse it
+ * or hand it to a DMA engine without first copying it out, as
+ * xStreamBufferReceive() would.  The data stays in the buffer until it is
+ * removed with xStreamBufferConsume() or xStreamBufferConsumeFromISR(), which
+ * need not remove all of it.
+ *
+ * The function does not block and can be called from a task or an interrupt.
+ * Only the reader may call it, and the regions must not be used after the
+ * bytes in them are consumed.  Data written after the call is not included in
+ * the regions.  Not available for message buffers, see xMessageBufferPeek().
+ *
+ * Example use:
+<pre>
+StreamBufferRegions_t xRegions;
+
+	if( xStreamBufferGetReadRegions( xStreamBuffer, &xRegions ) >= sizeof( xHeader ) )
+	{
+		// Parse the data in xRegions.pucFirst, then in xRegions.pucSecond if
+		// the frame wraps around, and remove the frame once it is handled.
+		xStreamBufferConsume( xStreamBuffer, xFrameLength );
+	}
+</pre>
+ *
+ * @param xStreamBuffer The handle of the stream buffer being read.
+ *
+ * @param pxRegions Set to the one or two regions holding the data, oldest
+ * bytes first.
+ *
+ * @return The number of bytes in the regions, which is
+ * xStreamBufferBytesAvailable().
+ *
+ * \defgroup xStreamBufferGetReadRegions xStreamBufferGetReadRegions
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferGetReadRegions( StreamBufferHandle_t xStreamBuffer, StreamBufferRegions_t * const pxRegions ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferConsume( StreamBufferHandle_t xStreamBuffer, size_t xBytesToConsume );
+size_t xStreamBufferConsumeFromISR( StreamBufferHandle_t xStreamBuffer, size_t xBytesToConsume, BaseType_t * const pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * Removes data that was read in place from the front of a stream buffer, and
+ * unblocks a writer waiting for space as xStreamBufferReceive() does.  Use
+ * xStreamBufferConsumeFromISR() from an interrupt.
+ *
+ * For a message buffer the next message is removed whole, and
+ * xBytesToConsume must be its length as returned by xMessageBufferPeek().
+ *
+ * @param xStreamBuffer The handle of the stream buffer being read.
+ *
+ * @param xBytesToConsume The number of bytes to remove.  Capped to the bytes
+ * in the buffer.
+ *
+ * @param pxHigherPriorityTaskWoken As for xStreamBufferReceiveFromISR().
+ *
+ * @return The number of bytes removed.
+ *
+ * \defgroup xStreamBufferConsume xStreamBufferConsume
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferConsume( StreamBufferHandle_t xStreamBuffer, size_t xBytesToConsume ) PRIVILEGED_FUNCTION;
+size_t xStreamBufferConsumeFromISR( StreamBufferHandle_t xStreamBuffer,
+									size_t xBytesToConsume,
+									BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferGetWriteRegions( StreamBufferHandle_t xStreamBuffer, StreamBufferRegions_t * const pxRegions );
+</pre>
+ *
+ * Describes the free space of a stream buffer, so the writer can produce data
+ * directly in the buffer (for example by pointing a DMA transfer at
+ * pxRegions->pucFirst) instead of copying it in with xStreamBufferSend().  The
+ * data is added to the buffer, and the reader unblocked, by
+ * xStreamBufferCommit() or xStreamBufferCommitFromISR().
+ *
+ * The function does not block and can be called from a task or an interrupt.
+ * Only the writer may call it.  Space freed by the reader after the call is
+ * not included in the regions.  Not available for message buffers.
+ *
+ * @param xStreamBuffer The handle of the stream buffer being written.
+ *
+ * @param pxRegions Set to the one or two free regions, in the order they must
+ * be filled.
+ *
+ * @return The number of bytes in the regions, which is
+ * xStreamBufferSpacesAvailable().
+ *
+ * \defgroup xStreamBufferGetWriteRegions xStreamBufferGetWriteRegions
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferGetWriteRegions( StreamBufferHandle_t xStreamBuffer, StreamBufferRegions_t * const pxRegions ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferCommit( StreamBufferHandle_t xStreamBuffer, size_t xBytesToCommit );
+size_t xStreamBufferCommitFromISR( StreamBufferHandle_t xStreamBuffer, size_t xBytesToCommit, BaseType_t * const pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * Adds the bytes written in place in the regions returned by
+ * xStreamBufferGetWriteRegions() to the stream buffer, first region first,
+ * and unblocks a reader as xStreamBufferSend() does once the trigger level is
+ * reached.  Use xStreamBufferCommitFromISR() from an interrupt.
+ *
+ * @param xStreamBuffer The handle of the stream buffer being written.
+ *
+ * @param xBytesToCommit The number of bytes written, at most the bytes in the
+ * regions.
+ *
+ * @param pxHigherPriorityTaskWoken As for xStreamBufferSendFromISR().
+ *
+ * @return The number of bytes added.
+ *
+ * \defgroup xStreamBufferCommit xStreamBufferCommit
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferCommit( StreamBufferHandle_t xStreamBuffer, size_t xBytesToCommit ) PRIVILEGED_FUNCTION;
+size_t xStreamBufferCommitFromISR( StreamBufferHandle_t xStreamBuffer,
+								   size_t xBytesToCommit,
+								   BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
 /* Functions below here are not part of the public API. */
 StreamBufferHandle_t xStreamBufferGenericCreate( size_t xBufferSizeBytes,
 												 size_t xTriggerLevelBytes,
 												 BaseType_t xIsMessageBuffer ) PRIVILEGED_FUNCTION;
 
+size_t xStreamBufferPeekMessage( StreamBufferHandle_t xStreamBuffer, StreamBufferRegions_t * const pxRegions ) PRIVILEGED_FUNCTION;
+
 StreamBufferHandle_t xStreamBufferGenericCreateStatic( size_t xBufferSizeBytes,
 													   size_t xTriggerLevelBytes,
 													   BaseType_t xIsMessageBuffer,
@@ -48,6 +48,10 @@ extern "C" {
 #define tskKERNEL_VERSION_MINOR 0
 #define tskKERNEL_VERSION_BUILD 1
 
+/* The index within the array of task notifications used by the non-indexed
+task notification API functions (xTaskNotify(), ulTaskNotifyTake(), etc.). */
+#define tskDEFAULT_INDEX_TO_NOTIFY		( 0 )
+
 /**
  * task. h
  *
@@ -87,6 +91,15 @@ typedef enum
 	eSetValueWithoutOverwrite	/* Set the task's notification value if the previous value has been read by the task. */
 } eNotifyAction;
 
+/* Actions taken when a task exhausts its execution time budget.  See
+xTaskSetBudget(). */
+typedef enum
+{
+	eBudgetDemote = 0,			/* Drop the task to configTASK_BUDGET_DEMOTE_PRIORITY until its budget is replenished. */
+	eBudgetSuspend,				/* Hold the task in the Blocked state until its budget is replenished. */
+	eBudgetCallHook				/* Call vApplicationTaskBudgetHook() and let the task continue. */
+} eBudgetAction;
+
 /*
  * Used internally only.
  */
@@ -136,8 +149,48 @@ typedef struct xTASK_STATUS
 	uint32_t ulRunTimeCounter;		/* The total run time allocated to the task so far, as defined by the run time stats clock.  See http://www.freertos.org/rtos-run-time-stats.html.  Only valid when configGENERATE_RUN_TIME_STATS is defined as 1 in FreeRTOSConfig.h. */
 	StackType_t *pxStackBase;		/* Points to the lowest address of the task's stack area. */
 	uint16_t usStackHighWaterMark;	/* The minimum amount of stack space that has remained for the task since the task was created.  The closer this value is to zero the closer the task has come to overflowing its stack. */
+	uint32_t ulStackDepth;			/* The size of the task's stack in words.  Only valid when configRECORD_STACK_HIGH_ADDRESS is defined as 1 in FreeRTOSConfig.h (or the stack grows up), 0 otherwise. */
 } TaskStatus_t;
 
+/* One task in a TaskSnapshot_t.  The fields are those of TaskStatus_t, but
+the name is copied rather than pointed to, so the entry stays valid after the
+task has been deleted. */
+typedef struct xTASK_SNAPSHOT_ENTRY
+{
+	UBaseType_t xTaskNumber;		/* A number unique to the task. */
+	uint32_t ulRunTimeCounter;		/* As TaskStatus_t. */
+	uint32_t ulStackDepth;			/* As TaskStatus_t. */
+	uint16_t usStackHighWaterMark;	/* As TaskStatus_t, or 0 if the snapshot was taken without measuring the stacks. */
+	uint16_t usCurrentPriority;		/* As TaskStatus_t. */
+	uint16_t usBasePriority;		/* As TaskStatus_t. */
+	uint8_t ucCurrentState;			/* The eTaskState of the task. */
+	char pcTaskName[ configMAX_TASK_NAME_LEN ]; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+} TaskSnapshotEntry_t;
+
+/* The state of every task at one point in time, see xTaskTakeSnapshot(). */
+typedef struct xTASK_SNAPSHOT
+{
+	volatile uint32_t ulSequence;	/* The number of the snapshot, 0 while it is being written. */
+	TickType_t xTimeStamp;			/* The tick count when the snapshot was completed. */
+	uint32_t ulTotalRunTime;		/* The run time stats clock when the snapshot was completed, 0 if configGENERATE_RUN_TIME_STATS is 0. */
+	UBaseType_t uxNumberOfTasks;	/* The number of valid entries in xTasks[]. */
+	UBaseType_t uxTotalTasks;		/* The number of tasks that existed, which is more than uxNumberOfTasks if the tasks did not fit in xTasks[]. */
+	TaskSnapshotEntry_t xTasks[ configMAX_SNAPSHOT_TASKS ];
+} TaskSnapshot_t;
+
+/* Two snapshots, so the latest one can be read while the next one is taken. */
+typedef struct xTASK_SNAPSHOT_BUFFER
+{
+	TaskSnapshot_t xSnapshots[ 2 ];
+	volatile uint32_t ulSequence;	/* The number of the latest complete snapshot, held in xSnapshots[ ulSequence & 1 ].  0 before the first. */
+} TaskSnapshotBuffer_t;
+
+/* Size in bytes of a snapshot of uxTasks tasks exported by
+xTaskExportSnapshot(): a 20 byte header and one entry per task. */
+#define taskSNAPSHOT_HEADER_SIZE		( 20U )
+#define taskSNAPSHOT_ENTRY_SIZE			( 20U + ( size_t ) configMAX_TASK_NAME_LEN )
+#define taskSNAPSHOT_EXPORT_SIZE( uxTasks )	( taskSNAPSHOT_HEADER_SIZE + ( ( size_t ) ( uxTasks ) * taskSNAPSHOT_ENTRY_SIZE ) )
+
 /* Possible return values for eTaskConfirmSleepModeStatus(). */
 typedef enum
 {
@@ -326,6 +379,39 @@ is used in assert() statements. */
 							TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
 #endif
 
+/**
+ * task. h
+ *<pre>
+ BaseType_t xTaskCreateCCM(	TaskFunction_t pvTaskCode,
+							const char * const pcName,
+							configSTACK_DEPTH_TYPE usStackDepth,
+							void *pvParameters,
+							UBaseType_t uxPriority,
+							TaskHandle_t *pvCreatedTask
+						  );</pre>
+ *
+ * configUSE_CCM_TASK_ALLOCATION must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * As xTaskCreate(), but the stack and TCB of the task are allocated from the
+ * core coupled memory region of the heap (portHEAP_REGION_CCM, see heap_5.c).
+ * Use it for the tasks that switch most often.  The CCM RAM cannot be reached
+ * by DMA, so buffers on the stack of such a task must not be used for DMA
+ * transfers.  The memory is returned to the CCM region when the task is
+ * deleted.
+ *
+ * \defgroup xTaskCreateCCM xTaskCreateCCM
+ * \ingroup Tasks
+ */
+#if( configUSE_CCM_TASK_ALLOCATION == 1 )
+	BaseType_t xTaskCreateCCM(	TaskFunction_t pxTaskCode,
+								const char * const pcName,	/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+								const configSTACK_DEPTH_TYPE usStackDepth,
+								void * const pvParameters,
+								UBaseType_t uxPriority,
+								TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  *<pre>
@@ -696,6 +782,33 @@ void vTaskAllocateMPURegions( TaskHandle_t xTask, const MemoryRegion_t * const p
  */
 void vTaskDelete( TaskHandle_t xTaskToDelete ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * <PRE>UBaseType_t uxTaskFlushRecycledTasks( void );</PRE>
+ *
+ * configUSE_TASK_RECYCLING must be defined as 1 for this function to be
+ * available.
+ *
+ * With configUSE_TASK_RECYCLING set to 1 the TCB and stack of a task created
+ * by xTaskCreate() are not freed when the task is deleted, but kept in a pool
+ * of up to configTASK_RECYCLE_POOL_SIZE tasks.  xTaskCreate() takes a task
+ * with the same stack depth out of the pool, if there is one, instead of
+ * allocating, so creating and deleting short lived tasks of a few standard
+ * stack sizes no longer goes through the heap.  A task that deletes itself
+ * is moved to the pool by the next xTaskCreate() call, or by the idle task if
+ * that runs first.  Tasks created statically or with xTaskCreateCCM() are
+ * never pooled.  When the pool is full a deleted task is freed as usual.
+ *
+ * uxTaskFlushRecycledTasks() frees every task held in the pool, returning the
+ * memory to the heap, for example when the stack sizes in use change.
+ *
+ * @return The number of tasks freed.
+ *
+ * \defgroup uxTaskFlushRecycledTasks uxTaskFlushRecycledTasks
+ * \ingroup Tasks
+ */
+UBaseType_t uxTaskFlushRecycledTasks( void ) PRIVILEGED_FUNCTION;
+
 /*-----------------------------------------------------------
  * TASK CONTROL API
  *----------------------------------------------------------*/
@@ -807,6 +920,53 @@ void vTaskDelay( const TickType_t xTicksToDelay ) PRIVILEGED_FUNCTION;
  */
 void vTaskDelayUntil( TickType_t * const pxPreviousWakeTime, const TickType_t xTimeIncrement ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * <pre>void vTaskDelayUntilMicroseconds( uint64_t *pullPreviousWakeTime, const uint64_t ullTimeIncrement );</pre>
+ *
+ * configUSE_MICROSECOND_TIME must be defined as 1 for this function to be
+ * available.
+ *
+ * A version of vTaskDelayUntil() that works in microseconds on the time base
+ * returned by ullTaskGetTimeMicroseconds().  The wake time is accumulated in
+ * microseconds, so a period that is not a whole number of ticks does not drift
+ * and keeps its phase relative to the first wake time.
+ *
+ * A task can only be unblocked by a tick interrupt.  If the wake time is no
+ * more than configTASK_DELAY_UNTIL_SPIN_US microseconds after a tick the task
+ * blocks until that tick and then busy waits for the remainder, waking within
+ * a few microseconds of the requested time.  Otherwise it blocks until the
+ * first tick after the wake time.  The function never returns before the
+ * wake time.  Busy waiting uses the CPU, so keep configTASK_DELAY_UNTIL_SPIN_US
+ * small relative to the tick period.
+ *
+ * @param pullPreviousWakeTime Pointer to a variable that holds the time in
+ * microseconds at which the task was last unblocked.  Initialise it with
+ * ullTaskGetTimeMicroseconds() before the first use.  It is updated
+ * automatically.
+ *
+ * @param ullTimeIncrement The cycle time period in microseconds.
+ *
+ * Example usage:
+   <pre>
+ // Run every 1500us, alternately one and two ticks apart at 1kHz.
+ void vTaskFunction( void * pvParameters )
+ {
+ uint64_t ullLastWakeTime = ullTaskGetTimeMicroseconds();
+
+	 for( ;; )
+	 {
+		 vTaskDelayUntilMicroseconds( &ullLastWakeTime, 1500 );
+
+		 // Perform action here.
+	 }
+ }
+   </pre>
+ * \defgroup vTaskDelayUntilMicroseconds vTaskDelayUntilMicroseconds
+ * \ingroup TaskCtrl
+ */
+void vTaskDelayUntilMicroseconds( uint64_t * const pullPreviousWakeTime, const uint64_t ullTimeIncrement ) PRIVILEGED_FUNCTION;
+
 /**
  * task. h
  * <pre>BaseType_t xTaskAbortDelay( TaskHandle_t xTask );</pre>
@@ -1282,6 +1442,11 @@ void vTaskSuspendAll( void ) PRIVILEGED_FUNCTION;
  * xTaskResumeAll() only resumes the scheduler.  It does not unsuspend tasks
  * that were previously suspended by a call to vTaskSuspend().
  *
+ * Tasks readied by interrupts and ticks that occurred while the scheduler was
+ * suspended are processed by xTaskResumeAll().  If configRESUME_ALL_BATCH_SIZE
+ * is not 0 this is done in batches of that many items, interrupts being
+ * enabled between the batches, rather than all in one critical section.
+ *
  * @return If resuming the scheduler caused a context switch then pdTRUE is
  *		  returned, otherwise pdFALSE is returned.
  *
@@ -1357,6 +1522,49 @@ TickType_t xTaskGetTickCount( void ) PRIVILEGED_FUNCTION;
  */
 TickType_t xTaskGetTickCountFromISR( void ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * <PRE>uint64_t ullTaskGetTickCount64( void );</PRE>
+ *
+ * configUSE_MICROSECOND_TIME must be defined as 1 for this function to be
+ * available.
+ *
+ * @return The count of ticks since vTaskStartScheduler was called, extended
+ * to 64 bits with the number of times the tick count has overflowed so it
+ * never wraps in practice.
+ *
+ * The function does not use a critical section and can be called from tasks
+ * and from interrupts at or below configMAX_SYSCALL_INTERRUPT_PRIORITY.  Ticks
+ * that are pending because the scheduler is suspended are included.
+ *
+ * \defgroup ullTaskGetTickCount64 ullTaskGetTickCount64
+ * \ingroup TaskUtils
+ */
+uint64_t ullTaskGetTickCount64( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <PRE>uint64_t ullTaskGetTimeMicroseconds( void );</PRE>
+ *
+ * configUSE_MICROSECOND_TIME must be defined as 1 for this function to be
+ * available.
+ *
+ * @return The time since vTaskStartScheduler was called in microseconds.  The
+ * tick count gives the whole tick periods and the tick timer gives the time
+ * into the current one, so the resolution is one microsecond while the value
+ * stays monotonic and consistent with ullTaskGetTickCount64().  The tick rate
+ * must divide 1MHz exactly.
+ *
+ * The function does not use a critical section and can be called from tasks
+ * and from interrupts at or below configMAX_SYSCALL_INTERRUPT_PRIORITY,
+ * including with interrupts masked across a tick.  When configUSE_TICKLESS_IDLE
+ * is 1 the time is approximate during the first tick after an idle period.
+ *
+ * \defgroup ullTaskGetTimeMicroseconds ullTaskGetTimeMicroseconds
+ * \ingroup TaskUtils
+ */
+uint64_t ullTaskGetTimeMicroseconds( void ) PRIVILEGED_FUNCTION;
+
 /**
  * task. h
  * <PRE>uint16_t uxTaskGetNumberOfTasks( void );</PRE>
@@ -1629,6 +1837,154 @@ UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray, const
  */
 void vTaskList( char * pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
 
+/**
+ * task. h
+ * <PRE>void vTaskListStackUsage( char *pcWriteBuffer, const TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize );</PRE>
+ *
+ * configUSE_TRACE_FACILITY and configUSE_STATS_FORMATTING_FUNCTIONS must
+ * both be defined as 1 for this function to be available.
+ *
+ * Formats the stack usage of the tasks in an array filled by
+ * uxTaskGetSystemState() into a human readable table with one line per task:
+ * the task name, the stack size, the most stack the task has ever used and
+ * the least stack it has ever had free, all in words, and the percentage of
+ * the stack used.  The stack size and the percentage are only known when
+ * configRECORD_STACK_HIGH_ADDRESS is 1, and are printed as 0 otherwise.
+ *
+ * Unlike vTaskList() the function does not allocate memory, so it can be used
+ * when configSUPPORT_DYNAMIC_ALLOCATION is 0, and it does not disable
+ * interrupts.  The high water marks are measured by the stack painting done
+ * when the tasks were created, so they are the deepest use seen so far, not
+ * a guaranteed worst case.
+ *
+ * Example usage:
+   <pre>
+   static TaskStatus_t xStatus[ 16 ];
+   static char cBuffer[ 16 * 50 ];
+   UBaseType_t uxTasks;
+
+	   uxTasks = uxTaskGetSystemState( xStatus, 16, NULL );
+	   vTaskListStackUsage( cBuffer, xStatus, uxTasks );
+	   printf( "%s", cBuffer );
+   </pre>
+ *
+ * @param pcWriteBuffer A buffer into which the table is written, in ASCII
+ * form.  Approximately 50 bytes per task should be sufficient.
+ *
+ * @param pxTaskStatusArray The array filled by uxTaskGetSystemState().
+ *
+ * @param uxArraySize The number of entries uxTaskGetSystemState() returned.
+ *
+ * \defgroup vTaskListStackUsage vTaskListStackUsage
+ * \ingroup TaskUtils
+ */
+void vTaskListStackUsage( char *pcWriteBuffer, const TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+
+/**
+ * task. h
+ * <PRE>BaseType_t xTaskTakeSnapshot( TaskSnapshotBuffer_t *pxBuffer, BaseType_t xGetFreeStackSpace );</PRE>
+ *
+ * configUSE_TASK_SNAPSHOTS must be defined as 1 for this function to be
+ * available.  It needs configUSE_TRACE_FACILITY as well.
+ *
+ * Records the state of every task into the snapshot of pxBuffer that is not
+ * the latest one, then makes it the latest one.  Nothing is allocated and
+ * nothing is formatted, so unlike vTaskList() the function is cheap enough
+ * to be called periodically, e.g. for health telemetry.
+ *
+ * uxTaskGetSystemState() suspends the scheduler for the whole walk of the
+ * task lists.  xTaskTakeSnapshot() suspends it for one task at a time, so
+ * other tasks can run between two entries and the snapshot is not an
+ * instant: a task deleted during the walk is missing from it, a task created
+ * during the walk may be.  Interrupts are never disabled for longer than
+ * xTaskResumeAll() does.
+ *
+ * The latest snapshot can be read at any time, also by another task or a
+ * debugger, without holding up the writer:
+   <pre>
+   uint32_t ulSequence = xBuffer.ulSequence;
+   const TaskSnapshot_t *pxSnapshot = &( xBuffer.xSnapshots[ ulSequence & 1U ] );
+
+	   // ... use *pxSnapshot ...
+
+	   if( pxSnapshot->ulSequence != ulSequence )
+	   {
+		   // Overwritten while in use, by two later calls to
+		   // xTaskTakeSnapshot().  Try again.
+	   }
+   </pre>
+ *
+ * Only one xTaskTakeSnapshot() can be in progress in the system: a call made
+ * while another task is part way through one returns pdFAIL at once, and
+ * leaves its buffer as it was.
+ *
+ * @param pxBuffer The double buffer, which must be zeroed before the first
+ * call (static storage is).
+ *
+ * @param xGetFreeStackSpace Measuring the stack high water marks scans the
+ * unused part of each stack, which is by far the most expensive part of the
+ * walk.  Pass pdFALSE to skip it, the usStackHighWaterMark fields are then 0.
+ *
+ * @return pdPASS if every task fitted in the snapshot, or pdFAIL if more than
+ * configMAX_SNAPSHOT_TASKS tasks existed and some were left out, or if another
+ * snapshot was in progress and none was taken (pxBuffer->ulSequence is then
+ * unchanged).
+ *
+ * \defgroup xTaskTakeSnapshot xTaskTakeSnapshot
+ * \ingroup TaskUtils
+ */
+BaseType_t xTaskTakeSnapshot( TaskSnapshotBuffer_t *pxBuffer, BaseType_t xGetFreeStackSpace ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <PRE>size_t xTaskExportSnapshot( const TaskSnapshot_t *pxSnapshot, uint8_t *pucBuffer, size_t xBufferLength );</PRE>
+ *
+ * configUSE_TASK_SNAPSHOTS must be defined as 1 for this function to be
+ * available.
+ *
+ * Writes pxSnapshot as a compact binary record that does not depend on the
+ * compiler's structure layout, for a host tool to render (see
+ * snapshot_report.sh).  All the values are little endian.  The header is:
+ *
+ * 2 bytes 'T' 'S', 1 byte format version (1), 1 byte configMAX_TASK_NAME_LEN,
+ * 2 bytes number of entries, 2 bytes total number of tasks, 4 bytes sequence
+ * number, 4 bytes tick count, 4 bytes total run time.
+ *
+ * then each entry is:
+ *
+ * 4 bytes task number, 4 bytes run time counter, 4 bytes stack depth in words,
+ * 2 bytes stack high water mark in words, 2 bytes current priority, 2 bytes
+ * base priority, 1 byte eTaskState, 1 byte 0, configMAX_TASK_NAME_LEN bytes
+ * name padded with 0s.
+ *
+ * taskSNAPSHOT_EXPORT_SIZE( uxTasks ) gives the size of the record.
+ *
+ * @param pxSnapshot The snapshot to export, normally the latest one of a
+ * TaskSnapshotBuffer_t.
+ *
+ * @param pucBuffer The buffer the record is written to.
+ *
+ * @param xBufferLength The size of pucBuffer in bytes.
+ *
+ * @return The size of the record in bytes, or 0 if it did not fit in
+ * pucBuffer.
+ *
+ * Example usage:
+   <pre>
+   static TaskSnapshotBuffer_t xSnapshots;
+   static uint8_t ucRecord[ taskSNAPSHOT_EXPORT_SIZE( configMAX_SNAPSHOT_TASKS ) ];
+   size_t xLength;
+
+	   xTaskTakeSnapshot( &xSnapshots, pdFALSE );
+	   xLength = xTaskExportSnapshot( &( xSnapshots.xSnapshots[ xSnapshots.ulSequence & 1U ] ), ucRecord, sizeof( ucRecord ) );
+	   // Send xLength bytes of ucRecord to the host.
+   </pre>
+ *
+ * \defgroup xTaskExportSnapshot xTaskExportSnapshot
+ * \ingroup TaskUtils
+ */
+size_t xTaskExportSnapshot( const TaskSnapshot_t *pxSnapshot, uint8_t *pucBuffer, size_t xBufferLength ) PRIVILEGED_FUNCTION;
+
 /**
  * task. h
  * <PRE>void vTaskGetRunTimeStats( char *pcWriteBuffer );</PRE>
@@ -1691,7 +2047,13 @@ void vTaskGetRunTimeStats( char *pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e9
  * function to be available.
  *
  * When configUSE_TASK_NOTIFICATIONS is set to one each task has its own private
- * "notification value", which is a 32-bit unsigned integer (uint32_t).
+ * array of configTASK_NOTIFICATION_ARRAY_ENTRIES "notification values", each of
+ * which is a 32-bit unsigned integer (uint32_t) with its own notification
+ * state.  xTaskNotify() operates on the notification at index
+ * tskDEFAULT_INDEX_TO_NOTIFY, xTaskNotifyIndexed() operates on the
+ * notification at index uxIndexToNotify.  The indexed variants of all the
+ * notification functions behave exactly as their non-indexed counterparts,
+ * other than the array index that they act on.
  *
  * Events can be sent to a task using an intermediary object.  Examples of such
  * objects are queues, semaphores, mutexes and event groups.  Task notifications
@@ -1721,6 +2083,10 @@ void vTaskGetRunTimeStats( char *pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e9
  * task, and the handle of the currently running task can be obtained by calling
  * xTaskGetCurrentTaskHandle().
  *
+ * @param uxIndexToNotify (xTaskNotifyIndexed() only) The index within the
+ * target task's array of notification values to which the notification is to be
+ * sent.  Must be less than configTASK_NOTIFICATION_ARRAY_ENTRIES.
+ *
  * @param ulValue Data that can be sent with the notification.  How the data is
  * used depends on the value of the eAction parameter.
  *
@@ -1762,9 +2128,11 @@ void vTaskGetRunTimeStats( char *pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e9
  * \defgroup xTaskNotify xTaskNotify
  * \ingroup TaskNotifications
  */
-BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue ) PRIVILEGED_FUNCTION;
-#define xTaskNotify( xTaskToNotify, ulValue, eAction ) xTaskGenericNotify( ( xTaskToNotify ), ( ulValue ), ( eAction ), NULL )
-#define xTaskNotifyAndQuery( xTaskToNotify, ulValue, eAction, pulPreviousNotifyValue ) xTaskGenericNotify( ( xTaskToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotifyValue ) )
+BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue ) PRIVILEGED_FUNCTION;
+#define xTaskNotify( xTaskToNotify, ulValue, eAction ) xTaskGenericNotify( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulValue ), ( eAction ), NULL )
+#define xTaskNotifyIndexed( xTaskToNotify, uxIndexToNotify, ulValue, eAction ) xTaskGenericNotify( ( xTaskToNotify ), ( uxIndexToNotify ), ( ulValue ), ( eAction ), NULL )
+#define xTaskNotifyAndQuery( xTaskToNotify, ulValue, eAction, pulPreviousNotifyValue ) xTaskGenericNotify( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulValue ), ( eAction ), ( pulPreviousNotifyValue ) )
+#define xTaskNotifyAndQueryIndexed( xTaskToNotify, uxIndexToNotify, ulValue, eAction, pulPreviousNotifyValue ) xTaskGenericNotify( ( xTaskToNotify ), ( uxIndexToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotifyValue ) )
 
 /**
  * task. h
@@ -1853,9 +2221,11 @@ BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNo
  * \defgroup xTaskNotify xTaskNotify
  * \ingroup TaskNotifications
  */
-BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
-#define xTaskNotifyFromISR( xTaskToNotify, ulValue, eAction, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( ulValue ), ( eAction ), NULL, ( pxHigherPriorityTaskWoken ) )
-#define xTaskNotifyAndQueryFromISR( xTaskToNotify, ulValue, eAction, pulPreviousNotificationValue, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotificationValue ), ( pxHigherPriorityTaskWoken ) )
+BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#define xTaskNotifyFromISR( xTaskToNotify, ulValue, eAction, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulValue ), ( eAction ), NULL, ( pxHigherPriorityTaskWoken ) )
+#define xTaskNotifyIndexedFromISR( xTaskToNotify, uxIndexToNotify, ulValue, eAction, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( uxIndexToNotify ), ( ulValue ), ( eAction ), NULL, ( pxHigherPriorityTaskWoken ) )
+#define xTaskNotifyAndQueryFromISR( xTaskToNotify, ulValue, eAction, pulPreviousNotificationValue, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulValue ), ( eAction ), ( pulPreviousNotificationValue ), ( pxHigherPriorityTaskWoken ) )
+#define xTaskNotifyAndQueryIndexedFromISR( xTaskToNotify, uxIndexToNotify, ulValue, eAction, pulPreviousNotificationValue, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( uxIndexToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotificationValue ), ( pxHigherPriorityTaskWoken ) )
 
 /**
  * task. h
@@ -1930,7 +2300,9 @@ BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulVal
  * \defgroup xTaskNotifyWait xTaskNotifyWait
  * \ingroup TaskNotifications
  */
-BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+BaseType_t xTaskGenericNotifyWait( UBaseType_t uxIndexToWait, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#define xTaskNotifyWait( ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, xTicksToWait ) xTaskGenericNotifyWait( tskDEFAULT_INDEX_TO_NOTIFY, ( ulBitsToClearOnEntry ), ( ulBitsToClearOnExit ), ( pulNotificationValue ), ( xTicksToWait ) )
+#define xTaskNotifyWaitIndexed( uxIndexToWait, ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, xTicksToWait ) xTaskGenericNotifyWait( ( uxIndexToWait ), ( ulBitsToClearOnEntry ), ( ulBitsToClearOnExit ), ( pulNotificationValue ), ( xTicksToWait ) )
 
 /**
  * task. h
@@ -1976,7 +2348,8 @@ BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClea
  * \defgroup xTaskNotifyGive xTaskNotifyGive
  * \ingroup TaskNotifications
  */
-#define xTaskNotifyGive( xTaskToNotify ) xTaskGenericNotify( ( xTaskToNotify ), ( 0 ), eIncrement, NULL )
+#define xTaskNotifyGive( xTaskToNotify ) xTaskGenericNotify( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( 0 ), eIncrement, NULL )
+#define xTaskNotifyGiveIndexed( xTaskToNotify, uxIndexToNotify ) xTaskGenericNotify( ( xTaskToNotify ), ( uxIndexToNotify ), ( 0 ), eIncrement, NULL )
 
 /**
  * task. h
@@ -2031,7 +2404,9 @@ BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClea
  * \defgroup xTaskNotifyWait xTaskNotifyWait
  * \ingroup TaskNotifications
  */
-void vTaskNotifyGiveFromISR( TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+void vTaskGenericNotifyGiveFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#define vTaskNotifyGiveFromISR( xTaskToNotify, pxHigherPriorityTaskWoken ) vTaskGenericNotifyGiveFromISR( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( pxHigherPriorityTaskWoken ) )
+#define vTaskNotifyGiveIndexedFromISR( xTaskToNotify, uxIndexToNotify, pxHigherPriorityTaskWoken ) vTaskGenericNotifyGiveFromISR( ( xTaskToNotify ), ( uxIndexToNotify ), ( pxHigherPriorityTaskWoken ) )
 
 /**
  * task. h
@@ -2100,7 +2475,9 @@ void vTaskNotifyGiveFromISR( TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPri
  * \defgroup ulTaskNotifyTake ulTaskNotifyTake
  * \ingroup TaskNotifications
  */
-uint32_t ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+uint32_t ulTaskGenericNotifyTake( UBaseType_t uxIndexToWait, BaseType_t xClearCountOnExit, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#define ulTaskNotifyTake( xClearCountOnExit, xTicksToWait ) ulTaskGenericNotifyTake( ( tskDEFAULT_INDEX_TO_NOTIFY ), ( xClearCountOnExit ), ( xTicksToWait ) )
+#define ulTaskNotifyTakeIndexed( uxIndexToWait, xClearCountOnExit, xTicksToWait ) ulTaskGenericNotifyTake( ( uxIndexToWait ), ( xClearCountOnExit ), ( xTicksToWait ) )
 
 /**
  * task. h
@@ -2116,7 +2493,118 @@ uint32_t ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait
  * \defgroup xTaskNotifyStateClear xTaskNotifyStateClear
  * \ingroup TaskNotifications
  */
-BaseType_t xTaskNotifyStateClear( TaskHandle_t xTask );
+BaseType_t xTaskGenericNotifyStateClear( TaskHandle_t xTask, UBaseType_t uxIndexToClear ) PRIVILEGED_FUNCTION;
+#define xTaskNotifyStateClear( xTask ) xTaskGenericNotifyStateClear( ( xTask ), ( tskDEFAULT_INDEX_TO_NOTIFY ) )
+#define xTaskNotifyStateClearIndexed( xTask, uxIndexToClear ) xTaskGenericNotifyStateClear( ( xTask ), ( uxIndexToClear ) )
+
+/**
+ * task. h
+ * <PRE>BaseType_t xTaskMailboxPost( TaskHandle_t xTask, UBaseType_t uxSlot, uint32_t ulMessage );</PRE>
+ * <PRE>BaseType_t xTaskMailboxOverwrite( TaskHandle_t xTask, UBaseType_t uxSlot, uint32_t ulMessage );</PRE>
+ * <PRE>BaseType_t xTaskMailboxPostFromISR( TaskHandle_t xTask, UBaseType_t uxSlot, uint32_t ulMessage, BaseType_t *pxHigherPriorityTaskWoken );</PRE>
+ * <PRE>BaseType_t xTaskMailboxReceive( UBaseType_t uxSlot, uint32_t *pulMessage, TickType_t xTicksToWait );</PRE>
+ *
+ * Single entry mailboxes built on the notification array.  Each of the
+ * configTASK_NOTIFICATION_ARRAY_ENTRIES notification slots of a task can be
+ * used as an independent length-one queue of 32-bit messages, without the RAM
+ * and code cost of creating a queue or a semaphore.  The slot's notification
+ * state is used as the "mailbox full" flag, so a post and a receive are both
+ * O(1) and never allocate.
+ *
+ * xTaskMailboxPost() fails (returns pdFAIL) if the slot already holds a message
+ * that has not yet been received.  xTaskMailboxOverwrite() always succeeds and
+ * replaces any unread message.  xTaskMailboxReceive() blocks for up to
+ * xTicksToWait ticks for a message to arrive in slot uxSlot of the calling
+ * task, returning pdTRUE and writing the message to *pulMessage if one was
+ * received.
+ *
+ * Slot tskDEFAULT_INDEX_TO_NOTIFY is also used by the non-indexed notification
+ * API, stream buffers and the CMSIS-RTOS signal functions, so applications
+ * should normally use the slots above it for mailboxes.
+ *
+ * \defgroup xTaskMailboxPost xTaskMailboxPost
+ * \ingroup TaskNotifications
+ */
+#define xTaskMailboxPost( xTask, uxSlot, ulMessage ) xTaskGenericNotify( ( xTask ), ( uxSlot ), ( ulMessage ), eSetValueWithoutOverwrite, NULL )
+#define xTaskMailboxOverwrite( xTask, uxSlot, ulMessage ) xTaskGenericNotify( ( xTask ), ( uxSlot ), ( ulMessage ), eSetValueWithOverwrite, NULL )
+#define xTaskMailboxPostFromISR( xTask, uxSlot, ulMessage, pxHigherPriorityTaskWoken ) xTaskGenericNotifyFromISR( ( xTask ), ( uxSlot ), ( ulMessage ), eSetValueWithoutOverwrite, NULL, ( pxHigherPriorityTaskWoken ) )
+#define xTaskMailboxReceive( uxSlot, pulMessage, xTicksToWait ) xTaskGenericNotifyWait( ( uxSlot ), 0UL, 0UL, ( pulMessage ), ( xTicksToWait ) )
+
+/**
+ * task. h
+ * <PRE>BaseType_t xTaskSetBudget( TaskHandle_t xTask, uint32_t ulBudgetCycles, TickType_t xReplenishPeriod, eBudgetAction eAction );</PRE>
+ *
+ * configUSE_TASK_BUDGETS must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * Limit the execution time of a task to ulBudgetCycles cycles of the port's
+ * cycle counter (portGET_CYCLE_COUNTER(), the core clock on this port) in
+ * every xReplenishPeriod ticks.  Time is charged to the running task each
+ * time it is switched out and on each tick interrupt, so a budget is enforced
+ * to within one tick.  Time spent in interrupts is charged to the task they
+ * interrupt.
+ *
+ * When the budget runs out eAction is taken:
+ *
+ * eBudgetDemote - the task runs at configTASK_BUDGET_DEMOTE_PRIORITY until the
+ * start of its next replenishment period, then returns to its own priority.
+ * Releasing the last mutex it holds also ends the demotion.
+ *
+ * eBudgetSuspend - the task is held in the Blocked state until the start of
+ * its next replenishment period.
+ *
+ * eBudgetCallHook - vApplicationTaskBudgetHook() is called from the tick
+ * interrupt or the context switch, and the task continues to run.  The hook
+ * must be short and must not call any FreeRTOS API function.
+ * configUSE_TASK_BUDGET_HOOK must be set to 1 to use this action.
+ *
+ * @param xTask The task being budgeted.  Passing NULL budgets the calling
+ * task.  The idle task cannot be budgeted.
+ *
+ * @param ulBudgetCycles The execution time allowed in each replenishment
+ * period.  Passing 0 removes the task's budget.
+ *
+ * @param xReplenishPeriod The replenishment period in ticks.  The first period
+ * starts when xTaskSetBudget() is called.
+ *
+ * @param eAction The action taken when the budget is exhausted.
+ *
+ * @return pdPASS if the budget was set, or pdFAIL if configMAX_BUDGETED_TASKS
+ * tasks already have a budget.
+ *
+ * Example usage:
+   <pre>
+ // Allow the aperiodic task 500us of CPU time in every 10ms.
+ xTaskSetBudget( xAperiodicTask, ( SystemCoreClock / 2000UL ), pdMS_TO_TICKS( 10 ), eBudgetSuspend );
+   </pre>
+ * \defgroup xTaskSetBudget xTaskSetBudget
+ * \ingroup TaskCtrl
+ */
+BaseType_t xTaskSetBudget( TaskHandle_t xTask, uint32_t ulBudgetCycles, TickType_t xReplenishPeriod, eBudgetAction eAction ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <PRE>UBaseType_t uxTaskGetBudgetOverruns( TaskHandle_t xTask );</PRE>
+ *
+ * Returns the number of replenishment periods in which xTask exhausted its
+ * budget since the task was created.  Passing NULL queries the calling task.
+ *
+ * \defgroup uxTaskGetBudgetOverruns uxTaskGetBudgetOverruns
+ * \ingroup TaskCtrl
+ */
+UBaseType_t uxTaskGetBudgetOverruns( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <PRE>uint32_t ulTaskGetBudgetRemaining( TaskHandle_t xTask );</PRE>
+ *
+ * Returns the number of cycles left in the current replenishment period of
+ * xTask, as last charged.  Passing NULL queries the calling task.
+ *
+ * \defgroup ulTaskGetBudgetRemaining ulTaskGetBudgetRemaining
+ * \ingroup TaskCtrl
+ */
+uint32_t ulTaskGetBudgetRemaining( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
 
 /*-----------------------------------------------------------
  * SCHEDULER INTERNALS AVAILABLE FOR PORTING PURPOSES
@@ -2137,7 +2625,7 @@ BaseType_t xTaskNotifyStateClear( TaskHandle_t xTask );
  *   + Time slicing is in use and there is a task of equal priority to the
  *     currently running task.
  */
-BaseType_t xTaskIncrementTick( void ) PRIVILEGED_FUNCTION;
+BaseType_t xTaskIncrementTick( void ) PRIVILEGED_FUNCTION CCM_FUNCTION;
 
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
@@ -2170,7 +2658,7 @@ BaseType_t xTaskIncrementTick( void ) PRIVILEGED_FUNCTION;
  * portTICK_PERIOD_MS can be used to convert kernel ticks into a real time
  * period.
  */
-void vTaskPlaceOnEventList( List_t * const pxEventList, const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+void vTaskPlaceOnEventList( List_t * const pxEventList, const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION CCM_FUNCTION;
 void vTaskPlaceOnUnorderedEventList( List_t * pxEventList, const TickType_t xItemValue, const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 
 /*
@@ -2205,13 +2693,16 @@ void vTaskPlaceOnEventListRestricted( List_t * const pxEventList, TickType_t xTi
  * vTaskRemoveFromUnorderedEventList() is used when the event list is not
  * ordered and the event list items hold something other than the owning tasks
  * priority.  In this case the event list item value is updated to the value
- * passed in the xItemValue parameter.
+ * passed in the xItemValue parameter.  vTaskRemoveFromUnorderedEventList() is
+ * called with the scheduler suspended, xTaskRemoveFromUnorderedEventListFromISR()
+ * with interrupts masked, as xTaskRemoveFromEventList().
  *
  * @return pdTRUE if the task being removed has a higher priority than the task
  * making the call, otherwise pdFALSE.
  */
-BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList ) PRIVILEGED_FUNCTION;
+BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList ) PRIVILEGED_FUNCTION CCM_FUNCTION;
 void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem, const TickType_t xItemValue ) PRIVILEGED_FUNCTION;
+BaseType_t xTaskRemoveFromUnorderedEventListFromISR( ListItem_t * pxEventListItem, const TickType_t xItemValue ) PRIVILEGED_FUNCTION;
 
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY
@@ -2221,7 +2712,7 @@ void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem, const Tick
  * Sets the pointer to the current TCB to the TCB of the highest priority task
  * that is ready to run.
  */
-void vTaskSwitchContext( void ) PRIVILEGED_FUNCTION;
+void vTaskSwitchContext( void ) PRIVILEGED_FUNCTION CCM_FUNCTION;
 
 /*
  * THESE FUNCTIONS MUST NOT BE USED FROM APPLICATION CODE.  THEY ARE USED BY
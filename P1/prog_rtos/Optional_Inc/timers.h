@@ -66,6 +66,10 @@ or interrupt version of the queue send function should be used. */
 #define tmrCOMMAND_STOP_FROM_ISR				( ( BaseType_t ) 8 )
 #define tmrCOMMAND_CHANGE_PERIOD_FROM_ISR		( ( BaseType_t ) 9 )
 
+/* Sent by the tick interrupt, not through the API, to tell the timer service
+task that timers have expired and their callbacks are waiting to be called. */
+#define tmrCOMMAND_PROCESS_EXPIRED				( ( BaseType_t ) 10 )
+
 
 /**
  * Type by which software timers are referenced.  For example, a call to
@@ -480,20 +484,13 @@ TaskHandle_t xTimerGetTimerDaemonTaskHandle( void ) PRIVILEGED_FUNCTION;
  *
  * @param xTimer The handle of the timer being started/restarted.
  *
- * @param xTicksToWait Specifies the time, in ticks, that the calling task should
- * be held in the Blocked state to wait for the start command to be successfully
- * sent to the timer command queue, should the queue already be full when
- * xTimerStart() was called.  xTicksToWait is ignored if xTimerStart() is called
- * before the scheduler is started.
+ * @param xTicksToWait Not used.  The start command is applied to the timer
+ * directly, in a short critical section, rather than being sent to the timer
+ * command queue, so xTimerStart() never blocks.  The parameter is kept so
+ * existing code builds unchanged.
  *
- * @return pdFAIL will be returned if the start command could not be sent to
- * the timer command queue even after xTicksToWait ticks had passed.  pdPASS will
- * be returned if the command was successfully sent to the timer command queue.
- * When the command is actually processed will depend on the priority of the
- * timer service/daemon task relative to other tasks in the system, although the
- * timers expiry time is relative to when xTimerStart() is actually called.  The
- * timer service/daemon task priority is set by the configTIMER_TASK_PRIORITY
- * configuration constant.
+ * @return pdPASS once the timer service has been created, in which case the
+ * start command has already been applied when the function returns.
  *
  * Example usage:
  *
@@ -523,19 +520,13 @@ TaskHandle_t xTimerGetTimerDaemonTaskHandle( void ) PRIVILEGED_FUNCTION;
  *
  * @param xTimer The handle of the timer being stopped.
  *
- * @param xTicksToWait Specifies the time, in ticks, that the calling task should
- * be held in the Blocked state to wait for the stop command to be successfully
- * sent to the timer command queue, should the queue already be full when
- * xTimerStop() was called.  xTicksToWait is ignored if xTimerStop() is called
- * before the scheduler is started.
+ * @param xTicksToWait Not used.  The stop command is applied to the timer
+ * directly, in a short critical section, rather than being sent to the timer
+ * command queue, so xTimerStop() never blocks.  The parameter is kept so
+ * existing code builds unchanged.
  *
- * @return pdFAIL will be returned if the stop command could not be sent to
- * the timer command queue even after xTicksToWait ticks had passed.  pdPASS will
- * be returned if the command was successfully sent to the timer command queue.
- * When the command is actually processed will depend on the priority of the
- * timer service/daemon task relative to other tasks in the system.  The timer
- * service/daemon task priority is set by the configTIMER_TASK_PRIORITY
- * configuration constant.
+ * @return pdPASS once the timer service has been created, in which case the
+ * stop command has already been applied when the function returns.
  *
  * Example usage:
  *
@@ -575,19 +566,13 @@ TaskHandle_t xTimerGetTimerDaemonTaskHandle( void ) PRIVILEGED_FUNCTION;
  * ( 500 / portTICK_PERIOD_MS ) provided configTICK_RATE_HZ is less than
  * or equal to 1000.
  *
- * @param xTicksToWait Specifies the time, in ticks, that the calling task should
- * be held in the Blocked state to wait for the change period command to be
- * successfully sent to the timer command queue, should the queue already be
- * full when xTimerChangePeriod() was called.  xTicksToWait is ignored if
- * xTimerChangePeriod() is called before the scheduler is started.
+ * @param xTicksToWait Not used.  The change period command is applied to the
+ * timer directly, in a short critical section, rather than being sent to the
+ * timer command queue, so xTimerChangePeriod() never blocks.  The parameter is
+ * kept so existing code builds unchanged.
  *
- * @return pdFAIL will be returned if the change period command could not be
- * sent to the timer command queue even after xTicksToWait ticks had passed.
- * pdPASS will be returned if the command was successfully sent to the timer
- * command queue.  When the command is actually processed will depend on the
- * priority of the timer service/daemon task relative to other tasks in the
- * system.  The timer service/daemon task priority is set by the
- * configTIMER_TASK_PRIORITY configuration constant.
+ * @return pdPASS once the timer service has been created, in which case the
+ * change period command has already been applied when the function returns.
  *
  * Example usage:
  * @verbatim
@@ -649,8 +634,10 @@ TaskHandle_t xTimerGetTimerDaemonTaskHandle( void ) PRIVILEGED_FUNCTION;
  * is called before the scheduler is started.
  *
  * @return pdFAIL will be returned if the delete command could not be sent to
- * the timer command queue even after xTicksToWait ticks had passed.  pdPASS will
- * be returned if the command was successfully sent to the timer command queue.
+ * the timer command queue even after xTicksToWait ticks had passed, in which
+ * case the timer is left as it was.  pdPASS will be returned if the command was
+ * successfully sent to the timer command queue.  A timer created with
+ * xTimerCreateStatic() is deleted at once, without going through the queue.
  * When the command is actually processed will depend on the priority of the
  * timer service/daemon task relative to other tasks in the system.  The timer
  * service/daemon task priority is set by the configTIMER_TASK_PRIORITY
@@ -694,20 +681,13 @@ TaskHandle_t xTimerGetTimerDaemonTaskHandle( void ) PRIVILEGED_FUNCTION;
  *
  * @param xTimer The handle of the timer being reset/started/restarted.
  *
- * @param xTicksToWait Specifies the time, in ticks, that the calling task should
- * be held in the Blocked state to wait for the reset command to be successfully
- * sent to the timer command queue, should the queue already be full when
- * xTimerReset() was called.  xTicksToWait is ignored if xTimerReset() is called
- * before the scheduler is started.
+ * @param xTicksToWait Not used.  The reset command is applied to the timer
+ * directly, in a short critical section, rather than being sent to the timer
+ * command queue, so xTimerReset() never blocks.  The parameter is kept so
+ * existing code builds unchanged.
  *
- * @return pdFAIL will be returned if the reset command could not be sent to
- * the timer command queue even after xTicksToWait ticks had passed.  pdPASS will
- * be returned if the command was successfully sent to the timer command queue.
- * When the command is actually processed will depend on the priority of the
- * timer service/daemon task relative to other tasks in the system, although the
- * timers expiry time is relative to when xTimerStart() is actually called.  The
- * timer service/daemon task priority is set by the configTIMER_TASK_PRIORITY
- * configuration constant.
+ * @return pdPASS once the timer service has been created, in which case the
+ * reset command has already been applied when the function returns.
  *
  * Example usage:
  * @verbatim
@@ -1256,11 +1236,44 @@ TickType_t xTimerGetPeriod( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
 */
 TickType_t xTimerGetExpiryTime( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
 
+/**
+ * void vTimerSetFastCallback( TimerHandle_t xTimer, UBaseType_t uxFastCallback );
+ *
+ * configUSE_TIMER_FAST_CALLBACKS must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * Active timers are kept in a hierarchical timing wheel that is advanced by
+ * the tick interrupt, so starting, resetting, stopping or changing the period
+ * of a timer takes a short, constant time and does not go through the timer
+ * command queue.  When a timer expires its callback is normally called by the
+ * timer service task.  A timer with a fast callback instead has its callback
+ * called directly from the tick interrupt, without waking the timer service
+ * task.  A fast callback must be short, must not block, and must only use the
+ * API functions that end in "FromISR".
+ *
+ * @param xTimer The handle of the timer being updated.
+ *
+ * @param uxFastCallback If uxFastCallback is set to pdTRUE then the callback
+ * of the timer is called from the tick interrupt.  If uxFastCallback is set to
+ * pdFALSE then the callback is called from the timer service task.
+ */
+void vTimerSetFastCallback( TimerHandle_t xTimer, const UBaseType_t uxFastCallback ) PRIVILEGED_FUNCTION;
+
 /*
  * Functions beyond this part are not part of the public API and are intended
  * for use by the kernel only.
  */
 BaseType_t xTimerCreateTimerTask( void ) PRIVILEGED_FUNCTION;
+BaseType_t xTimerIncrementTick( const TickType_t xTickCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Ticks from the current tick count to the next tick at which the timer wheel
+ * has timers to expire or to cascade, or portMAX_DELAY if there are none.  Used
+ * to cap the time the tick is suppressed for when configUSE_TICKLESS_IDLE is not
+ * 0: the suppressed ticks are then stepped through xTimerIncrementTick() one by
+ * one by vTaskStepTick().
+ */
+TickType_t xTimerGetExpectedIdleTime( void ) PRIVILEGED_FUNCTION;
 BaseType_t xTimerGenericCommand( TimerHandle_t xTimer, const BaseType_t xCommandID, const TickType_t xOptionalValue, BaseType_t * const pxHigherPriorityTaskWoken, const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 
 #if( configUSE_TRACE_FACILITY == 1 )
@@ -1268,6 +1281,12 @@ BaseType_t xTimerGenericCommand( TimerHandle_t xTimer, const BaseType_t xCommand
 	UBaseType_t uxTimerGetTimerNumber( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
 #endif
 
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	/* Provided by the application when static allocation is enabled: the
+	memory the timer service task is created in. */
+	void vApplicationGetTimerTaskMemory( StaticTask_t **ppxTimerTaskTCBBuffer, StackType_t **ppxTimerTaskStackBuffer, uint32_t *pulTimerTaskStackSize );
+#endif
+
 #ifdef __cplusplus
 }
 #endif
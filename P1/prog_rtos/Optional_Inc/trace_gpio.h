@@ -0,0 +1,134 @@
+/*
+ * prog_rtos kernel add-on: GPIO timing probes driven from the kernel trace
+ * hooks.
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#ifndef TRACE_GPIO_H
+#define TRACE_GPIO_H
+
+/*
+ * GPIO timing probes, for a logic analyser or an oscilloscope.
+ *
+ * Included by FreeRTOSConfig.h when configUSE_TRACE_GPIO is 1, so the trace
+ * macros below replace the empty defaults of FreeRTOS.h.  Each trace point is
+ * a single store to the BSRR register of configTRACE_GPIO_PORT_BSRR, which sets
+ * and clears pins atomically, so the probes neither read-modify-write the port
+ * nor take a critical section.
+ *
+ * Tasks are identified by the number set with vTaskSetTaskNumber(); a task
+ * with number 0 (the default, so the idle and timer tasks unless the
+ * application numbers them) drives no pin.  Two encodings are available:
+ *
+ * configTRACE_GPIO_MODE == traceGPIO_MODE_PIN_PER_TASK
+ *     task n, 1 <= n <= configTRACE_GPIO_TASK_PINS, owns pin
+ *     configTRACE_GPIO_FIRST_PIN + n - 1, high while the task runs.
+ *
+ * configTRACE_GPIO_MODE == traceGPIO_MODE_PATTERN
+ *     the number of the running task is written in binary on the
+ *     configTRACE_GPIO_TASK_PINS pins from configTRACE_GPIO_FIRST_PIN, so up to
+ *     2^pins - 1 tasks can be told apart (numbers are truncated to the pins).
+ *
+ * In both modes the task pins are cleared when a task is switched out and set
+ * again when the next one is switched in, so the gap between the two edges is
+ * the scheduler's own time.  configTRACE_GPIO_ISR_PIN (-1 for none) is high
+ * between traceISR_ENTER() and traceISR_EXIT(): the kernel calls them in the
+ * tick interrupt, application handlers can call them too.  Nested interrupts
+ * share the pin, the inner exit clears it.
+ *
+ * The defaults drive the Discovery LEDs on GPIOE (PE8-PE15): the task pins are
+ * PE8-PE14 and the ISR pin PE15.  The application must configure the pins as
+ * outputs (e.g. BSP_LED_InitMask( LEDS_ALL_PINS )) and must not use them for
+ * anything else while tracing.
+ *
+ * The encoding is done by the traceGPIO_SWITCHED_IN_BSRR(),
+ * traceGPIO_SWITCHED_OUT_BSRR() and traceGPIO_ISR_BSRR() macros, which only
+ * depend on the configuration and on their argument, and the store by
+ * traceGPIO_WRITE(), which can be defined before this header is included to
+ * check the encoding without the hardware.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Values for configTRACE_GPIO_MODE. */
+#define traceGPIO_MODE_PIN_PER_TASK		( 0 )
+#define traceGPIO_MODE_PATTERN			( 1 )
+
+#ifndef configTRACE_GPIO_MODE
+	#define configTRACE_GPIO_MODE traceGPIO_MODE_PATTERN
+#endif
+
+/* BSRR of GPIOE on the STM32F303. */
+#ifndef configTRACE_GPIO_PORT_BSRR
+	#define configTRACE_GPIO_PORT_BSRR ( 0x48001018UL )
+#endif
+
+#ifndef configTRACE_GPIO_FIRST_PIN
+	#define configTRACE_GPIO_FIRST_PIN 8
+#endif
+
+#ifndef configTRACE_GPIO_TASK_PINS
+	#define configTRACE_GPIO_TASK_PINS 7
+#endif
+
+#ifndef configTRACE_GPIO_ISR_PIN
+	#define configTRACE_GPIO_ISR_PIN 15
+#endif
+
+#if ( configUSE_TRACE_FACILITY != 1 )
+	#error configUSE_TRACE_GPIO needs configUSE_TRACE_FACILITY set to 1 for the task numbers
+#endif
+
+#if ( ( configTRACE_GPIO_FIRST_PIN + configTRACE_GPIO_TASK_PINS ) > 16 )
+	#error The trace task pins must fit in one 16 pin port
+#endif
+
+#if ( ( configTRACE_GPIO_ISR_PIN >= configTRACE_GPIO_FIRST_PIN ) && ( configTRACE_GPIO_ISR_PIN < ( configTRACE_GPIO_FIRST_PIN + configTRACE_GPIO_TASK_PINS ) ) )
+	#error configTRACE_GPIO_ISR_PIN must not be one of the task pins
+#endif
+
+/* The task pins, in place. */
+#define traceGPIO_TASK_MASK		( ( ( 1UL << configTRACE_GPIO_TASK_PINS ) - 1UL ) << configTRACE_GPIO_FIRST_PIN )
+
+/* Set bits of a BSRR word showing task number uxNumber. */
+#if ( configTRACE_GPIO_MODE == traceGPIO_MODE_PIN_PER_TASK )
+	#define traceGPIO_TASK_SET_BITS( uxNumber )															\
+		( ( ( ( uxNumber ) >= 1UL ) && ( ( uxNumber ) <= ( UBaseType_t ) configTRACE_GPIO_TASK_PINS ) ) ?	\
+		  ( 1UL << ( configTRACE_GPIO_FIRST_PIN + ( uxNumber ) - 1UL ) ) : 0UL )
+#else
+	#define traceGPIO_TASK_SET_BITS( uxNumber )	( ( ( uint32_t ) ( uxNumber ) << configTRACE_GPIO_FIRST_PIN ) & traceGPIO_TASK_MASK )
+#endif
+
+/* BSRR words written on a switch.  Switching in clears the pins not set as
+well, so the pins are right even if a switch out was missed (e.g. the first
+task started by the scheduler). */
+#define traceGPIO_SWITCHED_IN_BSRR( uxNumber )	( ( ( traceGPIO_TASK_MASK & ~traceGPIO_TASK_SET_BITS( uxNumber ) ) << 16UL ) | traceGPIO_TASK_SET_BITS( uxNumber ) )
+#define traceGPIO_SWITCHED_OUT_BSRR( uxNumber )	( traceGPIO_TASK_MASK << 16UL )
+
+/* BSRR words for the ISR pin, xEnter pdTRUE to set it. */
+#if ( configTRACE_GPIO_ISR_PIN >= 0 )
+	#define traceGPIO_ISR_BSRR( xEnter )	( ( xEnter ) ? ( 1UL << configTRACE_GPIO_ISR_PIN ) : ( 1UL << ( configTRACE_GPIO_ISR_PIN + 16 ) ) )
+#endif
+
+#ifndef traceGPIO_WRITE
+	#define traceGPIO_WRITE( ulBsrr )	( *( ( volatile uint32_t * ) configTRACE_GPIO_PORT_BSRR ) = ( ulBsrr ) )
+#endif
+
+/* pxCurrentTCB is only in scope in tasks.c, which is the only user of the
+switch macros. */
+#define traceTASK_SWITCHED_OUT()	traceGPIO_WRITE( traceGPIO_SWITCHED_OUT_BSRR( pxCurrentTCB->uxTaskNumber ) )
+#define traceTASK_SWITCHED_IN()		traceGPIO_WRITE( traceGPIO_SWITCHED_IN_BSRR( pxCurrentTCB->uxTaskNumber ) )
+
+#if ( configTRACE_GPIO_ISR_PIN >= 0 )
+	#define traceISR_ENTER()	traceGPIO_WRITE( traceGPIO_ISR_BSRR( 1 ) )
+	#define traceISR_EXIT()		traceGPIO_WRITE( traceGPIO_ISR_BSRR( 0 ) )
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TRACE_GPIO_H */
@@ -32,6 +32,10 @@
 /* Remove the whole file is co-routines are not being used. */
 #if( configUSE_CO_ROUTINES != 0 )
 
+#if( configMAX_CO_ROUTINE_PRIORITIES > 32 )
+	#error configMAX_CO_ROUTINE_PRIORITIES must be 32 or less, the ready co-routine priorities are held in one bit map word
+#endif
+
 /*
  * Some kernel aware debuggers require data to be viewed to be global, rather
  * than file scope.
@@ -51,12 +55,35 @@ static List_t xPendingReadyCoRoutineList;								/*< Holds co-routines that have
 
 /* Other file private variables. --------------------------------*/
 CRCB_t * pxCurrentCoRoutine = NULL;
-static UBaseType_t uxTopCoRoutineReadyPriority = 0;
-static TickType_t xCoRoutineTickCount = 0, xLastTickCount = 0, xPassedTicks = 0;
+static UBaseType_t uxCoRoutineReadyPriorities = 0;						/*< Bit n is set while pxReadyCoRoutineLists[ n ] is not empty. */
+static TickType_t xCoRoutineTickCount = 0;								/*< The tick count the delayed lists were last checked at. */
+static TaskHandle_t xCoRoutineSchedulerTask = NULL;						/*< The task running vCoRoutineSchedulerTask(), if any. */
 
 /* The initial state of the co-routine when it is created. */
 #define corINITIAL_STATE	( 0 )
 
+/* Values for the ucNotifyState member of the CRCB_t. */
+#define corNOT_WAITING_NOTIFICATION		( ( uint8_t ) 0 )
+#define corWAITING_NOTIFICATION			( ( uint8_t ) 1 )
+#define corNOTIFICATION_RECEIVED		( ( uint8_t ) 2 )
+
+/*
+ * The highest priority with a ready co-routine.  uxCoRoutineReadyPriorities
+ * must not be 0.
+ */
+#if( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 )
+	#define corGET_HIGHEST_READY_PRIORITY( uxTopPriority ) portGET_HIGHEST_PRIORITY( uxTopPriority, uxCoRoutineReadyPriorities )
+#else
+	#define corGET_HIGHEST_READY_PRIORITY( uxTopPriority )											\
+	{																								\
+		for( uxTopPriority = ( UBaseType_t ) configMAX_CO_ROUTINE_PRIORITIES - 1U;					\
+			 ( uxCoRoutineReadyPriorities & ( ( UBaseType_t ) 1U << uxTopPriority ) ) == 0U;		\
+			 uxTopPriority-- )																		\
+		{																							\
+		}																							\
+	}
+#endif
+
 /*
  * Place the co-routine represented by pxCRCB into the appropriate ready queue
  * for the priority.  It is inserted at the end of the list.
@@ -66,10 +93,7 @@ static TickType_t xCoRoutineTickCount = 0, xLastTickCount = 0, xPassedTicks = 0;
  */
 #define prvAddCoRoutineToReadyQueue( pxCRCB )																		\
 {																													\
-	if( pxCRCB->uxPriority > uxTopCoRoutineReadyPriority )															\
-	{																												\
-		uxTopCoRoutineReadyPriority = pxCRCB->uxPriority;															\
-	}																												\
+	uxCoRoutineReadyPriorities |= ( UBaseType_t ) 1U << pxCRCB->uxPriority;										\
 	vListInsertEnd( ( List_t * ) &( pxReadyCoRoutineLists[ pxCRCB->uxPriority ] ), &( pxCRCB->xGenericListItem ) );	\
 }
 
@@ -97,62 +121,129 @@ static void prvCheckPendingReadyList( void );
  */
 static void prvCheckDelayedList( void );
 
+/*
+ * Readies the co-routines on pxDelayedCoRoutineList whose wake time is
+ * xTickCount or earlier.
+ */
+static void prvWakeDelayedCoRoutines( TickType_t xTickCount );
+
+/*
+ * Moves the pending and delayed co-routines that are due to the ready lists,
+ * then runs the highest priority ready co-routine.  Returns pdFALSE if there
+ * was none.
+ */
+static BaseType_t prvRunNextCoRoutine( void );
+
+/*
+ * The number of ticks until the first delayed co-routine is due, or
+ * portMAX_DELAY if none is delayed.
+ */
+static TickType_t prvTicksToNextWake( void );
+
+/*
+ * Fills out a co-routine control block and makes the co-routine ready.
+ */
+static void prvInitialiseNewCoRoutine( CRCB_t *pxCoRoutine, crCOROUTINE_CODE pxCoRoutineCode, UBaseType_t uxPriority, UBaseType_t uxIndex );
+
+/*
+ * Moves a co-routine readied by an event to the pending ready list, and wakes
+ * the task running the co-routines to move it on.  Called with interrupts
+ * disabled, from a task or an interrupt.
+ */
+static void prvPendReady( CRCB_t *pxCRCB, BaseType_t * const pxHigherPriorityTaskWoken );
+
 /*-----------------------------------------------------------*/
 
-BaseType_t xCoRoutineCreate( crCOROUTINE_CODE pxCoRoutineCode, UBaseType_t uxPriority, UBaseType_t uxIndex )
-{
-BaseType_t xReturn;
-CRCB_t *pxCoRoutine;
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
 
-	/* Allocate the memory that will store the co-routine control block. */
-	pxCoRoutine = ( CRCB_t * ) pvPortMalloc( sizeof( CRCB_t ) );
-	if( pxCoRoutine )
+	BaseType_t xCoRoutineCreate( crCOROUTINE_CODE pxCoRoutineCode, UBaseType_t uxPriority, UBaseType_t uxIndex, CoRoutineHandle_t * const pxCreatedCoRoutine )
 	{
-		/* If pxCurrentCoRoutine is NULL then this is the first co-routine to
-		be created and the co-routine data structures need initialising. */
-		if( pxCurrentCoRoutine == NULL )
+	BaseType_t xReturn;
+	CRCB_t *pxCoRoutine;
+
+		/* Allocate the memory that will store the co-routine control block. */
+		pxCoRoutine = ( CRCB_t * ) pvPortMalloc( sizeof( CRCB_t ) );
+		if( pxCoRoutine )
+		{
+			prvInitialiseNewCoRoutine( pxCoRoutine, pxCoRoutineCode, uxPriority, uxIndex );
+			xReturn = pdPASS;
+		}
+		else
 		{
-			pxCurrentCoRoutine = pxCoRoutine;
-			prvInitialiseCoRoutineLists();
+			xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
 		}
 
-		/* Check the priority is within limits. */
-		if( uxPriority >= configMAX_CO_ROUTINE_PRIORITIES )
+		if( pxCreatedCoRoutine != NULL )
 		{
-			uxPriority = configMAX_CO_ROUTINE_PRIORITIES - 1;
+			/* Pass the handle out in an anonymous way.  NULL if the
+			co-routine could not be created. */
+			*pxCreatedCoRoutine = ( CoRoutineHandle_t ) pxCoRoutine;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
 		}
 
-		/* Fill out the co-routine control block from the function parameters. */
-		pxCoRoutine->uxState = corINITIAL_STATE;
-		pxCoRoutine->uxPriority = uxPriority;
-		pxCoRoutine->uxIndex = uxIndex;
-		pxCoRoutine->pxCoRoutineFunction = pxCoRoutineCode;
+		return xReturn;
+	}
 
-		/* Initialise all the other co-routine control block parameters. */
-		vListInitialiseItem( &( pxCoRoutine->xGenericListItem ) );
-		vListInitialiseItem( &( pxCoRoutine->xEventListItem ) );
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
 
-		/* Set the co-routine control block as a link back from the ListItem_t.
-		This is so we can get back to the containing CRCB from a generic item
-		in a list. */
-		listSET_LIST_ITEM_OWNER( &( pxCoRoutine->xGenericListItem ), pxCoRoutine );
-		listSET_LIST_ITEM_OWNER( &( pxCoRoutine->xEventListItem ), pxCoRoutine );
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
 
-		/* Event lists are always in priority order. */
-		listSET_LIST_ITEM_VALUE( &( pxCoRoutine->xEventListItem ), ( ( TickType_t ) configMAX_CO_ROUTINE_PRIORITIES - ( TickType_t ) uxPriority ) );
+	CoRoutineHandle_t xCoRoutineCreateStatic( crCOROUTINE_CODE pxCoRoutineCode, UBaseType_t uxPriority, UBaseType_t uxIndex, CRCB_t * const pxCoRoutineBuffer )
+	{
+		configASSERT( pxCoRoutineBuffer );
 
-		/* Now the co-routine has been initialised it can be added to the ready
-		list at the correct priority. */
-		prvAddCoRoutineToReadyQueue( pxCoRoutine );
+		prvInitialiseNewCoRoutine( pxCoRoutineBuffer, pxCoRoutineCode, uxPriority, uxIndex );
 
-		xReturn = pdPASS;
+		return ( CoRoutineHandle_t ) pxCoRoutineBuffer;
 	}
-	else
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewCoRoutine( CRCB_t *pxCoRoutine, crCOROUTINE_CODE pxCoRoutineCode, UBaseType_t uxPriority, UBaseType_t uxIndex )
+{
+	/* If pxCurrentCoRoutine is NULL then this is the first co-routine to
+	be created and the co-routine data structures need initialising. */
+	if( pxCurrentCoRoutine == NULL )
 	{
-		xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+		pxCurrentCoRoutine = pxCoRoutine;
+		prvInitialiseCoRoutineLists();
 	}
 
-	return xReturn;
+	/* Check the priority is within limits. */
+	if( uxPriority >= configMAX_CO_ROUTINE_PRIORITIES )
+	{
+		uxPriority = configMAX_CO_ROUTINE_PRIORITIES - 1;
+	}
+
+	/* Fill out the co-routine control block from the function parameters. */
+	pxCoRoutine->uxState = corINITIAL_STATE;
+	pxCoRoutine->uxPriority = uxPriority;
+	pxCoRoutine->uxIndex = uxIndex;
+	pxCoRoutine->pxCoRoutineFunction = pxCoRoutineCode;
+	pxCoRoutine->ulNotifiedValue = 0UL;
+	pxCoRoutine->ucNotifyState = corNOT_WAITING_NOTIFICATION;
+
+	/* Initialise all the other co-routine control block parameters. */
+	vListInitialiseItem( &( pxCoRoutine->xGenericListItem ) );
+	vListInitialiseItem( &( pxCoRoutine->xEventListItem ) );
+
+	/* Set the co-routine control block as a link back from the ListItem_t.
+	This is so we can get back to the containing CRCB from a generic item
+	in a list. */
+	listSET_LIST_ITEM_OWNER( &( pxCoRoutine->xGenericListItem ), pxCoRoutine );
+	listSET_LIST_ITEM_OWNER( &( pxCoRoutine->xEventListItem ), pxCoRoutine );
+
+	/* Event lists are always in priority order. */
+	listSET_LIST_ITEM_VALUE( &( pxCoRoutine->xEventListItem ), ( ( TickType_t ) configMAX_CO_ROUTINE_PRIORITIES - ( TickType_t ) uxPriority ) );
+
+	/* Now the co-routine has been initialised it can be added to the ready
+	list at the correct priority. */
+	prvAddCoRoutineToReadyQueue( pxCoRoutine );
 }
 /*-----------------------------------------------------------*/
 
@@ -167,7 +258,10 @@ TickType_t xTimeToWake;
 	/* We must remove ourselves from the ready list before adding
 	ourselves to the blocked list as the same list item is used for
 	both lists. */
-	( void ) uxListRemove( ( ListItem_t * ) &( pxCurrentCoRoutine->xGenericListItem ) );
+	if( uxListRemove( ( ListItem_t * ) &( pxCurrentCoRoutine->xGenericListItem ) ) == ( UBaseType_t ) 0 )
+	{
+		uxCoRoutineReadyPriorities &= ~( ( UBaseType_t ) 1U << pxCurrentCoRoutine->uxPriority );
+	}
 
 	/* The list item will be inserted in wake time order. */
 	listSET_LIST_ITEM_VALUE( &( pxCurrentCoRoutine->xGenericListItem ), xTimeToWake );
@@ -219,89 +313,174 @@ static void prvCheckPendingReadyList( void )
 
 static void prvCheckDelayedList( void )
 {
-CRCB_t *pxCRCB;
+const TickType_t xTickCount = xTaskGetTickCount();
+List_t * pxTemp;
 
-	xPassedTicks = xTaskGetTickCount() - xLastTickCount;
-	while( xPassedTicks )
+	if( xTickCount != xCoRoutineTickCount )
 	{
-		xCoRoutineTickCount++;
-		xPassedTicks--;
-
-		/* If the tick count has overflowed we need to swap the ready lists. */
-		if( xCoRoutineTickCount == 0 )
+		/* Rather than stepping through each tick that passed, jump to the
+		current count, stopping at the overflow if it is on the way. */
+		if( xTickCount < xCoRoutineTickCount )
 		{
-			List_t * pxTemp;
+			/* The tick count has overflowed, so everything left on the
+			current delayed list was due before the overflow. */
+			prvWakeDelayedCoRoutines( portMAX_DELAY );
 
-			/* Tick count has overflowed so we need to swap the delay lists.  If there are
-			any items in pxDelayedCoRoutineList here then there is an error! */
-			pxTemp = pxDelayedCoRoutineList;
-			pxDelayedCoRoutineList = pxOverflowDelayedCoRoutineList;
-			pxOverflowDelayedCoRoutineList = pxTemp;
+			/* Swap the delay lists.  xCoRoutineNotifyFromISR() looks at them
+			to tell a blocked co-routine. */
+			portDISABLE_INTERRUPTS();
+			{
+				pxTemp = pxDelayedCoRoutineList;
+				pxDelayedCoRoutineList = pxOverflowDelayedCoRoutineList;
+				pxOverflowDelayedCoRoutineList = pxTemp;
+			}
+			portENABLE_INTERRUPTS();
 		}
 
-		/* See if this tick has made a timeout expire. */
-		while( listLIST_IS_EMPTY( pxDelayedCoRoutineList ) == pdFALSE )
-		{
-			pxCRCB = ( CRCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxDelayedCoRoutineList );
+		xCoRoutineTickCount = xTickCount;
+		prvWakeDelayedCoRoutines( xTickCount );
+	}
+}
+/*-----------------------------------------------------------*/
 
-			if( xCoRoutineTickCount < listGET_LIST_ITEM_VALUE( &( pxCRCB->xGenericListItem ) ) )
-			{
-				/* Timeout not yet expired. */
-				break;
-			}
+static void prvWakeDelayedCoRoutines( TickType_t xTickCount )
+{
+CRCB_t *pxCRCB;
 
-			portDISABLE_INTERRUPTS();
+	while( listLIST_IS_EMPTY( pxDelayedCoRoutineList ) == pdFALSE )
+	{
+		pxCRCB = ( CRCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxDelayedCoRoutineList );
+
+		if( xTickCount < listGET_LIST_ITEM_VALUE( &( pxCRCB->xGenericListItem ) ) )
+		{
+			/* Timeout not yet expired. */
+			break;
+		}
+
+		portDISABLE_INTERRUPTS();
+		{
+			/* The event could have occurred just before this critical
+			section.  If this is the case then the generic list item will
+			have been moved to the pending ready list and the following
+			line is still valid.  Also the pvContainer parameter will have
+			been set to NULL so the following lines are also valid. */
+			( void ) uxListRemove( &( pxCRCB->xGenericListItem ) );
+
+			/* Is the co-routine waiting on an event also? */
+			if( pxCRCB->xEventListItem.pvContainer )
 			{
-				/* The event could have occurred just before this critical
-				section.  If this is the case then the generic list item will
-				have been moved to the pending ready list and the following
-				line is still valid.  Also the pvContainer parameter will have
-				been set to NULL so the following lines are also valid. */
-				( void ) uxListRemove( &( pxCRCB->xGenericListItem ) );
-
-				/* Is the co-routine waiting on an event also? */
-				if( pxCRCB->xEventListItem.pvContainer )
-				{
-					( void ) uxListRemove( &( pxCRCB->xEventListItem ) );
-				}
+				( void ) uxListRemove( &( pxCRCB->xEventListItem ) );
 			}
-			portENABLE_INTERRUPTS();
-
-			prvAddCoRoutineToReadyQueue( pxCRCB );
 		}
-	}
+		portENABLE_INTERRUPTS();
 
-	xLastTickCount = xCoRoutineTickCount;
+		prvAddCoRoutineToReadyQueue( pxCRCB );
+	}
 }
 /*-----------------------------------------------------------*/
 
-void vCoRoutineSchedule( void )
+static BaseType_t prvRunNextCoRoutine( void )
 {
+UBaseType_t uxTopPriority;
+
+	/* Nothing to run, nor any list initialised, until the first co-routine
+	is created. */
+	if( pxCurrentCoRoutine == NULL )
+	{
+		return pdFALSE;
+	}
+
 	/* See if any co-routines readied by events need moving to the ready lists. */
 	prvCheckPendingReadyList();
 
 	/* See if any delayed co-routines have timed out. */
 	prvCheckDelayedList();
 
-	/* Find the highest priority queue that contains ready co-routines. */
-	while( listLIST_IS_EMPTY( &( pxReadyCoRoutineLists[ uxTopCoRoutineReadyPriority ] ) ) )
+	if( uxCoRoutineReadyPriorities == ( UBaseType_t ) 0U )
 	{
-		if( uxTopCoRoutineReadyPriority == 0 )
-		{
-			/* No more co-routines to check. */
-			return;
-		}
-		--uxTopCoRoutineReadyPriority;
+		return pdFALSE;
 	}
 
+	/* Find the highest priority queue that contains ready co-routines. */
+	corGET_HIGHEST_READY_PRIORITY( uxTopPriority );
+
 	/* listGET_OWNER_OF_NEXT_ENTRY walks through the list, so the co-routines
 	 of the	same priority get an equal share of the processor time. */
-	listGET_OWNER_OF_NEXT_ENTRY( pxCurrentCoRoutine, &( pxReadyCoRoutineLists[ uxTopCoRoutineReadyPriority ] ) );
+	listGET_OWNER_OF_NEXT_ENTRY( pxCurrentCoRoutine, &( pxReadyCoRoutineLists[ uxTopPriority ] ) );
 
 	/* Call the co-routine. */
 	( pxCurrentCoRoutine->pxCoRoutineFunction )( pxCurrentCoRoutine, pxCurrentCoRoutine->uxIndex );
 
-	return;
+	return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+void vCoRoutineSchedule( void )
+{
+	( void ) prvRunNextCoRoutine();
+}
+/*-----------------------------------------------------------*/
+
+void vCoRoutineSchedulerTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	/* Only one task may run the co-routines. */
+	configASSERT( xCoRoutineSchedulerTask == NULL );
+	xCoRoutineSchedulerTask = xTaskGetCurrentTaskHandle();
+
+	for( ;; )
+	{
+		while( prvRunNextCoRoutine() != pdFALSE )
+		{
+			/* Keep running co-routines while any is ready, the task is
+			time sliced with the tasks of its priority as usual. */
+		}
+
+		/* Nothing is ready: sleep until the first delayed co-routine is due,
+		or until an event readies one.  An event that came since the lists
+		were last checked has already given the notification, so is not
+		missed. */
+		( void ) ulTaskNotifyTake( pdTRUE, prvTicksToNextWake() );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static TickType_t prvTicksToNextWake( void )
+{
+TickType_t xRemaining, xElapsed;
+
+	if( pxCurrentCoRoutine == NULL )
+	{
+		xRemaining = portMAX_DELAY;
+	}
+	else if( listLIST_IS_EMPTY( pxDelayedCoRoutineList ) == pdFALSE )
+	{
+		/* Every co-routine still delayed is due after xCoRoutineTickCount. */
+		xRemaining = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxDelayedCoRoutineList ) - xCoRoutineTickCount;
+	}
+	else if( listLIST_IS_EMPTY( pxOverflowDelayedCoRoutineList ) == pdFALSE )
+	{
+		/* Wake at the overflow, where the delay lists are swapped. */
+		xRemaining = ( TickType_t ) 0 - xCoRoutineTickCount;
+	}
+	else
+	{
+		xRemaining = portMAX_DELAY;
+	}
+
+	if( xRemaining != portMAX_DELAY )
+	{
+		/* The co-routines last run may have taken ticks. */
+		xElapsed = xTaskGetTickCount() - xCoRoutineTickCount;
+		xRemaining = ( xElapsed < xRemaining ) ? ( xRemaining - xElapsed ) : ( TickType_t ) 0;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xRemaining;
 }
 /*-----------------------------------------------------------*/
 
@@ -335,7 +514,7 @@ BaseType_t xReturn;
 	check has already been made to ensure pxEventList is not empty. */
 	pxUnblockedCRCB = ( CRCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxEventList );
 	( void ) uxListRemove( &( pxUnblockedCRCB->xEventListItem ) );
-	vListInsertEnd( ( List_t * ) &( xPendingReadyCoRoutineList ), &( pxUnblockedCRCB->xEventListItem ) );
+	prvPendReady( pxUnblockedCRCB, NULL );
 
 	if( pxUnblockedCRCB->uxPriority >= pxCurrentCoRoutine->uxPriority )
 	{
@@ -348,6 +527,154 @@ BaseType_t xReturn;
 
 	return xReturn;
 }
+/*-----------------------------------------------------------*/
 
-#endif /* configUSE_CO_ROUTINES == 0 */
+static void prvPendReady( CRCB_t *pxCRCB, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	vListInsertEnd( ( List_t * ) &( xPendingReadyCoRoutineList ), &( pxCRCB->xEventListItem ) );
+
+	if( xCoRoutineSchedulerTask != NULL )
+	{
+		/* The FromISR version is used from tasks too, as interrupts are
+		disabled. */
+		vTaskNotifyGiveFromISR( xCoRoutineSchedulerTask, &xHigherPriorityTaskWoken );
+
+		if( pxHigherPriorityTaskWoken != NULL )
+		{
+			if( xHigherPriorityTaskWoken != pdFALSE )
+			{
+				*pxHigherPriorityTaskWoken = pdTRUE;
+			}
+		}
+		else if( xHigherPriorityTaskWoken != pdFALSE )
+		{
+			/* The caller has no way to report it, so request the switch
+			here.  From a task it happens once interrupts are enabled again. */
+			portYIELD_FROM_ISR( pdTRUE );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		/* The co-routines are run from the idle task, which will find the
+		co-routine on its next call to vCoRoutineSchedule(). */
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xCoRoutineNotify( CoRoutineHandle_t xCoRoutine, uint32_t ulValue )
+{
+BaseType_t xReturn;
+
+	taskENTER_CRITICAL();
+	{
+		xReturn = xCoRoutineNotifyFromISR( xCoRoutine, ulValue, NULL );
+	}
+	taskEXIT_CRITICAL();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xCoRoutineNotifyFromISR( CoRoutineHandle_t xCoRoutine, uint32_t ulValue, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+CRCB_t * const pxCRCB = ( CRCB_t * ) xCoRoutine;
+UBaseType_t uxSavedInterruptStatus;
+uint8_t ucOriginalNotifyState;
 
+	configASSERT( pxCRCB );
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		ucOriginalNotifyState = pxCRCB->ucNotifyState;
+		pxCRCB->ulNotifiedValue |= ulValue;
+		pxCRCB->ucNotifyState = corNOTIFICATION_RECEIVED;
+
+		/* Only pend a co-routine that is still blocked: one that has timed
+		out is ready, or being made ready, and takes the notification when it
+		runs. */
+		if( ( ucOriginalNotifyState == corWAITING_NOTIFICATION ) &&
+			( ( listLIST_ITEM_CONTAINER( &( pxCRCB->xGenericListItem ) ) == pxDelayedCoRoutineList ) ||
+			  ( listLIST_ITEM_CONTAINER( &( pxCRCB->xGenericListItem ) ) == pxOverflowDelayedCoRoutineList ) ) )
+		{
+			prvPendReady( pxCRCB, pxHigherPriorityTaskWoken );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xCoRoutineNotifyWait( uint32_t *pulValue, TickType_t xTicksToWait )
+{
+BaseType_t xReturn;
+
+	/* Called from the running co-routine only. */
+	portDISABLE_INTERRUPTS();
+	{
+		if( pxCurrentCoRoutine->ucNotifyState == corNOTIFICATION_RECEIVED )
+		{
+			if( pulValue != NULL )
+			{
+				*pulValue = pxCurrentCoRoutine->ulNotifiedValue;
+			}
+
+			pxCurrentCoRoutine->ulNotifiedValue = 0UL;
+			pxCurrentCoRoutine->ucNotifyState = corNOT_WAITING_NOTIFICATION;
+			xReturn = pdPASS;
+		}
+		else if( xTicksToWait > ( TickType_t ) 0 )
+		{
+			pxCurrentCoRoutine->ucNotifyState = corWAITING_NOTIFICATION;
+			vCoRoutineAddToDelayedList( xTicksToWait, NULL );
+			xReturn = errQUEUE_BLOCKED;
+		}
+		else
+		{
+			pxCurrentCoRoutine->ucNotifyState = corNOT_WAITING_NOTIFICATION;
+			xReturn = pdFAIL;
+		}
+	}
+	portENABLE_INTERRUPTS();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xCoRoutineNotifyStateClear( CoRoutineHandle_t xCoRoutine )
+{
+CRCB_t * const pxCRCB = ( CRCB_t * ) xCoRoutine;
+BaseType_t xReturn;
+
+	configASSERT( pxCRCB );
+
+	taskENTER_CRITICAL();
+	{
+		if( pxCRCB->ucNotifyState == corNOTIFICATION_RECEIVED )
+		{
+			pxCRCB->ucNotifyState = corNOT_WAITING_NOTIFICATION;
+			pxCRCB->ulNotifiedValue = 0UL;
+			xReturn = pdPASS;
+		}
+		else
+		{
+			xReturn = pdFAIL;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return xReturn;
+}
+
+#endif /* configUSE_CO_ROUTINES == 0 */
@@ -60,15 +60,36 @@ taskEVENT_LIST_ITEM_VALUE_IN_USE definition. */
 	#define eventEVENT_BITS_CONTROL_BYTES	0xff000000UL
 #endif
 
+#if( ( configEVENT_GROUP_WAIT_LISTS < 1 ) || ( ( configEVENT_GROUP_WAIT_LISTS & ( configEVENT_GROUP_WAIT_LISTS - 1 ) ) != 0 ) )
+	#error configEVENT_GROUP_WAIT_LISTS must be a power of two
+#endif
+
+/* Waiting tasks are spread over configEVENT_GROUP_WAIT_LISTS lists, a task
+going on the list selected by the lowest bit it waits for.  uxWaitListBits[ x ]
+holds the bits waited for by the tasks on list x - it can hold more bits than
+that, as it is only rebuilt when the list is walked - so setting bits only
+walks the lists of the tasks that wait for at least one of them, rather than
+every task blocked on the group.
+
+While a task is using the lists it holds the group locked, with the scheduler
+suspended.  Interrupts that set or clear bits while the group is locked leave
+them in uxBitsSetFromISR and uxBitsClearedFromISR, and the task applies them
+when it unlocks the group.  Otherwise interrupts update the group and unblock
+the tasks themselves. */
 typedef struct xEventGroupDefinition
 {
 	EventBits_t uxEventBits;
-	List_t xTasksWaitingForBits;		/*< List of tasks waiting for a bit to be set. */
+	List_t xTasksWaitingForBits[ configEVENT_GROUP_WAIT_LISTS ];	/*< Lists of tasks waiting for a bit to be set. */
+	EventBits_t uxWaitListBits[ configEVENT_GROUP_WAIT_LISTS ];	/*< The bits waited for by the tasks of each list. */
+	volatile EventBits_t uxBitsSetFromISR;		/*< Bits set by interrupts while the group was locked. */
+	volatile EventBits_t uxBitsClearedFromISR;	/*< Bits cleared by interrupts while the group was locked. */
 
 	#if( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t uxEventGroupNumber;
 	#endif
 
+	volatile uint8_t ucLocked;	/*< pdTRUE while a task is using the wait lists. */
+
 	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 		uint8_t ucStaticallyAllocated; /*< Set to pdTRUE if the event group is statically allocated to ensure no attempt is made to free the memory. */
 	#endif
@@ -86,6 +107,35 @@ typedef struct xEventGroupDefinition
  */
 static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, const EventBits_t uxBitsToWaitFor, const BaseType_t xWaitForAllBits ) PRIVILEGED_FUNCTION;
 
+/*
+ * Initialise the members of a new event group.
+ */
+static void prvInitialiseEventGroup( EventGroup_t *pxEventBits ) PRIVILEGED_FUNCTION;
+
+/*
+ * Place the calling task on the wait list selected by uxBitsToWaitFor.
+ * uxItemValue is uxBitsToWaitFor plus the control bits.  Called with the group
+ * locked.
+ */
+static void prvPlaceOnWaitList( EventGroup_t *pxEventBits, const EventBits_t uxBitsToWaitFor, const EventBits_t uxItemValue, const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Set bits and unblock the tasks whose wait condition is then met, clearing
+ * the bits they asked to clear on exit.  Called either by a task that holds
+ * the group locked (xFromISR pdFALSE) or with interrupts masked while the group
+ * is not locked (xFromISR pdTRUE).  Returns pdTRUE if a task of a priority
+ * above that of the running task was unblocked.
+ */
+static BaseType_t prvSetBits( EventGroup_t *pxEventBits, const EventBits_t uxBitsToSet, const BaseType_t xFromISR ) PRIVILEGED_FUNCTION;
+
+/*
+ * Lock the group against interrupts that would use its wait lists, and unlock
+ * it again, applying the bits interrupts set and cleared in the meantime.  Both
+ * are called with the scheduler suspended.
+ */
+static void prvLockEventGroup( EventGroup_t *pxEventBits ) PRIVILEGED_FUNCTION;
+static void prvUnlockEventGroup( EventGroup_t *pxEventBits ) PRIVILEGED_FUNCTION;
+
 /*-----------------------------------------------------------*/
 
 #if( configSUPPORT_STATIC_ALLOCATION == 1 )
@@ -112,8 +162,7 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, co
 
 		if( pxEventBits != NULL )
 		{
-			pxEventBits->uxEventBits = 0;
-			vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+			prvInitialiseEventGroup( pxEventBits );
 
 			#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
 			{
@@ -148,8 +197,7 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, co
 
 		if( pxEventBits != NULL )
 		{
-			pxEventBits->uxEventBits = 0;
-			vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+			prvInitialiseEventGroup( pxEventBits );
 
 			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
 			{
@@ -190,9 +238,12 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 
 	vTaskSuspendAll();
 	{
+		prvLockEventGroup( pxEventBits );
+
 		uxOriginalBitValue = pxEventBits->uxEventBits;
 
-		( void ) xEventGroupSetBits( xEventGroup, uxBitsToSet );
+		traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet );
+		( void ) prvSetBits( pxEventBits, uxBitsToSet, pdFALSE );
 
 		if( ( ( uxOriginalBitValue | uxBitsToSet ) & uxBitsToWaitFor ) == uxBitsToWaitFor )
 		{
@@ -214,7 +265,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 				/* Store the bits that the calling task is waiting for in the
 				task's event list item so the kernel knows when a match is
 				found.  Then enter the blocked state. */
-				vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
+				prvPlaceOnWaitList( pxEventBits, uxBitsToWaitFor, ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
 
 				/* This assignment is obsolete as uxReturn will get set after
 				the task unblocks, but some compilers mistakenly generate a
@@ -230,6 +281,8 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 				xTimeoutOccurred = pdTRUE;
 			}
 		}
+
+		prvUnlockEventGroup( pxEventBits );
 	}
 	xAlreadyYielded = xTaskResumeAll();
 
@@ -296,7 +349,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 EventBits_t xEventGroupWaitBits( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToWaitFor, const BaseType_t xClearOnExit, const BaseType_t xWaitForAllBits, TickType_t xTicksToWait )
 {
 EventGroup_t *pxEventBits = ( EventGroup_t * ) xEventGroup;
-EventBits_t uxReturn, uxControlBits = 0;
+EventBits_t uxReturn, uxCurrentEventBits, uxControlBits = 0;
 BaseType_t xWaitConditionMet, xAlreadyYielded;
 BaseType_t xTimeoutOccurred = pdFALSE;
 
@@ -313,7 +366,10 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 
 	vTaskSuspendAll();
 	{
-		const EventBits_t uxCurrentEventBits = pxEventBits->uxEventBits;
+		/* The bits are read with the group locked, so an interrupt cannot set
+		them between the test below and the task joining a wait list. */
+		prvLockEventGroup( pxEventBits );
+		uxCurrentEventBits = pxEventBits->uxEventBits;
 
 		/* Check to see if the wait condition is already met or not. */
 		xWaitConditionMet = prvTestWaitCondition( uxCurrentEventBits, uxBitsToWaitFor, xWaitForAllBits );
@@ -369,7 +425,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 			/* Store the bits that the calling task is waiting for in the
 			task's event list item so the kernel knows when a match is
 			found.  Then enter the blocked state. */
-			vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
+			prvPlaceOnWaitList( pxEventBits, uxBitsToWaitFor, ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
 
 			/* This is obsolete as it will get set after the task unblocks, but
 			some compilers mistakenly generate a warning about the variable
@@ -378,6 +434,8 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 
 			traceEVENT_GROUP_WAIT_BITS_BLOCK( xEventGroup, uxBitsToWaitFor );
 		}
+
+		prvUnlockEventGroup( pxEventBits );
 	}
 	xAlreadyYielded = xTaskResumeAll();
 
@@ -470,19 +528,34 @@ EventBits_t uxReturn;
 }
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
+BaseType_t xEventGroupClearBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToClear )
+{
+UBaseType_t uxSavedInterruptStatus;
+EventGroup_t *pxEventBits = ( EventGroup_t * ) xEventGroup;
 
-	BaseType_t xEventGroupClearBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToClear )
-	{
-		BaseType_t xReturn;
+	configASSERT( xEventGroup );
+	configASSERT( ( uxBitsToClear & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
 
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
 		traceEVENT_GROUP_CLEAR_BITS_FROM_ISR( xEventGroup, uxBitsToClear );
-		xReturn = xTimerPendFunctionCallFromISR( vEventGroupClearBitsCallback, ( void * ) xEventGroup, ( uint32_t ) uxBitsToClear, NULL );
 
-		return xReturn;
+		if( pxEventBits->ucLocked == ( uint8_t ) pdFALSE )
+		{
+			pxEventBits->uxEventBits &= ~uxBitsToClear;
+		}
+		else
+		{
+			/* A task is using the group, it clears the bits when it unlocks
+			the group - after setting the bits set before by interrupts, which
+			are left in uxBitsSetFromISR. */
+			pxEventBits->uxBitsClearedFromISR |= uxBitsToClear;
+		}
 	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 
-#endif
+	return pdPASS;
+}
 /*-----------------------------------------------------------*/
 
 EventBits_t xEventGroupGetBitsFromISR( EventGroupHandle_t xEventGroup )
@@ -493,7 +566,8 @@ EventBits_t uxReturn;
 
 	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
 	{
-		uxReturn = pxEventBits->uxEventBits;
+		/* Include the bits interrupts changed while the group is locked. */
+		uxReturn = ( pxEventBits->uxEventBits | pxEventBits->uxBitsSetFromISR ) & ~( pxEventBits->uxBitsClearedFromISR );
 	}
 	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 
@@ -503,115 +577,97 @@ EventBits_t uxReturn;
 
 EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet )
 {
-ListItem_t *pxListItem, *pxNext;
-ListItem_t const *pxListEnd;
-List_t *pxList;
-EventBits_t uxBitsToClear = 0, uxBitsWaitedFor, uxControlBits;
 EventGroup_t *pxEventBits = ( EventGroup_t * ) xEventGroup;
-BaseType_t xMatchFound = pdFALSE;
 
 	/* Check the user is not attempting to set the bits used by the kernel
 	itself. */
 	configASSERT( xEventGroup );
 	configASSERT( ( uxBitsToSet & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
 
-	pxList = &( pxEventBits->xTasksWaitingForBits );
-	pxListEnd = listGET_END_MARKER( pxList ); /*lint !e826 !e740 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
 	vTaskSuspendAll();
 	{
 		traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet );
 
-		pxListItem = listGET_HEAD_ENTRY( pxList );
-
-		/* Set the bits. */
-		pxEventBits->uxEventBits |= uxBitsToSet;
-
-		/* See if the new bit value should unblock any tasks. */
-		while( pxListItem != pxListEnd )
-		{
-			pxNext = listGET_NEXT( pxListItem );
-			uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
-			xMatchFound = pdFALSE;
+		prvLockEventGroup( pxEventBits );
+		( void ) prvSetBits( pxEventBits, uxBitsToSet, pdFALSE );
+		prvUnlockEventGroup( pxEventBits );
+	}
+	( void ) xTaskResumeAll();
 
-			/* Split the bits waited for from the control bits. */
-			uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
-			uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
+	return pxEventBits->uxEventBits;
+}
+/*-----------------------------------------------------------*/
 
-			if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) == ( EventBits_t ) 0 )
-			{
-				/* Just looking for single bit being set. */
-				if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) != ( EventBits_t ) 0 )
-				{
-					xMatchFound = pdTRUE;
-				}
-				else
-				{
-					mtCOVERAGE_TEST_MARKER();
-				}
-			}
-			else if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) == uxBitsWaitedFor )
-			{
-				/* All bits are set. */
-				xMatchFound = pdTRUE;
-			}
-			else
-			{
-				/* Need all bits to be set, but not all the bits were set. */
-			}
+BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet, BaseType_t *pxHigherPriorityTaskWoken )
+{
+UBaseType_t uxSavedInterruptStatus;
+EventGroup_t *pxEventBits = ( EventGroup_t * ) xEventGroup;
+BaseType_t xTaskWoken = pdFALSE;
 
-			if( xMatchFound != pdFALSE )
-			{
-				/* The bits match.  Should the bits be cleared on exit? */
-				if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
-				{
-					uxBitsToClear |= uxBitsWaitedFor;
-				}
-				else
-				{
-					mtCOVERAGE_TEST_MARKER();
-				}
+	configASSERT( xEventGroup );
+	configASSERT( ( uxBitsToSet & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
 
-				/* Store the actual event flag value in the task's event list
-				item before removing the task from the event list.  The
-				eventUNBLOCKED_DUE_TO_BIT_SET bit is set so the task knows
-				that is was unblocked due to its required bits matching, rather
-				than because it timed out. */
-				vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
-			}
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		traceEVENT_GROUP_SET_BITS_FROM_ISR( xEventGroup, uxBitsToSet );
 
-			/* Move onto the next list item.  Note pxListItem->pxNext is not
-			used here as the list item may have been removed from the event list
-			and inserted into the ready/pending reading list. */
-			pxListItem = pxNext;
+		if( pxEventBits->ucLocked == ( uint8_t ) pdFALSE )
+		{
+			/* Only the tasks on the wait lists of the bits being set are
+			looked at, so the time spent here with interrupts masked depends
+			on the number of tasks waiting for these bits. */
+			xTaskWoken = prvSetBits( pxEventBits, uxBitsToSet, pdTRUE );
 		}
+		else
+		{
+			/* A task is using the group, it sets the bits and unblocks the
+			tasks waiting for them when it unlocks the group.  A later set
+			cancels an earlier clear from an interrupt. */
+			pxEventBits->uxBitsSetFromISR |= uxBitsToSet;
+			pxEventBits->uxBitsClearedFromISR &= ~uxBitsToSet;
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 
-		/* Clear any bits that matched when the eventCLEAR_EVENTS_ON_EXIT_BIT
-		bit was set in the control word. */
-		pxEventBits->uxEventBits &= ~uxBitsToClear;
+	if( ( xTaskWoken != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+	{
+		*pxHigherPriorityTaskWoken = pdTRUE;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
 	}
-	( void ) xTaskResumeAll();
 
-	return pxEventBits->uxEventBits;
+	return pdPASS;
 }
 /*-----------------------------------------------------------*/
 
 void vEventGroupDelete( EventGroupHandle_t xEventGroup )
 {
 EventGroup_t *pxEventBits = ( EventGroup_t * ) xEventGroup;
-const List_t *pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBits );
+const List_t *pxTasksWaitingForBits;
+UBaseType_t uxList;
 
 	vTaskSuspendAll();
 	{
 		traceEVENT_GROUP_DELETE( xEventGroup );
 
-		while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
+		/* The group is not unlocked again, interrupts must not use it once it
+		is being deleted. */
+		prvLockEventGroup( pxEventBits );
+
+		for( uxList = 0; uxList < ( UBaseType_t ) configEVENT_GROUP_WAIT_LISTS; uxList++ )
 		{
-			/* Unblock the task, returning 0 as the event list is being deleted
-			and cannot therefore have any bits set. */
-			configASSERT( pxTasksWaitingForBits->xListEnd.pxNext != ( const ListItem_t * ) &( pxTasksWaitingForBits->xListEnd ) );
-			vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
-		}
+			pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBits[ uxList ] );
 
+			while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
+			{
+				/* Unblock the task, returning 0 as the event list is being
+				deleted and cannot therefore have any bits set. */
+				configASSERT( pxTasksWaitingForBits->xListEnd.pxNext != ( const ListItem_t * ) &( pxTasksWaitingForBits->xListEnd ) );
+				vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
+			}
+		}
 		#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
 		{
 			/* The event group can only have been allocated dynamically - free
@@ -688,19 +744,201 @@ BaseType_t xWaitConditionMet = pdFALSE;
 }
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
+static void prvInitialiseEventGroup( EventGroup_t *pxEventBits )
+{
+UBaseType_t uxList;
+
+	pxEventBits->uxEventBits = 0;
+	pxEventBits->uxBitsSetFromISR = 0;
+	pxEventBits->uxBitsClearedFromISR = 0;
+	pxEventBits->ucLocked = ( uint8_t ) pdFALSE;
 
-	BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet, BaseType_t *pxHigherPriorityTaskWoken )
+	for( uxList = 0; uxList < ( UBaseType_t ) configEVENT_GROUP_WAIT_LISTS; uxList++ )
 	{
-	BaseType_t xReturn;
+		vListInitialise( &( pxEventBits->xTasksWaitingForBits[ uxList ] ) );
+		pxEventBits->uxWaitListBits[ uxList ] = 0;
+	}
+}
+/*-----------------------------------------------------------*/
 
-		traceEVENT_GROUP_SET_BITS_FROM_ISR( xEventGroup, uxBitsToSet );
-		xReturn = xTimerPendFunctionCallFromISR( vEventGroupSetBitsCallback, ( void * ) xEventGroup, ( uint32_t ) uxBitsToSet, pxHigherPriorityTaskWoken );
+static void prvPlaceOnWaitList( EventGroup_t *pxEventBits, const EventBits_t uxBitsToWaitFor, const EventBits_t uxItemValue, const TickType_t xTicksToWait )
+{
+EventBits_t uxBits = uxBitsToWaitFor;
+UBaseType_t uxList = 0;
 
-		return xReturn;
+	/* The list of the lowest bit waited for.  uxBitsToWaitFor is not 0. */
+	while( ( uxBits & ( EventBits_t ) 1 ) == ( EventBits_t ) 0 )
+	{
+		uxBits >>= 1;
+		uxList++;
 	}
+	uxList &= ( UBaseType_t ) ( configEVENT_GROUP_WAIT_LISTS - 1 );
 
-#endif
+	pxEventBits->uxWaitListBits[ uxList ] |= uxBitsToWaitFor;
+	vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits[ uxList ] ), uxItemValue, xTicksToWait );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvSetBits( EventGroup_t *pxEventBits, const EventBits_t uxBitsToSet, const BaseType_t xFromISR )
+{
+ListItem_t *pxListItem, *pxNext;
+ListItem_t const *pxListEnd;
+List_t *pxList;
+EventBits_t uxBitsToClear = 0, uxBitsWaitedFor, uxControlBits, uxStillWaitedFor;
+BaseType_t xMatchFound, xTaskWoken = pdFALSE;
+UBaseType_t uxList;
+
+	/* Set the bits. */
+	pxEventBits->uxEventBits |= uxBitsToSet;
+
+	/* A task is only unblocked by this call if it waits for one of the bits
+	being set (otherwise its wait condition was met already when it blocked),
+	so only the lists of such tasks are walked. */
+	for( uxList = 0; uxList < ( UBaseType_t ) configEVENT_GROUP_WAIT_LISTS; uxList++ )
+	{
+		if( ( pxEventBits->uxWaitListBits[ uxList ] & uxBitsToSet ) == ( EventBits_t ) 0 )
+		{
+			continue;
+		}
+
+		pxList = &( pxEventBits->xTasksWaitingForBits[ uxList ] );
+		pxListEnd = listGET_END_MARKER( pxList ); /*lint !e826 !e740 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+		pxListItem = listGET_HEAD_ENTRY( pxList );
+		uxStillWaitedFor = 0;
+
+		/* See if the new bit value should unblock any tasks. */
+		while( pxListItem != pxListEnd )
+		{
+			pxNext = listGET_NEXT( pxListItem );
+			uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
+			xMatchFound = pdFALSE;
+
+			/* Split the bits waited for from the control bits. */
+			uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
+			uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
+
+			if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) == ( EventBits_t ) 0 )
+			{
+				/* Just looking for single bit being set. */
+				if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) != ( EventBits_t ) 0 )
+				{
+					xMatchFound = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) == uxBitsWaitedFor )
+			{
+				/* All bits are set. */
+				xMatchFound = pdTRUE;
+			}
+			else
+			{
+				/* Need all bits to be set, but not all the bits were set. */
+			}
+
+			if( xMatchFound != pdFALSE )
+			{
+				/* The bits match.  Should the bits be cleared on exit? */
+				if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
+				{
+					uxBitsToClear |= uxBitsWaitedFor;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* Store the actual event flag value in the task's event list
+				item before removing the task from the event list.  The
+				eventUNBLOCKED_DUE_TO_BIT_SET bit is set so the task knows
+				that is was unblocked due to its required bits matching, rather
+				than because it timed out. */
+				if( xFromISR == pdFALSE )
+				{
+					vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
+				}
+				else if( xTaskRemoveFromUnorderedEventListFromISR( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET ) != pdFALSE )
+				{
+					xTaskWoken = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				uxStillWaitedFor |= uxBitsWaitedFor;
+			}
+
+			/* Move onto the next list item.  Note pxListItem->pxNext is not
+			used here as the list item may have been removed from the event list
+			and inserted into the ready/pending reading list. */
+			pxListItem = pxNext;
+		}
+
+		/* Tasks that timed out are removed from the list without updating the
+		mask, so it is rebuilt from the tasks still waiting. */
+		pxEventBits->uxWaitListBits[ uxList ] = uxStillWaitedFor;
+	}
+
+	/* Clear any bits that matched when the eventCLEAR_EVENTS_ON_EXIT_BIT
+	bit was set in the control word. */
+	pxEventBits->uxEventBits &= ~uxBitsToClear;
+
+	return xTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+static void prvLockEventGroup( EventGroup_t *pxEventBits )
+{
+	/* Interrupts do not run task code, so no other task can hold the lock
+	while the scheduler is suspended, and an interrupt using the group has
+	finished with it before this task runs again. */
+	pxEventBits->ucLocked = ( uint8_t ) pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+static void prvUnlockEventGroup( EventGroup_t *pxEventBits )
+{
+EventBits_t uxBitsToSet, uxBitsToClear;
+
+	for( ;; )
+	{
+		/* Take the bits interrupts changed while the group was locked, and
+		unlock the group if there are none, in the same critical section so
+		no interrupt can leave bits here after the last check. */
+		taskENTER_CRITICAL();
+		{
+			uxBitsToSet = pxEventBits->uxBitsSetFromISR;
+			uxBitsToClear = pxEventBits->uxBitsClearedFromISR;
+			pxEventBits->uxBitsSetFromISR = 0;
+			pxEventBits->uxBitsClearedFromISR = 0;
+
+			if( ( uxBitsToSet | uxBitsToClear ) == ( EventBits_t ) 0 )
+			{
+				pxEventBits->ucLocked = ( uint8_t ) pdFALSE;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( ( uxBitsToSet | uxBitsToClear ) == ( EventBits_t ) 0 )
+		{
+			break;
+		}
+
+		/* The sets were made before the clears, a set made after a clear
+		having removed the bit from uxBitsClearedFromISR. */
+		if( uxBitsToSet != ( EventBits_t ) 0 )
+		{
+			( void ) prvSetBits( pxEventBits, uxBitsToSet, pdFALSE );
+		}
+		pxEventBits->uxEventBits &= ~uxBitsToClear;
+	}
+}
 /*-----------------------------------------------------------*/
 
 #if (configUSE_TRACE_FACILITY == 1)
@@ -0,0 +1,565 @@
+/*
+ * prog_rtos kernel add-on: job pools, worker tasks running short jobs from
+ * per-worker deques, with work stealing.
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "job_pool.h"
+
+#if( configUSE_TASK_NOTIFICATIONS != 1 )
+	#error configUSE_TASK_NOTIFICATIONS must be set to 1 to build job_pool.c
+#endif
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION != 1 )
+	#error configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 to build job_pool.c
+#endif
+
+/* Lint e961 and e750 are suppressed as a MISRA exception justified because the
+MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
+header files above, but not in this file, in order to generate the correct
+privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750. */
+
+/* The most workers a pool can have, one bit each in ulIdleWorkers. */
+#define jpMAX_WORKERS		( ( UBaseType_t ) 32 )
+
+/*-----------------------------------------------------------*/
+
+typedef struct xJOB
+{
+	JobFunction_t pxFunction;
+	void *pvArgument;
+	JobCounter_t *pxCounter;
+} Job_t;
+
+/*
+ * The indexes of a deque run freely, the jobs of the deque are the ones from
+ * uxTop to uxBottom, at offset ( index & uxMask ) in pxJobs.  The owner and the
+ * submitters work at the bottom, the thieves at the top.
+ */
+typedef struct xJOB_WORKER
+{
+	volatile UBaseType_t uxTop;		/* Index of the oldest job, moved by the thieves. */
+	volatile UBaseType_t uxBottom;	/* Index after the newest job, moved by the owner and the submitters. */
+	Job_t *pxJobs;
+	TaskHandle_t xTask;
+	struct xJOB_POOL *pxPool;
+	UBaseType_t uxIndex;
+} JobWorker_t;
+
+typedef struct xJOB_POOL
+{
+	UBaseType_t uxWorkers;
+	UBaseType_t uxMask;					/* Length of the deques - 1. */
+	UBaseType_t uxNextWorker;			/* Worker the next job from outside the pool goes to. */
+	volatile uint32_t ulIdleWorkers;	/* One bit for each worker blocked for lack of jobs. */
+	volatile uint32_t ulSteals;
+	JobWorker_t *pxWorkers;
+} JobPool_t;
+
+/*
+ * The worker of pxPool running as the calling task, or NULL.
+ */
+static JobWorker_t *prvCurrentWorker( const JobPool_t * const pxPool ) PRIVILEGED_FUNCTION;
+
+/*
+ * Takes the newest job of pxWorker's own deque, or failing that the oldest job
+ * of the first other deque that has one, into *pxJob.  pxWorker is NULL when
+ * the caller is not a worker, in which case it only steals.  Returns pdFALSE if
+ * every deque was empty.
+ */
+static BaseType_t prvTakeJob( JobPool_t * const pxPool, JobWorker_t * const pxWorker, Job_t * const pxJob ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns pdTRUE if any deque of pxPool holds a job.  Called from a critical
+ * section.
+ */
+static BaseType_t prvIsJobQueued( const JobPool_t * const pxPool ) PRIVILEGED_FUNCTION;
+
+/*
+ * Runs a job and counts it as completed, waking the task waiting for its
+ * counter if it was the last one.
+ */
+static void prvRunJob( const Job_t * const pxJob ) PRIVILEGED_FUNCTION;
+
+/*
+ * The worker tasks.
+ */
+static void prvWorkerTask( void *pvParameters ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+JobPoolHandle_t xJobPoolCreate( UBaseType_t uxWorkers,
+								UBaseType_t uxDequeLength,
+								configSTACK_DEPTH_TYPE usStackDepth,
+								UBaseType_t uxPriority )
+{
+JobPool_t *pxPool;
+JobWorker_t *pxWorker;
+Job_t *pxJobs;
+UBaseType_t uxWorker;
+char cName[ 6 ];
+
+	configASSERT( ( uxWorkers > ( UBaseType_t ) 0 ) && ( uxWorkers <= jpMAX_WORKERS ) );
+	configASSERT( uxDequeLength > ( UBaseType_t ) 0 );
+	configASSERT( ( uxDequeLength & ( uxDequeLength - 1U ) ) == 0U );
+
+	/* The pool, then the workers, then the jobs of every deque, in one
+	allocation.  The structures are multiples of the pointer size. */
+	pxPool = ( JobPool_t * ) pvPortMalloc( sizeof( JobPool_t ) +
+										   ( uxWorkers * sizeof( JobWorker_t ) ) +
+										   ( uxWorkers * uxDequeLength * sizeof( Job_t ) ) ); /*lint !e9087 !e9079 Cast from the allocated block. */
+
+	if( pxPool != NULL )
+	{
+		pxPool->uxWorkers = uxWorkers;
+		pxPool->uxMask = uxDequeLength - 1U;
+		pxPool->uxNextWorker = 0;
+		pxPool->ulIdleWorkers = 0;
+		pxPool->ulSteals = 0;
+		pxPool->pxWorkers = ( JobWorker_t * ) &( pxPool[ 1 ] ); /*lint !e9087 Follows the pool in the same block. */
+		pxJobs = ( Job_t * ) &( pxPool->pxWorkers[ uxWorkers ] ); /*lint !e9087 Follows the workers in the same block. */
+
+		for( uxWorker = 0; uxWorker < uxWorkers; uxWorker++ )
+		{
+			pxWorker = &( pxPool->pxWorkers[ uxWorker ] );
+			pxWorker->uxTop = 0;
+			pxWorker->uxBottom = 0;
+			pxWorker->pxJobs = &( pxJobs[ uxWorker * uxDequeLength ] );
+			pxWorker->xTask = NULL;
+			pxWorker->pxPool = pxPool;
+			pxWorker->uxIndex = uxWorker;
+		}
+
+		/* The workers only start to look for jobs once all of them exist. */
+		vTaskSuspendAll();
+		{
+			for( uxWorker = 0; uxWorker < uxWorkers; uxWorker++ )
+			{
+				cName[ 0 ] = 'j';
+				cName[ 1 ] = 'o';
+				cName[ 2 ] = 'b';
+				cName[ 3 ] = ( char ) ( '0' + ( uxWorker / 10U ) );
+				cName[ 4 ] = ( char ) ( '0' + ( uxWorker % 10U ) );
+				cName[ 5 ] = ( char ) 0x00;
+
+				if( xTaskCreate( prvWorkerTask, cName, usStackDepth, &( pxPool->pxWorkers[ uxWorker ] ), uxPriority, &( pxPool->pxWorkers[ uxWorker ].xTask ) ) != pdPASS )
+				{
+					break;
+				}
+			}
+
+			if( uxWorker < uxWorkers )
+			{
+				/* Out of heap: undo the workers created so far. */
+				while( uxWorker > ( UBaseType_t ) 0 )
+				{
+					uxWorker--;
+					vTaskDelete( pxPool->pxWorkers[ uxWorker ].xTask );
+				}
+
+				vPortFree( pxPool );
+				pxPool = NULL;
+			}
+		}
+		( void ) xTaskResumeAll();
+	}
+
+	return ( JobPoolHandle_t ) pxPool;
+}
+/*-----------------------------------------------------------*/
+
+void vJobPoolDelete( JobPoolHandle_t xJobPool )
+{
+JobPool_t * const pxPool = ( JobPool_t * ) xJobPool;
+uint32_t ulAllIdle;
+UBaseType_t uxWorker;
+BaseType_t xIdle;
+
+	configASSERT( pxPool );
+	configASSERT( prvCurrentWorker( pxPool ) == NULL );
+
+	ulAllIdle = 0xFFFFFFFFUL >> ( jpMAX_WORKERS - pxPool->uxWorkers );
+
+	for( ;; )
+	{
+		/* Only tasks change the deques and the idle bits, so they hold still
+		while the scheduler is suspended. */
+		vTaskSuspendAll();
+		{
+			xIdle = ( ( pxPool->ulIdleWorkers == ulAllIdle ) && ( prvIsJobQueued( pxPool ) == pdFALSE ) ) ? pdTRUE : pdFALSE;
+
+			if( xIdle != pdFALSE )
+			{
+				for( uxWorker = 0; uxWorker < pxPool->uxWorkers; uxWorker++ )
+				{
+					vTaskDelete( pxPool->pxWorkers[ uxWorker ].xTask );
+				}
+			}
+		}
+		( void ) xTaskResumeAll();
+
+		if( xIdle != pdFALSE )
+		{
+			break;
+		}
+
+		/* A worker is still running a job, or jobs are queued: give the
+		workers a tick to finish them. */
+		vTaskDelay( 1 );
+	}
+
+	vPortFree( pxPool );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xJobPoolSubmit( JobPoolHandle_t xJobPool,
+						   JobFunction_t pxFunction,
+						   void *pvArgument,
+						   JobCounter_t *pxCounter )
+{
+JobPool_t * const pxPool = ( JobPool_t * ) xJobPool;
+JobWorker_t *pxWorker;
+Job_t *pxJob;
+UBaseType_t uxIndex, uxTried;
+uint32_t ulIdleWorkers;
+BaseType_t xReturn = pdFAIL;
+
+	configASSERT( pxPool );
+	configASSERT( pxFunction );
+
+	pxWorker = prvCurrentWorker( pxPool );
+
+	taskENTER_CRITICAL();
+	{
+		ulIdleWorkers = pxPool->ulIdleWorkers;
+
+		if( pxWorker != NULL )
+		{
+			/* Keep the job on this worker, it runs it next. */
+			uxIndex = pxWorker->uxIndex;
+		}
+		else if( ulIdleWorkers != 0UL )
+		{
+			/* Straight to a worker that has nothing to do, rather than to one
+			that would have to be robbed. */
+			for( uxIndex = 0; ( ulIdleWorkers & ( 1UL << uxIndex ) ) == 0UL; uxIndex++ )
+			{
+				/* Find the lowest idle worker. */
+			}
+		}
+		else
+		{
+			uxIndex = pxPool->uxNextWorker;
+			pxPool->uxNextWorker = ( uxIndex + 1U ) % pxPool->uxWorkers;
+		}
+
+		for( uxTried = 0; uxTried < pxPool->uxWorkers; uxTried++ )
+		{
+			pxWorker = &( pxPool->pxWorkers[ uxIndex ] );
+
+			if( ( pxWorker->uxBottom - pxWorker->uxTop ) <= pxPool->uxMask )
+			{
+				pxJob = &( pxWorker->pxJobs[ pxWorker->uxBottom & pxPool->uxMask ] );
+				pxJob->pxFunction = pxFunction;
+				pxJob->pvArgument = pvArgument;
+				pxJob->pxCounter = pxCounter;
+				pxWorker->uxBottom++;
+
+				if( pxCounter != NULL )
+				{
+					pxCounter->uxPending++;
+				}
+
+				/* Wake the worker that got the job if it is idle, otherwise
+				any idle worker, which steals it. */
+				if( ulIdleWorkers != 0UL )
+				{
+					if( ( ulIdleWorkers & ( 1UL << uxIndex ) ) == 0UL )
+					{
+						for( uxIndex = 0; ( ulIdleWorkers & ( 1UL << uxIndex ) ) == 0UL; uxIndex++ )
+						{
+							/* Find the lowest idle worker. */
+						}
+					}
+
+					pxPool->ulIdleWorkers = ulIdleWorkers & ~( 1UL << uxIndex );
+					( void ) xTaskNotifyGiveIndexed( pxPool->pxWorkers[ uxIndex ].xTask, configJOB_POOL_NOTIFICATION_INDEX );
+				}
+
+				xReturn = pdPASS;
+				break;
+			}
+
+			uxIndex = ( uxIndex + 1U ) % pxPool->uxWorkers;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xJobPoolWait( JobPoolHandle_t xJobPool, JobCounter_t *pxCounter, TickType_t xTicksToWait )
+{
+JobPool_t * const pxPool = ( JobPool_t * ) xJobPool;
+JobWorker_t * const pxWorker = prvCurrentWorker( pxPool );
+const TaskHandle_t xCurrentTask = xTaskGetCurrentTaskHandle();
+TimeOut_t xTimeOut;
+Job_t xJob;
+BaseType_t xReturn = pdFAIL, xBlock, xWaiting = pdFALSE, xTimedOut = pdFALSE;
+uint32_t ulNotified = 0UL;
+
+	configASSERT( pxPool );
+	configASSERT( pxCounter );
+
+	vTaskSetTimeOutState( &xTimeOut );
+
+	if( pxWorker != NULL )
+	{
+		/* A worker that blocked here could be the one holding the jobs it
+		waits for, so it runs jobs for as long as there are any. */
+		while( ( pxCounter->uxPending != 0U ) && ( xTimedOut == pdFALSE ) )
+		{
+			if( prvTakeJob( pxPool, pxWorker, &xJob ) == pdFALSE )
+			{
+				/* The remaining jobs are running on other workers. */
+				break;
+			}
+
+			prvRunJob( &xJob );
+			xTimedOut = xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait );
+		}
+	}
+
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			if( pxCounter->uxPending == 0U )
+			{
+				/* The last job clears xWaitingTask when it notifies the task,
+				so a task still registered here after a timeout missed it.
+				Take the notification rather than leave it pending. */
+				if( ( xWaiting != pdFALSE ) && ( ulNotified == 0UL ) )
+				{
+					( void ) ulTaskNotifyTakeIndexed( configJOB_POOL_NOTIFICATION_INDEX, pdTRUE, 0 );
+				}
+
+				xReturn = pdPASS;
+				xBlock = pdFALSE;
+			}
+			else if( ( xTimedOut != pdFALSE ) || ( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE ) )
+			{
+				pxCounter->xWaitingTask = NULL;
+				xReturn = pdFAIL;
+				xBlock = pdFALSE;
+			}
+			else
+			{
+				configASSERT( ( pxCounter->xWaitingTask == NULL ) || ( pxCounter->xWaitingTask == xCurrentTask ) );
+				pxCounter->xWaitingTask = xCurrentTask;
+				xWaiting = pdTRUE;
+				xBlock = pdTRUE;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( xBlock == pdFALSE )
+		{
+			break;
+		}
+
+		ulNotified = ulTaskNotifyTakeIndexed( configJOB_POOL_NOTIFICATION_INDEX, pdTRUE, xTicksToWait );
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulJobPoolGetSteals( JobPoolHandle_t xJobPool )
+{
+const JobPool_t * const pxPool = ( const JobPool_t * ) xJobPool;
+
+	configASSERT( pxPool );
+
+	return pxPool->ulSteals;
+}
+/*-----------------------------------------------------------*/
+
+static JobWorker_t *prvCurrentWorker( const JobPool_t * const pxPool )
+{
+const TaskHandle_t xCurrentTask = xTaskGetCurrentTaskHandle();
+UBaseType_t uxWorker;
+JobWorker_t *pxWorker = NULL;
+
+	for( uxWorker = 0; uxWorker < pxPool->uxWorkers; uxWorker++ )
+	{
+		if( pxPool->pxWorkers[ uxWorker ].xTask == xCurrentTask )
+		{
+			pxWorker = &( pxPool->pxWorkers[ uxWorker ] );
+			break;
+		}
+	}
+
+	return pxWorker;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTakeJob( JobPool_t * const pxPool, JobWorker_t * const pxWorker, Job_t * const pxJob )
+{
+JobWorker_t *pxVictim;
+UBaseType_t uxIndex, uxTried;
+BaseType_t xReturn = pdFALSE;
+
+	/* The indexes are read outside of the critical section first, so empty
+	deques cost no critical section.  They are read again inside. */
+	if( ( pxWorker != NULL ) && ( pxWorker->uxBottom != pxWorker->uxTop ) )
+	{
+		taskENTER_CRITICAL();
+		{
+			if( pxWorker->uxBottom != pxWorker->uxTop )
+			{
+				pxWorker->uxBottom--;
+				*pxJob = pxWorker->pxJobs[ pxWorker->uxBottom & pxPool->uxMask ];
+				xReturn = pdTRUE;
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+
+	if( xReturn == pdFALSE )
+	{
+		/* Steal, looking at the other workers from the next one on, so the
+		thieves do not all go for the first worker. */
+		uxIndex = ( pxWorker != NULL ) ? pxWorker->uxIndex : 0U;
+
+		for( uxTried = 0; uxTried < pxPool->uxWorkers; uxTried++ )
+		{
+			uxIndex = ( uxIndex + 1U ) % pxPool->uxWorkers;
+			pxVictim = &( pxPool->pxWorkers[ uxIndex ] );
+
+			if( ( pxVictim != pxWorker ) && ( pxVictim->uxBottom != pxVictim->uxTop ) )
+			{
+				taskENTER_CRITICAL();
+				{
+					if( pxVictim->uxBottom != pxVictim->uxTop )
+					{
+						*pxJob = pxVictim->pxJobs[ pxVictim->uxTop & pxPool->uxMask ];
+						pxVictim->uxTop++;
+						pxPool->ulSteals++;
+						xReturn = pdTRUE;
+					}
+				}
+				taskEXIT_CRITICAL();
+
+				if( xReturn != pdFALSE )
+				{
+					break;
+				}
+			}
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvIsJobQueued( const JobPool_t * const pxPool )
+{
+UBaseType_t uxWorker;
+BaseType_t xReturn = pdFALSE;
+
+	for( uxWorker = 0; uxWorker < pxPool->uxWorkers; uxWorker++ )
+	{
+		if( pxPool->pxWorkers[ uxWorker ].uxBottom != pxPool->pxWorkers[ uxWorker ].uxTop )
+		{
+			xReturn = pdTRUE;
+			break;
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunJob( const Job_t * const pxJob )
+{
+JobCounter_t * const pxCounter = pxJob->pxCounter;
+
+	pxJob->pxFunction( pxJob->pvArgument );
+
+	if( pxCounter != NULL )
+	{
+		taskENTER_CRITICAL();
+		{
+			configASSERT( pxCounter->uxPending > 0U );
+			pxCounter->uxPending--;
+
+			if( ( pxCounter->uxPending == 0U ) && ( pxCounter->xWaitingTask != NULL ) )
+			{
+				( void ) xTaskNotifyGiveIndexed( pxCounter->xWaitingTask, configJOB_POOL_NOTIFICATION_INDEX );
+				pxCounter->xWaitingTask = NULL;
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvWorkerTask( void *pvParameters )
+{
+JobWorker_t * const pxWorker = ( JobWorker_t * ) pvParameters;
+JobPool_t * const pxPool = pxWorker->pxPool;
+const uint32_t ulBit = 1UL << pxWorker->uxIndex;
+Job_t xJob;
+BaseType_t xIdle;
+
+	for( ;; )
+	{
+		if( prvTakeJob( pxPool, pxWorker, &xJob ) != pdFALSE )
+		{
+			prvRunJob( &xJob );
+		}
+		else
+		{
+			/* Only go idle if no job was submitted since the deques were
+			searched: the submitters only wake workers marked idle. */
+			taskENTER_CRITICAL();
+			{
+				xIdle = ( prvIsJobQueued( pxPool ) == pdFALSE ) ? pdTRUE : pdFALSE;
+
+				if( xIdle != pdFALSE )
+				{
+					pxPool->ulIdleWorkers |= ulBit;
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			if( xIdle != pdFALSE )
+			{
+				( void ) ulTaskNotifyTakeIndexed( configJOB_POOL_NOTIFICATION_INDEX, pdTRUE, portMAX_DELAY );
+
+				/* The submitter that woke the worker cleared its bit already,
+				unless an older notification woke it. */
+				taskENTER_CRITICAL();
+				{
+					pxPool->ulIdleWorkers &= ~ulBit;
+				}
+				taskEXIT_CRITICAL();
+			}
+		}
+	}
+}
@@ -0,0 +1,653 @@
+/*
+ * prog_rtos kernel add-on: multi-producer message buffers, where several
+ * writers reserve and commit messages without a lock.
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "mp_message_buffer.h"
+
+#if( configUSE_TASK_NOTIFICATIONS != 1 )
+	#error configUSE_TASK_NOTIFICATIONS must be set to 1 to build mp_message_buffer.c
+#endif
+
+/* Lint e961 and e750 are suppressed as a MISRA exception justified because the
+MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
+header files above, but not in this file, in order to generate the correct
+privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750. */
+
+/* Set in the length of the padding message that fills the end of the storage
+area when a message does not fit before it. */
+#define mpmbPADDING_BIT		( 0x80000000UL )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The header in front of every message.  ulIndex holds the free running index
+ * of the message once it is committed, and its complement while it is only
+ * reserved.  Indexes are multiples of 8, and the reader sets the second word
+ * of every 8 bytes it frees to all ones, so whatever a writer finds where a
+ * header will be written cannot look committed: a message is committed exactly
+ * when its ulIndex matches the index it is found at.
+ */
+typedef struct xMP_MESSAGE_HEADER
+{
+	volatile uint32_t ulLength;
+	volatile uint32_t ulIndex;
+} MPMessageHeader_t;
+
+/*
+ * The indexes run freely and wrap at 2^32, the storage area is a power of two
+ * so the offset of an index is ( index & ( ulLength - 1 ) ).
+ *
+ * ulTail <= ulHead <= ulReserve: the reader owns [ ulTail, ulHead ), the
+ * messages between ulHead and ulReserve are being written or are committed
+ * behind one that is still being written.
+ */
+typedef struct xMP_MESSAGE_BUFFER
+{
+	volatile uint32_t ulReserve;	/* Index up to which space is reserved, moved by the writers. */
+	volatile uint32_t ulHead;		/* Index up to which messages are published, moved by the writers. */
+	volatile uint32_t ulTail;		/* Index of the next message to read, moved by the reader. */
+	uint32_t ulLength;				/* Size of the storage area. */
+	uint8_t *pucBuffer;
+	volatile TaskHandle_t xTaskWaitingToReceive;
+	volatile uint32_t ulDropped;
+	uint8_t ucStaticallyAllocated;
+} MPMessageBuffer_t;
+
+/*
+ * The header at index ulIndex.
+ */
+static portFORCE_INLINE MPMessageHeader_t *prvHeaderAt( const MPMessageBuffer_t * const pxBuffer, uint32_t ulIndex );
+
+/*
+ * Sets *pulAddress to ulNew if it is still ulExpected, returns pdTRUE if it
+ * did.
+ */
+static BaseType_t prvCompareAndSwap( volatile uint32_t * const pulAddress, uint32_t ulExpected, uint32_t ulNew );
+
+/*
+ * Moves ulHead over the committed messages that follow it.  Whichever writer
+ * commits last publishes the messages that were waiting on it.  Returns pdTRUE
+ * if ulHead moved.
+ */
+static BaseType_t prvPublish( MPMessageBuffer_t * const pxBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * The oldest published message, skipping padding, or NULL.
+ */
+static MPMessageHeader_t *prvFirstMessage( MPMessageBuffer_t * const pxBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Hands the space of the message or padding at the tail back to the writers.
+ */
+static void prvRelease( MPMessageBuffer_t * const pxBuffer, const MPMessageHeader_t * const pxHeader ) PRIVILEGED_FUNCTION;
+
+/*
+ * Sets the ulIndex position of every 8 bytes of the ulCount bytes at index
+ * ulIndex to all ones, see MPMessageHeader_t.
+ */
+static void prvScrub( const MPMessageBuffer_t * const pxBuffer, uint32_t ulIndex, uint32_t ulCount ) PRIVILEGED_FUNCTION;
+
+static void prvInitialiseNewBuffer( MPMessageBuffer_t * const pxBuffer, uint8_t * const pucStorageArea, size_t xBufferSizeBytes ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	MPMessageBufferHandle_t xMPMessageBufferCreate( size_t xBufferSizeBytes )
+	{
+	MPMessageBuffer_t *pxBuffer;
+
+		configASSERT( xBufferSizeBytes >= ( size_t ) 16 );
+		configASSERT( ( xBufferSizeBytes & ( xBufferSizeBytes - 1U ) ) == 0U );
+
+		/* The structure is a multiple of 8 bytes, so the storage area that
+		follows it keeps the alignment of the allocation. */
+		pxBuffer = ( MPMessageBuffer_t * ) pvPortMalloc( sizeof( MPMessageBuffer_t ) + xBufferSizeBytes ); /*lint !e9079 malloc() only returns void*. */
+
+		if( pxBuffer != NULL )
+		{
+			prvInitialiseNewBuffer( pxBuffer, ( ( uint8_t * ) pxBuffer ) + sizeof( MPMessageBuffer_t ), xBufferSizeBytes );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return ( MPMessageBufferHandle_t ) pxBuffer;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+MPMessageBufferHandle_t xMPMessageBufferCreateStatic( size_t xBufferSizeBytes,
+													  uint8_t * const pucStorageArea,
+													  StaticMPMessageBuffer_t * const pxStaticBuffer )
+{
+MPMessageBuffer_t * const pxBuffer = ( MPMessageBuffer_t * ) pxStaticBuffer; /*lint !e740 !e9087 Safe cast as StaticMPMessageBuffer_t is opaque MPMessageBuffer_t. */
+
+	configASSERT( pucStorageArea );
+	configASSERT( pxStaticBuffer );
+	configASSERT( ( ( ( size_t ) pucStorageArea ) & ( size_t ) 7 ) == 0U );
+	configASSERT( xBufferSizeBytes >= ( size_t ) 16 );
+	configASSERT( ( xBufferSizeBytes & ( xBufferSizeBytes - 1U ) ) == 0U );
+
+	#if( configASSERT_DEFINED == 1 )
+	{
+		/* Sanity check that the size of the structure used to declare a
+		variable of type StaticMPMessageBuffer_t equals the size of the real
+		structure. */
+		volatile size_t xSize = sizeof( StaticMPMessageBuffer_t );
+		configASSERT( xSize == sizeof( MPMessageBuffer_t ) );
+	}
+	#endif /* configASSERT_DEFINED */
+
+	prvInitialiseNewBuffer( pxBuffer, pucStorageArea, xBufferSizeBytes );
+	pxBuffer->ucStaticallyAllocated = ( uint8_t ) pdTRUE;
+
+	return ( MPMessageBufferHandle_t ) pxBuffer;
+}
+/*-----------------------------------------------------------*/
+
+void vMPMessageBufferDelete( MPMessageBufferHandle_t xMessageBuffer )
+{
+MPMessageBuffer_t * const pxBuffer = ( MPMessageBuffer_t * ) xMessageBuffer;
+
+	configASSERT( pxBuffer );
+
+	if( pxBuffer->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+	{
+		#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+		{
+			vPortFree( ( void * ) pxBuffer );
+		}
+		#else
+		{
+			/* Should not be possible to get here, ucStaticallyAllocated must
+			be true if dynamic allocation is not supported. */
+			configASSERT( xMessageBuffer == ( MPMessageBufferHandle_t ) ~0 );
+		}
+		#endif
+	}
+	else
+	{
+		/* The structure and buffer were not allocated dynamically and cannot be
+		freed - just scrub the structure so future use will assert. */
+		memset( pxBuffer, 0x00, sizeof( MPMessageBuffer_t ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void *pvMPMessageBufferReserve( MPMessageBufferHandle_t xMessageBuffer, size_t xLength )
+{
+MPMessageBuffer_t * const pxBuffer = ( MPMessageBuffer_t * ) xMessageBuffer;
+MPMessageHeader_t *pxHeader;
+uint32_t ulReserve, ulGap, ulNeeded, ulTotal, ulDropped;
+const uint32_t ulMessageSize = ( uint32_t ) mpmbMESSAGE_SIZE( xLength );
+
+	configASSERT( pxBuffer );
+	configASSERT( xLength > ( size_t ) 0 );
+
+	if( ( size_t ) ulMessageSize > ( size_t ) pxBuffer->ulLength )
+	{
+		/* Could never fit. */
+		ulTotal = 0;
+	}
+	else
+	{
+		do
+		{
+			ulReserve = ulPortLoadExclusive( &( pxBuffer->ulReserve ) );
+
+			/* A message is never split: if it does not fit before the end of
+			the storage area the rest of the area is reserved too, as padding,
+			and the message goes at the start. */
+			ulGap = pxBuffer->ulLength - ( ulReserve & ( pxBuffer->ulLength - 1UL ) );
+			ulNeeded = ( ulGap < ulMessageSize ) ? ( ulGap + ulMessageSize ) : ulMessageSize;
+
+			/* ulTail only moves forward, a stale value only underestimates the
+			free space. */
+			if( ulNeeded > ( pxBuffer->ulLength - ( ulReserve - pxBuffer->ulTail ) ) )
+			{
+				vPortClearExclusive();
+				ulTotal = 0;
+				break;
+			}
+
+			ulTotal = ulNeeded;
+		} while( ulPortStoreExclusive( &( pxBuffer->ulReserve ), ulReserve + ulNeeded ) != 0UL );
+	}
+
+	if( ulTotal == 0UL )
+	{
+		do
+		{
+			ulDropped = ulPortLoadExclusive( &( pxBuffer->ulDropped ) );
+		} while( ulPortStoreExclusive( &( pxBuffer->ulDropped ), ulDropped + 1UL ) != 0UL );
+
+		return NULL;
+	}
+
+	if( ulTotal != ulMessageSize )
+	{
+		/* The padding has no content, so it is committed straight away. */
+		pxHeader = prvHeaderAt( pxBuffer, ulReserve );
+		pxHeader->ulLength = ( ulGap - ( uint32_t ) sizeof( MPMessageHeader_t ) ) | mpmbPADDING_BIT;
+		portMEMORY_BARRIER();
+		pxHeader->ulIndex = ulReserve;
+		ulReserve += ulGap;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	pxHeader = prvHeaderAt( pxBuffer, ulReserve );
+	pxHeader->ulLength = ( uint32_t ) xLength;
+	pxHeader->ulIndex = ~ulReserve;
+
+	return ( void * ) ( pxHeader + 1 );
+}
+/*-----------------------------------------------------------*/
+
+void vMPMessageBufferCommit( MPMessageBufferHandle_t xMessageBuffer, void *pvMessage )
+{
+MPMessageBuffer_t * const pxBuffer = ( MPMessageBuffer_t * ) xMessageBuffer;
+MPMessageHeader_t * const pxHeader = ( ( MPMessageHeader_t * ) pvMessage ) - 1;
+
+	configASSERT( pxBuffer );
+	configASSERT( pvMessage );
+
+	/* The message must be complete before the header says so. */
+	portMEMORY_BARRIER();
+	pxHeader->ulIndex = ~( pxHeader->ulIndex );
+
+	/* The reader only registers as waiting in a critical section, after
+	finding the buffer empty, so if it is not registered yet it will see the
+	messages just published. */
+	if( ( prvPublish( pxBuffer ) != pdFALSE ) && ( pxBuffer->xTaskWaitingToReceive != NULL ) )
+	{
+		vTaskSuspendAll();
+		{
+			if( pxBuffer->xTaskWaitingToReceive != NULL )
+			{
+				( void ) xTaskNotify( pxBuffer->xTaskWaitingToReceive, ( uint32_t ) 0, eNoAction );
+				pxBuffer->xTaskWaitingToReceive = NULL;
+			}
+		}
+		( void ) xTaskResumeAll();
+	}
+	else
+	{
+		/* Either nobody waits, or an earlier message is still being written
+		and its writer publishes this one too. */
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vMPMessageBufferCommitFromISR( MPMessageBufferHandle_t xMessageBuffer, void *pvMessage, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+MPMessageBuffer_t * const pxBuffer = ( MPMessageBuffer_t * ) xMessageBuffer;
+MPMessageHeader_t * const pxHeader = ( ( MPMessageHeader_t * ) pvMessage ) - 1;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( pxBuffer );
+	configASSERT( pvMessage );
+
+	portMEMORY_BARRIER();
+	pxHeader->ulIndex = ~( pxHeader->ulIndex );
+
+	if( ( prvPublish( pxBuffer ) != pdFALSE ) && ( pxBuffer->xTaskWaitingToReceive != NULL ) )
+	{
+		uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			if( pxBuffer->xTaskWaitingToReceive != NULL )
+			{
+				( void ) xTaskNotifyFromISR( pxBuffer->xTaskWaitingToReceive, ( uint32_t ) 0, eNoAction, pxHigherPriorityTaskWoken );
+				pxBuffer->xTaskWaitingToReceive = NULL;
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+size_t xMPMessageBufferSend( MPMessageBufferHandle_t xMessageBuffer, const void *pvTxData, size_t xDataLengthBytes )
+{
+void *pvMessage;
+size_t xReturn = 0;
+
+	configASSERT( pvTxData );
+
+	pvMessage = pvMPMessageBufferReserve( xMessageBuffer, xDataLengthBytes );
+
+	if( pvMessage != NULL )
+	{
+		( void ) memcpy( pvMessage, pvTxData, xDataLengthBytes );
+		vMPMessageBufferCommit( xMessageBuffer, pvMessage );
+		xReturn = xDataLengthBytes;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xMPMessageBufferSendFromISR( MPMessageBufferHandle_t xMessageBuffer, const void *pvTxData, size_t xDataLengthBytes, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+void *pvMessage;
+size_t xReturn = 0;
+
+	configASSERT( pvTxData );
+
+	pvMessage = pvMPMessageBufferReserve( xMessageBuffer, xDataLengthBytes );
+
+	if( pvMessage != NULL )
+	{
+		( void ) memcpy( pvMessage, pvTxData, xDataLengthBytes );
+		vMPMessageBufferCommitFromISR( xMessageBuffer, pvMessage, pxHigherPriorityTaskWoken );
+		xReturn = xDataLengthBytes;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xMPMessageBufferPeek( MPMessageBufferHandle_t xMessageBuffer, void **ppvMessage, TickType_t xTicksToWait )
+{
+MPMessageBuffer_t * const pxBuffer = ( MPMessageBuffer_t * ) xMessageBuffer;
+MPMessageHeader_t *pxHeader;
+TimeOut_t xTimeOut;
+BaseType_t xEmpty;
+
+	configASSERT( pxBuffer );
+	configASSERT( ppvMessage );
+
+	/* Not from an interrupt, which must pass 0. */
+	if( xTicksToWait != ( TickType_t ) 0 )
+	{
+		vTaskSetTimeOutState( &xTimeOut );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	for( ;; )
+	{
+		/* Padding in front of the first message is released here, so if the
+		published range held nothing else the buffer is now empty and the
+		message behind the padding, still being written, is waited for. */
+		pxHeader = prvFirstMessage( pxBuffer );
+
+		if( ( pxHeader != NULL ) || ( xTicksToWait == ( TickType_t ) 0 ) )
+		{
+			break;
+		}
+
+		/* Checking for data and registering as the waiting task must be
+		atomic with respect to the writers' wake up, as in
+		xStreamBufferReceive(). */
+		xEmpty = pdFALSE;
+		taskENTER_CRITICAL();
+		{
+			if( pxBuffer->ulHead == pxBuffer->ulTail )
+			{
+				( void ) xTaskNotifyStateClear( NULL );
+
+				/* Should only be one reader. */
+				configASSERT( pxBuffer->xTaskWaitingToReceive == NULL );
+				pxBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+				xEmpty = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( xEmpty != pdFALSE )
+		{
+			( void ) xTaskNotifyWait( ( uint32_t ) 0, UINT32_MAX, NULL, xTicksToWait );
+			pxBuffer->xTaskWaitingToReceive = NULL;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* Once the time is up look for a message one last time. */
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+		{
+			xTicksToWait = ( TickType_t ) 0;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	if( pxHeader != NULL )
+	{
+		*ppvMessage = ( void * ) ( pxHeader + 1 );
+		return ( size_t ) pxHeader->ulLength;
+	}
+	else
+	{
+		*ppvMessage = NULL;
+		return 0;
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vMPMessageBufferConsume( MPMessageBufferHandle_t xMessageBuffer )
+{
+MPMessageBuffer_t * const pxBuffer = ( MPMessageBuffer_t * ) xMessageBuffer;
+MPMessageHeader_t *pxHeader;
+
+	configASSERT( pxBuffer );
+
+	pxHeader = prvFirstMessage( pxBuffer );
+	configASSERT( pxHeader );
+
+	if( pxHeader != NULL )
+	{
+		prvRelease( pxBuffer, pxHeader );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+size_t xMPMessageBufferReceive( MPMessageBufferHandle_t xMessageBuffer, void *pvRxData, size_t xBufferLengthBytes, TickType_t xTicksToWait )
+{
+void *pvMessage;
+size_t xLength;
+
+	configASSERT( pvRxData );
+
+	xLength = xMPMessageBufferPeek( xMessageBuffer, &pvMessage, xTicksToWait );
+
+	if( ( xLength != ( size_t ) 0 ) && ( xLength <= xBufferLengthBytes ) )
+	{
+		( void ) memcpy( pvRxData, pvMessage, xLength );
+		vMPMessageBufferConsume( xMessageBuffer );
+	}
+	else
+	{
+		xLength = 0;
+	}
+
+	return xLength;
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulMPMessageBufferGetDropped( MPMessageBufferHandle_t xMessageBuffer )
+{
+const MPMessageBuffer_t * const pxBuffer = ( MPMessageBuffer_t * ) xMessageBuffer;
+
+	configASSERT( pxBuffer );
+
+	return pxBuffer->ulDropped;
+}
+/*-----------------------------------------------------------*/
+
+static portFORCE_INLINE MPMessageHeader_t *prvHeaderAt( const MPMessageBuffer_t * const pxBuffer, uint32_t ulIndex )
+{
+	return ( MPMessageHeader_t * ) &( pxBuffer->pucBuffer[ ulIndex & ( pxBuffer->ulLength - 1UL ) ] ); /*lint !e9087 !e826 Headers are 8 byte aligned in the storage area. */
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvCompareAndSwap( volatile uint32_t * const pulAddress, uint32_t ulExpected, uint32_t ulNew )
+{
+BaseType_t xReturn = pdFALSE;
+
+	do
+	{
+		if( ulPortLoadExclusive( pulAddress ) != ulExpected )
+		{
+			vPortClearExclusive();
+			break;
+		}
+
+		xReturn = ( ulPortStoreExclusive( pulAddress, ulNew ) == 0UL ) ? pdTRUE : pdFALSE;
+	} while( xReturn == pdFALSE );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvPublish( MPMessageBuffer_t * const pxBuffer )
+{
+uint32_t ulHead, ulNext, ulReserve;
+const MPMessageHeader_t *pxHeader;
+BaseType_t xMoved = pdFALSE;
+
+	for( ;; )
+	{
+		ulHead = pxBuffer->ulHead;
+		ulReserve = pxBuffer->ulReserve;
+		ulNext = ulHead;
+
+		/* Each writer sets its committed mark before it gets here, so of two
+		writers committing at the same time the later one to scan sees both
+		marks. */
+		while( ulNext != ulReserve )
+		{
+			pxHeader = prvHeaderAt( pxBuffer, ulNext );
+
+			if( pxHeader->ulIndex != ulNext )
+			{
+				break;
+			}
+
+			ulNext += ( uint32_t ) mpmbMESSAGE_SIZE( pxHeader->ulLength & ~mpmbPADDING_BIT );
+		}
+
+		if( ulNext == ulHead )
+		{
+			break;
+		}
+
+		if( prvCompareAndSwap( &( pxBuffer->ulHead ), ulHead, ulNext ) != pdFALSE )
+		{
+			xMoved = pdTRUE;
+			break;
+		}
+
+		/* Another writer moved ulHead meanwhile, scan again from there. */
+	}
+
+	return xMoved;
+}
+/*-----------------------------------------------------------*/
+
+static MPMessageHeader_t *prvFirstMessage( MPMessageBuffer_t * const pxBuffer )
+{
+MPMessageHeader_t *pxHeader = NULL;
+const uint32_t ulHead = pxBuffer->ulHead;
+
+	/* The messages below ulHead are complete. */
+	portMEMORY_BARRIER();
+
+	while( pxBuffer->ulTail != ulHead )
+	{
+		pxHeader = prvHeaderAt( pxBuffer, pxBuffer->ulTail );
+
+		if( ( pxHeader->ulLength & mpmbPADDING_BIT ) == 0UL )
+		{
+			break;
+		}
+
+		prvRelease( pxBuffer, pxHeader );
+		pxHeader = NULL;
+	}
+
+	return pxHeader;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRelease( MPMessageBuffer_t * const pxBuffer, const MPMessageHeader_t * const pxHeader )
+{
+const uint32_t ulSize = ( uint32_t ) mpmbMESSAGE_SIZE( pxHeader->ulLength & ~mpmbPADDING_BIT );
+
+	prvScrub( pxBuffer, pxBuffer->ulTail, ulSize );
+
+	/* The reader is done with the space before it is handed back. */
+	portMEMORY_BARRIER();
+	pxBuffer->ulTail += ulSize;
+}
+/*-----------------------------------------------------------*/
+
+static void prvScrub( const MPMessageBuffer_t * const pxBuffer, uint32_t ulIndex, uint32_t ulCount )
+{
+MPMessageHeader_t *pxHeader;
+
+	/* Messages never wrap, so neither do the areas they are freed in. */
+	for( pxHeader = prvHeaderAt( pxBuffer, ulIndex ); ulCount != 0UL; ulCount -= ( uint32_t ) sizeof( MPMessageHeader_t ) )
+	{
+		pxHeader->ulIndex = UINT32_MAX;
+		pxHeader++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewBuffer( MPMessageBuffer_t * const pxBuffer, uint8_t * const pucStorageArea, size_t xBufferSizeBytes )
+{
+	memset( ( void * ) pxBuffer, 0x00, sizeof( MPMessageBuffer_t ) ); /*lint !e9087 memset() requires void *. */
+	pxBuffer->pucBuffer = pucStorageArea;
+	pxBuffer->ulLength = ( uint32_t ) xBufferSizeBytes;
+
+	prvScrub( pxBuffer, 0UL, pxBuffer->ulLength );
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,410 @@
+/*
+ * prog_rtos kernel add-on: periodic tasks, given a period, a WCET budget and a
+ * deadline, with their priorities assigned by the kernel.
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "periodic.h"
+
+/* Lint e961 and e750 are suppressed as a MISRA exception justified because the
+MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
+header files above, but not in this file, in order to generate the correct
+privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750. */
+
+#if( configUSE_PERIODIC_TASKS == 1 )
+	#if( ( INCLUDE_vTaskDelayUntil == 0 ) || ( INCLUDE_vTaskDelete == 0 ) || ( INCLUDE_vTaskPrioritySet == 0 ) )
+		#error INCLUDE_vTaskDelayUntil, INCLUDE_vTaskDelete and INCLUDE_vTaskPrioritySet must be set to 1 to use periodic tasks
+	#endif
+
+	#if( ( INCLUDE_xTaskGetCurrentTaskHandle == 0 ) && ( configUSE_MUTEXES == 0 ) )
+		#error INCLUDE_xTaskGetCurrentTaskHandle must be set to 1 to use periodic tasks
+	#endif
+#endif
+
+#if( configPERIODIC_TASK_LOWEST_PRIORITY > configPERIODIC_TASK_HIGHEST_PRIORITY )
+	#error configPERIODIC_TASK_LOWEST_PRIORITY must not be above configPERIODIC_TASK_HIGHEST_PRIORITY
+#endif
+
+/*
+ * Returns the relative deadline of a task, substituting the period when no
+ * explicit deadline was given.
+ */
+static TickType_t prvGetDeadline( const PeriodicTaskParameters_t * const pxTask ) PRIVILEGED_FUNCTION;
+
+/*
+ * The key by which tasks are ordered when priorities are assigned - the period
+ * for rate monotonic assignment, the deadline for deadline monotonic
+ * assignment.  A smaller key means a higher priority.
+ */
+static TickType_t prvGetPriorityKey( const PeriodicTaskParameters_t * const pxTask ) PRIVILEGED_FUNCTION;
+
+#if( configUSE_PERIODIC_TASKS == 1 )
+
+	/*
+	 * The function run by every task created by xPeriodicTaskCreate().  Calls
+	 * the job function once per period and records deadline misses.
+	 */
+	static void prvPeriodicTask( void *pvParameters ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Returns the index of the periodic task set entry used by xTask, or
+	 * configMAX_PERIODIC_TASKS if xTask is not a periodic task.
+	 */
+	static UBaseType_t prvFindEntry( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+	/* The admitted periodic tasks.  An entry with an xPeriod of zero is
+	unused.  Entries do not move, so the task using an entry can keep a pointer
+	to it. */
+	PRIVILEGED_DATA static PeriodicTaskParameters_t xPeriodicTaskSet[ configMAX_PERIODIC_TASKS ];
+	PRIVILEGED_DATA static TaskHandle_t xPeriodicTaskHandles[ configMAX_PERIODIC_TASKS ];
+	PRIVILEGED_DATA static UBaseType_t uxPeriodicTaskPriorities[ configMAX_PERIODIC_TASKS ];
+	PRIVILEGED_DATA static volatile UBaseType_t uxDeadlineMisses[ configMAX_PERIODIC_TASKS ];
+
+	/* Working space for the admission test.  Only accessed with the scheduler
+	suspended. */
+	PRIVILEGED_DATA static UBaseType_t uxCandidatePriorities[ configMAX_PERIODIC_TASKS ];
+
+#endif /* configUSE_PERIODIC_TASKS */
+
+/*-----------------------------------------------------------*/
+
+static TickType_t prvGetDeadline( const PeriodicTaskParameters_t * const pxTask )
+{
+TickType_t xDeadline = pxTask->xDeadline;
+
+	if( xDeadline == ( TickType_t ) 0 )
+	{
+		xDeadline = pxTask->xPeriod;
+	}
+
+	return xDeadline;
+}
+/*-----------------------------------------------------------*/
+
+static TickType_t prvGetPriorityKey( const PeriodicTaskParameters_t * const pxTask )
+{
+	#if( configPERIODIC_TASK_PRIORITY_POLICY == periodicDEADLINE_MONOTONIC )
+	{
+		return prvGetDeadline( pxTask );
+	}
+	#else
+	{
+		return pxTask->xPeriod;
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPeriodicTaskSetAnalyse( const PeriodicTaskParameters_t * const pxTaskSet, const UBaseType_t uxNumberOfEntries, UBaseType_t * const puxPriorities, TickType_t * const pxResponseTimes )
+{
+UBaseType_t x, y, uxRank;
+TickType_t xKey, xDeadline, xResponseTime, xWorkload;
+BaseType_t xReturn = pdPASS;
+const UBaseType_t uxBandSize = ( UBaseType_t ) ( configPERIODIC_TASK_HIGHEST_PRIORITY - configPERIODIC_TASK_LOWEST_PRIORITY );
+
+	configASSERT( pxTaskSet );
+	configASSERT( puxPriorities );
+
+	/* Assign priorities.  The rank of a task is the number of tasks that
+	precede it in the chosen order, ties being broken by position in the array
+	so every task gets a distinct rank.  Ranks beyond the priority band share
+	the lowest priority of the band. */
+	for( x = 0; x < uxNumberOfEntries; x++ )
+	{
+		if( pxTaskSet[ x ].xPeriod == ( TickType_t ) 0 )
+		{
+			continue;
+		}
+
+		xKey = prvGetPriorityKey( &( pxTaskSet[ x ] ) );
+		uxRank = 0;
+
+		for( y = 0; y < uxNumberOfEntries; y++ )
+		{
+			if( ( y != x ) && ( pxTaskSet[ y ].xPeriod != ( TickType_t ) 0 ) )
+			{
+				if( ( prvGetPriorityKey( &( pxTaskSet[ y ] ) ) < xKey ) ||
+					( ( prvGetPriorityKey( &( pxTaskSet[ y ] ) ) == xKey ) && ( y < x ) ) )
+				{
+					uxRank++;
+				}
+			}
+		}
+
+		if( uxRank > uxBandSize )
+		{
+			uxRank = uxBandSize;
+		}
+
+		puxPriorities[ x ] = ( UBaseType_t ) configPERIODIC_TASK_HIGHEST_PRIORITY - uxRank;
+	}
+
+	/* Compute the worst case response time of each task as the least fixed
+	point of R = C(i) + sum over interfering tasks j of ceil( R / T(j) ) * C(j),
+	failing the task as soon as R exceeds its deadline. */
+	for( x = 0; x < uxNumberOfEntries; x++ )
+	{
+		if( pxTaskSet[ x ].xPeriod == ( TickType_t ) 0 )
+		{
+			continue;
+		}
+
+		xDeadline = prvGetDeadline( &( pxTaskSet[ x ] ) );
+		xResponseTime = pxTaskSet[ x ].xWCET;
+
+		while( xResponseTime <= xDeadline )
+		{
+			xWorkload = pxTaskSet[ x ].xWCET;
+
+			for( y = 0; y < uxNumberOfEntries; y++ )
+			{
+				if( ( y != x ) && ( pxTaskSet[ y ].xPeriod != ( TickType_t ) 0 ) && ( puxPriorities[ y ] >= puxPriorities[ x ] ) )
+				{
+					xWorkload += ( ( xResponseTime + pxTaskSet[ y ].xPeriod - ( TickType_t ) 1 ) / pxTaskSet[ y ].xPeriod ) * pxTaskSet[ y ].xWCET;
+				}
+			}
+
+			if( xWorkload == xResponseTime )
+			{
+				break;
+			}
+
+			xResponseTime = xWorkload;
+		}
+
+		if( xResponseTime > xDeadline )
+		{
+			xResponseTime = portMAX_DELAY;
+			xReturn = pdFAIL;
+		}
+
+		if( pxResponseTimes != NULL )
+		{
+			pxResponseTimes[ x ] = xResponseTime;
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_PERIODIC_TASKS == 1 )
+
+	BaseType_t xPeriodicTaskCreate( const PeriodicTaskParameters_t * const pxParameters, TaskHandle_t * const pxCreatedTask )
+	{
+	UBaseType_t x, uxEntry;
+	TaskHandle_t xCreatedTask = NULL;
+	BaseType_t xReturn;
+
+		configASSERT( pxParameters );
+		configASSERT( pxParameters->pxJobCode );
+		configASSERT( pxParameters->xPeriod > ( TickType_t ) 0 );
+		configASSERT( pxParameters->xWCET > ( TickType_t ) 0 );
+		configASSERT( pxParameters->xDeadline <= pxParameters->xPeriod );
+
+		vTaskSuspendAll();
+		{
+			for( uxEntry = 0; uxEntry < ( UBaseType_t ) configMAX_PERIODIC_TASKS; uxEntry++ )
+			{
+				if( xPeriodicTaskSet[ uxEntry ].xPeriod == ( TickType_t ) 0 )
+				{
+					break;
+				}
+			}
+
+			if( uxEntry == ( UBaseType_t ) configMAX_PERIODIC_TASKS )
+			{
+				xReturn = errPERIODIC_TASK_SET_FULL;
+			}
+			else
+			{
+				/* Tentatively add the task to the set and test the result. */
+				xPeriodicTaskSet[ uxEntry ] = *pxParameters;
+
+				if( xPeriodicTaskSetAnalyse( xPeriodicTaskSet, ( UBaseType_t ) configMAX_PERIODIC_TASKS, uxCandidatePriorities, NULL ) == pdFAIL )
+				{
+					xReturn = errPERIODIC_TASK_NOT_SCHEDULABLE;
+				}
+				else
+				{
+					uxDeadlineMisses[ uxEntry ] = 0;
+					xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+
+					#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+					{
+						if( ( pxParameters->puxStackBuffer != NULL ) && ( pxParameters->pxTaskBuffer != NULL ) )
+						{
+							xCreatedTask = xTaskCreateStatic( prvPeriodicTask, pxParameters->pcName, ( uint32_t ) pxParameters->usStackDepth, ( void * ) &( xPeriodicTaskSet[ uxEntry ] ), uxCandidatePriorities[ uxEntry ], pxParameters->puxStackBuffer, pxParameters->pxTaskBuffer );
+
+							if( xCreatedTask != NULL )
+							{
+								xReturn = pdPASS;
+							}
+						}
+					}
+					#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+					#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+					{
+						if( xReturn != pdPASS )
+						{
+							xReturn = xTaskCreate( prvPeriodicTask, pxParameters->pcName, pxParameters->usStackDepth, ( void * ) &( xPeriodicTaskSet[ uxEntry ] ), uxCandidatePriorities[ uxEntry ], &xCreatedTask );
+						}
+					}
+					#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+				}
+
+				if( xReturn == pdPASS )
+				{
+					xPeriodicTaskHandles[ uxEntry ] = xCreatedTask;
+					uxPeriodicTaskPriorities[ uxEntry ] = uxCandidatePriorities[ uxEntry ];
+
+					/* Move the existing tasks to their new priorities. */
+					for( x = 0; x < ( UBaseType_t ) configMAX_PERIODIC_TASKS; x++ )
+					{
+						if( ( x != uxEntry ) && ( xPeriodicTaskSet[ x ].xPeriod != ( TickType_t ) 0 ) && ( uxPeriodicTaskPriorities[ x ] != uxCandidatePriorities[ x ] ) )
+						{
+							vTaskPrioritySet( xPeriodicTaskHandles[ x ], uxCandidatePriorities[ x ] );
+							uxPeriodicTaskPriorities[ x ] = uxCandidatePriorities[ x ];
+						}
+					}
+				}
+				else
+				{
+					/* Leave the set as it was. */
+					xPeriodicTaskSet[ uxEntry ].xPeriod = ( TickType_t ) 0;
+				}
+			}
+		}
+		( void ) xTaskResumeAll();
+
+		if( pxCreatedTask != NULL )
+		{
+			*pxCreatedTask = xCreatedTask;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_PERIODIC_TASKS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_PERIODIC_TASKS == 1 )
+
+	void vPeriodicTaskDelete( TaskHandle_t xTask )
+	{
+	UBaseType_t uxEntry;
+
+		if( xTask == NULL )
+		{
+			xTask = xTaskGetCurrentTaskHandle();
+		}
+
+		uxEntry = prvFindEntry( xTask );
+		configASSERT( uxEntry < ( UBaseType_t ) configMAX_PERIODIC_TASKS );
+		( void ) uxEntry;
+
+		/* vTaskDelete() releases the entry. */
+		vTaskDelete( xTask );
+	}
+
+#endif /* configUSE_PERIODIC_TASKS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_PERIODIC_TASKS == 1 )
+
+	void vPeriodicTaskRemoveEntry( TaskHandle_t xTask )
+	{
+	UBaseType_t uxEntry;
+
+		uxEntry = prvFindEntry( xTask );
+
+		if( uxEntry < ( UBaseType_t ) configMAX_PERIODIC_TASKS )
+		{
+			xPeriodicTaskHandles[ uxEntry ] = NULL;
+			xPeriodicTaskSet[ uxEntry ].xPeriod = ( TickType_t ) 0;
+		}
+	}
+
+#endif /* configUSE_PERIODIC_TASKS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_PERIODIC_TASKS == 1 )
+
+	UBaseType_t uxPeriodicTaskGetDeadlineMisses( TaskHandle_t xTask )
+	{
+	UBaseType_t uxEntry, uxReturn = 0;
+
+		uxEntry = prvFindEntry( xTask );
+
+		if( uxEntry < ( UBaseType_t ) configMAX_PERIODIC_TASKS )
+		{
+			uxReturn = uxDeadlineMisses[ uxEntry ];
+		}
+
+		return uxReturn;
+	}
+
+#endif /* configUSE_PERIODIC_TASKS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_PERIODIC_TASKS == 1 )
+
+	static UBaseType_t prvFindEntry( TaskHandle_t xTask )
+	{
+	UBaseType_t uxEntry;
+
+		for( uxEntry = 0; uxEntry < ( UBaseType_t ) configMAX_PERIODIC_TASKS; uxEntry++ )
+		{
+			if( ( xPeriodicTaskSet[ uxEntry ].xPeriod != ( TickType_t ) 0 ) && ( xPeriodicTaskHandles[ uxEntry ] == xTask ) )
+			{
+				break;
+			}
+		}
+
+		return uxEntry;
+	}
+
+#endif /* configUSE_PERIODIC_TASKS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_PERIODIC_TASKS == 1 )
+
+	static void prvPeriodicTask( void *pvParameters )
+	{
+	const PeriodicTaskParameters_t * const pxTask = ( const PeriodicTaskParameters_t * ) pvParameters;
+	const UBaseType_t uxEntry = ( UBaseType_t ) ( pxTask - xPeriodicTaskSet );
+	const TickType_t xDeadline = prvGetDeadline( pxTask );
+	TickType_t xReleaseTime;
+
+		xReleaseTime = xTaskGetTickCount();
+
+		for( ;; )
+		{
+			pxTask->pxJobCode( pxTask->pvParameters );
+
+			if( ( xTaskGetTickCount() - xReleaseTime ) > xDeadline )
+			{
+				uxDeadlineMisses[ uxEntry ]++;
+				tracePERIODIC_TASK_DEADLINE_MISSED( pxTask );
+			}
+
+			vTaskDelayUntil( &xReleaseTime, pxTask->xPeriod );
+		}
+	}
+
+#endif /* configUSE_PERIODIC_TASKS */
+
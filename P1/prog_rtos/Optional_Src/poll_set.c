@@ -0,0 +1,363 @@
+/*
+ * prog_rtos kernel add-on: poll sets, one task waiting on many queues and
+ * stream or message buffers.
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+/* Standard includes. */
+#include <stdint.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "poll_set.h"
+
+/* Remove the whole file if poll sets are not being used. */
+#if( configUSE_POLL_SETS == 1 )
+
+#if( configUSE_TASK_NOTIFICATIONS != 1 )
+	#error configUSE_TASK_NOTIFICATIONS must be set to 1 to build poll_set.c
+#endif
+
+/* Lint e961 and e750 are suppressed as a MISRA exception justified because the
+MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
+header files above, but not in this file, in order to generate the correct
+privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750. */
+
+/*-----------------------------------------------------------*/
+
+typedef struct xPOLL_SET
+{
+	volatile uint32_t ulReady;			/* Bits set since the waiting task last collected them. */
+	uint32_t ulMembers;					/* Bits claimed by members. */
+	volatile TaskHandle_t xTaskWaiting;	/* The task blocked in ulPollSetWait(), or NULL. */
+	uint8_t ucStaticallyAllocated;
+
+	#if ( configUSE_CO_ROUTINES == 1 )
+		CoRoutineHandle_t xCoRoutine;	/* The co-routine notified of new bits, or NULL. */
+	#endif
+} PollSet_t;
+
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	PollSetHandle_t xPollSetCreate( void )
+	{
+	PollSet_t *pxPollSet;
+
+		pxPollSet = ( PollSet_t * ) pvPortMalloc( sizeof( PollSet_t ) ); /*lint !e9079 malloc() only returns void*. */
+
+		if( pxPollSet != NULL )
+		{
+			memset( ( void * ) pxPollSet, 0x00, sizeof( PollSet_t ) ); /*lint !e9087 memset() requires void *. */
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return ( PollSetHandle_t ) pxPollSet;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+PollSetHandle_t xPollSetCreateStatic( StaticPollSet_t * const pxStaticPollSet )
+{
+PollSet_t * const pxPollSet = ( PollSet_t * ) pxStaticPollSet; /*lint !e740 !e9087 Safe cast as StaticPollSet_t is opaque PollSet_t. */
+
+	configASSERT( pxStaticPollSet );
+
+	#if( configASSERT_DEFINED == 1 )
+	{
+		/* Sanity check that the size of the structure used to declare a
+		variable of type StaticPollSet_t equals the size of the real
+		structure. */
+		volatile size_t xSize = sizeof( StaticPollSet_t );
+		configASSERT( xSize == sizeof( PollSet_t ) );
+	}
+	#endif /* configASSERT_DEFINED */
+
+	memset( ( void * ) pxPollSet, 0x00, sizeof( PollSet_t ) ); /*lint !e9087 memset() requires void *. */
+	pxPollSet->ucStaticallyAllocated = ( uint8_t ) pdTRUE;
+
+	return ( PollSetHandle_t ) pxPollSet;
+}
+/*-----------------------------------------------------------*/
+
+void vPollSetDelete( PollSetHandle_t xPollSet )
+{
+PollSet_t * const pxPollSet = ( PollSet_t * ) xPollSet;
+
+	configASSERT( pxPollSet );
+	configASSERT( pxPollSet->ulMembers == 0UL );
+	configASSERT( pxPollSet->xTaskWaiting == NULL );
+
+	if( pxPollSet->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+	{
+		#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+		{
+			vPortFree( ( void * ) pxPollSet );
+		}
+		#else
+		{
+			/* Should not be possible to get here, ucStaticallyAllocated must
+			be true if dynamic allocation is not supported. */
+			configASSERT( xPollSet == ( PollSetHandle_t ) ~0 );
+		}
+		#endif
+	}
+	else
+	{
+		/* Scrub the structure so future use will assert. */
+		memset( pxPollSet, 0x00, sizeof( PollSet_t ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPollSetAddBit( PollSetHandle_t xPollSet, UBaseType_t uxBit )
+{
+PollSet_t * const pxPollSet = ( PollSet_t * ) xPollSet;
+const uint32_t ulBit = 1UL << uxBit;
+BaseType_t xReturn;
+
+	configASSERT( pxPollSet );
+	configASSERT( uxBit < pollsetMAX_MEMBERS );
+
+	taskENTER_CRITICAL();
+	{
+		if( ( pxPollSet->ulMembers & ulBit ) == 0UL )
+		{
+			pxPollSet->ulMembers |= ulBit;
+			xReturn = pdPASS;
+		}
+		else
+		{
+			xReturn = pdFAIL;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPollSetRemoveBit( PollSetHandle_t xPollSet, UBaseType_t uxBit )
+{
+PollSet_t * const pxPollSet = ( PollSet_t * ) xPollSet;
+const uint32_t ulBit = 1UL << uxBit;
+
+	configASSERT( pxPollSet );
+	configASSERT( uxBit < pollsetMAX_MEMBERS );
+
+	taskENTER_CRITICAL();
+	{
+		pxPollSet->ulMembers &= ~ulBit;
+		pxPollSet->ulReady &= ~ulBit;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vPollSetSignal( PollSetHandle_t xPollSet, uint32_t ulBits )
+{
+PollSet_t * const pxPollSet = ( PollSet_t * ) xPollSet;
+
+	configASSERT( pxPollSet );
+	configASSERT( ( ulBits & ~( pxPollSet->ulMembers ) ) == 0UL );
+
+	/* Nothing to do if the bits are set already: the waiting task has not
+	collected them yet, and when it does it will find the data that came with
+	this signal too.  This is the path of every send but the first to a member
+	that is not being drained. */
+	if( ( pxPollSet->ulReady & ulBits ) != ulBits )
+	{
+		taskENTER_CRITICAL();
+		{
+			pxPollSet->ulReady |= ulBits;
+
+			if( pxPollSet->xTaskWaiting != NULL )
+			{
+				( void ) xTaskNotifyIndexed( pxPollSet->xTaskWaiting, configPOLL_SET_NOTIFICATION_INDEX, ( uint32_t ) 0, eNoAction );
+				pxPollSet->xTaskWaiting = NULL;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			#if ( configUSE_CO_ROUTINES == 1 )
+			{
+				if( pxPollSet->xCoRoutine != NULL )
+				{
+					( void ) xCoRoutineNotify( pxPollSet->xCoRoutine, ulBits );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif
+		}
+		taskEXIT_CRITICAL();
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPollSetSignalFromISR( PollSetHandle_t xPollSet, uint32_t ulBits, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+PollSet_t * const pxPollSet = ( PollSet_t * ) xPollSet;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( pxPollSet );
+	configASSERT( ( ulBits & ~( pxPollSet->ulMembers ) ) == 0UL );
+
+	if( ( pxPollSet->ulReady & ulBits ) != ulBits )
+	{
+		uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			pxPollSet->ulReady |= ulBits;
+
+			if( pxPollSet->xTaskWaiting != NULL )
+			{
+				( void ) xTaskNotifyIndexedFromISR( pxPollSet->xTaskWaiting, configPOLL_SET_NOTIFICATION_INDEX, ( uint32_t ) 0, eNoAction, pxHigherPriorityTaskWoken );
+				pxPollSet->xTaskWaiting = NULL;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			#if ( configUSE_CO_ROUTINES == 1 )
+			{
+				if( pxPollSet->xCoRoutine != NULL )
+				{
+					( void ) xCoRoutineNotifyFromISR( pxPollSet->xCoRoutine, ulBits, pxHigherPriorityTaskWoken );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulPollSetWait( PollSetHandle_t xPollSet, TickType_t xTicksToWait )
+{
+PollSet_t * const pxPollSet = ( PollSet_t * ) xPollSet;
+uint32_t ulReady;
+BaseType_t xBlock;
+TimeOut_t xTimeOut;
+
+	configASSERT( pxPollSet );
+
+	vTaskSetTimeOutState( &xTimeOut );
+
+	for( ;; )
+	{
+		xBlock = pdFALSE;
+
+		/* Collecting the bits and registering as the waiting task must be
+		atomic with respect to the signals, as in xStreamBufferReceive(). */
+		taskENTER_CRITICAL();
+		{
+			ulReady = pxPollSet->ulReady;
+			pxPollSet->ulReady = 0UL;
+
+			if( ( ulReady == 0UL ) && ( xTicksToWait != ( TickType_t ) 0 ) )
+			{
+				( void ) xTaskNotifyStateClearIndexed( NULL, configPOLL_SET_NOTIFICATION_INDEX );
+
+				/* Should only be one waiting task. */
+				configASSERT( pxPollSet->xTaskWaiting == NULL );
+				pxPollSet->xTaskWaiting = xTaskGetCurrentTaskHandle();
+				xBlock = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( xBlock == pdFALSE )
+		{
+			break;
+		}
+
+		/* The set is signalled with eNoAction, so the value of the
+		notification is left alone for other users of the index. */
+		( void ) xTaskNotifyWaitIndexed( configPOLL_SET_NOTIFICATION_INDEX, ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+		pxPollSet->xTaskWaiting = NULL;
+
+		/* The notification is not necessarily from the set, so look again,
+		for the time that is left.  Once the time is up xTicksToWait is 0 and
+		the last look does not block. */
+		( void ) xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait );
+	}
+
+	return ulReady;
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulPollSetGetReady( PollSetHandle_t xPollSet )
+{
+const PollSet_t * const pxPollSet = ( PollSet_t * ) xPollSet;
+
+	configASSERT( pxPollSet );
+
+	return pxPollSet->ulReady;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_CO_ROUTINES == 1 )
+
+	void vPollSetBindCoRoutine( PollSetHandle_t xPollSet, CoRoutineHandle_t xCoRoutine )
+	{
+	PollSet_t * const pxPollSet = ( PollSet_t * ) xPollSet;
+
+		configASSERT( pxPollSet );
+
+		taskENTER_CRITICAL();
+		{
+			pxPollSet->xCoRoutine = xCoRoutine;
+
+			/* Bits set before the binding were not notified. */
+			if( ( xCoRoutine != NULL ) && ( pxPollSet->ulReady != 0UL ) )
+			{
+				( void ) xCoRoutineNotify( xCoRoutine, pxPollSet->ulReady );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_CO_ROUTINES */
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_POLL_SETS */
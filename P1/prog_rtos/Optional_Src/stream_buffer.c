@@ -39,6 +39,10 @@ task.h is included from an application file. */
 #include "task.h"
 #include "stream_buffer.h"
 
+#if( configUSE_POLL_SETS == 1 )
+	#include "poll_set.h"
+#endif
+
 #if( configUSE_TASK_NOTIFICATIONS != 1 )
 	#error configUSE_TASK_NOTIFICATIONS must be set to 1 to build stream_buffer.c
 #endif
@@ -128,6 +132,25 @@ that uses task notifications. */
 #endif /* sbSEND_COMPLETE_FROM_ISR */
 /*lint -restore (9026) */
 
+/* Sets the bit of a stream buffer that has reached its trigger level in the
+poll set the buffer is a member of, if any.  Done whatever the notification
+macros above are defined as. */
+#if( configUSE_POLL_SETS == 1 )
+	#define sbSIGNAL_POLL_SET( pxStreamBuffer )												\
+		if( ( pxStreamBuffer )->pvPollSet != NULL )										\
+		{																				\
+			vPollSetSignal( ( pxStreamBuffer )->pvPollSet, 1UL << ( pxStreamBuffer )->uxPollBit );	\
+		}
+	#define sbSIGNAL_POLL_SET_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken )			\
+		if( ( pxStreamBuffer )->pvPollSet != NULL )										\
+		{																				\
+			vPollSetSignalFromISR( ( pxStreamBuffer )->pvPollSet, 1UL << ( pxStreamBuffer )->uxPollBit, ( pxHigherPriorityTaskWoken ) );	\
+		}
+#else
+	#define sbSIGNAL_POLL_SET( pxStreamBuffer )
+	#define sbSIGNAL_POLL_SET_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken )
+#endif
+
 /* The number of bytes used to hold the length of a message in the buffer. */
 #define sbBYTES_TO_STORE_MESSAGE_LENGTH ( sizeof( size_t ) )
 
@@ -152,6 +175,11 @@ typedef struct xSTREAM_BUFFER /*lint !e9058 Style convention uses tag. */
 	#if ( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t uxStreamBufferNumber;		/* Used for tracing purposes. */
 	#endif
+
+	#if ( configUSE_POLL_SETS == 1 )
+		void *pvPollSet;					/* The poll set the buffer is a member of, or NULL. */
+		UBaseType_t uxPollBit;				/* The bit of the buffer in its poll set. */
+	#endif
 } StreamBuffer_t;
 
 /*
@@ -212,6 +240,33 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 										  size_t xTriggerLevelBytes,
 										  BaseType_t xIsMessageBuffer ) PRIVILEGED_FUNCTION;
 
+/*
+ * Describes the xCount bytes of the storage area that start at index xStart,
+ * which are split in two regions if they run past the end of the storage area.
+ */
+static void prvGetRegions( const StreamBuffer_t * const pxStreamBuffer,
+						   size_t xStart,
+						   size_t xCount,
+						   StreamBufferRegions_t * const pxRegions ) PRIVILEGED_FUNCTION;
+
+/*
+ * The length of the next message in a message buffer, read in place, or 0 if
+ * the message buffer is empty.
+ */
+static size_t prvNextMessageLength( const StreamBuffer_t * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Removes xBytesToConsume bytes, or the next message, from the front of the
+ * buffer without copying them.  Returns the number of bytes of data removed.
+ */
+static size_t prvConsume( StreamBuffer_t * const pxStreamBuffer, size_t xBytesToConsume ) PRIVILEGED_FUNCTION;
+
+/*
+ * Adds the xBytesToCommit bytes already written in place after the head to the
+ * data in the buffer.  Returns the number of bytes added.
+ */
+static size_t prvCommit( StreamBuffer_t * const pxStreamBuffer, size_t xBytesToCommit ) PRIVILEGED_FUNCTION;
+
 /*-----------------------------------------------------------*/
 
 #if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
@@ -340,6 +395,19 @@ StreamBuffer_t * pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9
 
 	traceSTREAM_BUFFER_DELETE( xStreamBuffer );
 
+	#if( configUSE_POLL_SETS == 1 )
+	{
+		if( pxStreamBuffer->pvPollSet != NULL )
+		{
+			( void ) xPollSetRemoveStreamBuffer( pxStreamBuffer->pvPollSet, xStreamBuffer );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
+
 	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) pdFALSE )
 	{
 		#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
@@ -373,6 +441,10 @@ BaseType_t xReturn = pdFAIL, xIsMessageBuffer;
 #if( configUSE_TRACE_FACILITY == 1 )
 	UBaseType_t uxStreamBufferNumber;
 #endif
+#if( configUSE_POLL_SETS == 1 )
+	void *pvPollSet;
+	UBaseType_t uxPollBit;
+#endif
 
 	configASSERT( pxStreamBuffer );
 
@@ -384,6 +456,14 @@ BaseType_t xReturn = pdFAIL, xIsMessageBuffer;
 	}
 	#endif
 
+	#if( configUSE_POLL_SETS == 1 )
+	{
+		/* Likewise the poll set membership. */
+		pvPollSet = pxStreamBuffer->pvPollSet;
+		uxPollBit = pxStreamBuffer->uxPollBit;
+	}
+	#endif
+
 	/* Can only reset a message buffer if there are no tasks blocked on it. */
 	if( pxStreamBuffer->xTaskWaitingToReceive == NULL )
 	{
@@ -411,6 +491,13 @@ BaseType_t xReturn = pdFAIL, xIsMessageBuffer;
 			}
 			#endif
 
+			#if( configUSE_POLL_SETS == 1 )
+			{
+				pxStreamBuffer->pvPollSet = pvPollSet;
+				pxStreamBuffer->uxPollBit = uxPollBit;
+			}
+			#endif
+
 			traceSTREAM_BUFFER_RESET( xStreamBuffer );
 		}
 	}
@@ -569,6 +656,7 @@ TimeOut_t xTimeOut;
 		if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
 		{
 			sbSEND_COMPLETED( pxStreamBuffer );
+			sbSIGNAL_POLL_SET( pxStreamBuffer );
 		}
 		else
 		{
@@ -619,6 +707,7 @@ size_t xRequiredSpace = xDataLengthBytes;
 		if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
 		{
 			sbSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+			sbSIGNAL_POLL_SET_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
 		}
 		else
 		{
@@ -899,6 +988,192 @@ size_t xOriginalTail, xReceivedLength, xNextMessageLength;
 }
 /*-----------------------------------------------------------*/
 
+size_t xStreamBufferGetReadRegions( StreamBufferHandle_t xStreamBuffer, StreamBufferRegions_t * const pxRegions )
+{
+const StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9087 !e9079 Safe cast as StreamBufferHandle_t is opaque Streambuffer_t. */
+size_t xBytesAvailable;
+
+	configASSERT( pxStreamBuffer );
+	configASSERT( pxRegions );
+
+	/* The data of a message buffer is interleaved with the message lengths,
+	xStreamBufferPeekMessage() is used for message buffers instead. */
+	configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 );
+
+	/* The head is only read once, bytes the writer adds after this point are
+	simply not included in the regions. */
+	xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+	prvGetRegions( pxStreamBuffer, pxStreamBuffer->xTail, xBytesAvailable, pxRegions );
+
+	return xBytesAvailable;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferPeekMessage( StreamBufferHandle_t xStreamBuffer, StreamBufferRegions_t * const pxRegions )
+{
+const StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9087 !e9079 Safe cast as StreamBufferHandle_t is opaque Streambuffer_t. */
+size_t xMessageLength, xStart;
+
+	configASSERT( pxStreamBuffer );
+	configASSERT( pxRegions );
+	configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 );
+
+	xMessageLength = prvNextMessageLength( pxStreamBuffer );
+
+	/* The message itself follows its length. */
+	xStart = pxStreamBuffer->xTail + sbBYTES_TO_STORE_MESSAGE_LENGTH;
+	if( xStart >= pxStreamBuffer->xLength )
+	{
+		xStart -= pxStreamBuffer->xLength;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	prvGetRegions( pxStreamBuffer, xStart, xMessageLength, pxRegions );
+
+	return xMessageLength;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferConsume( StreamBufferHandle_t xStreamBuffer, size_t xBytesToConsume )
+{
+StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9087 !e9079 Safe cast as StreamBufferHandle_t is opaque Streambuffer_t. */
+size_t xConsumed;
+
+	configASSERT( pxStreamBuffer );
+
+	xConsumed = prvConsume( pxStreamBuffer, xBytesToConsume );
+
+	/* Was a task waiting for space in the buffer? */
+	if( xConsumed != ( size_t ) 0 )
+	{
+		traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xConsumed );
+		sbRECEIVE_COMPLETED( pxStreamBuffer );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xConsumed;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferConsumeFromISR( StreamBufferHandle_t xStreamBuffer,
+									size_t xBytesToConsume,
+									BaseType_t * const pxHigherPriorityTaskWoken )
+{
+StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9087 !e9079 Safe cast as StreamBufferHandle_t is opaque Streambuffer_t. */
+size_t xConsumed;
+
+	configASSERT( pxStreamBuffer );
+
+	xConsumed = prvConsume( pxStreamBuffer, xBytesToConsume );
+
+	if( xConsumed != ( size_t ) 0 )
+	{
+		sbRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xConsumed );
+
+	return xConsumed;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferGetWriteRegions( StreamBufferHandle_t xStreamBuffer, StreamBufferRegions_t * const pxRegions )
+{
+const StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9087 !e9079 Safe cast as StreamBufferHandle_t is opaque Streambuffer_t. */
+size_t xSpace;
+
+	configASSERT( pxStreamBuffer );
+	configASSERT( pxRegions );
+
+	/* A message has to be written with its length in front of it in one go,
+	so only stream buffers can be written in place. */
+	configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 );
+
+	xSpace = xStreamBufferSpacesAvailable( xStreamBuffer );
+	prvGetRegions( pxStreamBuffer, pxStreamBuffer->xHead, xSpace, pxRegions );
+
+	return xSpace;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferCommit( StreamBufferHandle_t xStreamBuffer, size_t xBytesToCommit )
+{
+StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9087 !e9079 Safe cast as StreamBufferHandle_t is opaque Streambuffer_t. */
+size_t xReturn;
+
+	configASSERT( pxStreamBuffer );
+
+	xReturn = prvCommit( pxStreamBuffer, xBytesToCommit );
+
+	if( xReturn > ( size_t ) 0 )
+	{
+		traceSTREAM_BUFFER_SEND( xStreamBuffer, xReturn );
+
+		/* Was a task waiting for the data? */
+		if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+		{
+			sbSEND_COMPLETED( pxStreamBuffer );
+			sbSIGNAL_POLL_SET( pxStreamBuffer );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferCommitFromISR( StreamBufferHandle_t xStreamBuffer,
+								   size_t xBytesToCommit,
+								   BaseType_t * const pxHigherPriorityTaskWoken )
+{
+StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9087 !e9079 Safe cast as StreamBufferHandle_t is opaque Streambuffer_t. */
+size_t xReturn;
+
+	configASSERT( pxStreamBuffer );
+
+	xReturn = prvCommit( pxStreamBuffer, xBytesToCommit );
+
+	if( xReturn > ( size_t ) 0 )
+	{
+		/* Was a task waiting for the data? */
+		if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+		{
+			sbSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+			sbSIGNAL_POLL_SET_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xReturn );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
 BaseType_t xStreamBufferIsEmpty( StreamBufferHandle_t xStreamBuffer )
 {
 const StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9087 !e9079 Safe cast as StreamBufferHandle_t is opaque Streambuffer_t. */
@@ -1118,6 +1393,142 @@ size_t xCount, xFirstLength, xNextTail;
 }
 /*-----------------------------------------------------------*/
 
+static void prvGetRegions( const StreamBuffer_t * const pxStreamBuffer,
+						   size_t xStart,
+						   size_t xCount,
+						   StreamBufferRegions_t * const pxRegions )
+{
+size_t xFirstLength;
+
+	configASSERT( xStart < pxStreamBuffer->xLength );
+	configASSERT( xCount < pxStreamBuffer->xLength );
+
+	/* As in prvReadBytesFromBuffer(), the bytes up to the end of the storage
+	area come first, the rest from its start. */
+	xFirstLength = configMIN( pxStreamBuffer->xLength - xStart, xCount );
+
+	pxRegions->pucFirst = &( pxStreamBuffer->pucBuffer[ xStart ] );
+	pxRegions->xFirstLength = xFirstLength;
+
+	if( xCount > xFirstLength )
+	{
+		pxRegions->pucSecond = pxStreamBuffer->pucBuffer;
+		pxRegions->xSecondLength = xCount - xFirstLength;
+	}
+	else
+	{
+		pxRegions->pucSecond = NULL;
+		pxRegions->xSecondLength = 0;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvNextMessageLength( const StreamBuffer_t * const pxStreamBuffer )
+{
+StreamBufferRegions_t xLengthRegions;
+size_t xMessageLength;
+
+	if( prvBytesInBuffer( pxStreamBuffer ) > sbBYTES_TO_STORE_MESSAGE_LENGTH )
+	{
+		/* The length itself may be split by the end of the storage area.  The
+		tail is not moved to read it, so the writer never sees the space as
+		free. */
+		prvGetRegions( pxStreamBuffer, pxStreamBuffer->xTail, sbBYTES_TO_STORE_MESSAGE_LENGTH, &xLengthRegions );
+		( void ) memcpy( ( void * ) &xMessageLength, ( const void * ) xLengthRegions.pucFirst, xLengthRegions.xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+
+		if( xLengthRegions.xSecondLength != ( size_t ) 0 )
+		{
+			( void ) memcpy( ( void * ) ( ( ( uint8_t * ) &xMessageLength ) + xLengthRegions.xFirstLength ), ( const void * ) xLengthRegions.pucSecond, xLengthRegions.xSecondLength ); /*lint !e9087 memcpy() requires void *. */
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		xMessageLength = 0;
+	}
+
+	return xMessageLength;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvConsume( StreamBuffer_t * const pxStreamBuffer, size_t xBytesToConsume )
+{
+size_t xConsumed, xRemoved, xNextTail;
+
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+	{
+		/* A message is removed whole, with its length, and only once it has
+		been peeked. */
+		xConsumed = prvNextMessageLength( pxStreamBuffer );
+		configASSERT( xBytesToConsume == xConsumed );
+		xRemoved = ( xConsumed != ( size_t ) 0 ) ? ( xConsumed + sbBYTES_TO_STORE_MESSAGE_LENGTH ) : ( size_t ) 0;
+	}
+	else
+	{
+		xConsumed = configMIN( xBytesToConsume, prvBytesInBuffer( pxStreamBuffer ) );
+		xRemoved = xConsumed;
+	}
+
+	if( xRemoved != ( size_t ) 0 )
+	{
+		xNextTail = pxStreamBuffer->xTail + xRemoved;
+
+		if( xNextTail >= pxStreamBuffer->xLength )
+		{
+			xNextTail -= pxStreamBuffer->xLength;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxStreamBuffer->xTail = xNextTail;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xConsumed;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvCommit( StreamBuffer_t * const pxStreamBuffer, size_t xBytesToCommit )
+{
+size_t xNextHead;
+
+	configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 );
+
+	/* Only the bytes that were free can have been written. */
+	configASSERT( xBytesToCommit <= xStreamBufferSpacesAvailable( pxStreamBuffer ) );
+
+	if( xBytesToCommit != ( size_t ) 0 )
+	{
+		xNextHead = pxStreamBuffer->xHead + xBytesToCommit;
+
+		if( xNextHead >= pxStreamBuffer->xLength )
+		{
+			xNextHead -= pxStreamBuffer->xLength;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxStreamBuffer->xHead = xNextHead;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xBytesToCommit;
+}
+/*-----------------------------------------------------------*/
+
 static size_t prvBytesInBuffer( const StreamBuffer_t * const pxStreamBuffer )
 {
 /* Returns the distance between xTail and xHead. */
@@ -1197,3 +1608,82 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 
 #endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
+
+#if ( configUSE_POLL_SETS == 1 )
+
+	BaseType_t xPollSetAddStreamBuffer( PollSetHandle_t xPollSet, StreamBufferHandle_t xStreamBuffer, UBaseType_t uxBit )
+	{
+	StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9087 !e9079 Safe cast as StreamBufferHandle_t is opaque Streambuffer_t. */
+	BaseType_t xReturn = pdFAIL;
+
+		configASSERT( pxStreamBuffer );
+
+		taskENTER_CRITICAL();
+		{
+			if( pxStreamBuffer->pvPollSet == NULL )
+			{
+				if( xPollSetAddBit( xPollSet, uxBit ) != pdFAIL )
+				{
+					pxStreamBuffer->pvPollSet = xPollSet;
+					pxStreamBuffer->uxPollBit = uxBit;
+
+					/* The data already in the buffer arrived before the
+					buffer was a member, so did not set its bit. */
+					if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+					{
+						vPollSetSignal( xPollSet, 1UL << uxBit );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					xReturn = pdPASS;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_POLL_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_POLL_SETS == 1 )
+
+	BaseType_t xPollSetRemoveStreamBuffer( PollSetHandle_t xPollSet, StreamBufferHandle_t xStreamBuffer )
+	{
+	StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer; /*lint !e9087 !e9079 Safe cast as StreamBufferHandle_t is opaque Streambuffer_t. */
+	BaseType_t xReturn = pdFAIL;
+
+		configASSERT( pxStreamBuffer );
+
+		taskENTER_CRITICAL();
+		{
+			if( pxStreamBuffer->pvPollSet == xPollSet )
+			{
+				vPollSetRemoveBit( xPollSet, pxStreamBuffer->uxPollBit );
+				pxStreamBuffer->pvPollSet = NULL;
+				xReturn = pdPASS;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_POLL_SETS */
+/*-----------------------------------------------------------*/
@@ -36,12 +36,22 @@ osThreadId LEDThread1Handle, LEDThread2Handle,
 			PrintThreadHandle;
 			
 osSemaphoreId semaphore;                      				    // Semaphore ID
-osSemaphoreDef(semaphore);                      			    // Semaphore definition
+osSemaphoreStaticAllocDef(semaphore);           			    // Semaphore definition and control block
 
 uint32_t TIME_VECTOR [8] = {0,0,0,0,0,0,0,0};					//Time vector for the execution of 8 periodic tasks
-uint8_t * num[8];												//Pointer vector used as a arguments of thread functions
+uint8_t num[8] = {1, 2, 3, 4, 5, 6, 7, 8};						//Thread numbers, passed by address as arguments of thread functions
+const uint16_t LED_MASK [8] = {LED10_PIN, LED9_PIN, LED3_PIN, LED4_PIN,	//Led of each thread, as a BSP_LED_ToggleMask() mask
+							   LED5_PIN, LED6_PIN, LED7_PIN, LED8_PIN};
 uint32_t TIME;													//Reference time
 uint8_t sync_value;												//Synchronization variable
+#ifdef STACK_REPORT_BUILD
+TaskStatus_t STACK_STATUS [12];									//Task states for the stack report (8 LED, print, idle, timer + 1 spare)
+char STACK_REPORT [12 * 50];									//Stack report text, about 50 bytes per task
+#endif
+#ifdef SNAPSHOT_BUILD
+TaskSnapshotBuffer_t SNAPSHOTS;									//Task states of the last two rounds
+uint8_t SNAPSHOT_RECORD [taskSNAPSHOT_EXPORT_SIZE(configMAX_SNAPSHOT_TASKS)];	//Last snapshot in binary, for snapshot_report.sh
+#endif
 
 /* Private function prototypes -----------------------------------------------*/
 static void LED_Thread(void const *argument);					
@@ -85,47 +95,48 @@ int main(void)
   SystemClock_Config();
 
   /* Initialize LEDs */
-  BSP_LED_Init(LED3);
-  BSP_LED_Init(LED4);
-  BSP_LED_Init(LED5);
-  BSP_LED_Init(LED6);
-  BSP_LED_Init(LED7);
-  BSP_LED_Init(LED8);
-  BSP_LED_Init(LED9);
-  BSP_LED_Init(LED10);
+  BSP_LED_InitMask(LEDS_ALL_PINS);
 
-  //Periodic Threads with same priority
-  osThreadDef(LED10, LED_Thread, osPriorityNormal , 0, configMINIMAL_STACK_SIZE); 
-  osThreadDef(LED9, LED_Thread, osPriorityNormal, 0, configMINIMAL_STACK_SIZE);
-  osThreadDef(LED3, LED_Thread, osPriorityNormal , 0, configMINIMAL_STACK_SIZE);
-  osThreadDef(LED4, LED_Thread, osPriorityNormal , 0, configMINIMAL_STACK_SIZE);
-  osThreadDef(LED5, LED_Thread, osPriorityNormal, 0, configMINIMAL_STACK_SIZE);
-  osThreadDef(LED6, LED_Thread, osPriorityNormal, 0, configMINIMAL_STACK_SIZE);
-  osThreadDef(LED7, LED_Thread, osPriorityNormal, 0, configMINIMAL_STACK_SIZE);
-  osThreadDef(LED8, LED_Thread, osPriorityNormal, 0, configMINIMAL_STACK_SIZE);
+  //Periodic Threads with same priority; stacks and control blocks are static,
+  //so creating the threads does not touch the heap
+  osThreadStaticAllocDef(LED10, LED_Thread, osPriorityNormal , 1, configMINIMAL_STACK_SIZE); 
+  osThreadStaticAllocDef(LED9, LED_Thread, osPriorityNormal, 1, configMINIMAL_STACK_SIZE);
+  osThreadStaticAllocDef(LED3, LED_Thread, osPriorityNormal , 1, configMINIMAL_STACK_SIZE);
+  osThreadStaticAllocDef(LED4, LED_Thread, osPriorityNormal , 1, configMINIMAL_STACK_SIZE);
+  osThreadStaticAllocDef(LED5, LED_Thread, osPriorityNormal, 1, configMINIMAL_STACK_SIZE);
+  osThreadStaticAllocDef(LED6, LED_Thread, osPriorityNormal, 1, configMINIMAL_STACK_SIZE);
+  osThreadStaticAllocDef(LED7, LED_Thread, osPriorityNormal, 1, configMINIMAL_STACK_SIZE);
+  osThreadStaticAllocDef(LED8, LED_Thread, osPriorityNormal, 1, configMINIMAL_STACK_SIZE);
   //Print Thread
-  osThreadDef(print_task, Print_result, osPriorityNormal, 0, configMINIMAL_STACK_SIZE); 
+  osThreadStaticAllocDef(print_task, Print_result, osPriorityNormal, 1, configMINIMAL_STACK_SIZE); 
 
-  //enumeration used as input argument of osThreadCreate functions
-  uint8_t k = 0;
-  for(k=0;k<8;k++){
-	  num[k] = (uint8_t *) pvPortMalloc(sizeof(uint8_t));
-	  *num[k] = k+1;
-  }
   //Synchronization variable initialization
   sync_value = 0;
   
   //Periodic Threads
-  LEDThread1Handle = osThreadCreate(osThread(LED10), (void*) num[0]);
-  LEDThread2Handle = osThreadCreate(osThread(LED9),  (void*) num[1]);
-  LEDThread3Handle = osThreadCreate(osThread(LED3),  (void*) num[2]);
-  LEDThread4Handle = osThreadCreate(osThread(LED4),  (void*) num[3]);
-  LEDThread5Handle = osThreadCreate(osThread(LED5),  (void*) num[4]);
-  LEDThread6Handle = osThreadCreate(osThread(LED6),  (void*) num[5]);
-  LEDThread7Handle = osThreadCreate(osThread(LED7),  (void*) num[6]);
-  LEDThread8Handle = osThreadCreate(osThread(LED8),  (void*) num[7]);
+  LEDThread1Handle = osThreadCreate(osThread(LED10), (void*) &num[0]);
+  LEDThread2Handle = osThreadCreate(osThread(LED9),  (void*) &num[1]);
+  LEDThread3Handle = osThreadCreate(osThread(LED3),  (void*) &num[2]);
+  LEDThread4Handle = osThreadCreate(osThread(LED4),  (void*) &num[3]);
+  LEDThread5Handle = osThreadCreate(osThread(LED5),  (void*) &num[4]);
+  LEDThread6Handle = osThreadCreate(osThread(LED6),  (void*) &num[5]);
+  LEDThread7Handle = osThreadCreate(osThread(LED7),  (void*) &num[6]);
+  LEDThread8Handle = osThreadCreate(osThread(LED8),  (void*) &num[7]);
   //Print Thread
   PrintThreadHandle = osThreadCreate(osThread(print_task), NULL);
+  
+#if ( configUSE_TRACE_GPIO == 1 )
+  //GPIO probes: thread k shows as k on the LED pins, the print thread as 9
+  vTaskSetTaskNumber(LEDThread1Handle, 1);
+  vTaskSetTaskNumber(LEDThread2Handle, 2);
+  vTaskSetTaskNumber(LEDThread3Handle, 3);
+  vTaskSetTaskNumber(LEDThread4Handle, 4);
+  vTaskSetTaskNumber(LEDThread5Handle, 5);
+  vTaskSetTaskNumber(LEDThread6Handle, 6);
+  vTaskSetTaskNumber(LEDThread7Handle, 7);
+  vTaskSetTaskNumber(LEDThread8Handle, 8);
+  vTaskSetTaskNumber(PrintThreadHandle, 9);
+#endif
  
   //Reference time
   TIME = osKernelSysTick();
@@ -143,25 +154,19 @@ int main(void)
 
 static void LED_Thread(void const *argument)
 {
-  uint8_t led = *((int*) argument);
+  uint8_t led = *((uint8_t*) argument);
   uint8_t i = 0;
+  //A different led lights up depending on the thread
+  uint32_t mask = (led >= 1 && led <= 8) ? LED_MASK[led-1] : LED4_PIN;
   for(;;){
 	  
 	  for (i=0; i<10 ;i++)
 	  {
-		//A different led lights up depending on the thread
-		switch(led){
-			case 1: BSP_LED_Toggle(LED10); break;
-			case 2: BSP_LED_Toggle(LED9); break;
-			case 3: BSP_LED_Toggle(LED3); break;
-			case 4: BSP_LED_Toggle(LED4); break;
-			case 5: BSP_LED_Toggle(LED5); break;
-			case 6: BSP_LED_Toggle(LED6); break;
-			case 7: BSP_LED_Toggle(LED7); break;
-			case 8: BSP_LED_Toggle(LED8); break;
-			
-			default: BSP_LED_Toggle(LED4); break;
-		}
+#if ( configUSE_TRACE_GPIO == 0 )						//Otherwise the LED pins are the trace probes
+		BSP_LED_ToggleMask(mask);						//One BSRR store
+#else
+		(void) mask;
+#endif
 		ActiveWait(20);
 	  }
 	
@@ -181,7 +186,6 @@ static void LED_Thread(void const *argument)
 static void Print_result(void const *argument){	
 	uint8_t i = 0;
 	uint8_t k = 0;
-	uint8_t j = 0;
 	uint8_t num_ex = 200;							//Number of times periodic threads run
 	uint32_t AVG_VECTOR [8] = {0,0,0,0,0,0,0,0}; 	//Average Time Vector
 	uint32_t WCET_VECTOR [8] = {0,0,0,0,0,0,0,0}; 	//WCET Time Vector
@@ -218,19 +222,31 @@ static void Print_result(void const *argument){
 			}
 			
 			k++;
+#ifdef SNAPSHOT_BUILD
+			//Cheap health telemetry every round: task states without the stack scan
+			xTaskTakeSnapshot(&SNAPSHOTS, pdFALSE);
+#endif
+			
 			//After num_ex execution
 			if(k == num_ex){
-				//Memory is freed
-				for(j=0;j<8;j++){
-					vPortFree(num[j]);
-				}	
-				
 				//Print of results
 				for(i=0;i<8;i++){
 					printf("Thread: %d, priority:%d average time: %ld WCET: %ld",i+1,Vett_priority[i], AVG_VECTOR[i]/num_ex,WCET_VECTOR[i]);
 					printf("\n");
 				}
 				
+#ifdef STACK_REPORT_BUILD
+				//Stack usage of every task: size, most used and least free in words
+				vTaskListStackUsage(STACK_REPORT, STACK_STATUS, uxTaskGetSystemState(STACK_STATUS, 12, NULL));
+				printf("Task\t\tStack\tUsed\tFree\tUse\n%s", STACK_REPORT);
+#endif
+				
+#ifdef SNAPSHOT_BUILD
+				//Final snapshot with the stacks, exported for the host ("dump binary value snapshot.bin SNAPSHOT_RECORD" in gdb)
+				xTaskTakeSnapshot(&SNAPSHOTS, pdTRUE);
+				printf("Snapshot record: %u bytes\n", (unsigned int)xTaskExportSnapshot(&SNAPSHOTS.xSnapshots[SNAPSHOTS.ulSequence & 1U], SNAPSHOT_RECORD, sizeof(SNAPSHOT_RECORD)));
+#endif
+				
 				//The thread is terminated before to resume the others 
 				osThreadSuspend(NULL);
 			}
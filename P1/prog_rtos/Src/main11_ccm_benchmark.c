@@ -0,0 +1,238 @@
+/**
+  ******************************************************************************
+  * @file    FreeRTOS/FreeRTOS_ThreadCreation/Src/main.c
+  * @author  MCD Application Team
+  * @brief   Main program body
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2016 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "cmsis_os.h"
+#include <stdio.h>
+
+//Cycle cost of a context switch and of the tick interrupt, measured with the DWT cycle counter.
+//Build once with configUSE_CCM_HOT_PATHS set to 0 and once with it set to 1 in FreeRTOSConfig.h
+//to compare the kernel running from flash (2 wait states at 72 MHz) with the kernel in CCM RAM.
+//It is also the training run of the profile guided perf build ("make perf PGO=generate"):
+//the profile is written to the host through semihosting once the results are printed.
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define NUM_YIELDS			10000		//Yields done by each of the two switching threads
+#define NUM_TICKS			1000		//Tick interrupts sampled
+#define IRQ_GAP_CYCLES		40			//A gap between two counter reads above this is an interrupt
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+TaskHandle_t SwitchThread1Handle, SwitchThread2Handle, TickThreadHandle;
+
+volatile uint32_t switch_cycles;								//Cycles taken by 2*NUM_YIELDS context switches
+uint32_t tick_min, tick_max, tick_total, tick_count;			//Tick interrupt cost statistics
+
+/* Private function prototypes -----------------------------------------------*/
+static void Switch_Thread(void *argument);
+static void Tick_Thread(void *argument);
+static BaseType_t Create_Thread(TaskFunction_t code, const char *name, UBaseType_t priority, TaskHandle_t *handle);
+void SystemClock_Config(void);
+
+/* Prototype for semihosting -------------------------------------------------*/
+extern void initialise_monitor_handles(void);
+
+#ifdef PERF_PROFILE_GENERATE
+/* Prototype for the profile dump of -fprofile-generate ----------------------*/
+extern void __gcov_dump(void);
+#endif
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Main program
+  * @param  None
+  * @retval None
+  */
+int main(void)
+{
+  /*---------------------------Initialization---------------------------------*/
+
+  //Inizialization for semihosting
+  initialise_monitor_handles();
+
+  printf("*************freeRTOS CCM benchmark**************\n\n");
+
+  /* STM32F3xx HAL library initialization */
+  HAL_Init();
+
+  /* Configure the System clock to 72 MHz */
+  SystemClock_Config();
+
+  //The cycle counter is started by the kernel only when task budgets are used
+  portCONFIGURE_CYCLE_COUNTER();
+
+  //Tick thread runs first, at the highest priority, then the two switching threads
+  Create_Thread(Tick_Thread, "tick", tskIDLE_PRIORITY + 2, &TickThreadHandle);
+  Create_Thread(Switch_Thread, "switch1", tskIDLE_PRIORITY + 1, &SwitchThread1Handle);
+  Create_Thread(Switch_Thread, "switch2", tskIDLE_PRIORITY + 1, &SwitchThread2Handle);
+
+  /* Start scheduler */
+  vTaskStartScheduler();
+
+  /* We should never get here as control is now taken by the scheduler */
+  for (;;);
+
+}
+
+static BaseType_t Create_Thread(TaskFunction_t code, const char *name, UBaseType_t priority, TaskHandle_t *handle)
+{
+#if (configUSE_CCM_TASK_ALLOCATION == 1)
+  //Stacks and TCBs of the measured threads in CCM RAM
+  return xTaskCreateCCM(code, name, configMINIMAL_STACK_SIZE * 2, NULL, priority, handle);
+#else
+  return xTaskCreate(code, name, configMINIMAL_STACK_SIZE * 2, NULL, priority, handle);
+#endif
+}
+
+static void Tick_Thread(void *argument)
+{
+  uint32_t previous, now, gap;
+
+  //The HAL time base interrupt is stopped so only the kernel tick is sampled
+  HAL_SuspendTick();
+
+  tick_min = 0xFFFFFFFF;
+  tick_max = 0;
+  tick_total = 0;
+  tick_count = 0;
+
+  //Spin reading the cycle counter: every long gap between two reads is the tick interrupt
+  previous = portGET_CYCLE_COUNTER();
+  while (tick_count < NUM_TICKS)
+  {
+	now = portGET_CYCLE_COUNTER();
+	gap = now - previous;
+	previous = now;
+
+	if (gap > IRQ_GAP_CYCLES)
+	{
+		tick_total += gap;
+		tick_count++;
+		if (gap < tick_min) tick_min = gap;
+		if (gap > tick_max) tick_max = gap;
+	}
+  }
+
+  HAL_ResumeTick();
+
+  //The switching threads can run now
+  vTaskSuspend(NULL);
+}
+
+static void Switch_Thread(void *argument)
+{
+  uint32_t i, start;
+
+  //Both threads have the same priority, so each yield switches to the other one
+  start = portGET_CYCLE_COUNTER();
+  for (i = 0; i < NUM_YIELDS; i++)
+  {
+	taskYIELD();
+  }
+
+  if (xTaskGetCurrentTaskHandle() == SwitchThread1Handle)
+  {
+	switch_cycles = portGET_CYCLE_COUNTER() - start;
+
+	printf("CCM hot paths: %d, CCM stacks and TCBs: %d\n", configUSE_CCM_HOT_PATHS, configUSE_CCM_TASK_ALLOCATION);
+	printf("Context switch (yield to yield): %lu cycles\n", switch_cycles / (2 * NUM_YIELDS));
+	printf("Tick interrupt: min %lu avg %lu max %lu cycles\n", tick_min, tick_total / tick_count, tick_max);
+
+#ifdef PERF_PROFILE_GENERATE
+	//The scheduler never returns, so the profile is not written at exit
+	__gcov_dump();
+	printf("Profile written\n");
+#endif
+  }
+
+  vTaskSuspend(NULL);
+}
+
+/**
+  * @brief  System Clock Configuration
+  *         The system Clock is configured as follow : 
+  *            System Clock source            = PLL (HSE)
+  *            SYSCLK(Hz)                     = 72000000
+  *            HCLK(Hz)                       = 72000000
+  *            AHB Prescaler                  = 1
+  *            APB1 Prescaler                 = 2
+  *            APB2 Prescaler                 = 1
+  *            HSE Frequency(Hz)              = 8000000
+  *            HSE PREDIV                     = 1
+  *            PLLMUL                         = RCC_PLL_MUL9 (9)
+  *            Flash Latency(WS)              = 2
+  * @param  None
+  * @retval None
+  */
+void SystemClock_Config(void)
+{
+  RCC_ClkInitTypeDef RCC_ClkInitStruct;
+  RCC_OscInitTypeDef RCC_OscInitStruct;
+  
+  /* Enable HSE Oscillator and activate PLL with HSE as source */
+  RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSE;
+  RCC_OscInitStruct.HSEState = RCC_HSE_ON;
+  RCC_OscInitStruct.HSEPredivValue = RCC_HSE_PREDIV_DIV1;
+  RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
+  RCC_OscInitStruct.PLL.PLLSource = RCC_PLLSOURCE_HSE;
+  RCC_OscInitStruct.PLL.PLLMUL = RCC_PLL_MUL9;
+  if (HAL_RCC_OscConfig(&RCC_OscInitStruct)!= HAL_OK)
+  {
+    /* Initialization Error */
+    while(1); 
+  }
+
+  /* Select PLL as system clock source and configure the HCLK, PCLK1 and PCLK2 
+     clocks dividers */
+  RCC_ClkInitStruct.ClockType = (RCC_CLOCKTYPE_SYSCLK | RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2);
+  RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
+  RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
+  RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV2;  
+  RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV1;
+  if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_2)!= HAL_OK)
+  {
+    /* Initialization Error */
+    while(1); 
+  }
+}
+
+#ifdef  USE_FULL_ASSERT
+
+/**
+  * @brief  Reports the name of the source file and the source line number
+  *   where the assert_param error has occurred.
+  * @param  file: pointer to the source file name
+  * @param  line: assert_param error line source number
+  * @retval None
+  */
+void assert_failed(uint8_t *file, uint32_t line)
+{
+  /* User can add his own implementation to report the file name and line number,
+     ex: printf("Wrong parameters value: file %s on line %d\r\n", file, line) */
+
+  /* Infinite loop */
+  while (1)
+  {}
+}
+#endif
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,382 @@
+/**
+  ******************************************************************************
+  * @file    FreeRTOS/FreeRTOS_ThreadCreation/Src/main.c
+  * @author  MCD Application Team
+  * @brief   Main program body
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2016 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "cmsis_os.h"
+#include "semphr.h"
+#include "stream_buffer.h"
+#include <stdio.h>
+
+//Interrupt latency and jitter, measured with the DWT cycle counter.
+//TIM2 runs at the core clock (APB1 timer clock = 72 MHz) and fires a compare interrupt at
+//irregular intervals while a background thread keeps the kernel busy. The handler reads
+//how far the counter is past the compare value: that is the interrupt entry latency.
+//Each interrupt then wakes one of three threads in turn, through a semaphore, a direct
+//task notification or a stream buffer, and the thread measures the time from the
+//compare match to its first instruction after the wake up.
+//Set configUSE_INTERRUPT_MASK_TIMING to 1 in FreeRTOSConfig.h to also get the longest
+//time the kernel kept interrupts masked in a critical section, the main contributor to
+//the worst case entry latency of interrupts at or below configMAX_SYSCALL_INTERRUPT_PRIORITY.
+
+/* Private define ------------------------------------------------------------*/
+#define NUM_SAMPLES			3000		//Samples taken for each wake up mechanism
+#define IRQ_PERIOD			20000		//Cycles between two interrupts, plus a pseudo random jitter
+#define IRQ_JITTER_MASK		0x0FFF		//Up to 4095 cycles of jitter, so the interrupts hit every part of the load
+#define IRQ_PRIORITY		(configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY)	//Highest priority allowed to call the kernel
+#define HIST_WIDTH			16			//Cycles per histogram bucket
+#define HIST_BUCKETS		64
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct {
+  const char *name;
+  uint32_t min, max, count;
+  uint64_t total;
+  uint32_t hist[HIST_BUCKETS + 1];								//Last bucket: HIST_BUCKETS * HIST_WIDTH cycles and above
+} Latency_t;
+
+enum { LAT_ENTRY, LAT_SEMAPHORE, LAT_NOTIFY, LAT_STREAM, LAT_NUM };
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+TaskHandle_t SemThreadHandle, NotifyThreadHandle, StreamThreadHandle, LoadThreadHandle, ReportThreadHandle;
+SemaphoreHandle_t semaphore;
+StreamBufferHandle_t stream;
+
+Latency_t latency[LAT_NUM] = {
+  { "IRQ entry" }, { "ISR -> semaphore" }, { "ISR -> notification" }, { "ISR -> stream buffer" }
+};
+volatile uint32_t match_cycles[LAT_NUM];						//Cycle counter at the compare match that woke each thread
+volatile uint32_t irq_count;
+uint32_t jitter_seed = 1;
+
+/* Private function prototypes -----------------------------------------------*/
+static void Sem_Thread(void *argument);
+static void Notify_Thread(void *argument);
+static void Stream_Thread(void *argument);
+static void Load_Thread(void *argument);
+static void Report_Thread(void *argument);
+static void Latency_Record(Latency_t *lat, uint32_t cycles);
+static void Latency_Print(const Latency_t *lat);
+static void Timer_Start(void);
+void TIM2_IRQHandler(void);
+void SystemClock_Config(void);
+
+/* Prototype for semihosting -------------------------------------------------*/
+extern void initialise_monitor_handles(void);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Main program
+  * @param  None
+  * @retval None
+  */
+int main(void)
+{
+  /*---------------------------Initialization---------------------------------*/
+
+  //Inizialization for semihosting
+  initialise_monitor_handles();
+
+  printf("*************freeRTOS latency benchmark**************\n\n");
+
+  /* STM32F3xx HAL library initialization */
+  HAL_Init();
+
+  /* Configure the System clock to 72 MHz */
+  SystemClock_Config();
+
+  portCONFIGURE_CYCLE_COUNTER();
+
+  semaphore = xSemaphoreCreateBinary();
+  stream = xStreamBufferCreate(8 * sizeof(uint32_t), sizeof(uint32_t));
+
+  //The woken threads preempt everything else, the report thread only polls,
+  //the load thread takes all the time left
+  xTaskCreate(Sem_Thread, "sem", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 3, &SemThreadHandle);
+  xTaskCreate(Notify_Thread, "notify", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 3, &NotifyThreadHandle);
+  xTaskCreate(Stream_Thread, "stream", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 3, &StreamThreadHandle);
+  xTaskCreate(Report_Thread, "report", configMINIMAL_STACK_SIZE * 2, NULL, tskIDLE_PRIORITY + 2, &ReportThreadHandle);
+  xTaskCreate(Load_Thread, "load", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, &LoadThreadHandle);
+
+  /* Start scheduler */
+  vTaskStartScheduler();
+
+  /* We should never get here as control is now taken by the scheduler */
+  for (;;);
+
+}
+
+/**
+  * @brief  TIM2 compare interrupt: entry latency, then wakes one of the threads.
+  * @param  None
+  * @retval None
+  */
+void TIM2_IRQHandler(void)
+{
+  uint32_t late, now, which;
+  BaseType_t woken = pdFALSE;
+
+  //Timer ticks are core cycles: how far the counter is past the compare value is the
+  //time since the interrupt was requested (plus the few cycles of this read)
+  late = TIM2->CNT - TIM2->CCR1;
+  now = portGET_CYCLE_COUNTER();
+  TIM2->SR = (uint32_t) ~TIM_SR_CC1IF;
+
+  Latency_Record(&latency[LAT_ENTRY], late);
+
+  //Next interrupt, with a pseudo random jitter (LCG)
+  jitter_seed = jitter_seed * 1664525UL + 1013904223UL;
+  TIM2->CCR1 += IRQ_PERIOD + ((jitter_seed >> 16) & IRQ_JITTER_MASK);
+
+  which = LAT_SEMAPHORE + (irq_count % 3);
+  match_cycles[which] = now - late;
+  switch (which) {
+	case LAT_SEMAPHORE:
+	  xSemaphoreGiveFromISR(semaphore, &woken);
+	  break;
+	case LAT_NOTIFY:
+	  vTaskNotifyGiveFromISR(NotifyThreadHandle, &woken);
+	  break;
+	default:
+	  //The match time travels with the data
+	  xStreamBufferSendFromISR(stream, (const void *) &match_cycles[LAT_STREAM], sizeof(uint32_t), &woken);
+	  break;
+  }
+
+  if (++irq_count == 3 * NUM_SAMPLES)
+	TIM2->DIER = 0;
+
+  portYIELD_FROM_ISR(woken);
+}
+
+static void Sem_Thread(void *argument)
+{
+  for (;;) {
+	xSemaphoreTake(semaphore, portMAX_DELAY);
+	Latency_Record(&latency[LAT_SEMAPHORE], portGET_CYCLE_COUNTER() - match_cycles[LAT_SEMAPHORE]);
+  }
+}
+
+static void Notify_Thread(void *argument)
+{
+  for (;;) {
+	ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+	Latency_Record(&latency[LAT_NOTIFY], portGET_CYCLE_COUNTER() - match_cycles[LAT_NOTIFY]);
+  }
+}
+
+static void Stream_Thread(void *argument)
+{
+  uint32_t match;
+
+  for (;;) {
+	xStreamBufferReceive(stream, &match, sizeof(match), portMAX_DELAY);
+	Latency_Record(&latency[LAT_STREAM], portGET_CYCLE_COUNTER() - match);
+  }
+}
+
+static void Load_Thread(void *argument)
+{
+  QueueHandle_t queue = xQueueCreate(4, sizeof(uint32_t));
+  uint32_t i = 0, item;
+
+  //Typical kernel traffic: queue operations, scheduler suspension and yields,
+  //each with its own critical sections
+  for (;;) {
+	xQueueSend(queue, &i, 0);
+	xQueueReceive(queue, &item, 0);
+	vTaskSuspendAll();
+	i += xTaskGetTickCount();
+	xTaskResumeAll();
+	taskYIELD();
+  }
+}
+
+static void Report_Thread(void *argument)
+{
+  uint32_t i;
+#if (configUSE_INTERRUPT_MASK_TIMING == 1)
+  PortInterruptMaskStats_t mask;
+
+  //Forget the windows opened during the start up
+  vPortGetInterruptMaskStats(&mask, pdTRUE);
+#endif
+
+  //The HAL time base interrupt is stopped so only the measured interrupt is taken
+  HAL_SuspendTick();
+  Timer_Start();
+
+  while (irq_count < 3 * NUM_SAMPLES)
+	vTaskDelay(10);
+  vTaskDelay(10);
+
+  HAL_ResumeTick();
+
+  printf("Latency in cycles at %lu Hz, %d samples per wake up mechanism\n", SystemCoreClock, NUM_SAMPLES);
+  for (i = 0; i < LAT_NUM; i++)
+	Latency_Print(&latency[i]);
+
+#if (configUSE_INTERRUPT_MASK_TIMING == 1)
+  vPortGetInterruptMaskStats(&mask, pdFALSE);
+  printf("Interrupt masking: %lu windows avg %lu max %lu cycles, longest opened at 0x%08lx\n",
+		 mask.ulCount, mask.ulCount ? (uint32_t) (mask.ullTotalCycles / mask.ulCount) : 0UL,
+		 mask.ulMaxCycles, (uint32_t) mask.pvMaxCaller);
+#else
+  printf("Interrupt masking: set configUSE_INTERRUPT_MASK_TIMING to 1 to measure it\n");
+#endif
+
+  vTaskSuspend(LoadThreadHandle);
+  vTaskSuspend(NULL);
+}
+
+/**
+  * @brief  TIM2 free running at the core clock, compare 1 interrupt enabled.
+  * @param  None
+  * @retval None
+  */
+static void Timer_Start(void)
+{
+  __HAL_RCC_TIM2_CLK_ENABLE();
+
+  TIM2->PSC = 0;
+  TIM2->ARR = 0xFFFFFFFF;
+  TIM2->EGR = TIM_EGR_UG;										//Load the prescaler
+  TIM2->SR = 0;
+  TIM2->CCR1 = IRQ_PERIOD;
+  TIM2->DIER = TIM_DIER_CC1IE;
+
+  HAL_NVIC_SetPriority(TIM2_IRQn, IRQ_PRIORITY, 0);
+  HAL_NVIC_EnableIRQ(TIM2_IRQn);
+
+  TIM2->CR1 = TIM_CR1_CEN;
+}
+
+static void Latency_Record(Latency_t *lat, uint32_t cycles)
+{
+  uint32_t bucket = cycles / HIST_WIDTH;
+
+  if (lat->count == 0 || cycles < lat->min) lat->min = cycles;
+  if (cycles > lat->max) lat->max = cycles;
+  lat->total += cycles;
+  lat->count++;
+  lat->hist[bucket < HIST_BUCKETS ? bucket : HIST_BUCKETS]++;
+}
+
+static void Latency_Print(const Latency_t *lat)
+{
+  uint32_t i, sum = 0, p99 = lat->max;
+  uint32_t rank = (lat->count * 99 + 99) / 100;					//Samples at or below the 99th percentile
+
+  if (lat->count == 0) {
+	printf("%-22s no samples\n", lat->name);
+	return;
+  }
+
+  //Upper edge of the bucket holding the 99th percentile, the maximum if it is in the last one
+  for (i = 0; i < HIST_BUCKETS; i++) {
+	sum += lat->hist[i];
+	if (sum >= rank) {
+	  p99 = (i + 1) * HIST_WIDTH - 1;
+	  if (p99 > lat->max) p99 = lat->max;
+	  break;
+	}
+  }
+
+  printf("%-22s min %lu avg %lu p99 %lu max %lu\n", lat->name, lat->min,
+		 (uint32_t) (lat->total / lat->count), p99, lat->max);
+  for (i = 0; i <= HIST_BUCKETS; i++) {
+	if (lat->hist[i] == 0) continue;
+	if (i < HIST_BUCKETS)
+	  printf("  %4lu-%4lu: %lu\n", i * HIST_WIDTH, (i + 1) * HIST_WIDTH - 1, lat->hist[i]);
+	else
+	  printf("  %4lu-    : %lu\n", i * HIST_WIDTH, lat->hist[i]);
+  }
+}
+
+/**
+  * @brief  System Clock Configuration
+  *         The system Clock is configured as follow : 
+  *            System Clock source            = PLL (HSE)
+  *            SYSCLK(Hz)                     = 72000000
+  *            HCLK(Hz)                       = 72000000
+  *            AHB Prescaler                  = 1
+  *            APB1 Prescaler                 = 2
+  *            APB2 Prescaler                 = 1
+  *            HSE Frequency(Hz)              = 8000000
+  *            HSE PREDIV                     = 1
+  *            PLLMUL                         = RCC_PLL_MUL9 (9)
+  *            Flash Latency(WS)              = 2
+  * @param  None
+  * @retval None
+  */
+void SystemClock_Config(void)
+{
+  RCC_ClkInitTypeDef RCC_ClkInitStruct;
+  RCC_OscInitTypeDef RCC_OscInitStruct;
+  
+  /* Enable HSE Oscillator and activate PLL with HSE as source */
+  RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSE;
+  RCC_OscInitStruct.HSEState = RCC_HSE_ON;
+  RCC_OscInitStruct.HSEPredivValue = RCC_HSE_PREDIV_DIV1;
+  RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
+  RCC_OscInitStruct.PLL.PLLSource = RCC_PLLSOURCE_HSE;
+  RCC_OscInitStruct.PLL.PLLMUL = RCC_PLL_MUL9;
+  if (HAL_RCC_OscConfig(&RCC_OscInitStruct)!= HAL_OK)
+  {
+    /* Initialization Error */
+    while(1); 
+  }
+
+  /* Select PLL as system clock source and configure the HCLK, PCLK1 and PCLK2 
+     clocks dividers */
+  RCC_ClkInitStruct.ClockType = (RCC_CLOCKTYPE_SYSCLK | RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2);
+  RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
+  RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
+  RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV2;  
+  RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV1;
+  if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_2)!= HAL_OK)
+  {
+    /* Initialization Error */
+    while(1); 
+  }
+}
+
+#ifdef  USE_FULL_ASSERT
+
+/**
+  * @brief  Reports the name of the source file and the source line number
+  *   where the assert_param error has occurred.
+  * @param  file: pointer to the source file name
+  * @param  line: assert_param error line source number
+  * @retval None
+  */
+void assert_failed(uint8_t *file, uint32_t line)
+{
+  /* User can add his own implementation to report the file name and line number,
+     ex: printf("Wrong parameters value: file %s on line %d\r\n", file, line) */
+
+  /* Infinite loop */
+  while (1)
+  {}
+}
+#endif
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,212 @@
+/**
+  ******************************************************************************
+  * @file    FreeRTOS/FreeRTOS_ThreadCreation/Src/main.c
+  * @author  MCD Application Team
+  * @brief   Main program body
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2016 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "cmsis_os.h"
+#include <stdio.h>
+#include <string.h>
+
+//Cost of queue copies by item size, measured with the DWT cycle counter.
+//One thread sends an item to a queue and receives it back, with no blocking and no
+//context switch, so the time of a round trip is the time of the two calls and of the
+//two item copies. Items of 1, 2, 4 and 8 bytes and word multiples up to
+//configQUEUE_INLINE_COPY_MAX_SIZE are copied inline, larger ones with memcpy();
+//build once more with configQUEUE_INLINE_COPY_MAX_SIZE set to 0 to get the cost of the
+//memcpy() path for every size and compare.
+
+/* Private define ------------------------------------------------------------*/
+#define NUM_ROUNDS			10000		//Round trips for each item size
+#define QUEUE_LENGTH		4
+#define MAX_ITEM_SIZE		64
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+TaskHandle_t BenchThreadHandle;
+
+const uint32_t ITEM_SIZES[] = { 1, 2, 4, 8, 12, 16, 32, 64 };
+
+//Word aligned so the word copy is chosen for the multiples of 4
+uint32_t send_item[MAX_ITEM_SIZE / sizeof(uint32_t)];
+uint32_t receive_item[MAX_ITEM_SIZE / sizeof(uint32_t)];
+
+/* Private function prototypes -----------------------------------------------*/
+static void Bench_Thread(void *argument);
+static uint32_t Bench_Size(uint32_t size);
+void SystemClock_Config(void);
+
+/* Prototype for semihosting -------------------------------------------------*/
+extern void initialise_monitor_handles(void);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Main program
+  * @param  None
+  * @retval None
+  */
+int main(void)
+{
+  /*---------------------------Initialization---------------------------------*/
+
+  //Inizialization for semihosting
+  initialise_monitor_handles();
+
+  printf("*************freeRTOS queue copy benchmark**************\n\n");
+
+  /* STM32F3xx HAL library initialization */
+  HAL_Init();
+
+  /* Configure the System clock to 72 MHz */
+  SystemClock_Config();
+
+  portCONFIGURE_CYCLE_COUNTER();
+
+  xTaskCreate(Bench_Thread, "bench", configMINIMAL_STACK_SIZE * 2, NULL, tskIDLE_PRIORITY + 1, &BenchThreadHandle);
+
+  /* Start scheduler */
+  vTaskStartScheduler();
+
+  /* We should never get here as control is now taken by the scheduler */
+  for (;;);
+
+}
+
+static void Bench_Thread(void *argument)
+{
+  uint32_t i, cycles;
+
+  printf("Queue send + receive at %lu Hz, %d round trips per size, inline copies up to %d bytes\n",
+		 SystemCoreClock, NUM_ROUNDS, configQUEUE_INLINE_COPY_MAX_SIZE);
+  printf("%10s %10s %14s\n", "item size", "cycles", "items/s");
+
+  for (i = 0; i < sizeof(ITEM_SIZES) / sizeof(ITEM_SIZES[0]); i++) {
+	cycles = Bench_Size(ITEM_SIZES[i]);
+	printf("%10lu %10lu %14lu\n", ITEM_SIZES[i], cycles, cycles ? SystemCoreClock / cycles : 0UL);
+  }
+
+  vTaskSuspend(NULL);
+}
+
+/**
+  * @brief  Average cycles of a send and a receive of an item of the given size.
+  * @param  size: item size in bytes
+  * @retval cycles per round trip
+  */
+static uint32_t Bench_Size(uint32_t size)
+{
+  QueueHandle_t queue = xQueueCreate(QUEUE_LENGTH, size);
+  uint32_t i, start, total;
+
+  if (queue == NULL) {
+	printf("%10lu no memory for the queue\n", size);
+	return 0;
+  }
+
+  for (i = 0; i < sizeof(send_item) / sizeof(send_item[0]); i++)
+	send_item[i] = 0x01020304UL * (i + 1);
+
+  //The HAL tick would land in some of the rounds
+  HAL_SuspendTick();
+  start = portGET_CYCLE_COUNTER();
+  for (i = 0; i < NUM_ROUNDS; i++) {
+	xQueueSend(queue, send_item, 0);
+	xQueueReceive(queue, receive_item, 0);
+  }
+  total = portGET_CYCLE_COUNTER() - start;
+  HAL_ResumeTick();
+
+  if (memcmp(send_item, receive_item, size) != 0)
+	printf("%10lu item corrupted\n", size);
+
+  vQueueDelete(queue);
+
+  return total / NUM_ROUNDS;
+}
+
+/**
+  * @brief  System Clock Configuration
+  *         The system Clock is configured as follow : 
+  *            System Clock source            = PLL (HSE)
+  *            SYSCLK(Hz)                     = 72000000
+  *            HCLK(Hz)                       = 72000000
+  *            AHB Prescaler                  = 1
+  *            APB1 Prescaler                 = 2
+  *            APB2 Prescaler                 = 1
+  *            HSE Frequency(Hz)              = 8000000
+  *            HSE PREDIV                     = 1
+  *            PLLMUL                         = RCC_PLL_MUL9 (9)
+  *            Flash Latency(WS)              = 2
+  * @param  None
+  * @retval None
+  */
+void SystemClock_Config(void)
+{
+  RCC_ClkInitTypeDef RCC_ClkInitStruct;
+  RCC_OscInitTypeDef RCC_OscInitStruct;
+  
+  /* Enable HSE Oscillator and activate PLL with HSE as source */
+  RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSE;
+  RCC_OscInitStruct.HSEState = RCC_HSE_ON;
+  RCC_OscInitStruct.HSEPredivValue = RCC_HSE_PREDIV_DIV1;
+  RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
+  RCC_OscInitStruct.PLL.PLLSource = RCC_PLLSOURCE_HSE;
+  RCC_OscInitStruct.PLL.PLLMUL = RCC_PLL_MUL9;
+  if (HAL_RCC_OscConfig(&RCC_OscInitStruct)!= HAL_OK)
+  {
+    /* Initialization Error */
+    while(1); 
+  }
+
+  /* Select PLL as system clock source and configure the HCLK, PCLK1 and PCLK2 
+     clocks dividers */
+  RCC_ClkInitStruct.ClockType = (RCC_CLOCKTYPE_SYSCLK | RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2);
+  RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
+  RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
+  RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV2;  
+  RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV1;
+  if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_2)!= HAL_OK)
+  {
+    /* Initialization Error */
+    while(1); 
+  }
+}
+
+#ifdef  USE_FULL_ASSERT
+
+/**
+  * @brief  Reports the name of the source file and the source line number
+  *   where the assert_param error has occurred.
+  * @param  file: pointer to the source file name
+  * @param  line: assert_param error line source number
+  * @retval None
+  */
+void assert_failed(uint8_t *file, uint32_t line)
+{
+  /* User can add his own implementation to report the file name and line number,
+     ex: printf("Wrong parameters value: file %s on line %d\r\n", file, line) */
+
+  /* Infinite loop */
+  while (1)
+  {}
+}
+#endif
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
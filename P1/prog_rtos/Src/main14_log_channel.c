@@ -0,0 +1,301 @@
+/**
+  ******************************************************************************
+  * @file    FreeRTOS/FreeRTOS_ThreadCreation/Src/main.c
+  * @author  MCD Application Team
+  * @brief   Main program body
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2016 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "cmsis_os.h"
+#include "semphr.h"
+#include "message_buffer.h"
+#include "mp_message_buffer.h"
+#include <stdio.h>
+
+//Fan-in log channel: several producer threads of different priorities send records to
+//one consumer thread. The same traffic goes first through a multi-producer message buffer,
+//where each producer reserves its slot with LDREX/STREX and nobody waits for anybody,
+//then through a plain message buffer, which only takes one writer at a time and so is
+//guarded by a mutex. The producers time their sends with the DWT cycle counter; the
+//consumer checks that the records of each producer arrive complete and in order.
+
+/* Private define ------------------------------------------------------------*/
+#define NUM_PRODUCERS		3
+#define NUM_RECORDS			2000		//Records sent by each producer in each phase
+#define BUFFER_SIZE			1024		//Power of two, as the multi-producer buffer requires
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct {
+  uint32_t producer;
+  uint32_t seq;
+  uint32_t payload[4];											//A typical telemetry record
+} Record_t;
+
+typedef struct {
+  uint32_t sent, dropped;
+  uint64_t cycles;
+} ProducerStats_t;
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+TaskHandle_t ProducerHandle[NUM_PRODUCERS], ConsumerHandle;
+
+MPMessageBufferHandle_t mp_channel;
+MessageBufferHandle_t channel;
+SemaphoreHandle_t channel_mutex;
+
+volatile uint32_t use_mutex;									//Phase: 0 multi-producer buffer, 1 mutex + message buffer
+volatile uint32_t producers_done;
+ProducerStats_t stats[NUM_PRODUCERS];
+uint32_t received, out_of_order;
+uint32_t next_seq[NUM_PRODUCERS];
+
+/* Private function prototypes -----------------------------------------------*/
+static void Producer_Thread(void *argument);
+static void Consumer_Thread(void *argument);
+static uint32_t Send(const Record_t *record);
+static void Check(const Record_t *record);
+static void Report(const char *name);
+void SystemClock_Config(void);
+
+/* Prototype for semihosting -------------------------------------------------*/
+extern void initialise_monitor_handles(void);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Main program
+  * @param  None
+  * @retval None
+  */
+int main(void)
+{
+  uint32_t i;
+
+  /*---------------------------Initialization---------------------------------*/
+
+  //Inizialization for semihosting
+  initialise_monitor_handles();
+
+  printf("*************freeRTOS fan-in log channel**************\n\n");
+
+  /* STM32F3xx HAL library initialization */
+  HAL_Init();
+
+  /* Configure the System clock to 72 MHz */
+  SystemClock_Config();
+
+  portCONFIGURE_CYCLE_COUNTER();
+
+  mp_channel = xMPMessageBufferCreate(BUFFER_SIZE);
+  channel = xMessageBufferCreate(BUFFER_SIZE);
+  channel_mutex = xSemaphoreCreateMutex();
+
+  //Producers at different priorities preempt each other in the middle of their sends
+  for (i = 0; i < NUM_PRODUCERS; i++)
+	xTaskCreate(Producer_Thread, "producer", configMINIMAL_STACK_SIZE, (void *) i, tskIDLE_PRIORITY + 1 + i, &ProducerHandle[i]);
+  xTaskCreate(Consumer_Thread, "consumer", configMINIMAL_STACK_SIZE * 2, NULL, tskIDLE_PRIORITY + 1, &ConsumerHandle);
+
+  /* Start scheduler */
+  vTaskStartScheduler();
+
+  /* We should never get here as control is now taken by the scheduler */
+  for (;;);
+
+}
+
+static void Producer_Thread(void *argument)
+{
+  uint32_t id = (uint32_t) argument, phase, i, start;
+  Record_t record = { id };
+
+  for (phase = 0; phase < 2; phase++) {
+	//Wait for the consumer to start the phase
+	ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+	for (i = 0; i < NUM_RECORDS; i++) {
+	  record.seq = i;
+	  record.payload[0] = i * (id + 1);
+	  start = portGET_CYCLE_COUNTER();
+	  if (Send(&record))
+		stats[id].sent++;
+	  else
+		stats[id].dropped++;
+	  stats[id].cycles += portGET_CYCLE_COUNTER() - start;
+
+	  //Higher priority producers sleep now and then, so the others get to run
+	  if ((i & 0x1F) == 0x1F)
+		vTaskDelay(1);
+	}
+
+	taskENTER_CRITICAL();
+	producers_done++;
+	taskEXIT_CRITICAL();
+  }
+
+  vTaskSuspend(NULL);
+}
+
+static void Consumer_Thread(void *argument)
+{
+  static const char *const names[2] = { "multi-producer buffer", "mutex + message buffer" };
+  Record_t record;
+  uint32_t i;
+  size_t length;
+
+  for (use_mutex = 0; use_mutex < 2; use_mutex++) {
+	for (i = 0; i < NUM_PRODUCERS; i++) {
+	  stats[i].sent = stats[i].dropped = 0;
+	  stats[i].cycles = 0;
+	  next_seq[i] = 0;
+	}
+	received = out_of_order = 0;
+	producers_done = 0;
+
+	for (i = 0; i < NUM_PRODUCERS; i++)
+	  xTaskNotifyGive(ProducerHandle[i]);
+
+	//Drain until every producer is done and the channel is empty
+	for (;;) {
+	  if (use_mutex == 0)
+		length = xMPMessageBufferReceive(mp_channel, &record, sizeof(record), 2);
+	  else
+		length = xMessageBufferReceive(channel, &record, sizeof(record), 2);
+
+	  if (length == sizeof(record))
+		Check(&record);
+	  else if (producers_done == NUM_PRODUCERS)
+		break;
+	}
+
+	Report(names[use_mutex]);
+  }
+
+  vTaskSuspend(NULL);
+}
+
+static uint32_t Send(const Record_t *record)
+{
+  uint32_t sent;
+
+  if (use_mutex == 0)
+	return xMPMessageBufferSend(mp_channel, record, sizeof(*record)) != 0;
+
+  xSemaphoreTake(channel_mutex, portMAX_DELAY);
+  sent = xMessageBufferSend(channel, record, sizeof(*record), 0) != 0;
+  xSemaphoreGive(channel_mutex);
+
+  return sent;
+}
+
+static void Check(const Record_t *record)
+{
+  //Records of one producer are sent in order; a gap is only allowed for dropped records
+  if (record->producer >= NUM_PRODUCERS || record->seq < next_seq[record->producer]
+	  || record->payload[0] != record->seq * (record->producer + 1))
+	out_of_order++;
+  else
+	next_seq[record->producer] = record->seq + 1;
+  received++;
+}
+
+static void Report(const char *name)
+{
+  uint32_t i, sent = 0, dropped = 0;
+  uint64_t cycles = 0;
+
+  for (i = 0; i < NUM_PRODUCERS; i++) {
+	sent += stats[i].sent;
+	dropped += stats[i].dropped;
+	cycles += stats[i].cycles;
+  }
+
+  printf("%s: %lu sent, %lu dropped, %lu received, %lu out of order, %lu cycles per send\n",
+		 name, sent, dropped, received, out_of_order, (uint32_t) (cycles / (sent + dropped)));
+  for (i = 0; i < NUM_PRODUCERS; i++)
+	printf("  producer %lu (priority %lu): %lu cycles per send\n", i, i + 1,
+		   (uint32_t) (stats[i].cycles / (stats[i].sent + stats[i].dropped)));
+}
+
+/**
+  * @brief  System Clock Configuration
+  *         The system Clock is configured as follow : 
+  *            System Clock source            = PLL (HSE)
+  *            SYSCLK(Hz)                     = 72000000
+  *            HCLK(Hz)                       = 72000000
+  *            AHB Prescaler                  = 1
+  *            APB1 Prescaler                 = 2
+  *            APB2 Prescaler                 = 1
+  *            HSE Frequency(Hz)              = 8000000
+  *            HSE PREDIV                     = 1
+  *            PLLMUL                         = RCC_PLL_MUL9 (9)
+  *            Flash Latency(WS)              = 2
+  * @param  None
+  * @retval None
+  */
+void SystemClock_Config(void)
+{
+  RCC_ClkInitTypeDef RCC_ClkInitStruct;
+  RCC_OscInitTypeDef RCC_OscInitStruct;
+  
+  /* Enable HSE Oscillator and activate PLL with HSE as source */
+  RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSE;
+  RCC_OscInitStruct.HSEState = RCC_HSE_ON;
+  RCC_OscInitStruct.HSEPredivValue = RCC_HSE_PREDIV_DIV1;
+  RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
+  RCC_OscInitStruct.PLL.PLLSource = RCC_PLLSOURCE_HSE;
+  RCC_OscInitStruct.PLL.PLLMUL = RCC_PLL_MUL9;
+  if (HAL_RCC_OscConfig(&RCC_OscInitStruct)!= HAL_OK)
+  {
+    /* Initialization Error */
+    while(1); 
+  }
+
+  /* Select PLL as system clock source and configure the HCLK, PCLK1 and PCLK2 
+     clocks dividers */
+  RCC_ClkInitStruct.ClockType = (RCC_CLOCKTYPE_SYSCLK | RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2);
+  RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
+  RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
+  RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV2;  
+  RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV1;
+  if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_2)!= HAL_OK)
+  {
+    /* Initialization Error */
+    while(1); 
+  }
+}
+
+#ifdef  USE_FULL_ASSERT
+
+/**
+  * @brief  Reports the name of the source file and the source line number
+  *   where the assert_param error has occurred.
+  * @param  file: pointer to the source file name
+  * @param  line: assert_param error line source number
+  * @retval None
+  */
+void assert_failed(uint8_t *file, uint32_t line)
+{
+  /* User can add his own implementation to report the file name and line number,
+     ex: printf("Wrong parameters value: file %s on line %d\r\n", file, line) */
+
+  /* Infinite loop */
+  while (1)
+  {}
+}
+#endif
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,291 @@
+/**
+  ******************************************************************************
+  * @file    FreeRTOS/FreeRTOS_ThreadCreation/Src/main.c
+  * @author  MCD Application Team
+  * @brief   Main program body
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2016 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "cmsis_os.h"
+#include "queue.h"
+#include "job_pool.h"
+#include <stdio.h>
+
+//Fan-out and fan-in of short jobs, three ways. The bench thread hands out rounds of
+//FAN_OUT jobs and waits for each round to complete before the next, like Print_result
+//with the LED threads, and times NUM_ROUNDS rounds with the DWT cycle counter:
+// - thread per job: one task created for each job, which deletes itself when done
+//   (the kernel recycles the TCB and the stack of the deleted ones);
+// - queue dispatch: NUM_WORKERS tasks receive the jobs from one shared queue;
+// - job pool: NUM_WORKERS workers with a deque each, the round is counted in a
+//   JobCounter_t and xJobPoolWait() waits for it.
+//Jobs of WORK_SIZES iterations of arithmetic show where the dispatch cost stops
+//mattering. The bench thread runs above the workers, so a whole round is handed out
+//before the first job runs.
+
+/* Private define ------------------------------------------------------------*/
+#define NUM_WORKERS			4
+#define FAN_OUT				8			//Jobs in a round, as many as the LED threads
+#define NUM_ROUNDS			200
+#define QUEUE_LENGTH		FAN_OUT
+#define DEQUE_LENGTH		8			//Power of two, as the job pool requires
+#define WORKER_PRIORITY		(tskIDLE_PRIORITY + 1)
+#define BENCH_PRIORITY		(tskIDLE_PRIORITY + 2)
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct {
+  JobFunction_t function;
+  void *argument;
+} QueuedJob_t;
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static const uint32_t work_sizes[] = { 0, 100, 1000 };			//Iterations of each job
+
+TaskHandle_t BenchHandle, QueueWorkerHandle[NUM_WORKERS];
+QueueHandle_t job_queue;
+JobPoolHandle_t job_pool;
+
+volatile uint32_t jobs_done, checksum;
+
+/* Private function prototypes -----------------------------------------------*/
+static void Bench_Thread(void *argument);
+static void Job(void *argument);
+static void Job_Thread(void *argument);
+static void Queue_Worker_Thread(void *argument);
+static uint32_t Run_Thread_Per_Job(uint32_t work);
+static uint32_t Run_Queue_Dispatch(uint32_t work);
+static uint32_t Run_Job_Pool(uint32_t work);
+static void Report(const char *name, uint32_t work, uint32_t cycles);
+void SystemClock_Config(void);
+
+/* Prototype for semihosting -------------------------------------------------*/
+extern void initialise_monitor_handles(void);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Main program
+  * @param  None
+  * @retval None
+  */
+int main(void)
+{
+  /*---------------------------Initialization---------------------------------*/
+
+  //Inizialization for semihosting
+  initialise_monitor_handles();
+
+  printf("*************freeRTOS job pool vs thread per job**************\n\n");
+
+  /* STM32F3xx HAL library initialization */
+  HAL_Init();
+
+  /* Configure the System clock to 72 MHz */
+  SystemClock_Config();
+
+  portCONFIGURE_CYCLE_COUNTER();
+
+  xTaskCreate(Bench_Thread, "bench", configMINIMAL_STACK_SIZE * 2, NULL, BENCH_PRIORITY, &BenchHandle);
+
+  /* Start scheduler */
+  vTaskStartScheduler();
+
+  /* We should never get here as control is now taken by the scheduler */
+  for (;;);
+
+}
+
+static void Bench_Thread(void *argument)
+{
+  uint32_t i, j;
+
+  //One method at a time, so the heap only holds the tasks of one of them
+  for (i = 0; i < sizeof(work_sizes) / sizeof(work_sizes[0]); i++)
+	Report("thread per job", work_sizes[i], Run_Thread_Per_Job(work_sizes[i]));
+
+  job_queue = xQueueCreate(QUEUE_LENGTH, sizeof(QueuedJob_t));
+  for (j = 0; j < NUM_WORKERS; j++)
+	xTaskCreate(Queue_Worker_Thread, "qworker", configMINIMAL_STACK_SIZE, NULL, WORKER_PRIORITY, &QueueWorkerHandle[j]);
+  for (i = 0; i < sizeof(work_sizes) / sizeof(work_sizes[0]); i++)
+	Report("queue dispatch", work_sizes[i], Run_Queue_Dispatch(work_sizes[i]));
+  for (j = 0; j < NUM_WORKERS; j++)
+	vTaskDelete(QueueWorkerHandle[j]);
+  vQueueDelete(job_queue);
+
+  job_pool = xJobPoolCreate(NUM_WORKERS, DEQUE_LENGTH, configMINIMAL_STACK_SIZE, WORKER_PRIORITY);
+  for (i = 0; i < sizeof(work_sizes) / sizeof(work_sizes[0]); i++)
+	Report("job pool", work_sizes[i], Run_Job_Pool(work_sizes[i]));
+  printf("job pool: %lu jobs stolen\n", ulJobPoolGetSteals(job_pool));
+  vJobPoolDelete(job_pool);
+
+  vTaskSuspend(NULL);
+}
+
+static void Job(void *argument)
+{
+  uint32_t n = (uint32_t) argument, i, x = n;
+
+  for (i = 0; i < n; i++)
+	x = x * 1664525 + 1013904223;
+
+  taskENTER_CRITICAL();
+  checksum += x;
+  jobs_done++;
+  taskEXIT_CRITICAL();
+}
+
+static void Job_Thread(void *argument)
+{
+  Job(argument);
+  xTaskNotifyGive(BenchHandle);
+  vTaskDelete(NULL);
+}
+
+static void Queue_Worker_Thread(void *argument)
+{
+  QueuedJob_t job;
+
+  for (;;) {
+	xQueueReceive(job_queue, &job, portMAX_DELAY);
+	job.function(job.argument);
+	xTaskNotifyGive(BenchHandle);
+  }
+}
+
+static uint32_t Run_Thread_Per_Job(uint32_t work)
+{
+  uint32_t round, i, done, start;
+
+  jobs_done = 0;
+  start = portGET_CYCLE_COUNTER();
+  for (round = 0; round < NUM_ROUNDS; round++) {
+	for (i = 0; i < FAN_OUT; i++)
+	  xTaskCreate(Job_Thread, "job", configMINIMAL_STACK_SIZE, (void *) work, WORKER_PRIORITY, NULL);
+	for (done = 0; done < FAN_OUT; )
+	  done += ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+  }
+  return portGET_CYCLE_COUNTER() - start;
+}
+
+static uint32_t Run_Queue_Dispatch(uint32_t work)
+{
+  QueuedJob_t job = { Job, (void *) work };
+  uint32_t round, i, done, start;
+
+  jobs_done = 0;
+  start = portGET_CYCLE_COUNTER();
+  for (round = 0; round < NUM_ROUNDS; round++) {
+	for (i = 0; i < FAN_OUT; i++)
+	  xQueueSend(job_queue, &job, portMAX_DELAY);
+	for (done = 0; done < FAN_OUT; )
+	  done += ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+  }
+  return portGET_CYCLE_COUNTER() - start;
+}
+
+static uint32_t Run_Job_Pool(uint32_t work)
+{
+  JobCounter_t round_done = { 0 };
+  uint32_t round, i, start;
+
+  jobs_done = 0;
+  start = portGET_CYCLE_COUNTER();
+  for (round = 0; round < NUM_ROUNDS; round++) {
+	for (i = 0; i < FAN_OUT; i++)
+	  xJobPoolSubmit(job_pool, Job, (void *) work, &round_done);
+	xJobPoolWait(job_pool, &round_done, portMAX_DELAY);
+  }
+  return portGET_CYCLE_COUNTER() - start;
+}
+
+static void Report(const char *name, uint32_t work, uint32_t cycles)
+{
+  uint32_t per_job = cycles / (NUM_ROUNDS * FAN_OUT);
+
+  printf("%-14s work %4lu: %lu jobs, %6lu cycles per job, %7lu jobs/s\n",
+		 name, work, jobs_done, per_job, SystemCoreClock / per_job);
+}
+
+/**
+  * @brief  System Clock Configuration
+  *         The system Clock is configured as follow : 
+  *            System Clock source            = PLL (HSE)
+  *            SYSCLK(Hz)                     = 72000000
+  *            HCLK(Hz)                       = 72000000
+  *            AHB Prescaler                  = 1
+  *            APB1 Prescaler                 = 2
+  *            APB2 Prescaler                 = 1
+  *            HSE Frequency(Hz)              = 8000000
+  *            HSE PREDIV                     = 1
+  *            PLLMUL                         = RCC_PLL_MUL9 (9)
+  *            Flash Latency(WS)              = 2
+  * @param  None
+  * @retval None
+  */
+void SystemClock_Config(void)
+{
+  RCC_ClkInitTypeDef RCC_ClkInitStruct;
+  RCC_OscInitTypeDef RCC_OscInitStruct;
+  
+  /* Enable HSE Oscillator and activate PLL with HSE as source */
+  RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSE;
+  RCC_OscInitStruct.HSEState = RCC_HSE_ON;
+  RCC_OscInitStruct.HSEPredivValue = RCC_HSE_PREDIV_DIV1;
+  RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
+  RCC_OscInitStruct.PLL.PLLSource = RCC_PLLSOURCE_HSE;
+  RCC_OscInitStruct.PLL.PLLMUL = RCC_PLL_MUL9;
+  if (HAL_RCC_OscConfig(&RCC_OscInitStruct)!= HAL_OK)
+  {
+    /* Initialization Error */
+    while(1); 
+  }
+
+  /* Select PLL as system clock source and configure the HCLK, PCLK1 and PCLK2 
+     clocks dividers */
+  RCC_ClkInitStruct.ClockType = (RCC_CLOCKTYPE_SYSCLK | RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2);
+  RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
+  RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
+  RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV2;  
+  RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV1;
+  if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_2)!= HAL_OK)
+  {
+    /* Initialization Error */
+    while(1); 
+  }
+}
+
+#ifdef  USE_FULL_ASSERT
+
+/**
+  * @brief  Reports the name of the source file and the source line number
+  *   where the assert_param error has occurred.
+  * @param  file: pointer to the source file name
+  * @param  line: assert_param error line source number
+  * @retval None
+  */
+void assert_failed(uint8_t *file, uint32_t line)
+{
+  /* User can add his own implementation to report the file name and line number,
+     ex: printf("Wrong parameters value: file %s on line %d\r\n", file, line) */
+
+  /* Infinite loop */
+  while (1)
+  {}
+}
+#endif
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -151,6 +151,18 @@ const uint8_t APBPrescTable[8]  = {0, 0, 0, 0, 1, 2, 3, 4};
   */
 void SystemInit(void)
 {
+  /* CCM-RAM initialisation --------------------------------------------------*/
+  /* Copy the code and data placed in the .ccmram section from flash, as the
+     template startup code only initialises .data and .bss */
+  extern uint32_t _siccmram, _sccmram, _eccmram;
+  uint32_t *pSrc = &_siccmram;
+  uint32_t *pDest = &_sccmram;
+
+  while (pDest < &_eccmram)
+  {
+    *pDest++ = *pSrc++;
+  }
+
   /* FPU settings ------------------------------------------------------------*/
   #if (__FPU_PRESENT == 1) && (__FPU_USED == 1)
     SCB->CPACR |= ((3UL << 10*2)|(3UL << 11*2));  /* set CP10 and CP11 Full Access */
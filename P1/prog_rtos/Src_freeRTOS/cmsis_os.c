@@ -507,12 +507,12 @@ int32_t osSignalSet (osThreadId thread_id, int32_t signal)
   
   if (inHandlerMode())
   {
-    if(xTaskGenericNotifyFromISR( thread_id , (uint32_t)signal, eSetBits, &ulPreviousNotificationValue, &xHigherPriorityTaskWoken ) != pdPASS )
+    if(xTaskGenericNotifyFromISR( thread_id , tskDEFAULT_INDEX_TO_NOTIFY, (uint32_t)signal, eSetBits, &ulPreviousNotificationValue, &xHigherPriorityTaskWoken ) != pdPASS )
       return 0x80000000;
     
     portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
   }  
-  else if(xTaskGenericNotify( thread_id , (uint32_t)signal, eSetBits, &ulPreviousNotificationValue) != pdPASS )
+  else if(xTaskGenericNotify( thread_id , tskDEFAULT_INDEX_TO_NOTIFY, (uint32_t)signal, eSetBits, &ulPreviousNotificationValue) != pdPASS )
     return 0x80000000;
   
   return ulPreviousNotificationValue;
@@ -717,7 +717,13 @@ osSemaphoreId osSemaphoreCreate (const osSemaphoreDef_t *semaphore_def, int32_t
   
   if (semaphore_def->controlblock != NULL){
     if (count == 1) {
-      return xSemaphoreCreateBinaryStatic( semaphore_def->controlblock );
+      /* Binary semaphores are created empty: give it so it starts available,
+         as vSemaphoreCreateBinary does for the dynamic case. */
+      sema = xSemaphoreCreateBinaryStatic( semaphore_def->controlblock );
+      if (sema != NULL) {
+        xSemaphoreGive(sema);
+      }
+      return sema;
     }
     else {
 #if (configUSE_COUNTING_SEMAPHORES == 1 )
@@ -741,8 +747,14 @@ osSemaphoreId osSemaphoreCreate (const osSemaphoreDef_t *semaphore_def, int32_t
     }
   }
 #elif ( configSUPPORT_STATIC_ALLOCATION == 1 ) // configSUPPORT_DYNAMIC_ALLOCATION == 0
+  osSemaphoreId sema;
+
   if(count == 1) {
-    return xSemaphoreCreateBinaryStatic( semaphore_def->controlblock );
+    sema = xSemaphoreCreateBinaryStatic( semaphore_def->controlblock );
+    if (sema != NULL) {
+      xSemaphoreGive(sema);
+    }
+    return sema;
   }
   else
   {
@@ -865,15 +877,6 @@ osStatus osSemaphoreDelete (osSemaphoreId semaphore_id)
 //A better implementation will have to modify heap_x.c!
 
 
-typedef struct os_pool_cb {
-  void *pool;
-  uint8_t *markers;
-  uint32_t pool_sz;
-  uint32_t item_sz;
-  uint32_t currentIndex;
-} os_pool_cb_t;
-
-
 /**
 * @brief Create and Initialize a memory pool
 * @param  pool_def      memory pool definition referenced with \ref osPool.
@@ -882,11 +885,29 @@ typedef struct os_pool_cb {
 */
 osPoolId osPoolCreate (const osPoolDef_t *pool_def)
 {
-#if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
   osPoolId thePool;
   int itemSize = 4 * ((pool_def->item_sz + 3) / 4);
   uint32_t i;
-  
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+  if ((pool_def->pool != NULL) && (pool_def->markers != NULL) && (pool_def->controlblock != NULL)) {
+    /* The control block, markers and blocks were all provided by osPoolStaticDef. */
+    thePool = pool_def->controlblock;
+    thePool->pool_sz = pool_def->pool_sz;
+    thePool->item_sz = itemSize;
+    thePool->currentIndex = 0;
+    thePool->markers = pool_def->markers;
+    thePool->pool = pool_def->pool;
+
+    for (i = 0; i < pool_def->pool_sz; i++) {
+      thePool->markers[i] = 0;
+    }
+
+    return thePool;
+  }
+#endif
+
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
   /* First have to allocate memory for the pool control block. */
  thePool = pvPortMalloc(sizeof(os_pool_cb_t));
 
@@ -1546,6 +1567,42 @@ osStatus osThreadList (uint8_t *buffer)
   return osOK;
 }
 
+/**
+* @brief   Get the stack usage of a thread.
+* @param   thread_id   thread ID obtained by \ref osThreadCreate or \ref osThreadGetId.
+* @param   stats       filled with the stack size, the most stack used and the
+*          least stack free since the thread was created.
+* @retval  status code that indicates the execution status of the function.
+*/
+osStatus osThreadGetStats (osThreadId thread_id, osThreadStats_t *stats)
+{
+#if ( configUSE_TRACE_FACILITY == 1 )
+  TaskStatus_t status;
+
+  if ((thread_id == NULL) || (stats == NULL) || inHandlerMode()) {
+    return osErrorParameter;
+  }
+
+  vTaskGetInfo(thread_id, &status, pdTRUE, eInvalid);
+
+  stats->stack_size = status.ulStackDepth;
+  stats->stack_free_min = status.usStackHighWaterMark;
+  if (status.ulStackDepth > status.usStackHighWaterMark) {
+    stats->stack_used_max = status.ulStackDepth - status.usStackHighWaterMark;
+  }
+  else {
+    stats->stack_used_max = 0;
+  }
+
+  return osOK;
+#else
+  (void) thread_id;
+  (void) stats;
+
+  return osErrorResource;
+#endif
+}
+
 /**
 * @brief  Receive an item from a queue without removing the item from the queue.
 * @param  queue_id  message queue ID obtained with \ref osMessageCreate.
@@ -1725,3 +1782,60 @@ uint32_t osSemaphoreGetCount(osSemaphoreId semaphore_id)
 {
   return uxSemaphoreGetCount(semaphore_id);
 }
+
+#if( configCHECK_FOR_STACK_OVERFLOW > 0 )
+/**
+* @brief  Called by the kernel when it finds a task has overflowed its stack.
+* @param  xTask        the task that overflowed.
+* @param  pcTaskName   its name.
+* @note   Weak, so an application can provide its own.  Halts with interrupts
+*         disabled so a debugger shows the state at the overflow; pcTaskName
+*         names the task whose stack must grow.
+*/
+__attribute__((weak)) void vApplicationStackOverflowHook( TaskHandle_t xTask, char *pcTaskName )
+{
+  (void) xTask;
+  (void) pcTaskName;
+
+  taskDISABLE_INTERRUPTS();
+  for( ;; );
+}
+#endif
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+/**
+* @brief  Provide the memory of the idle task when static allocation is enabled.
+* @param  ppxIdleTaskTCBBuffer    set to the idle task control block.
+* @param  ppxIdleTaskStackBuffer  set to the idle task stack.
+* @param  pulIdleTaskStackSize    set to the idle task stack size in words.
+* @note   Weak, so an application can provide its own (e.g. to place it in CCM RAM).
+*/
+__attribute__((weak)) void vApplicationGetIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize )
+{
+  static StaticTask_t xIdleTaskTCB;
+  static StackType_t uxIdleTaskStack[ configMINIMAL_STACK_SIZE ];
+
+  *ppxIdleTaskTCBBuffer = &xIdleTaskTCB;
+  *ppxIdleTaskStackBuffer = uxIdleTaskStack;
+  *pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+
+#if( configUSE_TIMERS == 1 )
+/**
+* @brief  Provide the memory of the timer service task when static allocation is enabled.
+* @param  ppxTimerTaskTCBBuffer    set to the timer task control block.
+* @param  ppxTimerTaskStackBuffer  set to the timer task stack.
+* @param  pulTimerTaskStackSize    set to the timer task stack size in words.
+* @note   Weak, so an application can provide its own.
+*/
+__attribute__((weak)) void vApplicationGetTimerTaskMemory( StaticTask_t **ppxTimerTaskTCBBuffer, StackType_t **ppxTimerTaskStackBuffer, uint32_t *pulTimerTaskStackSize )
+{
+  static StaticTask_t xTimerTaskTCB;
+  static StackType_t uxTimerTaskStack[ configTIMER_TASK_STACK_DEPTH ];
+
+  *ppxTimerTaskTCBBuffer = &xTimerTaskTCB;
+  *ppxTimerTaskStackBuffer = uxTimerTaskStack;
+  *pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+}
+#endif
+#endif
@@ -0,0 +1,689 @@
+/*
+ * prog_rtos heap_5.c, derived from heap_4.c of the FreeRTOS Kernel V10.0.1,
+ * which is distributed under the following notice:
+ *
+ * Copyright (C) 2017 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * A version of heap_4.c that spans several non-contiguous memory regions, each
+ * one managed as a separate heap with its own free list and statistics.  On
+ * the STM32F303 that lets the 40K of SRAM and the 8K of core coupled memory
+ * (CCM RAM) be used together, while still letting the caller choose which one
+ * an allocation comes from:
+ *
+ * pvPortMalloc() tries each region of the general pool in turn, in the order
+ * they were defined.
+ *
+ * pvPortMallocIn() only allocates from the given region.  Use it to place
+ * stacks and TCBs in the zero wait state CCM RAM, or buffers that are accessed
+ * by the DMA controllers in SRAM.
+ *
+ * vPortFree() returns the block to the region it was allocated from.
+ *
+ * The regions can be set by calling vPortDefineHeapRegions() before the first
+ * allocation.  Otherwise the port defaults are used: the ucHeap array of
+ * configTOTAL_HEAP_SIZE bytes in SRAM as portHEAP_REGION_SRAM, then, if the
+ * port defines portCCM_HEAP_START and portCCM_HEAP_END, the part of the CCM RAM
+ * not used by the .ccmram section as portHEAP_REGION_CCM.  The DMA controllers
+ * cannot reach the CCM RAM, and drivers expect pvPortMalloc() buffers to be
+ * DMA capable, so the default CCM region is left out of the general pool and
+ * is only reached through pvPortMallocIn().  Every region passed to
+ * vPortDefineHeapRegions() is in the general pool.
+ *
+ * See heap_1.c, heap_2.c and heap_3.c for alternative implementations, and the
+ * memory management pages of http://www.FreeRTOS.org for more information.
+ */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+	#error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+/* Block sizes must not get too small. */
+#define heapMINIMUM_BLOCK_SIZE	( ( size_t ) ( xHeapStructSize << 1 ) )
+
+/* Assumes 8bit bytes! */
+#define heapBITS_PER_BYTE		( ( size_t ) 8 )
+
+/* Allocate the memory for the default SRAM region. */
+#if( configAPPLICATION_ALLOCATED_HEAP == 1 )
+	/* The application writer has already defined the array used for the RTOS
+	heap - probably so it can be placed in a special segment or address. */
+	extern uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#else
+	static uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#endif /* configAPPLICATION_ALLOCATED_HEAP */
+
+/* Define the linked list structure.  This is used to link free blocks in order
+of their memory address. */
+typedef struct A_BLOCK_LINK
+{
+	struct A_BLOCK_LINK *pxNextFreeBlock;	/*<< The next free block in the list. */
+	size_t xBlockSize;						/*<< The size of the free block. */
+} BlockLink_t;
+
+/* The state kept for each region.  Free blocks never cross a region boundary,
+so each region has its own free list, terminated by its own end marker. */
+typedef struct A_HEAP_REGION
+{
+	BlockLink_t xStart;						/*<< Marks the start of the list of free blocks in the region. */
+	BlockLink_t *pxEnd;						/*<< Marks the end of the list, placed at the end of the region. */
+	uint8_t *pucRegionStart;				/*<< The first byte of the region, used to find the region of a block being freed. */
+	size_t xFreeBytesRemaining;				/*<< Free bytes in the region, but says nothing about fragmentation. */
+	size_t xMinimumEverFreeBytesRemaining;	/*<< The lowest value xFreeBytesRemaining has had. */
+	BaseType_t xInGeneralPool;				/*<< pdTRUE if pvPortMalloc() allocates from the region, not only pvPortMallocIn(). */
+} HeapRegionState_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Inserts a block of memory that is being freed into the correct position in
+ * the list of free memory blocks of its region.  The block being freed will be
+ * merged with the block in front it and/or the block behind it if the memory
+ * blocks are adjacent to each other.
+ */
+static void prvInsertBlockIntoFreeList( HeapRegionState_t *pxRegion, BlockLink_t *pxBlockToInsert );
+
+/*
+ * Allocates a block of xWantedSize bytes, already including the block header
+ * and alignment padding, from the given region.  Called with the scheduler
+ * suspended.
+ */
+static void *prvAllocateFromRegion( HeapRegionState_t *pxRegion, size_t xWantedSize );
+
+/*
+ * Returns the region that contains pv, or NULL if pv is not in any region.
+ */
+static HeapRegionState_t *prvRegionContaining( const void *pv );
+
+/*
+ * Called automatically to define the default regions if the application has
+ * not called vPortDefineHeapRegions() before the first allocation.
+ */
+static void prvHeapDefineDefaultRegions( void );
+
+/*-----------------------------------------------------------*/
+
+/* The size of the structure placed at the beginning of each allocated memory
+block must by correctly byte aligned. */
+static const size_t xHeapStructSize	= ( sizeof( BlockLink_t ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* The regions, in the order they were defined. */
+static HeapRegionState_t xHeapRegions[ configMAX_HEAP_REGIONS ];
+static BaseType_t xDefinedHeapRegions = 0;
+
+/* Gets set to the top bit of an size_t type.  When this bit in the xBlockSize
+member of an BlockLink_t structure is set then the block belongs to the
+application.  When the bit is free the block is still part of the free heap
+space. */
+static size_t xBlockAllocatedBit = 0;
+
+/*-----------------------------------------------------------*/
+
+static size_t prvBlockSizeFor( size_t xWantedSize )
+{
+	/* The wanted size is increased so it can contain a BlockLink_t structure
+	in addition to the requested amount of bytes, and is then rounded up so
+	the block stays aligned.  A size with the top bit set cannot be allocated
+	as that bit is used to mark allocated blocks. */
+	if( ( xWantedSize > 0 ) && ( ( xWantedSize & xBlockAllocatedBit ) == 0 ) )
+	{
+		xWantedSize += xHeapStructSize;
+
+		if( ( xWantedSize & portBYTE_ALIGNMENT_MASK ) != 0x00 )
+		{
+			xWantedSize += ( portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		xWantedSize = 0;
+	}
+
+	return xWantedSize;
+}
+/*-----------------------------------------------------------*/
+
+static void prvMallocFailed( void *pvReturn )
+{
+	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
+	{
+		if( pvReturn == NULL )
+		{
+			extern void vApplicationMallocFailedHook( void );
+			vApplicationMallocFailedHook();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#else
+	{
+		( void ) pvReturn;
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+void *pvPortMalloc( size_t xWantedSize )
+{
+void *pvReturn = NULL;
+size_t xBlockSize;
+BaseType_t xRegion;
+
+	vTaskSuspendAll();
+	{
+		if( xDefinedHeapRegions == 0 )
+		{
+			prvHeapDefineDefaultRegions();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		xBlockSize = prvBlockSizeFor( xWantedSize );
+
+		if( xBlockSize != 0 )
+		{
+			/* Take the block from the first region of the general pool that
+			can hold it. */
+			for( xRegion = 0; ( xRegion < xDefinedHeapRegions ) && ( pvReturn == NULL ); xRegion++ )
+			{
+				if( xHeapRegions[ xRegion ].xInGeneralPool != pdFALSE )
+				{
+					pvReturn = prvAllocateFromRegion( &( xHeapRegions[ xRegion ] ), xBlockSize );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		traceMALLOC( pvReturn, xWantedSize );
+	}
+	( void ) xTaskResumeAll();
+
+	prvMallocFailed( pvReturn );
+
+	configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void *pvPortMallocIn( BaseType_t xRegion, size_t xWantedSize )
+{
+void *pvReturn = NULL;
+size_t xBlockSize;
+
+	vTaskSuspendAll();
+	{
+		if( xDefinedHeapRegions == 0 )
+		{
+			prvHeapDefineDefaultRegions();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		xBlockSize = prvBlockSizeFor( xWantedSize );
+
+		/* A region the application did not define (for example the CCM
+		region on a port without one) behaves as a full region. */
+		if( ( xBlockSize != 0 ) && ( xRegion >= 0 ) && ( xRegion < xDefinedHeapRegions ) )
+		{
+			pvReturn = prvAllocateFromRegion( &( xHeapRegions[ xRegion ] ), xBlockSize );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		traceMALLOC( pvReturn, xWantedSize );
+	}
+	( void ) xTaskResumeAll();
+
+	prvMallocFailed( pvReturn );
+
+	configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void *prvAllocateFromRegion( HeapRegionState_t *pxRegion, size_t xWantedSize )
+{
+BlockLink_t *pxBlock, *pxPreviousBlock, *pxNewBlockLink;
+void *pvReturn = NULL;
+
+	if( xWantedSize <= pxRegion->xFreeBytesRemaining )
+	{
+		/* Traverse the list from the start	(lowest address) block until
+		one	of adequate size is found. */
+		pxPreviousBlock = &( pxRegion->xStart );
+		pxBlock = pxRegion->xStart.pxNextFreeBlock;
+		while( ( pxBlock->xBlockSize < xWantedSize ) && ( pxBlock->pxNextFreeBlock != NULL ) )
+		{
+			pxPreviousBlock = pxBlock;
+			pxBlock = pxBlock->pxNextFreeBlock;
+		}
+
+		/* If the end marker was reached then a block of adequate size
+		was	not found. */
+		if( pxBlock != pxRegion->pxEnd )
+		{
+			/* Return the memory space pointed to - jumping over the
+			BlockLink_t structure at its start. */
+			pvReturn = ( void * ) ( ( ( uint8_t * ) pxPreviousBlock->pxNextFreeBlock ) + xHeapStructSize );
+
+			/* This block is being returned for use so must be taken out
+			of the list of free blocks. */
+			pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+
+			/* If the block is larger than required it can be split into
+			two. */
+			if( ( pxBlock->xBlockSize - xWantedSize ) > heapMINIMUM_BLOCK_SIZE )
+			{
+				/* This block is to be split into two.  Create a new
+				block following the number of bytes requested. */
+				pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
+				configASSERT( ( ( ( size_t ) pxNewBlockLink ) & portBYTE_ALIGNMENT_MASK ) == 0 );
+
+				/* Calculate the sizes of two blocks split from the
+				single block. */
+				pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
+				pxBlock->xBlockSize = xWantedSize;
+
+				/* Insert the new block into the list of free blocks. */
+				prvInsertBlockIntoFreeList( pxRegion, pxNewBlockLink );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxRegion->xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+			if( pxRegion->xFreeBytesRemaining < pxRegion->xMinimumEverFreeBytesRemaining )
+			{
+				pxRegion->xMinimumEverFreeBytesRemaining = pxRegion->xFreeBytesRemaining;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* The block is being returned - it is allocated and owned
+			by the application and has no "next" block. */
+			pxBlock->xBlockSize |= xBlockAllocatedBit;
+			pxBlock->pxNextFreeBlock = NULL;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void *pv )
+{
+uint8_t *puc = ( uint8_t * ) pv;
+BlockLink_t *pxLink;
+HeapRegionState_t *pxRegion;
+
+	if( pv != NULL )
+	{
+		/* The memory being freed will have an BlockLink_t structure immediately
+		before it. */
+		puc -= xHeapStructSize;
+
+		/* This casting is to keep the compiler from issuing warnings. */
+		pxLink = ( void * ) puc;
+
+		/* Check the block is actually allocated, and find the region it was
+		allocated from. */
+		pxRegion = prvRegionContaining( pv );
+		configASSERT( pxRegion != NULL );
+		configASSERT( ( pxLink->xBlockSize & xBlockAllocatedBit ) != 0 );
+		configASSERT( pxLink->pxNextFreeBlock == NULL );
+
+		if( ( pxRegion != NULL ) && ( ( pxLink->xBlockSize & xBlockAllocatedBit ) != 0 ) )
+		{
+			if( pxLink->pxNextFreeBlock == NULL )
+			{
+				/* The block is being returned to the heap - it is no longer
+				allocated. */
+				pxLink->xBlockSize &= ~xBlockAllocatedBit;
+
+				vTaskSuspendAll();
+				{
+					/* Add this block to the list of free blocks. */
+					pxRegion->xFreeBytesRemaining += pxLink->xBlockSize;
+					traceFREE( pv, pxLink->xBlockSize );
+					prvInsertBlockIntoFreeList( pxRegion, ( ( BlockLink_t * ) pxLink ) );
+				}
+				( void ) xTaskResumeAll();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static HeapRegionState_t *prvRegionContaining( const void *pv )
+{
+HeapRegionState_t *pxReturn = NULL;
+BaseType_t xRegion;
+
+	for( xRegion = 0; xRegion < xDefinedHeapRegions; xRegion++ )
+	{
+		if( ( ( const uint8_t * ) pv > xHeapRegions[ xRegion ].pucRegionStart ) && ( ( const uint8_t * ) pv < ( const uint8_t * ) xHeapRegions[ xRegion ].pxEnd ) )
+		{
+			pxReturn = &( xHeapRegions[ xRegion ] );
+			break;
+		}
+	}
+
+	return pxReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+size_t xReturn = 0;
+BaseType_t xRegion;
+
+	for( xRegion = 0; xRegion < xDefinedHeapRegions; xRegion++ )
+	{
+		xReturn += xHeapRegions[ xRegion ].xFreeBytesRemaining;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+size_t xReturn = 0;
+BaseType_t xRegion;
+
+	/* The sum of the low water marks of the regions.  The regions may have
+	reached them at different times, so this is a lower bound. */
+	for( xRegion = 0; xRegion < xDefinedHeapRegions; xRegion++ )
+	{
+		xReturn += xHeapRegions[ xRegion ].xMinimumEverFreeBytesRemaining;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSizeIn( BaseType_t xRegion )
+{
+size_t xReturn = 0;
+
+	if( ( xRegion >= 0 ) && ( xRegion < xDefinedHeapRegions ) )
+	{
+		xReturn = xHeapRegions[ xRegion ].xFreeBytesRemaining;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSizeIn( BaseType_t xRegion )
+{
+size_t xReturn = 0;
+
+	if( ( xRegion >= 0 ) && ( xRegion < xDefinedHeapRegions ) )
+	{
+		xReturn = xHeapRegions[ xRegion ].xMinimumEverFreeBytesRemaining;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+	/* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertBlockIntoFreeList( HeapRegionState_t *pxRegion, BlockLink_t *pxBlockToInsert )
+{
+BlockLink_t *pxIterator;
+uint8_t *puc;
+
+	/* Iterate through the list until a block is found that has a higher address
+	than the block being inserted. */
+	for( pxIterator = &( pxRegion->xStart ); pxIterator->pxNextFreeBlock < pxBlockToInsert; pxIterator = pxIterator->pxNextFreeBlock )
+	{
+		/* Nothing to do here, just iterate to the right position. */
+	}
+
+	/* Do the block being inserted, and the block it is being inserted after
+	make a contiguous block of memory? */
+	puc = ( uint8_t * ) pxIterator;
+	if( ( puc + pxIterator->xBlockSize ) == ( uint8_t * ) pxBlockToInsert )
+	{
+		pxIterator->xBlockSize += pxBlockToInsert->xBlockSize;
+		pxBlockToInsert = pxIterator;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/* Do the block being inserted, and the block it is being inserted before
+	make a contiguous block of memory? */
+	puc = ( uint8_t * ) pxBlockToInsert;
+	if( ( puc + pxBlockToInsert->xBlockSize ) == ( uint8_t * ) pxIterator->pxNextFreeBlock )
+	{
+		if( pxIterator->pxNextFreeBlock != pxRegion->pxEnd )
+		{
+			/* Form one big block from the two blocks. */
+			pxBlockToInsert->xBlockSize += pxIterator->pxNextFreeBlock->xBlockSize;
+			pxBlockToInsert->pxNextFreeBlock = pxIterator->pxNextFreeBlock->pxNextFreeBlock;
+		}
+		else
+		{
+			pxBlockToInsert->pxNextFreeBlock = pxRegion->pxEnd;
+		}
+	}
+	else
+	{
+		pxBlockToInsert->pxNextFreeBlock = pxIterator->pxNextFreeBlock;
+	}
+
+	/* If the block being inserted plugged a gab, so was merged with the block
+	before and the block after, then it's pxNextFreeBlock pointer will have
+	already been set, and should not be set here as that would make it point
+	to itself. */
+	if( pxIterator != pxBlockToInsert )
+	{
+		pxIterator->pxNextFreeBlock = pxBlockToInsert;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions )
+{
+BlockLink_t *pxFirstFreeBlock;
+HeapRegionState_t *pxRegion;
+size_t xAlignedHeap, xAddress, xTotalRegionSize;
+const HeapRegion_t *pxHeapRegion;
+
+	/* Can only call once! */
+	configASSERT( xDefinedHeapRegions == 0 );
+
+	pxHeapRegion = &( pxHeapRegions[ 0 ] );
+
+	while( ( pxHeapRegion->xSizeInBytes > 0 ) && ( xDefinedHeapRegions < configMAX_HEAP_REGIONS ) )
+	{
+		pxRegion = &( xHeapRegions[ xDefinedHeapRegions ] );
+		xTotalRegionSize = pxHeapRegion->xSizeInBytes;
+
+		/* Ensure the heap region starts on a correctly aligned boundary. */
+		xAddress = ( size_t ) pxHeapRegion->pucStartAddress;
+		if( ( xAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
+		{
+			xAddress += ( portBYTE_ALIGNMENT - 1 );
+			xAddress &= ~portBYTE_ALIGNMENT_MASK;
+
+			/* Adjust the size for the bytes lost to alignment. */
+			xTotalRegionSize -= xAddress - ( size_t ) pxHeapRegion->pucStartAddress;
+		}
+
+		xAlignedHeap = xAddress;
+		pxRegion->pucRegionStart = ( uint8_t * ) xAlignedHeap;
+
+		/* xStart is used to hold a pointer to the first item in the list of
+		free blocks.  The void cast is used to prevent compiler warnings. */
+		pxRegion->xStart.pxNextFreeBlock = ( BlockLink_t * ) xAlignedHeap;
+		pxRegion->xStart.xBlockSize = ( size_t ) 0;
+
+		/* pxEnd is used to mark the end of the list of free blocks and is
+		inserted at the end of the region space. */
+		xAddress = xAlignedHeap + xTotalRegionSize;
+		xAddress -= xHeapStructSize;
+		xAddress &= ~portBYTE_ALIGNMENT_MASK;
+		pxRegion->pxEnd = ( BlockLink_t * ) xAddress;
+		pxRegion->pxEnd->xBlockSize = 0;
+		pxRegion->pxEnd->pxNextFreeBlock = NULL;
+
+		/* To start with there is a single free block in the region that is
+		sized to take up the entire region space minus the space taken by
+		pxEnd. */
+		pxFirstFreeBlock = ( BlockLink_t * ) xAlignedHeap;
+		pxFirstFreeBlock->xBlockSize = xAddress - ( size_t ) pxFirstFreeBlock;
+		pxFirstFreeBlock->pxNextFreeBlock = pxRegion->pxEnd;
+
+		pxRegion->xFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
+		pxRegion->xMinimumEverFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
+		pxRegion->xInGeneralPool = pdTRUE;
+
+		/* Move onto the next HeapRegion_t structure. */
+		xDefinedHeapRegions++;
+		pxHeapRegion = &( pxHeapRegions[ xDefinedHeapRegions ] );
+	}
+
+	/* Check the heap was actually defined, and that no region was dropped
+	because there are more than configMAX_HEAP_REGIONS of them. */
+	configASSERT( xDefinedHeapRegions > 0 );
+	configASSERT( pxHeapRegion->xSizeInBytes == 0 );
+
+	/* Work out the position of the top bit in a size_t variable. */
+	xBlockAllocatedBit = ( ( size_t ) 1 ) << ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) - 1 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvHeapDefineDefaultRegions( void )
+{
+HeapRegion_t xDefaultRegions[ 3 ];
+BaseType_t xRegion = 0;
+
+	/* The order of the entries has to match portHEAP_REGION_SRAM and
+	portHEAP_REGION_CCM. */
+	xDefaultRegions[ xRegion ].pucStartAddress = ucHeap;
+	xDefaultRegions[ xRegion ].xSizeInBytes = configTOTAL_HEAP_SIZE;
+	xRegion++;
+
+	#if defined( portCCM_HEAP_START ) && defined( portCCM_HEAP_END )
+	{
+		/* The CCM RAM left over by the .ccmram section may be too small to
+		hold even the end marker, in which case the region is left out. */
+		if( ( size_t ) ( portCCM_HEAP_END - portCCM_HEAP_START ) > ( xHeapStructSize << 2 ) )
+		{
+			xDefaultRegions[ xRegion ].pucStartAddress = portCCM_HEAP_START;
+			xDefaultRegions[ xRegion ].xSizeInBytes = ( size_t ) ( portCCM_HEAP_END - portCCM_HEAP_START );
+			xRegion++;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* portCCM_HEAP_START */
+
+	/* Terminate the array. */
+	xDefaultRegions[ xRegion ].pucStartAddress = NULL;
+	xDefaultRegions[ xRegion ].xSizeInBytes = 0;
+
+	vPortDefineHeapRegions( xDefaultRegions );
+
+	#if defined( portCCM_HEAP_START ) && defined( portCCM_HEAP_END )
+	{
+		/* Not DMA capable, so only for pvPortMallocIn(). */
+		if( xDefinedHeapRegions > portHEAP_REGION_CCM )
+		{
+			xHeapRegions[ portHEAP_REGION_CCM ].xInGeneralPool = pdFALSE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* portCCM_HEAP_START */
+}
@@ -58,6 +58,7 @@
 #define portNVIC_SYSTICK_COUNT_FLAG_BIT		( 1UL << 16UL )
 #define portNVIC_PENDSVCLEAR_BIT 			( 1UL << 27UL )
 #define portNVIC_PEND_SYSTICK_CLEAR_BIT		( 1UL << 25UL )
+#define portNVIC_PEND_SYSTICK_SET_BIT		( 1UL << 26UL )
 
 /* Constants used to detect a Cortex-M7 r0p1 core, which should use the ARM_CM7
 r0p1 port. */
@@ -120,10 +121,36 @@ void vPortSetupTimerInterrupt( void );
 /*
  * Exception handlers.
  */
-void xPortPendSVHandler( void ) __attribute__ (( naked ));
-void xPortSysTickHandler( void );
+void xPortPendSVHandler( void ) __attribute__ (( naked )) CCM_FUNCTION;
+void xPortSysTickHandler( void ) CCM_FUNCTION;
 void vPortSVCHandler( void ) __attribute__ (( naked ));
 
+/*
+ * The critical section functions are on every queue and task API path.  When
+ * interrupt masking is timed vPortEnterCritical() is never inlined, so its
+ * return address names the code that entered the critical section.
+ */
+#if( configUSE_INTERRUPT_MASK_TIMING == 1 )
+	void vPortEnterCritical( void ) __attribute__(( noinline )) CCM_FUNCTION;
+#else
+	void vPortEnterCritical( void ) CCM_FUNCTION;
+#endif
+void vPortExitCritical( void ) CCM_FUNCTION;
+
+/*
+ * Timed versions of the BASEPRI functions, used by the interrupt masking
+ * macros when configUSE_INTERRUPT_MASK_TIMING is 1.  Never inlined, so the
+ * return address names the code that masked interrupts.  The window is opened
+ * by prvRaiseBASEPRITimed(), which records pvCaller as the code that raised
+ * the mask.
+ */
+#if( configUSE_INTERRUPT_MASK_TIMING == 1 )
+	static uint32_t prvRaiseBASEPRITimed( void *pvCaller ) CCM_FUNCTION;
+	void vPortRaiseBASEPRITimed( void ) __attribute__(( noinline )) CCM_FUNCTION;
+	uint32_t ulPortRaiseBASEPRITimed( void ) __attribute__(( noinline )) CCM_FUNCTION;
+	void vPortSetBASEPRITimed( uint32_t ulNewMaskValue ) __attribute__(( noinline )) CCM_FUNCTION;
+#endif
+
 /*
  * Start first task is a separate function so it can be tested in isolation.
  */
@@ -145,6 +172,15 @@ static void prvTaskExitError( void );
 variable. */
 static UBaseType_t uxCriticalNesting = 0xaaaaaaaa;
 
+/* Interrupt masking statistics.  Only one window can be open at a time: while
+BASEPRI is raised no interrupt that uses the masking functions can run. */
+#if( configUSE_INTERRUPT_MASK_TIMING == 1 )
+	static PortInterruptMaskStats_t xMaskStats = { 0 };
+	static uint32_t ulMaskStart = 0;
+	static void *pvMaskCaller = NULL;
+	static BaseType_t xMaskOpen = pdFALSE;
+#endif
+
 /*
  * The number of SysTick increments that make up one tick period.
  */
@@ -369,6 +405,15 @@ BaseType_t xPortStartScheduler( void )
 	/* Initialise the critical nesting count ready for the first task. */
 	uxCriticalNesting = 0;
 
+	#if( configUSE_INTERRUPT_MASK_TIMING == 1 )
+	{
+		/* The first task unmasks interrupts in assembly, so the window opened
+		when the scheduler was started is never closed. */
+		portCONFIGURE_CYCLE_COUNTER();
+		xMaskOpen = pdFALSE;
+	}
+	#endif
+
 	/* Ensure the VFP is enabled - it should be anyway. */
 	vPortEnableVFP();
 
@@ -402,7 +447,17 @@ void vPortEndScheduler( void )
 
 void vPortEnterCritical( void )
 {
-	portDISABLE_INTERRUPTS();
+	#if( configUSE_INTERRUPT_MASK_TIMING == 1 )
+	{
+		/* One frame up, so the window is charged to the caller rather than to
+		this function. */
+		( void ) prvRaiseBASEPRITimed( __builtin_return_address( 0 ) );
+	}
+	#else
+	{
+		portDISABLE_INTERRUPTS();
+	}
+	#endif
 	uxCriticalNesting++;
 
 	/* This is not the interrupt safe version of the enter critical function so
@@ -428,6 +483,83 @@ void vPortExitCritical( void )
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_INTERRUPT_MASK_TIMING == 1 )
+
+	static uint32_t prvRaiseBASEPRITimed( void *pvCaller )
+	{
+	uint32_t ulOriginalBASEPRI;
+
+		ulOriginalBASEPRI = ulPortRaiseBASEPRI();
+
+		/* Only the outermost raise opens a window. */
+		if( ulOriginalBASEPRI == 0 )
+		{
+			ulMaskStart = portGET_CYCLE_COUNTER();
+			pvMaskCaller = pvCaller;
+			xMaskOpen = pdTRUE;
+		}
+
+		return ulOriginalBASEPRI;
+	}
+	/*-----------------------------------------------------------*/
+
+	uint32_t ulPortRaiseBASEPRITimed( void )
+	{
+		return prvRaiseBASEPRITimed( __builtin_return_address( 0 ) );
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortRaiseBASEPRITimed( void )
+	{
+		( void ) prvRaiseBASEPRITimed( __builtin_return_address( 0 ) );
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortSetBASEPRITimed( uint32_t ulNewMaskValue )
+	{
+	uint32_t ulCycles;
+
+		if( ( ulNewMaskValue == 0 ) && ( xMaskOpen != pdFALSE ) )
+		{
+			ulCycles = portGET_CYCLE_COUNTER() - ulMaskStart;
+			xMaskOpen = pdFALSE;
+
+			xMaskStats.ulCount++;
+			xMaskStats.ullTotalCycles += ulCycles;
+			if( ulCycles > xMaskStats.ulMaxCycles )
+			{
+				xMaskStats.ulMaxCycles = ulCycles;
+				xMaskStats.pvMaxCaller = pvMaskCaller;
+			}
+		}
+
+		vPortSetBASEPRI( ulNewMaskValue );
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortGetInterruptMaskStats( PortInterruptMaskStats_t *pxStats, BaseType_t xReset )
+	{
+	uint32_t ulOriginalBASEPRI;
+
+		/* Not through the timed functions, this window is not measured. */
+		ulOriginalBASEPRI = ulPortRaiseBASEPRI();
+		{
+			*pxStats = xMaskStats;
+
+			if( xReset != pdFALSE )
+			{
+				xMaskStats.ulMaxCycles = 0;
+				xMaskStats.pvMaxCaller = NULL;
+				xMaskStats.ulCount = 0;
+				xMaskStats.ullTotalCycles = 0;
+			}
+		}
+		vPortSetBASEPRI( ulOriginalBASEPRI );
+	}
+
+#endif /* configUSE_INTERRUPT_MASK_TIMING */
+/*-----------------------------------------------------------*/
+
 void xPortPendSVHandler( void )
 {
 	/* This is a naked function. */
@@ -487,6 +619,8 @@ void xPortPendSVHandler( void )
 
 void xPortSysTickHandler( void )
 {
+	traceISR_ENTER();
+
 	/* The SysTick runs at the lowest interrupt priority, so when this interrupt
 	executes all interrupts must be unmasked.  There is therefore no need to
 	save and then restore the interrupt mask value as its value is already
@@ -502,6 +636,8 @@ void xPortSysTickHandler( void )
 		}
 	}
 	portENABLE_INTERRUPTS();
+
+	traceISR_EXIT();
 }
 /*-----------------------------------------------------------*/
 
@@ -697,6 +833,44 @@ __attribute__(( weak )) void vPortSetupTimerInterrupt( void )
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_MICROSECOND_TIME == 1 )
+
+	uint32_t ulPortGetMicrosecondsSinceTick( BaseType_t * const pxTickPending )
+	{
+	uint32_t ulCurrentValue, ulElapsedCounts;
+
+		ulCurrentValue = portNVIC_SYSTICK_CURRENT_VALUE_REG;
+
+		/* If SysTick has wrapped but the tick interrupt is still pending (the
+		caller has interrupts masked, or the read raced the reload) then the
+		value read may belong to either side of the reload, so read it again
+		now the wrap is known to have happened. */
+		if( ( portNVIC_INT_CTRL_REG & portNVIC_PEND_SYSTICK_SET_BIT ) != 0UL )
+		{
+			ulCurrentValue = portNVIC_SYSTICK_CURRENT_VALUE_REG;
+			*pxTickPending = pdTRUE;
+		}
+		else
+		{
+			*pxTickPending = pdFALSE;
+		}
+
+		/* SysTick counts down from the reload value.  The reload value is
+		only different from a whole tick period in the tick that follows a
+		tickless idle period, during which the result is approximate. */
+		ulElapsedCounts = portNVIC_SYSTICK_LOAD_REG - ulCurrentValue;
+
+		/* configSYSTICK_CLOCK_HZ may be a variable, so the scaling is done at
+		run time.  Scaling in two steps of 1000 keeps the result exact for any
+		clock that is a whole number of kHz, even when it is not a whole
+		number of MHz, and does not overflow while a tick period is shorter
+		than 4294967 timer counts (any tick rate above 17Hz at 72MHz). */
+		return ( ulElapsedCounts * 1000UL ) / ( configSYSTICK_CLOCK_HZ / 1000UL );
+	}
+
+#endif /* configUSE_MICROSECOND_TIME */
+/*-----------------------------------------------------------*/
+
 /* This is a naked function. */
 static void vPortEnableVFP( void )
 {
@@ -41,6 +41,10 @@ task.h is included from an application file. */
 	#include "croutine.h"
 #endif
 
+#if ( configUSE_POLL_SETS == 1 )
+	#include "poll_set.h"
+#endif
+
 /* Lint e961 and e750 are suppressed as a MISRA exception justified because the
 MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
 header files above, but not in this file, in order to generate the correct
@@ -72,6 +76,16 @@ zero. */
 #define queueSEMAPHORE_QUEUE_ITEM_LENGTH ( ( UBaseType_t ) 0 )
 #define queueMUTEX_GIVE_BLOCK_TIME		 ( ( TickType_t ) 0U )
 
+/* How items are copied in and out of the queue storage area, chosen when the
+queue is created from the item size and the alignment of the storage area.
+See prvCopyItem(). */
+#define queueCOPY_MEMCPY				( ( uint8_t ) 0U )
+#define queueCOPY_1_BYTE				( ( uint8_t ) 1U )
+#define queueCOPY_2_BYTES				( ( uint8_t ) 2U )
+#define queueCOPY_4_BYTES				( ( uint8_t ) 3U )
+#define queueCOPY_8_BYTES				( ( uint8_t ) 4U )
+#define queueCOPY_WORDS					( ( uint8_t ) 5U )
+
 #if( configUSE_PREEMPTION == 0 )
 	/* If the cooperative scheduler is being used then a yield should not be
 	performed just because a higher priority task has been woken. */
@@ -80,6 +94,24 @@ zero. */
 	#define queueYIELD_IF_USING_PREEMPTION() portYIELD_WITHIN_API()
 #endif
 
+#if( configUSE_POLL_SETS == 1 )
+	/* Sets the bit of a queue that has just received an item in the poll set
+	the queue is a member of, if any. */
+	#define queueSIGNAL_POLL_SET( pxQueue )											\
+		if( ( pxQueue )->pvPollSet != NULL )										\
+		{																			\
+			vPollSetSignal( ( pxQueue )->pvPollSet, 1UL << ( pxQueue )->uxPollBit );	\
+		}
+	#define queueSIGNAL_POLL_SET_FROM_ISR( pxQueue, pxHigherPriorityTaskWoken )		\
+		if( ( pxQueue )->pvPollSet != NULL )										\
+		{																			\
+			vPollSetSignalFromISR( ( pxQueue )->pvPollSet, 1UL << ( pxQueue )->uxPollBit, ( pxHigherPriorityTaskWoken ) );	\
+		}
+#else
+	#define queueSIGNAL_POLL_SET( pxQueue )
+	#define queueSIGNAL_POLL_SET_FROM_ISR( pxQueue, pxHigherPriorityTaskWoken )
+#endif
+
 /*
  * Definition of the queue used by the scheduler.
  * Items are queued by copy, not reference.  See the following link for the
@@ -106,6 +138,7 @@ typedef struct QueueDefinition
 
 	volatile int8_t cRxLock;		/*< Stores the number of items received from the queue (removed from the queue) while the queue was locked.  Set to queueUNLOCKED when the queue is not locked. */
 	volatile int8_t cTxLock;		/*< Stores the number of items transmitted to the queue (added to the queue) while the queue was locked.  Set to queueUNLOCKED when the queue is not locked. */
+	uint8_t ucCopyMode;				/*< One of the queueCOPY_ values, set when the queue is created. */
 
 	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 		uint8_t ucStaticallyAllocated;	/*< Set to pdTRUE if the memory used by the queue was statically allocated to ensure no attempt is made to free the memory. */
@@ -120,6 +153,17 @@ typedef struct QueueDefinition
 		uint8_t ucQueueType;
 	#endif
 
+	#if ( configUSE_ADAPTIVE_SEMAPHORE_SPIN == 1 )
+		UBaseType_t uxSpinEstimate;		/*< Running average of the number of polls a successful spin needed.  Sets the bound on the next spin. */
+		UBaseType_t uxSpinSuccesses;	/*< Number of takes that obtained the semaphore by spinning rather than blocking. */
+		UBaseType_t uxSpinFailures;		/*< Number of spins that gave up and fell through to the block path. */
+	#endif
+
+	#if ( configUSE_POLL_SETS == 1 )
+		void *pvPollSet;				/*< The poll set the queue is a member of, or NULL. */
+		UBaseType_t uxPollBit;			/*< The bit of the queue in its poll set. */
+	#endif
+
 } xQUEUE;
 
 /* The old xQUEUE name is maintained above then typedefed to the new Queue_t
@@ -163,7 +207,7 @@ typedef xQUEUE Queue_t;
  * to indicate that a task may require unblocking.  When the queue in unlocked
  * these lock counts are inspected, and the appropriate action taken.
  */
-static void prvUnlockQueue( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+static void prvUnlockQueue( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION CCM_FUNCTION;
 
 /*
  * Uses a critical section to determine if there is any data in a queue.
@@ -183,12 +227,24 @@ static BaseType_t prvIsQueueFull( const Queue_t *pxQueue ) PRIVILEGED_FUNCTION;
  * Copies an item into the queue, either at the front of the queue or the
  * back of the queue.
  */
-static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue, const void *pvItemToQueue, const BaseType_t xPosition ) PRIVILEGED_FUNCTION;
+static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue, const void *pvItemToQueue, const BaseType_t xPosition ) PRIVILEGED_FUNCTION CCM_FUNCTION;
 
 /*
  * Copies an item out of a queue.
  */
-static void prvCopyDataFromQueue( Queue_t * const pxQueue, void * const pvBuffer ) PRIVILEGED_FUNCTION;
+static void prvCopyDataFromQueue( Queue_t * const pxQueue, void * const pvBuffer ) PRIVILEGED_FUNCTION CCM_FUNCTION;
+
+/*
+ * Copies one item, using the copy mode chosen for the queue.  Inlined into the
+ * two functions above.
+ */
+static portFORCE_INLINE void prvCopyItem( const Queue_t * const pxQueue, void * const pvDestination, const void * const pvSource );
+
+/*
+ * Chooses the copy mode of a queue, once its item size and storage area are
+ * set.
+ */
+static uint8_t prvQueueCopyMode( const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
 
 #if ( configUSE_QUEUE_SETS == 1 )
 	/*
@@ -223,6 +279,18 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 	 */
 	static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
 #endif
+
+#if( configUSE_ADAPTIVE_SEMAPHORE_SPIN == 1 )
+	/*
+	 * Called by xQueueSemaphoreTake() before the calling task would first
+	 * block on an unavailable semaphore.  Polls the semaphore count, with
+	 * interrupts enabled, for a bounded number of iterations derived from how
+	 * long previous successful spins on the same semaphore took.  Returns
+	 * pdTRUE if the count became non-zero while spinning, in which case the
+	 * caller should retry the take rather than block.
+	 */
+	static BaseType_t prvSpinForSemaphore( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+#endif
 /*-----------------------------------------------------------*/
 
 /*
@@ -429,6 +497,7 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 	defined. */
 	pxNewQueue->uxLength = uxQueueLength;
 	pxNewQueue->uxItemSize = uxItemSize;
+	pxNewQueue->ucCopyMode = prvQueueCopyMode( pxNewQueue );
 	( void ) xQueueGenericReset( pxNewQueue, pdTRUE );
 
 	#if ( configUSE_TRACE_FACILITY == 1 )
@@ -443,6 +512,20 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 	}
 	#endif /* configUSE_QUEUE_SETS */
 
+	#if( configUSE_POLL_SETS == 1 )
+	{
+		pxNewQueue->pvPollSet = NULL;
+	}
+	#endif /* configUSE_POLL_SETS */
+
+	#if( configUSE_ADAPTIVE_SEMAPHORE_SPIN == 1 )
+	{
+		pxNewQueue->uxSpinEstimate = ( UBaseType_t ) configSEMAPHORE_SPIN_MIN;
+		pxNewQueue->uxSpinSuccesses = ( UBaseType_t ) 0U;
+		pxNewQueue->uxSpinFailures = ( UBaseType_t ) 0U;
+	}
+	#endif /* configUSE_ADAPTIVE_SEMAPHORE_SPIN */
+
 	traceQUEUE_CREATE( pxNewQueue );
 }
 /*-----------------------------------------------------------*/
@@ -753,6 +836,7 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 			{
 				traceQUEUE_SEND( pxQueue );
 				xYieldRequired = prvCopyDataToQueue( pxQueue, pvItemToQueue, xCopyPosition );
+				queueSIGNAL_POLL_SET( pxQueue );
 
 				#if ( configUSE_QUEUE_SETS == 1 )
 				{
@@ -965,6 +1049,7 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 			called here even though the disinherit function does not check if
 			the scheduler is suspended before accessing the ready lists. */
 			( void ) prvCopyDataToQueue( pxQueue, pvItemToQueue, xCopyPosition );
+			queueSIGNAL_POLL_SET_FROM_ISR( pxQueue, pxHigherPriorityTaskWoken );
 
 			/* The event list is not altered if the queue is locked.  This will
 			be done when the queue is unlocked later. */
@@ -1130,6 +1215,7 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 			priority disinheritance is needed.  Simply increase the count of
 			messages (semaphores) available. */
 			pxQueue->uxMessagesWaiting = uxMessagesWaiting + ( UBaseType_t ) 1;
+			queueSIGNAL_POLL_SET_FROM_ISR( pxQueue, pxHigherPriorityTaskWoken );
 
 			/* The event list is not altered if the queue is locked.  This will
 			be done when the queue is unlocked later. */
@@ -1485,6 +1571,21 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 					so configure the timeout structure ready to block. */
 					vTaskInternalSetTimeOutState( &xTimeOut );
 					xEntryTimeSet = pdTRUE;
+
+					#if( configUSE_ADAPTIVE_SEMAPHORE_SPIN == 1 )
+					{
+						/* Before blocking for the first time, poll for a short
+						while in case the semaphore is about to be given. */
+						taskEXIT_CRITICAL();
+
+						if( prvSpinForSemaphore( pxQueue ) != pdFALSE )
+						{
+							continue;
+						}
+
+						taskENTER_CRITICAL();
+					}
+					#endif /* configUSE_ADAPTIVE_SEMAPHORE_SPIN */
 				}
 				else
 				{
@@ -1950,6 +2051,19 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 	}
 	#endif
 
+	#if ( configUSE_POLL_SETS == 1 )
+	{
+		if( pxQueue->pvPollSet != NULL )
+		{
+			( void ) xPollSetRemoveQueue( pxQueue->pvPollSet, xQueue );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
+
 	#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
 	{
 		/* The queue can only have been allocated dynamically - free it
@@ -2009,6 +2123,100 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 #endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
 
+#if( configUSE_ADAPTIVE_SEMAPHORE_SPIN == 1 )
+
+	static BaseType_t prvSpinForSemaphore( Queue_t * const pxQueue )
+	{
+	UBaseType_t uxSpinLimit, uxSpins = 0;
+	BaseType_t xReturn;
+
+		#if( configSEMAPHORE_SPIN_ON_MUTEXES == 0 )
+		{
+			/* On a single core the holder of a mutex is a task that cannot
+			run while the calling task spins, so spinning can only waste
+			time. */
+			if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+			{
+				return pdFALSE;
+			}
+		}
+		#endif
+
+		/* Allow the spin to run to twice the average number of polls that
+		recent successful spins needed, plus some headroom, but never beyond
+		the configured maximum. */
+		uxSpinLimit = ( pxQueue->uxSpinEstimate * ( UBaseType_t ) 2 ) + ( UBaseType_t ) configSEMAPHORE_SPIN_MIN;
+		if( uxSpinLimit > ( UBaseType_t ) configSEMAPHORE_SPIN_MAX )
+		{
+			uxSpinLimit = ( UBaseType_t ) configSEMAPHORE_SPIN_MAX;
+		}
+
+		/* uxMessagesWaiting is volatile and a single word, so it can be
+		polled outside of a critical section. */
+		while( ( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0 ) && ( uxSpins < uxSpinLimit ) )
+		{
+			portSPIN_WAIT_HINT();
+			uxSpins++;
+		}
+
+		taskENTER_CRITICAL();
+		{
+			if( pxQueue->uxMessagesWaiting != ( UBaseType_t ) 0 )
+			{
+				/* Move the estimate one eighth of the way towards the number
+				of polls this spin needed. */
+				if( uxSpins > pxQueue->uxSpinEstimate )
+				{
+					pxQueue->uxSpinEstimate += ( uxSpins - pxQueue->uxSpinEstimate ) >> 3;
+				}
+				else
+				{
+					pxQueue->uxSpinEstimate -= ( pxQueue->uxSpinEstimate - uxSpins ) >> 3;
+				}
+
+				( pxQueue->uxSpinSuccesses )++;
+				traceQUEUE_SPIN_SUCCESS( pxQueue, uxSpins );
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				/* Back off quickly so a semaphore that is normally held for a
+				long time soon stops costing a spin on every take. */
+				pxQueue->uxSpinEstimate -= pxQueue->uxSpinEstimate >> 2;
+				( pxQueue->uxSpinFailures )++;
+				traceQUEUE_SPIN_FAILED( pxQueue, uxSpins );
+				xReturn = pdFALSE;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_ADAPTIVE_SEMAPHORE_SPIN */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_ADAPTIVE_SEMAPHORE_SPIN == 1 )
+
+	void vQueueGetSpinStats( QueueHandle_t xQueue, QueueSpinStats_t *pxSpinStats )
+	{
+	Queue_t * const pxQueue = ( Queue_t * ) xQueue;
+
+		configASSERT( pxQueue );
+		configASSERT( pxSpinStats );
+
+		taskENTER_CRITICAL();
+		{
+			pxSpinStats->uxSpinEstimate = pxQueue->uxSpinEstimate;
+			pxSpinStats->uxSpinSuccesses = pxQueue->uxSpinSuccesses;
+			pxSpinStats->uxSpinFailures = pxQueue->uxSpinFailures;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_ADAPTIVE_SEMAPHORE_SPIN */
+/*-----------------------------------------------------------*/
+
 #if( configUSE_MUTEXES == 1 )
 
 	static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const Queue_t * const pxQueue )
@@ -2036,6 +2244,104 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+static uint8_t prvQueueCopyMode( const Queue_t * const pxQueue )
+{
+uint8_t ucMode;
+
+	if( ( pxQueue->uxItemSize == ( UBaseType_t ) 0 ) || ( pxQueue->uxItemSize > ( UBaseType_t ) configQUEUE_INLINE_COPY_MAX_SIZE ) )
+	{
+		/* Semaphores copy nothing, large items are left to the library. */
+		ucMode = queueCOPY_MEMCPY;
+	}
+	else if( pxQueue->uxItemSize == ( UBaseType_t ) 1 )
+	{
+		ucMode = queueCOPY_1_BYTE;
+	}
+	else if( pxQueue->uxItemSize == ( UBaseType_t ) 2 )
+	{
+		ucMode = queueCOPY_2_BYTES;
+	}
+	else if( pxQueue->uxItemSize == ( UBaseType_t ) 4 )
+	{
+		/* Pointers, handles and the osMessage/osMail items. */
+		ucMode = queueCOPY_4_BYTES;
+	}
+	else if( pxQueue->uxItemSize == ( UBaseType_t ) 8 )
+	{
+		ucMode = queueCOPY_8_BYTES;
+	}
+	else if( ( ( pxQueue->uxItemSize & ( sizeof( uint32_t ) - 1U ) ) == 0U ) &&
+			 ( ( ( ( size_t ) pxQueue->pcHead ) & ( sizeof( uint32_t ) - 1U ) ) == 0U ) )
+	{
+		/* Small structures in a word aligned storage area: every item in the
+		storage area is word aligned too.  The buffer of the caller is checked
+		on each copy. */
+		ucMode = queueCOPY_WORDS;
+	}
+	else
+	{
+		ucMode = queueCOPY_MEMCPY;
+	}
+
+	return ucMode;
+}
+/*-----------------------------------------------------------*/
+
+static portFORCE_INLINE void prvCopyItem( const Queue_t * const pxQueue, void * const pvDestination, const void * const pvSource )
+{
+	/* A memcpy() of a constant size is expanded by the compiler into loads and
+	stores, which the Cortex-M4 allows at any alignment, so only the last case
+	calls the library with a variable size. */
+	switch( pxQueue->ucCopyMode )
+	{
+		case queueCOPY_4_BYTES:
+			( void ) memcpy( pvDestination, pvSource, 4U );
+			break;
+
+		case queueCOPY_1_BYTE:
+			( void ) memcpy( pvDestination, pvSource, 1U );
+			break;
+
+		case queueCOPY_2_BYTES:
+			( void ) memcpy( pvDestination, pvSource, 2U );
+			break;
+
+		case queueCOPY_8_BYTES:
+			( void ) memcpy( pvDestination, pvSource, 8U );
+			break;
+
+		case queueCOPY_WORDS:
+		{
+		uint32_t *pulDestination = ( uint32_t * ) pvDestination;
+		const uint32_t *pulSource = ( const uint32_t * ) pvSource;
+		UBaseType_t uxWords = pxQueue->uxItemSize / sizeof( uint32_t );
+
+			/* The item in the storage area is word aligned, the buffer of the
+			caller may not be. */
+			if( ( ( ( size_t ) pvDestination | ( size_t ) pvSource ) & ( sizeof( uint32_t ) - 1U ) ) == 0U )
+			{
+				do
+				{
+					*pulDestination = *pulSource;
+					pulDestination++;
+					pulSource++;
+					uxWords--;
+				} while( uxWords != ( UBaseType_t ) 0 );
+			}
+			else
+			{
+				( void ) memcpy( pvDestination, pvSource, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 MISRA exception as the casts are only redundant for some ports. */
+			}
+			break;
+		}
+
+		default:
+			( void ) memcpy( pvDestination, pvSource, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 MISRA exception as the casts are only redundant for some ports. */
+			break;
+	}
+}
+/*-----------------------------------------------------------*/
+
 static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue, const void *pvItemToQueue, const BaseType_t xPosition )
 {
 BaseType_t xReturn = pdFALSE;
@@ -2064,7 +2370,7 @@ UBaseType_t uxMessagesWaiting;
 	}
 	else if( xPosition == queueSEND_TO_BACK )
 	{
-		( void ) memcpy( ( void * ) pxQueue->pcWriteTo, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 MISRA exception as the casts are only redundant for some ports, plus previous logic ensures a null pointer can only be passed to memcpy() if the copy size is 0. */
+		prvCopyItem( pxQueue, ( void * ) pxQueue->pcWriteTo, pvItemToQueue );
 		pxQueue->pcWriteTo += pxQueue->uxItemSize;
 		if( pxQueue->pcWriteTo >= pxQueue->pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
 		{
@@ -2077,7 +2383,7 @@ UBaseType_t uxMessagesWaiting;
 	}
 	else
 	{
-		( void ) memcpy( ( void * ) pxQueue->u.pcReadFrom, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+		prvCopyItem( pxQueue, ( void * ) pxQueue->u.pcReadFrom, pvItemToQueue );
 		pxQueue->u.pcReadFrom -= pxQueue->uxItemSize;
 		if( pxQueue->u.pcReadFrom < pxQueue->pcHead ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
 		{
@@ -2128,7 +2434,7 @@ static void prvCopyDataFromQueue( Queue_t * const pxQueue, void * const pvBuffer
 		{
 			mtCOVERAGE_TEST_MARKER();
 		}
-		( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.pcReadFrom, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 MISRA exception as the casts are only redundant for some ports.  Also previous logic ensures a null pointer can only be passed to memcpy() when the count is 0. */
+		prvCopyItem( pxQueue, pvBuffer, ( void * ) pxQueue->u.pcReadFrom );
 	}
 }
 /*-----------------------------------------------------------*/
@@ -2894,6 +3200,88 @@ BaseType_t xReturn;
 	}
 
 #endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_POLL_SETS == 1 )
+
+	BaseType_t xPollSetAddQueue( PollSetHandle_t xPollSet, QueueHandle_t xQueue, UBaseType_t uxBit )
+	{
+	Queue_t * const pxQueue = ( Queue_t * ) xQueue;
+	BaseType_t xReturn = pdFAIL;
+
+		configASSERT( pxQueue );
+
+		/* Giving a mutex back is not data arriving. */
+		configASSERT( pxQueue->uxQueueType != queueQUEUE_IS_MUTEX );
+
+		taskENTER_CRITICAL();
+		{
+			if( pxQueue->pvPollSet == NULL )
+			{
+				if( xPollSetAddBit( xPollSet, uxBit ) != pdFAIL )
+				{
+					pxQueue->pvPollSet = xPollSet;
+					pxQueue->uxPollBit = uxBit;
+
+					/* The items already queued arrived before the queue was
+					a member, so did not set its bit. */
+					if( pxQueue->uxMessagesWaiting != ( UBaseType_t ) 0 )
+					{
+						vPollSetSignal( xPollSet, 1UL << uxBit );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					xReturn = pdPASS;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_POLL_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_POLL_SETS == 1 )
+
+	BaseType_t xPollSetRemoveQueue( PollSetHandle_t xPollSet, QueueHandle_t xQueue )
+	{
+	Queue_t * const pxQueue = ( Queue_t * ) xQueue;
+	BaseType_t xReturn = pdFAIL;
+
+		configASSERT( pxQueue );
+
+		taskENTER_CRITICAL();
+		{
+			if( pxQueue->pvPollSet == xPollSet )
+			{
+				vPollSetRemoveBit( xPollSet, pxQueue->uxPollBit );
+				pxQueue->pvPollSet = NULL;
+				xReturn = pdPASS;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_POLL_SETS */
 
 
 
@@ -40,6 +40,10 @@ task.h is included from an application file. */
 #include "timers.h"
 #include "stack_macros.h"
 
+#if( configUSE_PERIODIC_TASKS == 1 )
+	#include "periodic.h"
+#endif
+
 /* Lint e961 and e750 are suppressed as a MISRA exception justified because the
 MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
 header files above, but not in this file, in order to generate the correct
@@ -115,6 +119,14 @@ set then don't fill the stack so there is no unnecessary dependency on memset. *
 #define tskDELETED_CHAR		( 'D' )
 #define tskSUSPENDED_CHAR	( 'S' )
 
+/*
+ * Constants used by the 64-bit and microsecond time API.  The tick rate must
+ * divide 1MHz exactly for the microsecond time to be exact.
+ */
+#define tskTICK_COUNT_BITS				( sizeof( TickType_t ) * ( size_t ) 8 )
+#define tskMICROSECONDS_PER_TICK		( ( uint32_t ) 1000000UL / ( uint32_t ) configTICK_RATE_HZ )
+#define tskMAX_DELAY_UNTIL_BLOCK_TICKS	( portMAX_DELAY >> 1 )
+
 /*
  * Some kernel aware debuggers require the data the debugger needs access to be
  * global, rather than file scope.
@@ -129,6 +141,13 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 	#define configIDLE_TASK_NAME "IDLE"
 #endif
 
+/* Dimensions of the ready priority bit map used by port optimised task
+selection when configMAX_PRIORITIES is larger than a single bit map word. */
+#define taskPRIORITIES_PER_BITMAP_WORD	( 32 )
+#define taskBITMAP_WORD_SHIFT			( 5U )
+#define taskBITMAP_WORD_MASK			( 0x1FU )
+#define taskBITMAP_WORDS				( ( configMAX_PRIORITIES + ( taskPRIORITIES_PER_BITMAP_WORD - 1 ) ) / taskPRIORITIES_PER_BITMAP_WORD )
+
 #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
 
 	/* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 0 then task selection is
@@ -166,11 +185,11 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 
 	/*-----------------------------------------------------------*/
 
-	/* Define away taskRESET_READY_PRIORITY() and portRESET_READY_PRIORITY() as
+	/* Define away taskRESET_READY_PRIORITY() and taskCLEAR_READY_PRIORITY() as
 	they are only required when a port optimised method of task selection is
 	being used. */
 	#define taskRESET_READY_PRIORITY( uxPriority )
-	#define portRESET_READY_PRIORITY( uxPriority, uxTopReadyPriority )
+	#define taskCLEAR_READY_PRIORITY( uxPriority )
 
 #else /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
 
@@ -178,8 +197,49 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 	performed in a way that is tailored to the particular microcontroller
 	architecture being used. */
 
-	/* A port optimised version is provided.  Call the port defined macros. */
-	#define taskRECORD_READY_PRIORITY( uxPriority )	portRECORD_READY_PRIORITY( uxPriority, uxTopReadyPriority )
+	#if( configMAX_PRIORITIES <= taskPRIORITIES_PER_BITMAP_WORD )
+
+		/* A port optimised version is provided.  Call the port defined macros.
+		uxTopReadyPriority is used as a bit map with one bit per priority. */
+		#define taskRECORD_READY_PRIORITY( uxPriority )	portRECORD_READY_PRIORITY( uxPriority, uxTopReadyPriority )
+		#define taskCLEAR_READY_PRIORITY( uxPriority )	portRESET_READY_PRIORITY( ( uxPriority ), uxTopReadyPriority )
+		#define taskGET_HIGHEST_READY_PRIORITY( uxTopPriority ) portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority )
+
+	#else
+
+		/* There are more priorities than bits in a word, so a two level bit map
+		is used.  Bit n of uxReadyPriorityBitmap[ g ] is set when priority
+		( g * 32 ) + n has ready tasks, and uxTopReadyPriority holds one bit
+		per non-zero word of uxReadyPriorityBitmap.  Finding the highest ready
+		priority is then two port optimised lookups, whatever the number of
+		priorities. */
+		#define taskRECORD_READY_PRIORITY( uxPriority )																	\
+		{																												\
+			portRECORD_READY_PRIORITY( ( ( uxPriority ) & taskBITMAP_WORD_MASK ), uxReadyPriorityBitmap[ ( uxPriority ) >> taskBITMAP_WORD_SHIFT ] );	\
+			portRECORD_READY_PRIORITY( ( ( uxPriority ) >> taskBITMAP_WORD_SHIFT ), uxTopReadyPriority );				\
+		}
+
+		#define taskCLEAR_READY_PRIORITY( uxPriority )																	\
+		{																												\
+		const UBaseType_t uxBitmapWord = ( uxPriority ) >> taskBITMAP_WORD_SHIFT;										\
+																														\
+			portRESET_READY_PRIORITY( ( ( uxPriority ) & taskBITMAP_WORD_MASK ), uxReadyPriorityBitmap[ uxBitmapWord ] );	\
+			if( uxReadyPriorityBitmap[ uxBitmapWord ] == ( UBaseType_t ) 0 )											\
+			{																											\
+				portRESET_READY_PRIORITY( uxBitmapWord, uxTopReadyPriority );											\
+			}																											\
+		}
+
+		#define taskGET_HIGHEST_READY_PRIORITY( uxTopPriority )														\
+		{																												\
+		UBaseType_t uxTopBitmapWord;																					\
+																														\
+			portGET_HIGHEST_PRIORITY( uxTopBitmapWord, uxTopReadyPriority );											\
+			portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorityBitmap[ uxTopBitmapWord ] );						\
+			uxTopPriority += uxTopBitmapWord << taskBITMAP_WORD_SHIFT;													\
+		}
+
+	#endif /* configMAX_PRIORITIES */
 
 	/*-----------------------------------------------------------*/
 
@@ -188,7 +248,7 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 	UBaseType_t uxTopPriority;																		\
 																									\
 		/* Find the highest priority list that contains ready tasks. */								\
-		portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority );								\
+		taskGET_HIGHEST_READY_PRIORITY( uxTopPriority );											\
 		configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ] ) ) > 0 );		\
 		listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );		\
 	} /* taskSELECT_HIGHEST_PRIORITY_TASK() */
@@ -202,7 +262,7 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 	{																									\
 		if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ ( uxPriority ) ] ) ) == ( UBaseType_t ) 0 )	\
 		{																								\
-			portRESET_READY_PRIORITY( ( uxPriority ), ( uxTopReadyPriority ) );							\
+			taskCLEAR_READY_PRIORITY( ( uxPriority ) );													\
 		}																								\
 	}
 
@@ -261,6 +321,11 @@ to its original value when it is released. */
 	#define taskEVENT_LIST_ITEM_VALUE_IN_USE	0x80000000UL
 #endif
 
+/* Values that can be assigned to the ucBudgetState member of the TCB. */
+#define taskBUDGET_AVAILABLE	( ( uint8_t ) 0 )
+#define taskBUDGET_EXHAUSTED	( ( uint8_t ) 1 )
+#define taskBUDGET_DEMOTED		( ( uint8_t ) 2 )
+
 /*
  * Task control block.  A task control block (TCB) is allocated for each task,
  * and stores task state information, including a pointer to the task's context
@@ -322,8 +387,8 @@ typedef struct tskTaskControlBlock
 	#endif
 
 	#if( configUSE_TASK_NOTIFICATIONS == 1 )
-		volatile uint32_t ulNotifiedValue;
-		volatile uint8_t ucNotifyState;
+		volatile uint32_t ulNotifiedValue[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
+		volatile uint8_t ucNotifyState[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
 	#endif
 
 	/* See the comments above the definition of
@@ -336,6 +401,26 @@ typedef struct tskTaskControlBlock
 		uint8_t ucDelayAborted;
 	#endif
 
+	#if( configUSE_TASK_BUDGETS == 1 )
+		uint32_t		ulBudgetCycles;			/*< Execution time allowed per replenishment period, in portGET_CYCLE_COUNTER() counts.  0 if the task has no budget. */
+		uint32_t		ulBudgetRemaining;		/*< Execution time left in the current replenishment period. */
+		TickType_t		xBudgetPeriod;			/*< The replenishment period in ticks. */
+		TickType_t		xBudgetPeriodStart;		/*< The tick count at which the current replenishment period started. */
+		UBaseType_t		uxBudgetOverruns;		/*< The number of replenishment periods in which the budget was exhausted. */
+		UBaseType_t		uxBudgetSavedPriority;	/*< The priority to restore when a demoted task is replenished. */
+		uint8_t			ucBudgetAction;			/*< The eBudgetAction taken when the budget is exhausted. */
+		uint8_t			ucBudgetState;			/*< One of the taskBUDGET_ states below. */
+	#endif
+
+	#if( configUSE_TASK_SNAPSHOTS == 1 )
+		struct tskTaskControlBlock *pxNextCreated;	/*< The next older task in the list of all the tasks walked by xTaskTakeSnapshot(). */
+		struct tskTaskControlBlock *pxPrevCreated;	/*< The next newer task in the same list. */
+	#endif
+
+	#if( configUSE_TASK_RECYCLING == 1 )
+		uint32_t		ulRecycleStackDepth;	/*< The stack depth the task was created with by xTaskCreate(), or 0 if its memory cannot be recycled. */
+	#endif
+
 } tskTCB;
 
 /* The old tskTCB name is maintained above then typedefed to the new TCB_t name
@@ -372,6 +457,12 @@ PRIVILEGED_DATA static List_t xPendingReadyList = {0};								/*< Tasks that hav
 PRIVILEGED_DATA static volatile UBaseType_t uxCurrentNumberOfTasks 	= ( UBaseType_t ) 0U;
 PRIVILEGED_DATA static volatile TickType_t xTickCount 				= ( TickType_t ) configINITIAL_TICK_COUNT;
 PRIVILEGED_DATA static volatile UBaseType_t uxTopReadyPriority 		= tskIDLE_PRIORITY;
+
+#if( ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 ) && ( configMAX_PRIORITIES > taskPRIORITIES_PER_BITMAP_WORD ) )
+	/* Second level of the ready priority bit map - see
+	taskRECORD_READY_PRIORITY(). */
+	PRIVILEGED_DATA static volatile UBaseType_t uxReadyPriorityBitmap[ taskBITMAP_WORDS ] = { 0 };
+#endif
 PRIVILEGED_DATA static volatile BaseType_t xSchedulerRunning 		= pdFALSE;
 PRIVILEGED_DATA static volatile UBaseType_t uxPendedTicks 			= ( UBaseType_t ) 0U;
 PRIVILEGED_DATA static volatile BaseType_t xYieldPending 			= pdFALSE;
@@ -397,6 +488,27 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t
 
 #endif
 
+#if ( configUSE_TASK_BUDGETS == 1 )
+
+	PRIVILEGED_DATA static TCB_t * pxBudgetedTasks[ configMAX_BUDGETED_TASKS ] = { NULL };	/*< The tasks that have an execution time budget, scanned on each tick for replenishment. */
+	PRIVILEGED_DATA static uint32_t ulBudgetChargedTime = 0UL;	/*< The cycle counter value when the running task was last charged for its execution time. */
+
+#endif
+
+#if ( configUSE_TASK_SNAPSHOTS == 1 )
+
+	PRIVILEGED_DATA static TCB_t * pxAllTasks = NULL;			/*< Every task that has not been deleted, newest first, linked through pxNextCreated. */
+	PRIVILEGED_DATA static TCB_t * pxSnapshotCursor = NULL;	/*< The next task xTaskTakeSnapshot() records, moved on if that task is deleted first. */
+	PRIVILEGED_DATA static BaseType_t xSnapshotInProgress = pdFALSE;	/*< Set while an xTaskTakeSnapshot() is in progress, so another one fails instead of sharing the cursor. */
+
+#endif
+
+#if ( configUSE_TASK_RECYCLING == 1 )
+
+	PRIVILEGED_DATA static TCB_t * pxRecycledTasks[ configTASK_RECYCLE_POOL_SIZE ] = { NULL };	/*< Deleted tasks kept with their stacks for xTaskCreate() to reuse. */
+
+#endif
+
 /*lint -restore */
 
 /*-----------------------------------------------------------*/
@@ -410,6 +522,10 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t
 	extern void vApplicationTickHook( void );
 #endif
 
+#if( ( configUSE_TASK_BUDGETS == 1 ) && ( configUSE_TASK_BUDGET_HOOK == 1 ) )
+	extern void vApplicationTaskBudgetHook( TaskHandle_t xTask );
+#endif
+
 #if( configSUPPORT_STATIC_ALLOCATION == 1 )
 	extern void vApplicationGetIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize );
 #endif
@@ -460,9 +576,9 @@ static portTASK_FUNCTION_PROTO( prvIdleTask, pvParameters );
 #endif
 
 /*
- * Used only by the idle task.  This checks to see if anything has been placed
- * in the list of tasks waiting to be deleted.  If so the task is cleaned up
- * and its TCB deleted.
+ * Used by the idle task, and by xTaskCreate() when tasks are recycled.  This
+ * checks to see if anything has been placed in the list of tasks waiting to be
+ * deleted.  If so the task is cleaned up and its TCB deleted.
  */
 static void prvCheckTasksWaitingTermination( void ) PRIVILEGED_FUNCTION;
 
@@ -470,7 +586,7 @@ static void prvCheckTasksWaitingTermination( void ) PRIVILEGED_FUNCTION;
  * The currently executing task is entering the Blocked state.  Add the task to
  * either the current or the overflow delayed task list.
  */
-static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait, const BaseType_t xCanBlockIndefinitely ) PRIVILEGED_FUNCTION;
+static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait, const BaseType_t xCanBlockIndefinitely ) PRIVILEGED_FUNCTION CCM_FUNCTION;
 
 /*
  * Fills an TaskStatus_t structure with information on each task that is
@@ -528,6 +644,98 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait, const BaseT
  */
 static void prvResetNextTaskUnblockTime( void );
 
+#if ( configRESUME_ALL_BATCH_SIZE > 0 )
+
+	/*
+	 * Move tasks from the pending ready list to the ready lists, taking one
+	 * item of *puxBudget per task.  Returns pdTRUE if the pending ready list is
+	 * empty, pdFALSE if the budget ran out first.
+	 */
+	static BaseType_t prvMovePendingReadyTasks( UBaseType_t * const puxBudget ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Apply the ticks pended while the scheduler was suspended to the tick
+	 * count, unblocking the delayed tasks whose time has come, taking one item
+	 * of *puxBudget per task unblocked and per step of the tick count.  Returns
+	 * pdTRUE once all the pended ticks are applied, pdFALSE if the budget ran
+	 * out first.  Called with the scheduler suspended.
+	 */
+	static BaseType_t prvCatchUpPendedTicks( UBaseType_t * const puxBudget ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_TASK_BUDGETS == 1 )
+
+	/*
+	 * Charge the cycles used since the last charge to the running task, and
+	 * take the task's budget action if its budget is exhausted.  Returns pdTRUE
+	 * if the running task was demoted or blocked, in which case a context
+	 * switch is required.  Must only be called with the scheduler running.
+	 */
+	static BaseType_t prvChargeTaskBudget( void ) PRIVILEGED_FUNCTION CCM_FUNCTION;
+
+	/*
+	 * Start a new replenishment period for each budgeted task whose current
+	 * period has ended.  Called from the tick interrupt.  Returns pdTRUE if a
+	 * demoted task was returned to a priority that should preempt the running
+	 * task.
+	 */
+	static BaseType_t prvReplenishTaskBudgets( const TickType_t xConstTickCount ) PRIVILEGED_FUNCTION CCM_FUNCTION;
+
+	/*
+	 * Change the priority in use by a task without changing its base priority,
+	 * moving the task to the matching ready list if it is ready.
+	 */
+	static void prvSetBudgetPriority( TCB_t * const pxTCB, const UBaseType_t uxNewPriority ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Return a demoted task to its own priority, keeping any higher priority
+	 * it has inherited since it was demoted.
+	 */
+	static void prvRestoreBudgetPriority( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Remove the budget of a task, returning it to its own priority if it has
+	 * been demoted.  Called from within a critical section.
+	 */
+	static void prvRemoveTaskBudget( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_TASK_SNAPSHOTS == 1 )
+
+	/*
+	 * Add a task to, and remove a task from, the list of all the tasks walked
+	 * by xTaskTakeSnapshot().  Called from within a critical section.
+	 */
+	static void prvAddTaskToAllTasks( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+	static void prvRemoveTaskFromAllTasks( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Store the xBytes low bytes of ulValue at pucBuffer, least significant
+	 * first, and return the address following them.
+	 */
+	static uint8_t *prvExportLittleEndian( uint8_t *pucBuffer, uint32_t ulValue, size_t xBytes ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_TASK_RECYCLING == 1 )
+
+	/*
+	 * Take a deleted task created with a stack of ulStackDepth words out of
+	 * the recycling pool, first moving the tasks that deleted themselves into
+	 * the pool.  Returns NULL if there is none.
+	 */
+	static TCB_t *prvTakeRecycledTask( uint32_t ulStackDepth ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Keep the memory of a deleted dynamically allocated task in the recycling
+	 * pool, or free it if the task cannot be recycled or the pool is full.
+	 */
+	static void prvRecycleTask( TCB_t *pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
 #if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
 
 	/*
@@ -730,64 +938,79 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 							UBaseType_t uxPriority,
 							TaskHandle_t * const pxCreatedTask )
 	{
-	TCB_t *pxNewTCB;
+	TCB_t *pxNewTCB = NULL;
 	BaseType_t xReturn;
 
-		/* If the stack grows down then allocate the stack then the TCB so the stack
-		does not grow into the TCB.  Likewise if the stack grows up then allocate
-		the TCB then the stack. */
-		#if( portSTACK_GROWTH > 0 )
+		#if( configUSE_TASK_RECYCLING == 1 )
 		{
-			/* Allocate space for the TCB.  Where the memory comes from depends on
-			the implementation of the port malloc function and whether or not static
-			allocation is being used. */
-			pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+			/* Reuse the TCB and stack of a deleted task of the same stack
+			depth if there is one. */
+			pxNewTCB = prvTakeRecycledTask( ( uint32_t ) usStackDepth );
+		}
+		#endif
 
-			if( pxNewTCB != NULL )
+		if( pxNewTCB == NULL )
+		{
+			/* If the stack grows down then allocate the stack then the TCB so
+			the stack does not grow into the TCB.  Likewise if the stack grows
+			up then allocate the TCB then the stack. */
+			#if( portSTACK_GROWTH > 0 )
 			{
-				/* Allocate space for the stack used by the task being created.
-				The base of the stack memory stored in the TCB so the task can
-				be deleted later if required. */
-				pxNewTCB->pxStack = ( StackType_t * ) pvPortMalloc( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+				/* Allocate space for the TCB.  Where the memory comes from depends on
+				the implementation of the port malloc function and whether or not static
+				allocation is being used. */
+				pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
 
-				if( pxNewTCB->pxStack == NULL )
+				if( pxNewTCB != NULL )
 				{
-					/* Could not allocate the stack.  Delete the allocated TCB. */
-					vPortFree( pxNewTCB );
-					pxNewTCB = NULL;
+					/* Allocate space for the stack used by the task being created.
+					The base of the stack memory stored in the TCB so the task can
+					be deleted later if required. */
+					pxNewTCB->pxStack = ( StackType_t * ) pvPortMalloc( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+
+					if( pxNewTCB->pxStack == NULL )
+					{
+						/* Could not allocate the stack.  Delete the allocated TCB. */
+						vPortFree( pxNewTCB );
+						pxNewTCB = NULL;
+					}
 				}
 			}
-		}
-		#else /* portSTACK_GROWTH */
-		{
-		StackType_t *pxStack;
-
-			/* Allocate space for the stack used by the task being created. */
-			pxStack = ( StackType_t * ) pvPortMalloc( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-
-			if( pxStack != NULL )
+			#else /* portSTACK_GROWTH */
 			{
-				/* Allocate space for the TCB. */
-				pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) ); /*lint !e961 MISRA exception as the casts are only redundant for some paths. */
+			StackType_t *pxStack;
 
-				if( pxNewTCB != NULL )
+				/* Allocate space for the stack used by the task being created. */
+				pxStack = ( StackType_t * ) pvPortMalloc( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+
+				if( pxStack != NULL )
 				{
-					/* Store the stack location in the TCB. */
-					pxNewTCB->pxStack = pxStack;
+					/* Allocate space for the TCB. */
+					pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) ); /*lint !e961 MISRA exception as the casts are only redundant for some paths. */
+
+					if( pxNewTCB != NULL )
+					{
+						/* Store the stack location in the TCB. */
+						pxNewTCB->pxStack = pxStack;
+					}
+					else
+					{
+						/* The stack cannot be used as the TCB was not created.  Free
+						it again. */
+						vPortFree( pxStack );
+					}
 				}
 				else
 				{
-					/* The stack cannot be used as the TCB was not created.  Free
-					it again. */
-					vPortFree( pxStack );
+					pxNewTCB = NULL;
 				}
 			}
-			else
-			{
-				pxNewTCB = NULL;
-			}
+			#endif /* portSTACK_GROWTH */
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
 		}
-		#endif /* portSTACK_GROWTH */
 
 		if( pxNewTCB != NULL )
 		{
@@ -800,6 +1023,15 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 			#endif /* configSUPPORT_STATIC_ALLOCATION */
 
 			prvInitialiseNewTask( pxTaskCode, pcName, ( uint32_t ) usStackDepth, pvParameters, uxPriority, pxCreatedTask, pxNewTCB, NULL );
+
+			#if( configUSE_TASK_RECYCLING == 1 )
+			{
+				/* Only the memory of tasks created here is of the kind
+				xTaskCreate() allocates, so only these tasks are recycled. */
+				pxNewTCB->ulRecycleStackDepth = ( uint32_t ) usStackDepth;
+			}
+			#endif
+
 			prvAddNewTaskToReadyList( pxNewTCB );
 			xReturn = pdPASS;
 		}
@@ -814,6 +1046,66 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
+#if( configUSE_CCM_TASK_ALLOCATION == 1 )
+
+	BaseType_t xTaskCreateCCM(	TaskFunction_t pxTaskCode,
+								const char * const pcName,		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+								const configSTACK_DEPTH_TYPE usStackDepth,
+								void * const pvParameters,
+								UBaseType_t uxPriority,
+								TaskHandle_t * const pxCreatedTask )
+	{
+	TCB_t *pxNewTCB = NULL;
+	StackType_t *pxStack;
+	BaseType_t xReturn;
+
+		/* The stack is allocated before the TCB, as in xTaskCreate(), so a
+		stack growing down cannot run into the TCB.  Both come from the CCM
+		region of the heap, and are freed with vPortFree() like the memory of
+		any other dynamically allocated task. */
+		pxStack = ( StackType_t * ) pvPortMallocIn( portHEAP_REGION_CCM, ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+
+		if( pxStack != NULL )
+		{
+			pxNewTCB = ( TCB_t * ) pvPortMallocIn( portHEAP_REGION_CCM, sizeof( TCB_t ) );
+
+			if( pxNewTCB != NULL )
+			{
+				pxNewTCB->pxStack = pxStack;
+			}
+			else
+			{
+				vPortFree( pxStack );
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( pxNewTCB != NULL )
+		{
+			#if( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 Macro has been consolidated for readability reasons. */
+			{
+				pxNewTCB->ucStaticallyAllocated = tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB;
+			}
+			#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+			prvInitialiseNewTask( pxTaskCode, pcName, ( uint32_t ) usStackDepth, pvParameters, uxPriority, pxCreatedTask, pxNewTCB, NULL );
+			prvAddNewTaskToReadyList( pxNewTCB );
+			xReturn = pdPASS;
+		}
+		else
+		{
+			xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_CCM_TASK_ALLOCATION */
+/*-----------------------------------------------------------*/
+
 static void prvInitialiseNewTask( 	TaskFunction_t pxTaskCode,
 									const char * const pcName,		/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
 									const uint32_t ulStackDepth,
@@ -951,6 +1243,21 @@ UBaseType_t x;
 	}
 	#endif /* configGENERATE_RUN_TIME_STATS */
 
+	#if ( configUSE_TASK_BUDGETS == 1 )
+	{
+		pxNewTCB->ulBudgetCycles = 0UL;
+		pxNewTCB->ulBudgetRemaining = 0UL;
+		pxNewTCB->uxBudgetOverruns = 0;
+		pxNewTCB->ucBudgetState = taskBUDGET_AVAILABLE;
+	}
+	#endif /* configUSE_TASK_BUDGETS */
+
+	#if ( configUSE_TASK_RECYCLING == 1 )
+	{
+		pxNewTCB->ulRecycleStackDepth = 0UL;
+	}
+	#endif /* configUSE_TASK_RECYCLING */
+
 	#if ( portUSING_MPU_WRAPPERS == 1 )
 	{
 		vPortStoreTaskMPUSettings( &( pxNewTCB->xMPUSettings ), xRegions, pxNewTCB->pxStack, ulStackDepth );
@@ -973,8 +1280,10 @@ UBaseType_t x;
 
 	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
 	{
-		pxNewTCB->ulNotifiedValue = 0;
-		pxNewTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+		/* taskNOT_WAITING_NOTIFICATION is zero, so clearing both arrays puts
+		every notification slot into its initial empty state. */
+		memset( ( void * ) &( pxNewTCB->ulNotifiedValue[ 0 ] ), 0x00, sizeof( pxNewTCB->ulNotifiedValue ) );
+		memset( ( void * ) &( pxNewTCB->ucNotifyState[ 0 ] ), 0x00, sizeof( pxNewTCB->ucNotifyState ) );
 	}
 	#endif
 
@@ -1077,6 +1386,12 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 
 		prvAddTaskToReadyList( pxNewTCB );
 
+		#if ( configUSE_TASK_SNAPSHOTS == 1 )
+		{
+			prvAddTaskToAllTasks( pxNewTCB );
+		}
+		#endif
+
 		portSETUP_TCB( pxNewTCB );
 	}
 	taskEXIT_CRITICAL();
@@ -1133,6 +1448,24 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				mtCOVERAGE_TEST_MARKER();
 			}
 
+			#if ( configUSE_TASK_BUDGETS == 1 )
+			{
+				prvRemoveTaskBudget( pxTCB );
+			}
+			#endif
+
+			#if ( configUSE_TASK_SNAPSHOTS == 1 )
+			{
+				prvRemoveTaskFromAllTasks( pxTCB );
+			}
+			#endif
+
+			#if ( configUSE_PERIODIC_TASKS == 1 )
+			{
+				vPeriodicTaskRemoveEntry( ( TaskHandle_t ) pxTCB );
+			}
+			#endif
+
 			/* Increment the uxTaskNumber also so kernel aware debuggers can
 			detect that the task lists need re-generating.  This is done before
 			portPRE_TASK_DELETE_HOOK() as in the Windows port that macro will
@@ -1586,7 +1919,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 						/* It is known that the task is in its ready list so
 						there is no need to check again and the port level
 						reset macro can be called directly. */
-						portRESET_READY_PRIORITY( uxPriorityUsedOnEntry, uxTopReadyPriority );
+						taskCLEAR_READY_PRIORITY( uxPriorityUsedOnEntry );
 					}
 					else
 					{
@@ -1658,11 +1991,16 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 
 			#if( configUSE_TASK_NOTIFICATIONS == 1 )
 			{
-				if( pxTCB->ucNotifyState == taskWAITING_NOTIFICATION )
+			UBaseType_t x;
+
+				for( x = 0; x < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
 				{
-					/* The task was blocked to wait for a notification, but is
-					now suspended, so no notification was received. */
-					pxTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+					if( pxTCB->ucNotifyState[ x ] == taskWAITING_NOTIFICATION )
+					{
+						/* The task was blocked to wait for a notification, but
+						is now suspended, so no notification was received. */
+						pxTCB->ucNotifyState[ x ] = taskNOT_WAITING_NOTIFICATION;
+					}
 				}
 			}
 			#endif
@@ -1986,6 +2324,13 @@ BaseType_t xReturn;
 		FreeRTOSConfig.h file. */
 		portCONFIGURE_TIMER_FOR_RUN_TIME_STATS();
 
+		#if ( configUSE_TASK_BUDGETS == 1 )
+		{
+			portCONFIGURE_CYCLE_COUNTER();
+			ulBudgetChargedTime = portGET_CYCLE_COUNTER();
+		}
+		#endif
+
 		/* Setting up the timer tick is hardware specific and thus in the
 		portable interface. */
 		if( xPortStartScheduler() != pdFALSE )
@@ -2064,6 +2409,18 @@ void vTaskSuspendAll( void )
 			{
 				uxHigherPriorityReadyTasks = pdTRUE;
 			}
+
+			#if( configMAX_PRIORITIES > taskPRIORITIES_PER_BITMAP_WORD )
+			{
+				/* With a two level bit map the least significant bit of
+				uxTopReadyPriority covers the lowest word of priorities, so the
+				idle priority bit has to be checked within that word too. */
+				if( uxReadyPriorityBitmap[ 0 ] > uxLeastSignificantBit )
+				{
+					uxHigherPriorityReadyTasks = pdTRUE;
+				}
+			}
+			#endif
 		}
 		#endif
 
@@ -2088,6 +2445,25 @@ void vTaskSuspendAll( void )
 		else
 		{
 			xReturn = xNextTaskUnblockTime - xTickCount;
+
+			/* The timer service task blocks without a timeout, so the next
+			tick the timer wheel has work on is not in xNextTaskUnblockTime. */
+			#if ( configUSE_TIMERS == 1 )
+			{
+			TickType_t xTimerIdleTime;
+
+				xTimerIdleTime = xTimerGetExpectedIdleTime();
+
+				if( xTimerIdleTime < xReturn )
+				{
+					xReturn = xTimerIdleTime;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_TIMERS */
 		}
 
 		return xReturn;
@@ -2096,6 +2472,82 @@ void vTaskSuspendAll( void )
 #endif /* configUSE_TICKLESS_IDLE */
 /*----------------------------------------------------------*/
 
+#if ( configRESUME_ALL_BATCH_SIZE > 0 )
+
+BaseType_t xTaskResumeAll( void )
+{
+BaseType_t xAlreadyYielded = pdFALSE, xResumed = pdFALSE;
+UBaseType_t uxBudget;
+
+	/* If uxSchedulerSuspended is zero then this function does not match a
+	previous call to vTaskSuspendAll(). */
+	configASSERT( uxSchedulerSuspended );
+
+	/* The tasks readied by interrupts while the scheduler was suspended, and
+	the ticks that occurred meanwhile, are processed at most
+	configRESUME_ALL_BATCH_SIZE at a time, each batch in its own critical
+	section.  The scheduler is only resumed in the critical section that finds
+	nothing left to do, so between the batches interrupts keep adding to
+	xPendingReadyList and uxPendedTicks, and the next batch picks that up. */
+	do
+	{
+		taskENTER_CRITICAL();
+		{
+			if( ( uxSchedulerSuspended > ( UBaseType_t ) 1U ) || ( uxCurrentNumberOfTasks == ( UBaseType_t ) 0U ) )
+			{
+				/* Not the outermost resume, or the scheduler has not been
+				started. */
+				--uxSchedulerSuspended;
+				xResumed = pdTRUE;
+			}
+			else
+			{
+				uxBudget = ( UBaseType_t ) configRESUME_ALL_BATCH_SIZE;
+
+				/* Catching up the ticks can ready the timer task, which then
+				goes on the pending ready list, so the list is checked again
+				once the ticks are done. */
+				while( ( prvMovePendingReadyTasks( &uxBudget ) != pdFALSE ) && ( prvCatchUpPendedTicks( &uxBudget ) != pdFALSE ) )
+				{
+					if( listLIST_IS_EMPTY( &xPendingReadyList ) != pdFALSE )
+					{
+						xResumed = pdTRUE;
+						break;
+					}
+				}
+
+				if( xResumed != pdFALSE )
+				{
+					--uxSchedulerSuspended;
+
+					if( xYieldPending != pdFALSE )
+					{
+						#if( configUSE_PREEMPTION != 0 )
+						{
+							xAlreadyYielded = pdTRUE;
+						}
+						#endif
+						taskYIELD_IF_USING_PREEMPTION();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
+	} while( xResumed == pdFALSE );
+
+	return xAlreadyYielded;
+}
+
+#else /* configRESUME_ALL_BATCH_SIZE */
+
 BaseType_t xTaskResumeAll( void )
 {
 TCB_t *pxTCB = NULL;
@@ -2204,6 +2656,8 @@ BaseType_t xAlreadyYielded = pdFALSE;
 
 	return xAlreadyYielded;
 }
+
+#endif /* configRESUME_ALL_BATCH_SIZE */
 /*-----------------------------------------------------------*/
 
 TickType_t xTaskGetTickCount( void )
@@ -2252,7 +2706,170 @@ UBaseType_t uxSavedInterruptStatus;
 }
 /*-----------------------------------------------------------*/
 
-UBaseType_t uxTaskGetNumberOfTasks( void )
+#if( configUSE_MICROSECOND_TIME == 1 )
+
+	uint64_t ullTaskGetTickCount64( void )
+	{
+	TickType_t xOverflows, xTicks;
+	UBaseType_t uxPended;
+
+		/* No critical section is used, so the function can be called from
+		tasks and interrupts alike without adding to interrupt latency.  The
+		three variables are each read atomically, and are read again until
+		none of them changed in between, so the tick interrupt cannot leave
+		the snapshot torn.  Ticks that are pended while the scheduler is
+		suspended have not reached xTickCount yet but have still happened,
+		so they are included. */
+		do
+		{
+			xOverflows = ( TickType_t ) xNumOfOverflows;
+			xTicks = xTickCount;
+			uxPended = uxPendedTicks;
+		} while( ( xOverflows != ( TickType_t ) xNumOfOverflows ) || ( xTicks != xTickCount ) || ( uxPended != uxPendedTicks ) );
+
+		return ( ( ( uint64_t ) xOverflows << tskTICK_COUNT_BITS ) | ( uint64_t ) xTicks ) + ( uint64_t ) uxPended;
+	}
+	/*-----------------------------------------------------------*/
+
+	uint64_t ullTaskGetTimeMicroseconds( void )
+	{
+	TickType_t xOverflows, xTicks;
+	UBaseType_t uxPended;
+	uint32_t ulMicroseconds;
+	BaseType_t xTickPending;
+	uint64_t ullTicks;
+
+		/* As ullTaskGetTickCount64(), with the tick timer read inside the
+		loop so a tick interrupt between reading the tick count and reading
+		the timer forces another pass. */
+		do
+		{
+			xOverflows = ( TickType_t ) xNumOfOverflows;
+			xTicks = xTickCount;
+			uxPended = uxPendedTicks;
+			ulMicroseconds = ulPortGetMicrosecondsSinceTick( &xTickPending );
+		} while( ( xOverflows != ( TickType_t ) xNumOfOverflows ) || ( xTicks != xTickCount ) || ( uxPended != uxPendedTicks ) );
+
+		ullTicks = ( ( ( uint64_t ) xOverflows << tskTICK_COUNT_BITS ) | ( uint64_t ) xTicks ) + ( uint64_t ) uxPended;
+
+		/* A tick the timer has counted but the tick interrupt has not yet
+		processed belongs to the time, otherwise the result would step
+		backwards while interrupts are masked across a tick. */
+		if( xTickPending != pdFALSE )
+		{
+			ullTicks++;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return ( ullTicks * ( uint64_t ) tskMICROSECONDS_PER_TICK ) + ( uint64_t ) ulMicroseconds;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vTaskDelayUntilMicroseconds( uint64_t * const pullPreviousWakeTime, const uint64_t ullTimeIncrement )
+	{
+	uint64_t ullTimeToWake, ullTickToWake, ullConstTickCount;
+	uint32_t ulMicrosecondsIntoTick;
+	TickType_t xTicksToWait;
+	BaseType_t xAlreadyYielded, xShouldSpin = pdFALSE, xReachedTick;
+
+		configASSERT( pullPreviousWakeTime );
+		configASSERT( ( ullTimeIncrement > 0U ) );
+		configASSERT( uxSchedulerSuspended == 0 );
+		configASSERT( ( ( uint32_t ) 1000000UL % ( uint32_t ) configTICK_RATE_HZ ) == 0UL );
+
+		/* The wake time is accumulated in microseconds, so a period that is
+		not a whole number of ticks keeps its phase instead of being rounded
+		to the tick on every call. */
+		ullTimeToWake = *pullPreviousWakeTime + ullTimeIncrement;
+		*pullPreviousWakeTime = ullTimeToWake;
+
+		/* The tick in which the wake time falls, and how far into that tick
+		it is.  A task can only be unblocked by a tick, so if the remainder
+		is short enough the task blocks until that tick and then spins for
+		the remainder, otherwise it blocks until the following tick, as a
+		delay must never end early. */
+		ullTickToWake = ullTimeToWake / ( uint64_t ) tskMICROSECONDS_PER_TICK;
+		ulMicrosecondsIntoTick = ( uint32_t ) ( ullTimeToWake - ( ullTickToWake * ( uint64_t ) tskMICROSECONDS_PER_TICK ) );
+
+		if( ulMicrosecondsIntoTick > ( uint32_t ) configTASK_DELAY_UNTIL_SPIN_US )
+		{
+			ullTickToWake++;
+		}
+		else if( ulMicrosecondsIntoTick != 0UL )
+		{
+			xShouldSpin = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* A wake tick further away than the delayed lists can represent is
+		reached in more than one block. */
+		do
+		{
+			xReachedTick = pdTRUE;
+
+			vTaskSuspendAll();
+			{
+				/* Neither variable can change while the scheduler is
+				suspended.  Pended ticks are deliberately not included as
+				prvAddCurrentTaskToDelayedList() measures the block time from
+				xTickCount. */
+				ullConstTickCount = ( ( uint64_t ) ( TickType_t ) xNumOfOverflows << tskTICK_COUNT_BITS ) | ( uint64_t ) xTickCount;
+
+				if( ullTickToWake > ullConstTickCount )
+				{
+					if( ( ullTickToWake - ullConstTickCount ) > ( uint64_t ) tskMAX_DELAY_UNTIL_BLOCK_TICKS )
+					{
+						xTicksToWait = tskMAX_DELAY_UNTIL_BLOCK_TICKS;
+						xReachedTick = pdFALSE;
+					}
+					else
+					{
+						xTicksToWait = ( TickType_t ) ( ullTickToWake - ullConstTickCount );
+					}
+
+					traceTASK_DELAY_UNTIL( ( TickType_t ) ullTickToWake );
+					prvAddCurrentTaskToDelayedList( xTicksToWait, pdFALSE );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			xAlreadyYielded = xTaskResumeAll();
+
+			if( xAlreadyYielded == pdFALSE )
+			{
+				portYIELD_WITHIN_API();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		} while( xReachedTick == pdFALSE );
+
+		if( xShouldSpin != pdFALSE )
+		{
+			while( ullTaskGetTimeMicroseconds() < ullTimeToWake )
+			{
+				/* Bounded by configTASK_DELAY_UNTIL_SPIN_US. */
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_MICROSECOND_TIME */
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxTaskGetNumberOfTasks( void )
 {
 	/* A critical section is not required because the variables are of type
 	BaseType_t. */
@@ -2472,6 +3089,187 @@ TCB_t *pxTCB;
 #endif /* configUSE_TRACE_FACILITY */
 /*----------------------------------------------------------*/
 
+#if ( configUSE_TASK_SNAPSHOTS == 1 )
+
+	BaseType_t xTaskTakeSnapshot( TaskSnapshotBuffer_t *pxBuffer, BaseType_t xGetFreeStackSpace )
+	{
+	TaskSnapshot_t *pxSnapshot;
+	TaskSnapshotEntry_t *pxEntry;
+	TaskStatus_t xStatus;
+	TCB_t *pxTCB;
+	UBaseType_t uxTask = 0, uxTotalTasks, x;
+	const uint32_t ulSequence = pxBuffer->ulSequence + 1UL;
+	BaseType_t xReturn = pdPASS;
+
+		configASSERT( pxBuffer );
+
+		pxSnapshot = &( pxBuffer->xSnapshots[ ulSequence & 1UL ] );
+
+		vTaskSuspendAll();
+		{
+			if( xSnapshotInProgress != pdFALSE )
+			{
+				/* Another task is part way through a snapshot and owns the
+				cursor.  Leave the buffer as it is. */
+				( void ) xTaskResumeAll();
+				return pdFAIL;
+			}
+
+			xSnapshotInProgress = pdTRUE;
+
+			/* Write over the older of the two snapshots, marking it as being
+			written so a reader still using it can tell. */
+			pxSnapshot->ulSequence = 0UL;
+			pxSnapshotCursor = pxAllTasks;
+
+			while( pxSnapshotCursor != NULL )
+			{
+				if( uxTask >= ( UBaseType_t ) configMAX_SNAPSHOT_TASKS )
+				{
+					xReturn = pdFAIL;
+					break;
+				}
+
+				/* Move the cursor on before the scheduler is resumed, so a
+				task that deletes the next task moves it on again. */
+				pxTCB = pxSnapshotCursor;
+				pxSnapshotCursor = pxTCB->pxNextCreated;
+
+				vTaskGetInfo( ( TaskHandle_t ) pxTCB, &xStatus, xGetFreeStackSpace, eInvalid );
+
+				pxEntry = &( pxSnapshot->xTasks[ uxTask ] );
+				pxEntry->xTaskNumber = xStatus.xTaskNumber;
+				pxEntry->ulRunTimeCounter = xStatus.ulRunTimeCounter;
+				pxEntry->ulStackDepth = xStatus.ulStackDepth;
+				pxEntry->usStackHighWaterMark = xStatus.usStackHighWaterMark;
+				pxEntry->usCurrentPriority = ( uint16_t ) xStatus.uxCurrentPriority;
+				pxEntry->usBasePriority = ( uint16_t ) xStatus.uxBasePriority;
+				pxEntry->ucCurrentState = ( uint8_t ) xStatus.eCurrentState;
+
+				/* Copy the name padded with 0s, so the exported record does
+				not depend on what the buffer held before. */
+				for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) configMAX_TASK_NAME_LEN; x++ )
+				{
+					pxEntry->pcTaskName[ x ] = pxTCB->pcTaskName[ x ];
+
+					if( pxTCB->pcTaskName[ x ] == 0x00 )
+					{
+						break;
+					}
+				}
+
+				for( ; x < ( UBaseType_t ) configMAX_TASK_NAME_LEN; x++ )
+				{
+					pxEntry->pcTaskName[ x ] = 0x00;
+				}
+
+				uxTask++;
+
+				/* Let higher priority tasks run between two entries. */
+				( void ) xTaskResumeAll();
+				vTaskSuspendAll();
+			}
+
+			/* Count the tasks that did not fit. */
+			uxTotalTasks = uxTask;
+			for( pxTCB = pxSnapshotCursor; pxTCB != NULL; pxTCB = pxTCB->pxNextCreated )
+			{
+				uxTotalTasks++;
+			}
+
+			pxSnapshotCursor = NULL;
+
+			pxSnapshot->xTimeStamp = xTickCount;
+
+			#if ( configGENERATE_RUN_TIME_STATS == 1 )
+			{
+				#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+					portALT_GET_RUN_TIME_COUNTER_VALUE( pxSnapshot->ulTotalRunTime );
+				#else
+					pxSnapshot->ulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
+				#endif
+			}
+			#else
+			{
+				pxSnapshot->ulTotalRunTime = 0UL;
+			}
+			#endif
+		}
+		( void ) xTaskResumeAll();
+
+		pxSnapshot->uxNumberOfTasks = uxTask;
+		pxSnapshot->uxTotalTasks = uxTotalTasks;
+
+		/* Publish the snapshot. */
+		pxSnapshot->ulSequence = ulSequence;
+		pxBuffer->ulSequence = ulSequence;
+
+		xSnapshotInProgress = pdFALSE;
+
+		return xReturn;
+	}
+
+#endif /* configUSE_TASK_SNAPSHOTS */
+/*----------------------------------------------------------*/
+
+#if ( configUSE_TASK_SNAPSHOTS == 1 )
+
+	size_t xTaskExportSnapshot( const TaskSnapshot_t *pxSnapshot, uint8_t *pucBuffer, size_t xBufferLength )
+	{
+	const TaskSnapshotEntry_t *pxEntry;
+	uint8_t *pucNext = pucBuffer;
+	UBaseType_t uxTask, x;
+	size_t xLength;
+
+		configASSERT( pxSnapshot );
+		configASSERT( pucBuffer );
+
+		xLength = taskSNAPSHOT_EXPORT_SIZE( pxSnapshot->uxNumberOfTasks );
+
+		if( xLength <= xBufferLength )
+		{
+			*pucNext++ = ( uint8_t ) 'T';
+			*pucNext++ = ( uint8_t ) 'S';
+			*pucNext++ = 1U;
+			*pucNext++ = ( uint8_t ) configMAX_TASK_NAME_LEN;
+			pucNext = prvExportLittleEndian( pucNext, ( uint32_t ) pxSnapshot->uxNumberOfTasks, 2 );
+			pucNext = prvExportLittleEndian( pucNext, ( uint32_t ) pxSnapshot->uxTotalTasks, 2 );
+			pucNext = prvExportLittleEndian( pucNext, pxSnapshot->ulSequence, 4 );
+			pucNext = prvExportLittleEndian( pucNext, ( uint32_t ) pxSnapshot->xTimeStamp, 4 );
+			pucNext = prvExportLittleEndian( pucNext, pxSnapshot->ulTotalRunTime, 4 );
+
+			for( uxTask = 0; uxTask < pxSnapshot->uxNumberOfTasks; uxTask++ )
+			{
+				pxEntry = &( pxSnapshot->xTasks[ uxTask ] );
+
+				pucNext = prvExportLittleEndian( pucNext, ( uint32_t ) pxEntry->xTaskNumber, 4 );
+				pucNext = prvExportLittleEndian( pucNext, pxEntry->ulRunTimeCounter, 4 );
+				pucNext = prvExportLittleEndian( pucNext, pxEntry->ulStackDepth, 4 );
+				pucNext = prvExportLittleEndian( pucNext, ( uint32_t ) pxEntry->usStackHighWaterMark, 2 );
+				pucNext = prvExportLittleEndian( pucNext, ( uint32_t ) pxEntry->usCurrentPriority, 2 );
+				pucNext = prvExportLittleEndian( pucNext, ( uint32_t ) pxEntry->usBasePriority, 2 );
+				*pucNext++ = pxEntry->ucCurrentState;
+				*pucNext++ = 0U;
+
+				for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) configMAX_TASK_NAME_LEN; x++ )
+				{
+					*pucNext++ = ( uint8_t ) pxEntry->pcTaskName[ x ];
+				}
+			}
+
+			configASSERT( ( size_t ) ( pucNext - pucBuffer ) == xLength );
+		}
+		else
+		{
+			xLength = 0;
+		}
+
+		return xLength;
+	}
+
+#endif /* configUSE_TASK_SNAPSHOTS */
+/*----------------------------------------------------------*/
+
 #if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
 
 	TaskHandle_t xTaskGetIdleTaskHandle( void )
@@ -2497,6 +3295,29 @@ implementations require configUSE_TICKLESS_IDLE to be set to a value other than
 		was suppressed.  Note this does *not* call the tick hook function for
 		each stepped tick. */
 		configASSERT( ( xTickCount + xTicksToJump ) <= xNextTaskUnblockTime );
+
+		/* The timer wheel processes every tick count in order.  No timer is
+		due in the stepped ticks, as prvGetExpectedIdleTime() stops at the next
+		one, unless an interrupt started a timer while the tick was
+		suppressed. */
+		#if ( configUSE_TIMERS == 1 )
+		{
+		TickType_t xTick;
+
+			for( xTick = ( TickType_t ) 1; xTick <= xTicksToJump; xTick++ )
+			{
+				if( xTimerIncrementTick( xTickCount + xTick ) != pdFALSE )
+				{
+					xYieldPending = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		#endif /* configUSE_TIMERS */
+
 		xTickCount += xTicksToJump;
 		traceINCREASE_TICK_COUNT( xTicksToJump );
 	}
@@ -2609,6 +3430,31 @@ BaseType_t xSwitchRequired = pdFALSE;
 			mtCOVERAGE_TEST_MARKER();
 		}
 
+		/* Replenish budgets before charging the running task so a task that
+		is blocked for exhausting its budget wakes at the start of its next
+		period, which is processed below. */
+		#if ( configUSE_TASK_BUDGETS == 1 )
+		{
+			if( prvReplenishTaskBudgets( xConstTickCount ) != pdFALSE )
+			{
+				xSwitchRequired = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( prvChargeTaskBudget() != pdFALSE )
+			{
+				xSwitchRequired = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_TASK_BUDGETS */
+
 		/* See if this tick has made a timeout expire.  Tasks are stored in
 		the	queue in the order of their wake time - meaning once one task
 		has been found whose block time has not expired there is no need to
@@ -2691,6 +3537,22 @@ BaseType_t xSwitchRequired = pdFALSE;
 			}
 		}
 
+		/* Advance the software timer wheel to the new tick count.  This calls
+		the fast timer callbacks, and wakes the timer service task if other
+		timers have expired. */
+		#if ( configUSE_TIMERS == 1 )
+		{
+			if( xTimerIncrementTick( xConstTickCount ) != pdFALSE )
+			{
+				xSwitchRequired = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_TIMERS */
+
 		/* Tasks of equal priority to the currently running task will share
 		processing time (time slice) if preemption is on, and the application
 		writer has not explicitly turned time slicing off. */
@@ -2882,6 +3744,14 @@ void vTaskSwitchContext( void )
 		}
 		#endif /* configGENERATE_RUN_TIME_STATS */
 
+		#if ( configUSE_TASK_BUDGETS == 1 )
+		{
+			/* A task selection follows, so whether the task being switched
+			out was demoted or blocked does not need to be checked. */
+			( void ) prvChargeTaskBudget();
+		}
+		#endif /* configUSE_TASK_BUDGETS */
+
 		/* Check for stack overflow, if configured. */
 		taskCHECK_FOR_STACK_OVERFLOW();
 
@@ -2933,9 +3803,9 @@ void vTaskPlaceOnUnorderedEventList( List_t * pxEventList, const TickType_t xIte
 
 	/* Place the event list item of the TCB at the end of the appropriate event
 	list.  It is safe to access the event list here because it is part of an
-	event group implementation - and interrupts don't access event groups
-	directly (instead they access them indirectly by pending function calls to
-	the task level). */
+	event group implementation - and interrupts don't access the event lists of
+	an event group while a task has the group locked, which it has while this
+	function is called. */
 	vListInsertEnd( pxEventList, &( pxCurrentTCB->xEventListItem ) );
 
 	prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
@@ -3077,6 +3947,56 @@ TCB_t *pxUnblockedTCB;
 }
 /*-----------------------------------------------------------*/
 
+BaseType_t xTaskRemoveFromUnorderedEventListFromISR( ListItem_t * pxEventListItem, const TickType_t xItemValue )
+{
+TCB_t *pxUnblockedTCB;
+BaseType_t xReturn;
+
+	/* THIS FUNCTION MUST BE CALLED WITH INTERRUPTS MASKED, either from an ISR
+	or from a critical section.  It is used by the event groups implementation
+	to unblock tasks directly from an interrupt, while no task has the event
+	group locked. */
+
+	/* Store the new item value in the event list. */
+	listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+	pxUnblockedTCB = ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxEventListItem );
+	configASSERT( pxUnblockedTCB );
+	( void ) uxListRemove( pxEventListItem );
+
+	if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+	{
+		( void ) uxListRemove( &( pxUnblockedTCB->xStateListItem ) );
+		prvAddTaskToReadyList( pxUnblockedTCB );
+	}
+	else
+	{
+		/* The delayed and ready lists cannot be accessed, so hold this task
+		pending until the scheduler is resumed. */
+		vListInsertEnd( &( xPendingReadyList ), pxEventListItem );
+	}
+
+	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+	{
+		/* As xTaskRemoveFromEventList(). */
+		xReturn = pdTRUE;
+		xYieldPending = pdTRUE;
+	}
+	else
+	{
+		xReturn = pdFALSE;
+	}
+
+	#if( configUSE_TICKLESS_IDLE != 0 )
+	{
+		prvResetNextTaskUnblockTime();
+	}
+	#endif
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
 void vTaskSetTimeOutState( TimeOut_t * const pxTimeOut )
 {
 	configASSERT( pxTimeOut );
@@ -3462,7 +4382,8 @@ UBaseType_t uxPriority;
 static void prvCheckTasksWaitingTermination( void )
 {
 
-	/** THIS FUNCTION IS CALLED FROM THE RTOS IDLE TASK **/
+	/** THIS FUNCTION IS CALLED FROM THE RTOS IDLE TASK, AND FROM xTaskCreate()
+	WHEN configUSE_TASK_RECYCLING IS 1 **/
 
 	#if ( INCLUDE_vTaskDelete == 1 )
 	{
@@ -3474,275 +4395,1105 @@ static void prvCheckTasksWaitingTermination( void )
 		{
 			taskENTER_CRITICAL();
 			{
-				pxTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) );
-				( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-				--uxCurrentNumberOfTasks;
-				--uxDeletedTasksWaitingCleanUp;
-			}
-			taskEXIT_CRITICAL();
+				/* A task creating a task can preempt the idle task between
+				the test above and here and empty the list, so test again. */
+				if( uxDeletedTasksWaitingCleanUp > ( UBaseType_t ) 0U )
+				{
+					pxTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) );
+					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+					--uxCurrentNumberOfTasks;
+					--uxDeletedTasksWaitingCleanUp;
+				}
+				else
+				{
+					pxTCB = NULL;
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			if( pxTCB != NULL )
+			{
+				prvDeleteTCB( pxTCB );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+	#endif /* INCLUDE_vTaskDelete */
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TRACE_FACILITY == 1 )
+
+	void vTaskGetInfo( TaskHandle_t xTask, TaskStatus_t *pxTaskStatus, BaseType_t xGetFreeStackSpace, eTaskState eState )
+	{
+	TCB_t *pxTCB;
+
+		/* xTask is NULL then get the state of the calling task. */
+		pxTCB = prvGetTCBFromHandle( xTask );
+
+		pxTaskStatus->xHandle = ( TaskHandle_t ) pxTCB;
+		pxTaskStatus->pcTaskName = ( const char * ) &( pxTCB->pcTaskName [ 0 ] );
+		pxTaskStatus->uxCurrentPriority = pxTCB->uxPriority;
+		pxTaskStatus->pxStackBase = pxTCB->pxStack;
+		pxTaskStatus->xTaskNumber = pxTCB->uxTCBNumber;
+
+		#if ( configUSE_MUTEXES == 1 )
+		{
+			pxTaskStatus->uxBasePriority = pxTCB->uxBasePriority;
+		}
+		#else
+		{
+			pxTaskStatus->uxBasePriority = 0;
+		}
+		#endif
+
+		#if ( configGENERATE_RUN_TIME_STATS == 1 )
+		{
+			pxTaskStatus->ulRunTimeCounter = pxTCB->ulRunTimeCounter;
+		}
+		#else
+		{
+			pxTaskStatus->ulRunTimeCounter = 0;
+		}
+		#endif
+
+		/* Obtaining the task state is a little fiddly, so is only done if the
+		value of eState passed into this function is eInvalid - otherwise the
+		state is just set to whatever is passed in. */
+		if( eState != eInvalid )
+		{
+			if( pxTCB == pxCurrentTCB )
+			{
+				pxTaskStatus->eCurrentState = eRunning;
+			}
+			else
+			{
+				pxTaskStatus->eCurrentState = eState;
+
+				#if ( INCLUDE_vTaskSuspend == 1 )
+				{
+					/* If the task is in the suspended list then there is a
+					chance it is actually just blocked indefinitely - so really
+					it should be reported as being in the Blocked state. */
+					if( eState == eSuspended )
+					{
+						vTaskSuspendAll();
+						{
+							if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+							{
+								pxTaskStatus->eCurrentState = eBlocked;
+							}
+						}
+						( void ) xTaskResumeAll();
+					}
+				}
+				#endif /* INCLUDE_vTaskSuspend */
+			}
+		}
+		else
+		{
+			pxTaskStatus->eCurrentState = eTaskGetState( pxTCB );
+		}
+
+		/* Obtaining the stack space takes some time, so the xGetFreeStackSpace
+		parameter is provided to allow it to be skipped. */
+		if( xGetFreeStackSpace != pdFALSE )
+		{
+			#if ( portSTACK_GROWTH > 0 )
+			{
+				pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxEndOfStack );
+			}
+			#else
+			{
+				pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxStack );
+			}
+			#endif
+		}
+		else
+		{
+			pxTaskStatus->usStackHighWaterMark = 0;
+		}
+
+		/* pxEndOfStack holds the last usable word, which may be one below the
+		top of the buffer as the top of stack is aligned down. */
+		#if ( ( portSTACK_GROWTH > 0 ) || ( configRECORD_STACK_HIGH_ADDRESS == 1 ) )
+		{
+			pxTaskStatus->ulStackDepth = ( uint32_t ) ( pxTCB->pxEndOfStack - pxTCB->pxStack ) + 1UL;
+		}
+		#else
+		{
+			pxTaskStatus->ulStackDepth = 0;
+		}
+		#endif
+	}
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+	static UBaseType_t prvListTasksWithinSingleList( TaskStatus_t *pxTaskStatusArray, List_t *pxList, eTaskState eState )
+	{
+	configLIST_VOLATILE TCB_t *pxNextTCB, *pxFirstTCB;
+	UBaseType_t uxTask = 0;
+
+		if( listCURRENT_LIST_LENGTH( pxList ) > ( UBaseType_t ) 0 )
+		{
+			listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList );
+
+			/* Populate an TaskStatus_t structure within the
+			pxTaskStatusArray array for each task that is referenced from
+			pxList.  See the definition of TaskStatus_t in task.h for the
+			meaning of each TaskStatus_t structure member. */
+			do
+			{
+				listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList );
+				vTaskGetInfo( ( TaskHandle_t ) pxNextTCB, &( pxTaskStatusArray[ uxTask ] ), pdTRUE, eState );
+				uxTask++;
+			} while( pxNextTCB != pxFirstTCB );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return uxTask;
+	}
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) )
+
+	static uint16_t prvTaskCheckFreeStackSpace( const uint8_t * pucStackByte )
+	{
+	uint32_t ulCount = 0U;
+
+		while( *pucStackByte == ( uint8_t ) tskSTACK_FILL_BYTE )
+		{
+			pucStackByte -= portSTACK_GROWTH;
+			ulCount++;
+		}
+
+		ulCount /= ( uint32_t ) sizeof( StackType_t ); /*lint !e961 Casting is not redundant on smaller architectures. */
+
+		return ( uint16_t ) ulCount;
+	}
+
+#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_uxTaskGetStackHighWaterMark == 1 )
+
+	UBaseType_t uxTaskGetStackHighWaterMark( TaskHandle_t xTask )
+	{
+	TCB_t *pxTCB;
+	uint8_t *pucEndOfStack;
+	UBaseType_t uxReturn;
+
+		pxTCB = prvGetTCBFromHandle( xTask );
+
+		#if portSTACK_GROWTH < 0
+		{
+			pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
+		}
+		#else
+		{
+			pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
+		}
+		#endif
+
+		uxReturn = ( UBaseType_t ) prvTaskCheckFreeStackSpace( pucEndOfStack );
+
+		return uxReturn;
+	}
+
+#endif /* INCLUDE_uxTaskGetStackHighWaterMark */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_vTaskDelete == 1 )
+
+	static void prvDeleteTCB( TCB_t *pxTCB )
+	{
+		/* This call is required specifically for the TriCore port.  It must be
+		above the vPortFree() calls.  The call is also used by ports/demos that
+		want to allocate and clean RAM statically. */
+		portCLEAN_UP_TCB( pxTCB );
+
+		/* Free up the memory allocated by the scheduler for the task.  It is up
+		to the task to free any memory allocated at the application level. */
+		#if ( configUSE_NEWLIB_REENTRANT == 1 )
+		{
+			_reclaim_reent( &( pxTCB->xNewLib_reent ) );
+		}
+		#endif /* configUSE_NEWLIB_REENTRANT */
+
+		#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) && ( portUSING_MPU_WRAPPERS == 0 ) )
+		{
+			/* The task can only have been allocated dynamically - free both
+			the stack and TCB, or keep them for a new task. */
+			#if( configUSE_TASK_RECYCLING == 1 )
+			{
+				prvRecycleTask( pxTCB );
+			}
+			#else
+			{
+				vPortFree( pxTCB->pxStack );
+				vPortFree( pxTCB );
+			}
+			#endif
+		}
+		#elif( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 Macro has been consolidated for readability reasons. */
+		{
+			/* The task could have been allocated statically or dynamically, so
+			check what was statically allocated before trying to free the
+			memory. */
+			if( pxTCB->ucStaticallyAllocated == tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB )
+			{
+				/* Both the stack and TCB were allocated dynamically, so both
+				must be freed, or kept for a new task. */
+				#if( configUSE_TASK_RECYCLING == 1 )
+				{
+					prvRecycleTask( pxTCB );
+				}
+				#else
+				{
+					vPortFree( pxTCB->pxStack );
+					vPortFree( pxTCB );
+				}
+				#endif
+			}
+			else if( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_ONLY )
+			{
+				/* Only the stack was statically allocated, so the TCB is the
+				only memory that must be freed. */
+				vPortFree( pxTCB );
+			}
+			else
+			{
+				/* Neither the stack nor the TCB were allocated dynamically, so
+				nothing needs to be freed. */
+				configASSERT( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_AND_TCB	);
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+	}
+
+#endif /* INCLUDE_vTaskDelete */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_RECYCLING == 1 )
+
+	static TCB_t *prvTakeRecycledTask( uint32_t ulStackDepth )
+	{
+	TCB_t *pxTCB = NULL;
+	UBaseType_t x;
+
+		/* Tasks that deleted themselves wait for the idle task to free their
+		memory.  They are not running, as the calling task is, so move them
+		to the pool now rather than allocate while they wait. */
+		prvCheckTasksWaitingTermination();
+
+		taskENTER_CRITICAL();
+		{
+			for( x = 0; x < ( UBaseType_t ) configTASK_RECYCLE_POOL_SIZE; x++ )
+			{
+				if( ( pxRecycledTasks[ x ] != NULL ) && ( pxRecycledTasks[ x ]->ulRecycleStackDepth == ulStackDepth ) )
+				{
+					pxTCB = pxRecycledTasks[ x ];
+					pxRecycledTasks[ x ] = NULL;
+					break;
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return pxTCB;
+	}
+
+#endif /* configUSE_TASK_RECYCLING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_RECYCLING == 1 )
+
+	static void prvRecycleTask( TCB_t *pxTCB )
+	{
+	UBaseType_t x;
+	BaseType_t xKept = pdFALSE;
+
+		if( pxTCB->ulRecycleStackDepth != 0UL )
+		{
+			taskENTER_CRITICAL();
+			{
+				for( x = 0; x < ( UBaseType_t ) configTASK_RECYCLE_POOL_SIZE; x++ )
+				{
+					if( pxRecycledTasks[ x ] == NULL )
+					{
+						pxRecycledTasks[ x ] = pxTCB;
+						xKept = pdTRUE;
+						break;
+					}
+				}
+			}
+			taskEXIT_CRITICAL();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( xKept == pdFALSE )
+		{
+			vPortFree( pxTCB->pxStack );
+			vPortFree( pxTCB );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_TASK_RECYCLING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_RECYCLING == 1 )
+
+	UBaseType_t uxTaskFlushRecycledTasks( void )
+	{
+	TCB_t *pxTCB;
+	UBaseType_t x, uxFreed = 0;
+
+		for( x = 0; x < ( UBaseType_t ) configTASK_RECYCLE_POOL_SIZE; x++ )
+		{
+			taskENTER_CRITICAL();
+			{
+				pxTCB = pxRecycledTasks[ x ];
+				pxRecycledTasks[ x ] = NULL;
+			}
+			taskEXIT_CRITICAL();
+
+			if( pxTCB != NULL )
+			{
+				vPortFree( pxTCB->pxStack );
+				vPortFree( pxTCB );
+				uxFreed++;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		return uxFreed;
+	}
+
+#endif /* configUSE_TASK_RECYCLING */
+/*-----------------------------------------------------------*/
+
+#if ( configRESUME_ALL_BATCH_SIZE > 0 )
+
+	static BaseType_t prvMovePendingReadyTasks( UBaseType_t * const puxBudget )
+	{
+	TCB_t *pxTCB = NULL;
+
+		while( ( listLIST_IS_EMPTY( &xPendingReadyList ) == pdFALSE ) && ( *puxBudget > ( UBaseType_t ) 0U ) )
+		{
+			( *puxBudget )--;
+
+			pxTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( ( &xPendingReadyList ) );
+			( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+			( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+			prvAddTaskToReadyList( pxTCB );
+
+			/* If the moved task has a priority higher than the current task
+			then a yield must be performed. */
+			if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+			{
+				xYieldPending = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		if( pxTCB != NULL )
+		{
+			/* As xTaskResumeAll(), the tasks may have left the delayed list
+			without the next unblock time being re-calculated. */
+			prvResetNextTaskUnblockTime();
+		}
+
+		return listLIST_IS_EMPTY( &xPendingReadyList );
+	}
+
+#endif /* configRESUME_ALL_BATCH_SIZE */
+/*-----------------------------------------------------------*/
+
+#if ( configRESUME_ALL_BATCH_SIZE > 0 )
+
+	static BaseType_t prvCatchUpPendedTicks( UBaseType_t * const puxBudget )
+	{
+	TCB_t *pxTCB;
+	TickType_t xItemValue, xTicks;
+
+		for( ;; )
+		{
+			/* Unblock the tasks whose wake time is the current tick count or
+			earlier, as xTaskIncrementTick() does.  The tick count may already
+			include ticks caught up by an earlier batch, so this is done before
+			looking at the pended ticks. */
+			while( xTickCount >= xNextTaskUnblockTime )
+			{
+				if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+				{
+					xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+					break;
+				}
+
+				pxTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList );
+				xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
+
+				if( xTickCount < xItemValue )
+				{
+					xNextTaskUnblockTime = xItemValue;
+					break;
+				}
+				else if( *puxBudget == ( UBaseType_t ) 0U )
+				{
+					return pdFALSE;
+				}
+				else
+				{
+					( *puxBudget )--;
+				}
+
+				( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+
+				/* The event list item may be on an event list or, if an
+				interrupt has readied the task since the scheduler was
+				suspended, on the pending ready list. */
+				if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+				{
+					( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				prvAddTaskToReadyList( pxTCB );
+
+				#if ( configUSE_PREEMPTION == 1 )
+				{
+					if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+					{
+						xYieldPending = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configUSE_PREEMPTION */
+			}
+
+			if( uxPendedTicks == ( UBaseType_t ) 0U )
+			{
+				return pdTRUE;
+			}
+			else if( *puxBudget == ( UBaseType_t ) 0U )
+			{
+				return pdFALSE;
+			}
+			else
+			{
+				( *puxBudget )--;
+			}
+
+			/* The delayed list only has to be looked at again once the tick
+			count reaches the next unblock time, so all the pended ticks are
+			applied in one step, stopping at the overflow of the tick count
+			where the delayed lists are switched.  The task budgets compare the
+			ticks elapsed since the start of each period, so they are correct
+			after a step of any length, but the timer wheel has to see every
+			tick count, so with timers the ticks are applied one at a time,
+			each taking one item of the budget. */
+			#if ( configUSE_TIMERS == 1 )
+			{
+				xTicks = ( TickType_t ) 1U;
+			}
+			#else
+			{
+				xTicks = ( TickType_t ) ( portMAX_DELAY - xTickCount );
+
+				if( xTicks == ( TickType_t ) 0U )
+				{
+					xTicks = ( TickType_t ) 1U;
+				}
+				else if( ( UBaseType_t ) xTicks > uxPendedTicks )
+				{
+					xTicks = ( TickType_t ) uxPendedTicks;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif
+
+			xTickCount += xTicks;
+			uxPendedTicks -= ( UBaseType_t ) xTicks;
+
+			if( xTickCount == ( TickType_t ) 0U )
+			{
+				taskSWITCH_DELAYED_LISTS();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			#if ( configUSE_TASK_BUDGETS == 1 )
+			{
+				/* The running task is not charged here: the next tick charges
+				it all the cycles it has used since its last charge. */
+				if( prvReplenishTaskBudgets( xTickCount ) != pdFALSE )
+				{
+					xYieldPending = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_TASK_BUDGETS */
+
+			#if ( configUSE_TIMERS == 1 )
+			{
+				if( xTimerIncrementTick( xTickCount ) != pdFALSE )
+				{
+					xYieldPending = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_TIMERS */
+
+			#if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
+			{
+				if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
+				{
+					xYieldPending = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) ) */
+		}
+	}
+
+#endif /* configRESUME_ALL_BATCH_SIZE */
+/*-----------------------------------------------------------*/
+
+static void prvResetNextTaskUnblockTime( void )
+{
+TCB_t *pxTCB;
+
+	if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+	{
+		/* The new current delayed list is empty.  Set xNextTaskUnblockTime to
+		the maximum possible value so it is	extremely unlikely that the
+		if( xTickCount >= xNextTaskUnblockTime ) test will pass until
+		there is an item in the delayed list. */
+		xNextTaskUnblockTime = portMAX_DELAY;
+	}
+	else
+	{
+		/* The new current delayed list is not empty, get the value of
+		the item at the head of the delayed list.  This is the time at
+		which the task at the head of the delayed list should be removed
+		from the Blocked state. */
+		( pxTCB ) = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList );
+		xNextTaskUnblockTime = listGET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_BUDGETS == 1 )
+
+	BaseType_t xTaskSetBudget( TaskHandle_t xTask, uint32_t ulBudgetCycles, TickType_t xReplenishPeriod, eBudgetAction eAction )
+	{
+	TCB_t *pxTCB;
+	UBaseType_t x, uxEntry = ( UBaseType_t ) configMAX_BUDGETED_TASKS;
+	BaseType_t xReturn = pdPASS, xYieldRequired;
+
+		configASSERT( ( ulBudgetCycles == 0UL ) || ( xReplenishPeriod > ( TickType_t ) 0U ) );
+
+		#if ( configUSE_TASK_BUDGET_HOOK == 0 )
+		{
+			configASSERT( eAction != eBudgetCallHook );
+		}
+		#endif
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+
+			/* Throttling or demoting the idle task would leave the scheduler
+			with nothing to run. */
+			configASSERT( pxTCB != xIdleTaskHandle );
+
+			/* Ending a demotion can make a task ready to run at a priority
+			above the calling task. */
+			xYieldRequired = ( pxTCB->ucBudgetState == taskBUDGET_DEMOTED ) ? pdTRUE : pdFALSE;
+
+			if( ulBudgetCycles == 0UL )
+			{
+				prvRemoveTaskBudget( pxTCB );
+			}
+			else
+			{
+				/* Use the task's existing entry if it has one, otherwise the
+				first free entry. */
+				for( x = 0; x < ( UBaseType_t ) configMAX_BUDGETED_TASKS; x++ )
+				{
+					if( pxBudgetedTasks[ x ] == pxTCB )
+					{
+						uxEntry = x;
+						break;
+					}
+					else if( ( pxBudgetedTasks[ x ] == NULL ) && ( uxEntry == ( UBaseType_t ) configMAX_BUDGETED_TASKS ) )
+					{
+						uxEntry = x;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+
+				if( uxEntry < ( UBaseType_t ) configMAX_BUDGETED_TASKS )
+				{
+					/* Changing the budget of a demoted task starts a new
+					period, so end the demotion first. */
+					prvRemoveTaskBudget( pxTCB );
+
+					pxTCB->ulBudgetCycles = ulBudgetCycles;
+					pxTCB->ulBudgetRemaining = ulBudgetCycles;
+					pxTCB->xBudgetPeriod = xReplenishPeriod;
+					pxTCB->xBudgetPeriodStart = xTickCount;
+					pxTCB->ucBudgetAction = ( uint8_t ) eAction;
+					pxBudgetedTasks[ uxEntry ] = pxTCB;
+				}
+				else
+				{
+					xReturn = pdFAIL;
+				}
+			}
+
+			if( ( xYieldRequired != pdFALSE ) && ( pxTCB->ucBudgetState != taskBUDGET_DEMOTED ) )
+			{
+				taskYIELD_IF_USING_PREEMPTION();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif /* configUSE_TASK_BUDGETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_BUDGETS == 1 )
+
+	UBaseType_t uxTaskGetBudgetOverruns( TaskHandle_t xTask )
+	{
+	TCB_t *pxTCB;
+
+		pxTCB = prvGetTCBFromHandle( xTask );
+		return pxTCB->uxBudgetOverruns;
+	}
+
+#endif /* configUSE_TASK_BUDGETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_BUDGETS == 1 )
+
+	uint32_t ulTaskGetBudgetRemaining( TaskHandle_t xTask )
+	{
+	TCB_t *pxTCB;
+
+		pxTCB = prvGetTCBFromHandle( xTask );
+		return pxTCB->ulBudgetRemaining;
+	}
+
+#endif /* configUSE_TASK_BUDGETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_BUDGETS == 1 )
+
+	static BaseType_t prvChargeTaskBudget( void )
+	{
+	TCB_t * const pxTCB = pxCurrentTCB;
+	uint32_t ulNow, ulUsed;
+	TickType_t xElapsed, xTicksToReplenish;
+	BaseType_t xSwitchRequired = pdFALSE;
+
+		/* Unsigned arithmetic gives the right answer across a wrap of the
+		cycle counter, as a task is charged at least once per tick. */
+		ulNow = portGET_CYCLE_COUNTER();
+		ulUsed = ulNow - ulBudgetChargedTime;
+		ulBudgetChargedTime = ulNow;
+
+		if( pxTCB->ulBudgetCycles != 0UL )
+		{
+			if( ulUsed < pxTCB->ulBudgetRemaining )
+			{
+				pxTCB->ulBudgetRemaining -= ulUsed;
+			}
+			else
+			{
+				pxTCB->ulBudgetRemaining = 0UL;
+
+				if( pxTCB->ucBudgetState == taskBUDGET_AVAILABLE )
+				{
+					/* The budget ran out for the first time in this
+					period. */
+					pxTCB->ucBudgetState = taskBUDGET_EXHAUSTED;
+					( pxTCB->uxBudgetOverruns )++;
+					traceTASK_BUDGET_EXHAUSTED( pxTCB );
+
+					if( pxTCB->ucBudgetAction == ( uint8_t ) eBudgetDemote )
+					{
+						if( pxTCB->uxPriority > ( UBaseType_t ) configTASK_BUDGET_DEMOTE_PRIORITY )
+						{
+							pxTCB->uxBudgetSavedPriority = pxTCB->uxPriority;
+							pxTCB->ucBudgetState = taskBUDGET_DEMOTED;
+							prvSetBudgetPriority( pxTCB, ( UBaseType_t ) configTASK_BUDGET_DEMOTE_PRIORITY );
+							xSwitchRequired = pdTRUE;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					#if ( configUSE_TASK_BUDGET_HOOK == 1 )
+					else if( pxTCB->ucBudgetAction == ( uint8_t ) eBudgetCallHook )
+					{
+						vApplicationTaskBudgetHook( ( TaskHandle_t ) pxTCB );
+					}
+					#endif
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* A task that was already blocked when its budget ran out can
+				run again before it is replenished, so it is blocked each time
+				it is found running without a budget, not only the first. */
+				if( pxTCB->ucBudgetAction == ( uint8_t ) eBudgetSuspend )
+				{
+					if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+					{
+						xElapsed = xTickCount - pxTCB->xBudgetPeriodStart;
+
+						if( xElapsed < pxTCB->xBudgetPeriod )
+						{
+							xTicksToReplenish = pxTCB->xBudgetPeriod - xElapsed;
+						}
+						else
+						{
+							/* vTaskStepTick() moved the tick count past the
+							end of the period, the budget will be replenished
+							on the next tick. */
+							xTicksToReplenish = ( TickType_t ) 1U;
+						}
+
+						prvAddCurrentTaskToDelayedList( xTicksToReplenish, pdFALSE );
+						xSwitchRequired = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xSwitchRequired;
+	}
+
+#endif /* configUSE_TASK_BUDGETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_BUDGETS == 1 )
+
+	static BaseType_t prvReplenishTaskBudgets( const TickType_t xConstTickCount )
+	{
+	UBaseType_t x;
+	TCB_t *pxTCB;
+	BaseType_t xSwitchRequired = pdFALSE;
+
+		for( x = 0; x < ( UBaseType_t ) configMAX_BUDGETED_TASKS; x++ )
+		{
+			pxTCB = pxBudgetedTasks[ x ];
+
+			if( pxTCB == NULL )
+			{
+				continue;
+			}
+
+			if( ( TickType_t ) ( xConstTickCount - pxTCB->xBudgetPeriodStart ) >= pxTCB->xBudgetPeriod )
+			{
+				pxTCB->xBudgetPeriodStart = xConstTickCount;
+				pxTCB->ulBudgetRemaining = pxTCB->ulBudgetCycles;
+
+				if( pxTCB->ucBudgetState == taskBUDGET_DEMOTED )
+				{
+					prvRestoreBudgetPriority( pxTCB );
+
+					#if ( configUSE_PREEMPTION == 1 )
+					{
+						if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+						{
+							xSwitchRequired = pdTRUE;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					#endif /* configUSE_PREEMPTION */
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 
-			prvDeleteTCB( pxTCB );
+				pxTCB->ucBudgetState = taskBUDGET_AVAILABLE;
+				traceTASK_BUDGET_REPLENISHED( pxTCB );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 		}
+
+		return xSwitchRequired;
 	}
-	#endif /* INCLUDE_vTaskDelete */
-}
+
+#endif /* configUSE_TASK_BUDGETS */
 /*-----------------------------------------------------------*/
 
-#if( configUSE_TRACE_FACILITY == 1 )
+#if ( configUSE_TASK_BUDGETS == 1 )
 
-	void vTaskGetInfo( TaskHandle_t xTask, TaskStatus_t *pxTaskStatus, BaseType_t xGetFreeStackSpace, eTaskState eState )
+	static void prvRestoreBudgetPriority( TCB_t * const pxTCB )
 	{
-	TCB_t *pxTCB;
-
-		/* xTask is NULL then get the state of the calling task. */
-		pxTCB = prvGetTCBFromHandle( xTask );
-
-		pxTaskStatus->xHandle = ( TaskHandle_t ) pxTCB;
-		pxTaskStatus->pcTaskName = ( const char * ) &( pxTCB->pcTaskName [ 0 ] );
-		pxTaskStatus->uxCurrentPriority = pxTCB->uxPriority;
-		pxTaskStatus->pxStackBase = pxTCB->pxStack;
-		pxTaskStatus->xTaskNumber = pxTCB->uxTCBNumber;
+	UBaseType_t uxRestorePriority;
 
+		/* With mutexes the base priority is the one to return to, as
+		vTaskPrioritySet() only changes the base priority of a task that is not
+		running at its base priority. */
 		#if ( configUSE_MUTEXES == 1 )
 		{
-			pxTaskStatus->uxBasePriority = pxTCB->uxBasePriority;
+			uxRestorePriority = pxTCB->uxBasePriority;
 		}
 		#else
 		{
-			pxTaskStatus->uxBasePriority = 0;
+			uxRestorePriority = pxTCB->uxBudgetSavedPriority;
 		}
 		#endif
 
-		#if ( configGENERATE_RUN_TIME_STATS == 1 )
+		if( uxRestorePriority > pxTCB->uxPriority )
 		{
-			pxTaskStatus->ulRunTimeCounter = pxTCB->ulRunTimeCounter;
+			prvSetBudgetPriority( pxTCB, uxRestorePriority );
 		}
-		#else
+		else
 		{
-			pxTaskStatus->ulRunTimeCounter = 0;
+			mtCOVERAGE_TEST_MARKER();
 		}
-		#endif
+	}
 
-		/* Obtaining the task state is a little fiddly, so is only done if the
-		value of eState passed into this function is eInvalid - otherwise the
-		state is just set to whatever is passed in. */
-		if( eState != eInvalid )
-		{
-			if( pxTCB == pxCurrentTCB )
-			{
-				pxTaskStatus->eCurrentState = eRunning;
-			}
-			else
-			{
-				pxTaskStatus->eCurrentState = eState;
+#endif /* configUSE_TASK_BUDGETS */
+/*-----------------------------------------------------------*/
 
-				#if ( INCLUDE_vTaskSuspend == 1 )
-				{
-					/* If the task is in the suspended list then there is a
-					chance it is actually just blocked indefinitely - so really
-					it should be reported as being in the Blocked state. */
-					if( eState == eSuspended )
-					{
-						vTaskSuspendAll();
-						{
-							if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
-							{
-								pxTaskStatus->eCurrentState = eBlocked;
-							}
-						}
-						( void ) xTaskResumeAll();
-					}
-				}
-				#endif /* INCLUDE_vTaskSuspend */
-			}
+#if ( configUSE_TASK_BUDGETS == 1 )
+
+	static void prvSetBudgetPriority( TCB_t * const pxTCB, const UBaseType_t uxNewPriority )
+	{
+	const UBaseType_t uxPriorityUsedOnEntry = pxTCB->uxPriority;
+
+		/* Only reset the event list item value if the value is not being used
+		for anything else. */
+		if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+		{
+			listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxNewPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 		}
 		else
 		{
-			pxTaskStatus->eCurrentState = eTaskGetState( pxTCB );
+			mtCOVERAGE_TEST_MARKER();
 		}
 
-		/* Obtaining the stack space takes some time, so the xGetFreeStackSpace
-		parameter is provided to allow it to be skipped. */
-		if( xGetFreeStackSpace != pdFALSE )
+		if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
 		{
-			#if ( portSTACK_GROWTH > 0 )
+			if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
 			{
-				pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxEndOfStack );
+				taskCLEAR_READY_PRIORITY( uxPriorityUsedOnEntry );
 			}
-			#else
+			else
 			{
-				pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxStack );
+				mtCOVERAGE_TEST_MARKER();
 			}
-			#endif
+
+			pxTCB->uxPriority = uxNewPriority;
+			prvAddTaskToReadyList( pxTCB );
 		}
 		else
 		{
-			pxTaskStatus->usStackHighWaterMark = 0;
+			pxTCB->uxPriority = uxNewPriority;
 		}
+
+		/* Remove compiler warning about unused variables when the port
+		optimised task selection is not being used. */
+		( void ) uxPriorityUsedOnEntry;
 	}
 
-#endif /* configUSE_TRACE_FACILITY */
+#endif /* configUSE_TASK_BUDGETS */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if ( configUSE_TASK_BUDGETS == 1 )
 
-	static UBaseType_t prvListTasksWithinSingleList( TaskStatus_t *pxTaskStatusArray, List_t *pxList, eTaskState eState )
+	static void prvRemoveTaskBudget( TCB_t * const pxTCB )
 	{
-	configLIST_VOLATILE TCB_t *pxNextTCB, *pxFirstTCB;
-	UBaseType_t uxTask = 0;
+	UBaseType_t x;
 
-		if( listCURRENT_LIST_LENGTH( pxList ) > ( UBaseType_t ) 0 )
+		if( pxTCB->ucBudgetState == taskBUDGET_DEMOTED )
 		{
-			listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList );
-
-			/* Populate an TaskStatus_t structure within the
-			pxTaskStatusArray array for each task that is referenced from
-			pxList.  See the definition of TaskStatus_t in task.h for the
-			meaning of each TaskStatus_t structure member. */
-			do
-			{
-				listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList );
-				vTaskGetInfo( ( TaskHandle_t ) pxNextTCB, &( pxTaskStatusArray[ uxTask ] ), pdTRUE, eState );
-				uxTask++;
-			} while( pxNextTCB != pxFirstTCB );
+			prvRestoreBudgetPriority( pxTCB );
 		}
 		else
 		{
 			mtCOVERAGE_TEST_MARKER();
 		}
 
-		return uxTask;
-	}
-
-#endif /* configUSE_TRACE_FACILITY */
-/*-----------------------------------------------------------*/
-
-#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) )
-
-	static uint16_t prvTaskCheckFreeStackSpace( const uint8_t * pucStackByte )
-	{
-	uint32_t ulCount = 0U;
+		pxTCB->ulBudgetCycles = 0UL;
+		pxTCB->ucBudgetState = taskBUDGET_AVAILABLE;
 
-		while( *pucStackByte == ( uint8_t ) tskSTACK_FILL_BYTE )
+		for( x = 0; x < ( UBaseType_t ) configMAX_BUDGETED_TASKS; x++ )
 		{
-			pucStackByte -= portSTACK_GROWTH;
-			ulCount++;
+			if( pxBudgetedTasks[ x ] == pxTCB )
+			{
+				pxBudgetedTasks[ x ] = NULL;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 		}
-
-		ulCount /= ( uint32_t ) sizeof( StackType_t ); /*lint !e961 Casting is not redundant on smaller architectures. */
-
-		return ( uint16_t ) ulCount;
 	}
 
-#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) ) */
+#endif /* configUSE_TASK_BUDGETS */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_uxTaskGetStackHighWaterMark == 1 )
+#if ( configUSE_TASK_SNAPSHOTS == 1 )
 
-	UBaseType_t uxTaskGetStackHighWaterMark( TaskHandle_t xTask )
+	static void prvAddTaskToAllTasks( TCB_t * const pxTCB )
 	{
-	TCB_t *pxTCB;
-	uint8_t *pucEndOfStack;
-	UBaseType_t uxReturn;
-
-		pxTCB = prvGetTCBFromHandle( xTask );
+		pxTCB->pxPrevCreated = NULL;
+		pxTCB->pxNextCreated = pxAllTasks;
 
-		#if portSTACK_GROWTH < 0
+		if( pxAllTasks != NULL )
 		{
-			pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
+			pxAllTasks->pxPrevCreated = pxTCB;
 		}
-		#else
+		else
 		{
-			pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
+			mtCOVERAGE_TEST_MARKER();
 		}
-		#endif
-
-		uxReturn = ( UBaseType_t ) prvTaskCheckFreeStackSpace( pucEndOfStack );
 
-		return uxReturn;
+		pxAllTasks = pxTCB;
 	}
 
-#endif /* INCLUDE_uxTaskGetStackHighWaterMark */
+#endif /* configUSE_TASK_SNAPSHOTS */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_vTaskDelete == 1 )
+#if ( configUSE_TASK_SNAPSHOTS == 1 )
 
-	static void prvDeleteTCB( TCB_t *pxTCB )
+	static void prvRemoveTaskFromAllTasks( TCB_t * const pxTCB )
 	{
-		/* This call is required specifically for the TriCore port.  It must be
-		above the vPortFree() calls.  The call is also used by ports/demos that
-		want to allocate and clean RAM statically. */
-		portCLEAN_UP_TCB( pxTCB );
+		/* Do not leave a snapshot in progress pointing at the task. */
+		if( pxSnapshotCursor == pxTCB )
+		{
+			pxSnapshotCursor = pxTCB->pxNextCreated;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
 
-		/* Free up the memory allocated by the scheduler for the task.  It is up
-		to the task to free any memory allocated at the application level. */
-		#if ( configUSE_NEWLIB_REENTRANT == 1 )
+		if( pxTCB->pxPrevCreated != NULL )
 		{
-			_reclaim_reent( &( pxTCB->xNewLib_reent ) );
+			pxTCB->pxPrevCreated->pxNextCreated = pxTCB->pxNextCreated;
+		}
+		else
+		{
+			pxAllTasks = pxTCB->pxNextCreated;
 		}
-		#endif /* configUSE_NEWLIB_REENTRANT */
 
-		#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) && ( portUSING_MPU_WRAPPERS == 0 ) )
+		if( pxTCB->pxNextCreated != NULL )
 		{
-			/* The task can only have been allocated dynamically - free both
-			the stack and TCB. */
-			vPortFree( pxTCB->pxStack );
-			vPortFree( pxTCB );
+			pxTCB->pxNextCreated->pxPrevCreated = pxTCB->pxPrevCreated;
 		}
-		#elif( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 Macro has been consolidated for readability reasons. */
+		else
 		{
-			/* The task could have been allocated statically or dynamically, so
-			check what was statically allocated before trying to free the
-			memory. */
-			if( pxTCB->ucStaticallyAllocated == tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB )
-			{
-				/* Both the stack and TCB were allocated dynamically, so both
-				must be freed. */
-				vPortFree( pxTCB->pxStack );
-				vPortFree( pxTCB );
-			}
-			else if( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_ONLY )
-			{
-				/* Only the stack was statically allocated, so the TCB is the
-				only memory that must be freed. */
-				vPortFree( pxTCB );
-			}
-			else
-			{
-				/* Neither the stack nor the TCB were allocated dynamically, so
-				nothing needs to be freed. */
-				configASSERT( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_AND_TCB	);
-				mtCOVERAGE_TEST_MARKER();
-			}
+			mtCOVERAGE_TEST_MARKER();
 		}
-		#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
 	}
 
-#endif /* INCLUDE_vTaskDelete */
+#endif /* configUSE_TASK_SNAPSHOTS */
 /*-----------------------------------------------------------*/
 
-static void prvResetNextTaskUnblockTime( void )
-{
-TCB_t *pxTCB;
+#if ( configUSE_TASK_SNAPSHOTS == 1 )
 
-	if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
-	{
-		/* The new current delayed list is empty.  Set xNextTaskUnblockTime to
-		the maximum possible value so it is	extremely unlikely that the
-		if( xTickCount >= xNextTaskUnblockTime ) test will pass until
-		there is an item in the delayed list. */
-		xNextTaskUnblockTime = portMAX_DELAY;
-	}
-	else
+	static uint8_t *prvExportLittleEndian( uint8_t *pucBuffer, uint32_t ulValue, size_t xBytes )
 	{
-		/* The new current delayed list is not empty, get the value of
-		the item at the head of the delayed list.  This is the time at
-		which the task at the head of the delayed list should be removed
-		from the Blocked state. */
-		( pxTCB ) = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList );
-		xNextTaskUnblockTime = listGET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ) );
+	size_t x;
+
+		for( x = 0; x < xBytes; x++ )
+		{
+			pucBuffer[ x ] = ( uint8_t ) ( ulValue >> ( 8U * x ) );
+		}
+
+		return &( pucBuffer[ xBytes ] );
 	}
-}
+
+#endif /* configUSE_TASK_SNAPSHOTS */
 /*-----------------------------------------------------------*/
 
 #if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) )
@@ -4246,6 +5997,41 @@ TCB_t *pxTCB;
 #endif /* ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
 /*----------------------------------------------------------*/
 
+#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
+
+	void vTaskListStackUsage( char *pcWriteBuffer, const TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize )
+	{
+	UBaseType_t x;
+	uint32_t ulUsed, ulPercent;
+
+		/* Make sure the write buffer does not contain a string. */
+		*pcWriteBuffer = 0x00;
+
+		for( x = 0; x < uxArraySize; x++ )
+		{
+			/* The high water mark is the least free space, so the most used
+			is the rest of the stack.  Without the stack size only the free
+			space is known. */
+			if( pxTaskStatusArray[ x ].ulStackDepth > ( uint32_t ) pxTaskStatusArray[ x ].usStackHighWaterMark )
+			{
+				ulUsed = pxTaskStatusArray[ x ].ulStackDepth - ( uint32_t ) pxTaskStatusArray[ x ].usStackHighWaterMark;
+				ulPercent = ( ulUsed * 100UL ) / pxTaskStatusArray[ x ].ulStackDepth;
+			}
+			else
+			{
+				ulUsed = 0UL;
+				ulPercent = 0UL;
+			}
+
+			pcWriteBuffer = prvWriteNameToBuffer( pcWriteBuffer, pxTaskStatusArray[ x ].pcTaskName );
+			sprintf( pcWriteBuffer, "\t%u\t%u\t%u\t%u%%\r\n", ( unsigned int ) pxTaskStatusArray[ x ].ulStackDepth, ( unsigned int ) ulUsed, ( unsigned int ) pxTaskStatusArray[ x ].usStackHighWaterMark, ( unsigned int ) ulPercent );
+			pcWriteBuffer += strlen( pcWriteBuffer );
+		}
+	}
+
+#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) ) */
+/*----------------------------------------------------------*/
+
 #if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 
 	void vTaskGetRunTimeStats( char *pcWriteBuffer )
@@ -4406,17 +6192,19 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	uint32_t ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait )
+	uint32_t ulTaskGenericNotifyTake( UBaseType_t uxIndexToWait, BaseType_t xClearCountOnExit, TickType_t xTicksToWait )
 	{
 	uint32_t ulReturn;
 
+		configASSERT( uxIndexToWait < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
 		taskENTER_CRITICAL();
 		{
 			/* Only block if the notification count is not already non-zero. */
-			if( pxCurrentTCB->ulNotifiedValue == 0UL )
+			if( pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] == 0UL )
 			{
 				/* Mark this task as waiting for a notification. */
-				pxCurrentTCB->ucNotifyState = taskWAITING_NOTIFICATION;
+				pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskWAITING_NOTIFICATION;
 
 				if( xTicksToWait > ( TickType_t ) 0 )
 				{
@@ -4444,17 +6232,17 @@ TickType_t uxReturn;
 		taskENTER_CRITICAL();
 		{
 			traceTASK_NOTIFY_TAKE();
-			ulReturn = pxCurrentTCB->ulNotifiedValue;
+			ulReturn = pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ];
 
 			if( ulReturn != 0UL )
 			{
 				if( xClearCountOnExit != pdFALSE )
 				{
-					pxCurrentTCB->ulNotifiedValue = 0UL;
+					pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] = 0UL;
 				}
 				else
 				{
-					pxCurrentTCB->ulNotifiedValue = ulReturn - ( uint32_t ) 1;
+					pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] = ulReturn - ( uint32_t ) 1;
 				}
 			}
 			else
@@ -4462,7 +6250,7 @@ TickType_t uxReturn;
 				mtCOVERAGE_TEST_MARKER();
 			}
 
-			pxCurrentTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+			pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskNOT_WAITING_NOTIFICATION;
 		}
 		taskEXIT_CRITICAL();
 
@@ -4474,22 +6262,24 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait )
+	BaseType_t xTaskGenericNotifyWait( UBaseType_t uxIndexToWait, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait )
 	{
 	BaseType_t xReturn;
 
+		configASSERT( uxIndexToWait < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
 		taskENTER_CRITICAL();
 		{
 			/* Only block if a notification is not already pending. */
-			if( pxCurrentTCB->ucNotifyState != taskNOTIFICATION_RECEIVED )
+			if( pxCurrentTCB->ucNotifyState[ uxIndexToWait ] != taskNOTIFICATION_RECEIVED )
 			{
 				/* Clear bits in the task's notification value as bits may get
 				set	by the notifying task or interrupt.  This can be used to
 				clear the value to zero. */
-				pxCurrentTCB->ulNotifiedValue &= ~ulBitsToClearOnEntry;
+				pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] &= ~ulBitsToClearOnEntry;
 
 				/* Mark this task as waiting for a notification. */
-				pxCurrentTCB->ucNotifyState = taskWAITING_NOTIFICATION;
+				pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskWAITING_NOTIFICATION;
 
 				if( xTicksToWait > ( TickType_t ) 0 )
 				{
@@ -4522,14 +6312,14 @@ TickType_t uxReturn;
 			{
 				/* Output the current notification value, which may or may not
 				have changed. */
-				*pulNotificationValue = pxCurrentTCB->ulNotifiedValue;
+				*pulNotificationValue = pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ];
 			}
 
 			/* If ucNotifyValue is set then either the task never entered the
 			blocked state (because a notification was already pending) or the
 			task unblocked because of a notification.  Otherwise the task
 			unblocked because of a timeout. */
-			if( pxCurrentTCB->ucNotifyState != taskNOTIFICATION_RECEIVED )
+			if( pxCurrentTCB->ucNotifyState[ uxIndexToWait ] != taskNOTIFICATION_RECEIVED )
 			{
 				/* A notification was not received. */
 				xReturn = pdFALSE;
@@ -4538,11 +6328,11 @@ TickType_t uxReturn;
 			{
 				/* A notification was already pending or a notification was
 				received while the task was waiting. */
-				pxCurrentTCB->ulNotifiedValue &= ~ulBitsToClearOnExit;
+				pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] &= ~ulBitsToClearOnExit;
 				xReturn = pdTRUE;
 			}
 
-			pxCurrentTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+			pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskNOT_WAITING_NOTIFICATION;
 		}
 		taskEXIT_CRITICAL();
 
@@ -4554,44 +6344,45 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue )
+	BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue )
 	{
 	TCB_t * pxTCB;
 	BaseType_t xReturn = pdPASS;
 	uint8_t ucOriginalNotifyState;
 
 		configASSERT( xTaskToNotify );
+		configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
 		pxTCB = ( TCB_t * ) xTaskToNotify;
 
 		taskENTER_CRITICAL();
 		{
 			if( pulPreviousNotificationValue != NULL )
 			{
-				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue;
+				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue[ uxIndexToNotify ];
 			}
 
-			ucOriginalNotifyState = pxTCB->ucNotifyState;
+			ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
 
-			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+			pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
 
 			switch( eAction )
 			{
 				case eSetBits	:
-					pxTCB->ulNotifiedValue |= ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] |= ulValue;
 					break;
 
 				case eIncrement	:
-					( pxTCB->ulNotifiedValue )++;
+					( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
 					break;
 
 				case eSetValueWithOverwrite	:
-					pxTCB->ulNotifiedValue = ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					break;
 
 				case eSetValueWithoutOverwrite :
 					if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
 					{
-						pxTCB->ulNotifiedValue = ulValue;
+						pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					}
 					else
 					{
@@ -4660,7 +6451,7 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken )
+	BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken )
 	{
 	TCB_t * pxTCB;
 	uint8_t ucOriginalNotifyState;
@@ -4668,6 +6459,7 @@ TickType_t uxReturn;
 	UBaseType_t uxSavedInterruptStatus;
 
 		configASSERT( xTaskToNotify );
+		configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
 
 		/* RTOS ports that support interrupt nesting have the concept of a
 		maximum	system call (or maximum API call) interrupt priority.
@@ -4693,30 +6485,30 @@ TickType_t uxReturn;
 		{
 			if( pulPreviousNotificationValue != NULL )
 			{
-				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue;
+				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue[ uxIndexToNotify ];
 			}
 
-			ucOriginalNotifyState = pxTCB->ucNotifyState;
-			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+			ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
+			pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
 
 			switch( eAction )
 			{
 				case eSetBits	:
-					pxTCB->ulNotifiedValue |= ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] |= ulValue;
 					break;
 
 				case eIncrement	:
-					( pxTCB->ulNotifiedValue )++;
+					( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
 					break;
 
 				case eSetValueWithOverwrite	:
-					pxTCB->ulNotifiedValue = ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					break;
 
 				case eSetValueWithoutOverwrite :
 					if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
 					{
-						pxTCB->ulNotifiedValue = ulValue;
+						pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					}
 					else
 					{
@@ -4784,13 +6576,14 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	void vTaskNotifyGiveFromISR( TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken )
+	void vTaskGenericNotifyGiveFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, BaseType_t *pxHigherPriorityTaskWoken )
 	{
 	TCB_t * pxTCB;
 	uint8_t ucOriginalNotifyState;
 	UBaseType_t uxSavedInterruptStatus;
 
 		configASSERT( xTaskToNotify );
+		configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
 
 		/* RTOS ports that support interrupt nesting have the concept of a
 		maximum	system call (or maximum API call) interrupt priority.
@@ -4814,12 +6607,12 @@ TickType_t uxReturn;
 
 		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
 		{
-			ucOriginalNotifyState = pxTCB->ucNotifyState;
-			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+			ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
+			pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
 
 			/* 'Giving' is equivalent to incrementing a count in a counting
 			semaphore. */
-			( pxTCB->ulNotifiedValue )++;
+			( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
 
 			traceTASK_NOTIFY_GIVE_FROM_ISR();
 
@@ -4873,20 +6666,21 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskNotifyStateClear( TaskHandle_t xTask )
+	BaseType_t xTaskGenericNotifyStateClear( TaskHandle_t xTask, UBaseType_t uxIndexToClear )
 	{
 	TCB_t *pxTCB;
 	BaseType_t xReturn;
 
+		configASSERT( uxIndexToClear < configTASK_NOTIFICATION_ARRAY_ENTRIES );
 		/* If null is passed in here then it is the calling task that is having
 		its notification state cleared. */
 		pxTCB = prvGetTCBFromHandle( xTask );
 
 		taskENTER_CRITICAL();
 		{
-			if( pxTCB->ucNotifyState == taskNOTIFICATION_RECEIVED )
+			if( pxTCB->ucNotifyState[ uxIndexToClear ] == taskNOTIFICATION_RECEIVED )
 			{
-				pxTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+				pxTCB->ucNotifyState[ uxIndexToClear ] = taskNOT_WAITING_NOTIFICATION;
 				xReturn = pdPASS;
 			}
 			else
@@ -4923,7 +6717,7 @@ const TickType_t xConstTickCount = xTickCount;
 	{
 		/* The current task must be in a ready list, so there is no need to
 		check, and the port reset macro can be called directly. */
-		portRESET_READY_PRIORITY( pxCurrentTCB->uxPriority, uxTopReadyPriority );
+		taskCLEAR_READY_PRIORITY( pxCurrentTCB->uxPriority );
 	}
 	else
 	{
@@ -67,6 +67,33 @@
     #define tmrSTATUS_IS_ACTIVE                  ( ( uint8_t ) 0x01 )
     #define tmrSTATUS_IS_STATICALLY_ALLOCATED    ( ( uint8_t ) 0x02 )
     #define tmrSTATUS_IS_AUTORELOAD              ( ( uint8_t ) 0x04 )
+    #define tmrSTATUS_IS_FAST_CALLBACK           ( ( uint8_t ) 0x08 )
+
+/* The timing wheel.  Level 0 has one slot per tick, and each slot of level n
+ * covers a whole rotation of level n - 1.  A timer is placed in the lowest level
+ * that can hold its remaining time, and is moved (cascaded) to a lower level
+ * when the tick count reaches the start of its slot.  Timers further away than
+ * the wheel can hold are placed in the last slot of the top level, and are
+ * cascaded back into the top level until they are close enough. */
+    #define tmrWHEEL_SLOTS             ( ( UBaseType_t ) 1U << configTIMER_WHEEL_SLOT_BITS )
+    #define tmrWHEEL_SLOT_MASK         ( ( TickType_t ) tmrWHEEL_SLOTS - ( TickType_t ) 1U )
+    #define tmrWHEEL_MAX_TICKS         ( ( TickType_t ) ( ( ( TickType_t ) 1U << ( configTIMER_WHEEL_SLOT_BITS * configTIMER_WHEEL_LEVELS ) ) - ( TickType_t ) 1U ) )
+
+/* Level 0 must only hold timers that expire within one rotation, so timers
+ * beyond the span of the wheel need a level above it. */
+    #if ( configTIMER_WHEEL_LEVELS < 2 )
+        #error configTIMER_WHEEL_LEVELS must be at least 2.
+    #endif
+
+    #if ( configUSE_16_BIT_TICKS == 1 )
+        #if ( ( configTIMER_WHEEL_SLOT_BITS * configTIMER_WHEEL_LEVELS ) > 15 )
+            #error configTIMER_WHEEL_SLOT_BITS * configTIMER_WHEEL_LEVELS must be less than 16 when 16 bit ticks are used.
+        #endif
+    #else
+        #if ( ( configTIMER_WHEEL_SLOT_BITS * configTIMER_WHEEL_LEVELS ) > 31 )
+            #error configTIMER_WHEEL_SLOT_BITS * configTIMER_WHEEL_LEVELS must be less than 32.
+        #endif
+    #endif
 
 /* The definition of the timers themselves. */
     typedef struct tmrTimerControl                  /* The old naming convention is used to prevent breaking kernel aware debuggers. */
@@ -125,16 +152,20 @@
 /*lint -save -e956 A manual analysis and inspection has been used to determine
  * which static variables must be declared volatile. */
 
-/* The list in which active timers are stored.  Timers are referenced in expire
- * time order, with the nearest expiry time at the front of the list.  Only the
- * timer service task is allowed to access these lists.
- * xActiveTimerList1 and xActiveTimerList2 could be at function scope but that
- * breaks some kernel aware debuggers, and debuggers that reply on removing the
- * static qualifier. */
-    PRIVILEGED_DATA static List_t xActiveTimerList1;
-    PRIVILEGED_DATA static List_t xActiveTimerList2;
-    PRIVILEGED_DATA static List_t * pxCurrentTimerList;
-    PRIVILEGED_DATA static List_t * pxOverflowTimerList;
+/* The timing wheel, and the tick count the wheel will process next.  The wheel
+ * is advanced from the tick interrupt, so is only accessed from critical
+ * sections.  xTimerWheel and xExpiredTimerList could be at function scope but
+ * that breaks some kernel aware debuggers, and debuggers that reply on removing
+ * the static qualifier. */
+    PRIVILEGED_DATA static List_t xTimerWheel[ configTIMER_WHEEL_LEVELS ][ tmrWHEEL_SLOTS ];
+    PRIVILEGED_DATA static TickType_t xWheelTime = ( TickType_t ) 0U;
+
+/* Timers that have expired and whose callbacks are waiting to be called by the
+ * timer service task, in expiry order.  xExpiredTimersSignalled is pdTRUE while
+ * a tmrCOMMAND_PROCESS_EXPIRED message is in xTimerQueue, so the tick sends at
+ * most one message however many timers expire. */
+    PRIVILEGED_DATA static List_t xExpiredTimerList;
+    PRIVILEGED_DATA static volatile BaseType_t xExpiredTimersSignalled = pdFALSE;
 
 /* A queue that is used to send commands to the timer service task. */
     PRIVILEGED_DATA static QueueHandle_t xTimerQueue = NULL;
@@ -158,53 +189,47 @@
     static portTASK_FUNCTION_PROTO( prvTimerTask, pvParameters ) PRIVILEGED_FUNCTION;
 
 /*
- * Called by the timer service task to interpret and process a command it
- * received on the timer queue.
+ * Called by the timer service task to process the messages it receives on the
+ * timer queue: pended function calls, deferred deletes, and the notification
+ * that timers have expired.  Blocks until a message is received.
  */
     static void prvProcessReceivedCommands( void ) PRIVILEGED_FUNCTION;
 
 /*
- * Insert the timer into either xActiveTimerList1, or xActiveTimerList2,
- * depending on if the expire time causes a timer counter overflow.
+ * Called by the timer service task to call the callbacks of the timers in
+ * xExpiredTimerList, reloading the auto-reload timers first.
  */
-    static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer,
-                                                  const TickType_t xNextExpiryTime,
-                                                  const TickType_t xTimeNow,
-                                                  const TickType_t xCommandTime ) PRIVILEGED_FUNCTION;
+    static void prvProcessExpiredTimers( void ) PRIVILEGED_FUNCTION;
 
 /*
- * An active timer has reached its expire time.  Reload the timer if it is an
- * auto-reload timer, then call its callback.
+ * Start, reset, stop or change the period of a timer.  Called from a critical
+ * section.
  */
-    static void prvProcessExpiredTimer( const TickType_t xNextExpireTime,
-                                        const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+    static void prvApplyTimerCommand( Timer_t * const pxTimer,
+                                      const BaseType_t xCommandID,
+                                      const TickType_t xOptionalValue ) PRIVILEGED_FUNCTION;
 
 /*
- * The tick count has overflowed.  Switch the timer lists after ensuring the
- * current timer list does not still reference some timers.
+ * Insert the timer in the wheel so it expires one period after xCommandTime.
+ * If that time has already been processed by the wheel then the timer expires
+ * on the next tick.  Called from a critical section.
  */
-    static void prvSwitchTimerLists( void ) PRIVILEGED_FUNCTION;
+    static void prvInsertTimerInWheel( Timer_t * const pxTimer,
+                                       const TickType_t xCommandTime ) PRIVILEGED_FUNCTION;
 
 /*
- * Obtain the current tick count, setting *pxTimerListsWereSwitched to pdTRUE
- * if a tick count overflow occurred since prvSampleTimeNow() was last called.
+ * Insert the timer in the wheel slot for an expiry xTicksToExpiry ticks after
+ * the tick the wheel will process next.  The expiry time must already be set as
+ * the list item value.  Called from a critical section.
  */
-    static TickType_t prvSampleTimeNow( BaseType_t * const pxTimerListsWereSwitched ) PRIVILEGED_FUNCTION;
+    static void prvInsertTimerInSlot( Timer_t * const pxTimer,
+                                      TickType_t xTicksToExpiry ) PRIVILEGED_FUNCTION;
 
 /*
- * If the timer list contains any active timers then return the expire time of
- * the timer that will expire first and set *pxListWasEmpty to false.  If the
- * timer list does not contain any timers then return 0 and set *pxListWasEmpty
- * to pdTRUE.
+ * Move the timers in the slots of the upper levels that start at xTickCount
+ * down to the lower levels.  Called from the tick interrupt.
  */
-    static TickType_t prvGetNextExpireTime( BaseType_t * const pxListWasEmpty ) PRIVILEGED_FUNCTION;
-
-/*
- * If a timer has expired, process it.  Otherwise, block the timer service task
- * until either a timer does expire or a command is received.
- */
-    static void prvProcessTimerOrBlockTask( const TickType_t xNextExpireTime,
-                                            BaseType_t xListWasEmpty ) PRIVILEGED_FUNCTION;
+    static void prvCascadeTimers( const TickType_t xTickCount ) PRIVILEGED_FUNCTION;
 
 /*
  * Called after a Timer_t structure has been allocated either statically or
@@ -381,33 +406,70 @@
                                      const TickType_t xTicksToWait )
     {
         BaseType_t xReturn = pdFAIL;
-        DaemonTaskMessage_t xMessage;
+        Timer_t * const pxTimer = xTimer;
+        UBaseType_t uxSavedInterruptStatus;
+
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+            DaemonTaskMessage_t xMessage;
+        #endif
 
         configASSERT( xTimer );
 
-        /* Send a message to the timer service task to perform a particular action
-         * on a particular timer definition. */
+        /* The command is applied to the wheel directly rather than being sent to
+         * the timer service task, so it takes the same short, constant time
+         * however many timers are active.  Only the delete of a dynamically
+         * allocated timer still goes through the queue, so it is the only
+         * command that can block for xTicksToWait. */
         if( xTimerQueue != NULL )
         {
-            /* Send a command to the timer service task to start the xTimer timer. */
-            xMessage.xMessageID = xCommandID;
-            xMessage.u.xTimerParameters.xMessageValue = xOptionalValue;
-            xMessage.u.xTimerParameters.pxTimer = xTimer;
-
             if( xCommandID < tmrFIRST_FROM_ISR_COMMAND )
             {
-                if( xTaskGetSchedulerState() == taskSCHEDULER_RUNNING )
-                {
-                    xReturn = xQueueSendToBack( xTimerQueue, &xMessage, xTicksToWait );
-                }
-                else
+                #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+                    if( ( xCommandID == tmrCOMMAND_DELETE ) && ( ( pxTimer->ucStatus & tmrSTATUS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 ) )
+                    {
+                        /* The timer service task might be calling the callback of
+                         * the timer being deleted, so that task takes the timer
+                         * out of the wheel and frees it.  The timer is left
+                         * untouched if the message cannot be sent. */
+                        xMessage.xMessageID = xCommandID;
+                        xMessage.u.xTimerParameters.xMessageValue = xOptionalValue;
+                        xMessage.u.xTimerParameters.pxTimer = pxTimer;
+
+                        if( xTaskGetSchedulerState() == taskSCHEDULER_RUNNING )
+                        {
+                            xReturn = xQueueSendToBack( xTimerQueue, &xMessage, xTicksToWait );
+                        }
+                        else
+                        {
+                            xReturn = xQueueSendToBack( xTimerQueue, &xMessage, tmrNO_DELAY );
+                        }
+                    }
+                    else
+                #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
                 {
-                    xReturn = xQueueSendToBack( xTimerQueue, &xMessage, tmrNO_DELAY );
+                    /* Never blocks, so xTicksToWait is not used. */
+                    ( void ) xTicksToWait;
+
+                    taskENTER_CRITICAL();
+                    {
+                        prvApplyTimerCommand( pxTimer, xCommandID, xOptionalValue );
+                    }
+                    taskEXIT_CRITICAL();
+
+                    xReturn = pdPASS;
                 }
             }
             else
             {
-                xReturn = xQueueSendToBackFromISR( xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
+                uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+                {
+                    prvApplyTimerCommand( pxTimer, xCommandID, xOptionalValue );
+                }
+                portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+                /* No task is unblocked by a command. */
+                ( void ) pxHigherPriorityTaskWoken;
+                xReturn = pdPASS;
             }
 
             traceTIMER_COMMAND_SEND( xTimer, xCommandID, xOptionalValue, xReturn );
@@ -485,6 +547,31 @@
     }
 /*-----------------------------------------------------------*/
 
+    #if ( configUSE_TIMER_FAST_CALLBACKS == 1 )
+
+        void vTimerSetFastCallback( TimerHandle_t xTimer,
+                                    const UBaseType_t uxFastCallback )
+        {
+            Timer_t * pxTimer = xTimer;
+
+            configASSERT( xTimer );
+            taskENTER_CRITICAL();
+            {
+                if( uxFastCallback != pdFALSE )
+                {
+                    pxTimer->ucStatus |= tmrSTATUS_IS_FAST_CALLBACK;
+                }
+                else
+                {
+                    pxTimer->ucStatus &= ~tmrSTATUS_IS_FAST_CALLBACK;
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+
+    #endif /* configUSE_TIMER_FAST_CALLBACKS */
+/*-----------------------------------------------------------*/
+
     TickType_t xTimerGetExpiryTime( TimerHandle_t xTimer )
     {
         Timer_t * pxTimer = xTimer;
@@ -505,32 +592,90 @@
     }
 /*-----------------------------------------------------------*/
 
-    static void prvProcessExpiredTimer( const TickType_t xNextExpireTime,
-                                        const TickType_t xTimeNow )
+    BaseType_t xTimerIncrementTick( const TickType_t xTickCount )
     {
-        BaseType_t xResult;
-        Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+        DaemonTaskMessage_t xMessage;
+        List_t * pxSlot;
+        Timer_t * pxTimer;
 
-        /* Remove the timer from the list of active timers.  A check has already
-         * been performed to ensure the list is not empty. */
+        /* Called by the kernel with interrupts masked each time the tick count
+         * is incremented, including when pended ticks are unwound, so every tick
+         * count is processed exactly once and in order. */
+        if( xTimerQueue != NULL )
+        {
+            configASSERT( xTickCount == xWheelTime );
 
-        ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
-        traceTIMER_EXPIRED( pxTimer );
+            /* At the start of each rotation of level 0 the next slot of level 1
+             * is cascaded, and so on up the levels. */
+            if( ( xTickCount & tmrWHEEL_SLOT_MASK ) == ( TickType_t ) 0U )
+            {
+                prvCascadeTimers( xTickCount );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-        /* If the timer is an auto-reload timer then calculate the next
-         * expiry time and re-insert the timer in the list of active timers. */
-        if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
-        {
-            /* The timer is inserted into a list using a time relative to anything
-             * other than the current time.  It will therefore be inserted into the
-             * correct list relative to the time this task thinks it is now. */
-            if( prvInsertTimerInActiveList( pxTimer, ( xNextExpireTime + pxTimer->xTimerPeriodInTicks ), xTimeNow, xNextExpireTime ) != pdFALSE )
+            /* Timers started from the callbacks below are inserted relative to
+             * the next tick, never in the slot being processed. */
+            xWheelTime = xTickCount + ( TickType_t ) 1U;
+
+            /* Every timer in the slot for this tick has expired.  Timers added to
+             * the end of the slot while it is processed expire a rotation later,
+             * so the loop stops at the first of those. */
+            pxSlot = &( xTimerWheel[ 0 ][ xTickCount & tmrWHEEL_SLOT_MASK ] );
+
+            while( ( listLIST_IS_EMPTY( pxSlot ) == pdFALSE ) &&
+                   ( ( TickType_t ) ( listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxSlot ) - xWheelTime ) > tmrWHEEL_MAX_TICKS ) )
+            {
+                pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxSlot ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+
+                #if ( configUSE_TIMER_FAST_CALLBACKS == 1 )
+                    if( ( pxTimer->ucStatus & tmrSTATUS_IS_FAST_CALLBACK ) != 0 )
+                    {
+                        traceTIMER_EXPIRED( pxTimer );
+
+                        if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
+                        {
+                            /* Reload relative to the expiry time so the period
+                             * does not drift. */
+                            prvInsertTimerInWheel( pxTimer, listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) ) );
+                        }
+                        else
+                        {
+                            pxTimer->ucStatus &= ~tmrSTATUS_IS_ACTIVE;
+                        }
+
+                        /* The callback runs in the tick interrupt, so it must be
+                         * short and only use the FromISR API functions. */
+                        pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+                    }
+                    else
+                #endif /* configUSE_TIMER_FAST_CALLBACKS */
+                {
+                    /* The expiry time is kept as the item value, for the reload. */
+                    vListInsertEnd( &xExpiredTimerList, &( pxTimer->xTimerListItem ) );
+                }
+            }
+
+            /* Tell the timer service task there are callbacks to call.  If the
+             * queue is full this is retried on the next tick. */
+            if( ( listLIST_IS_EMPTY( &xExpiredTimerList ) == pdFALSE ) && ( xExpiredTimersSignalled == pdFALSE ) )
             {
-                /* The timer expired before it was added to the active timer
-                 * list.  Reload it now.  */
-                xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xNextExpireTime, NULL, tmrNO_DELAY );
-                configASSERT( xResult );
-                ( void ) xResult;
+                xMessage.xMessageID = tmrCOMMAND_PROCESS_EXPIRED;
+                xMessage.u.xTimerParameters.xMessageValue = xTickCount;
+                xMessage.u.xTimerParameters.pxTimer = NULL;
+
+                if( xQueueSendToBackFromISR( xTimerQueue, &xMessage, &xHigherPriorityTaskWoken ) != pdFAIL )
+                {
+                    xExpiredTimersSignalled = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
             else
             {
@@ -539,215 +684,299 @@
         }
         else
         {
-            pxTimer->ucStatus &= ~tmrSTATUS_IS_ACTIVE;
             mtCOVERAGE_TEST_MARKER();
         }
 
-        /* Call the timer callback. */
-        pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+        return xHigherPriorityTaskWoken;
     }
 /*-----------------------------------------------------------*/
 
-    static portTASK_FUNCTION( prvTimerTask, pvParameters )
-    {
-        TickType_t xNextExpireTime;
-        BaseType_t xListWasEmpty;
+    #if ( configUSE_TICKLESS_IDLE != 0 )
 
-        /* Just to avoid compiler warnings. */
-        ( void ) pvParameters;
+        TickType_t xTimerGetExpectedIdleTime( void )
+        {
+            TickType_t xReturn = portMAX_DELAY;
+            TickType_t xSpan, xFirst, xTicks;
+            UBaseType_t uxLevel, uxSlot;
 
-        #if ( configUSE_DAEMON_TASK_STARTUP_HOOK == 1 )
+            /* Called from the idle task with the scheduler suspended, but the
+             * wheel is also changed by interrupts. */
+            taskENTER_CRITICAL();
             {
-                extern void vApplicationDaemonTaskStartupHook( void );
+                if( xTimerQueue == NULL )
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+                else if( ( listLIST_IS_EMPTY( &xExpiredTimerList ) == pdFALSE ) && ( xExpiredTimersSignalled == pdFALSE ) )
+                {
+                    /* The message to the timer service task is retried on the
+                     * next tick. */
+                    xReturn = ( TickType_t ) 1U;
+                }
+                else
+                {
+                    /* The slots of level 0 are processed one per tick, those of
+                     * level n when the low n * configTIMER_WHEEL_SLOT_BITS bits
+                     * of the tick count are 0.  The first occupied slot of each
+                     * level is the next tick that level has work to do. */
+                    for( uxLevel = ( UBaseType_t ) 0U; uxLevel < ( UBaseType_t ) configTIMER_WHEEL_LEVELS; uxLevel++ )
+                    {
+                        xSpan = ( TickType_t ) 1U << ( configTIMER_WHEEL_SLOT_BITS * uxLevel );
+                        xFirst = ( xWheelTime + ( xSpan - ( TickType_t ) 1U ) ) & ~( xSpan - ( TickType_t ) 1U );
 
-                /* Allow the application writer to execute some code in the context of
-                 * this task at the point the task starts executing.  This is useful if the
-                 * application includes initialisation code that would benefit from
-                 * executing after the scheduler has been started. */
-                vApplicationDaemonTaskStartupHook();
-            }
-        #endif /* configUSE_DAEMON_TASK_STARTUP_HOOK */
+                        for( uxSlot = ( UBaseType_t ) 0U; uxSlot < tmrWHEEL_SLOTS; uxSlot++ )
+                        {
+                            if( listLIST_IS_EMPTY( &( xTimerWheel[ uxLevel ][ ( ( xFirst >> ( configTIMER_WHEEL_SLOT_BITS * uxLevel ) ) + uxSlot ) & tmrWHEEL_SLOT_MASK ] ) ) == pdFALSE )
+                            {
+                                /* Counted from the current tick count, which is
+                                 * one less than xWheelTime. */
+                                xTicks = ( xFirst - xWheelTime ) + ( ( TickType_t ) uxSlot * xSpan ) + ( TickType_t ) 1U;
 
-        for( ; ; )
-        {
-            /* Query the timers list to see if it contains any timers, and if so,
-             * obtain the time at which the next timer will expire. */
-            xNextExpireTime = prvGetNextExpireTime( &xListWasEmpty );
+                                if( xTicks < xReturn )
+                                {
+                                    xReturn = xTicks;
+                                }
 
-            /* If a timer has expired, process it.  Otherwise, block this task
-             * until either a timer does expire, or a command is received. */
-            prvProcessTimerOrBlockTask( xNextExpireTime, xListWasEmpty );
+                                break;
+                            }
+                        }
+                    }
+                }
+            }
+            taskEXIT_CRITICAL();
 
-            /* Empty the command queue. */
-            prvProcessReceivedCommands();
+            return xReturn;
         }
-    }
+
+    #endif /* configUSE_TICKLESS_IDLE */
 /*-----------------------------------------------------------*/
 
-    static void prvProcessTimerOrBlockTask( const TickType_t xNextExpireTime,
-                                            BaseType_t xListWasEmpty )
+    static void prvCascadeTimers( const TickType_t xTickCount )
     {
-        TickType_t xTimeNow;
-        BaseType_t xTimerListsWereSwitched;
+        UBaseType_t uxLevel, uxRemaining;
+        TickType_t xSlot;
+        List_t * pxSlot;
+        Timer_t * pxTimer;
 
-        vTaskSuspendAll();
+        for( uxLevel = ( UBaseType_t ) 1U; uxLevel < ( UBaseType_t ) configTIMER_WHEEL_LEVELS; uxLevel++ )
         {
-            /* Obtain the time now to make an assessment as to whether the timer
-             * has expired or not.  If obtaining the time causes the lists to switch
-             * then don't process this timer as any timers that remained in the list
-             * when the lists were switched will have been processed within the
-             * prvSampleTimeNow() function. */
-            xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
-
-            if( xTimerListsWereSwitched == pdFALSE )
-            {
-                /* The tick count has not overflowed, has the timer expired? */
-                if( ( xListWasEmpty == pdFALSE ) && ( xNextExpireTime <= xTimeNow ) )
-                {
-                    ( void ) xTaskResumeAll();
-                    prvProcessExpiredTimer( xNextExpireTime, xTimeNow );
-                }
-                else
-                {
-                    /* The tick count has not overflowed, and the next expire
-                     * time has not been reached yet.  This task should therefore
-                     * block to wait for the next expire time or a command to be
-                     * received - whichever comes first.  The following line cannot
-                     * be reached unless xNextExpireTime > xTimeNow, except in the
-                     * case when the current timer list is empty. */
-                    if( xListWasEmpty != pdFALSE )
-                    {
-                        /* The current timer list is empty - is the overflow list
-                         * also empty? */
-                        xListWasEmpty = listLIST_IS_EMPTY( pxOverflowTimerList );
-                    }
+            xSlot = ( xTickCount >> ( configTIMER_WHEEL_SLOT_BITS * uxLevel ) ) & tmrWHEEL_SLOT_MASK;
+            pxSlot = &( xTimerWheel[ uxLevel ][ xSlot ] );
 
-                    vQueueWaitForMessageRestricted( xTimerQueue, ( xNextExpireTime - xTimeNow ), xListWasEmpty );
+            /* Every timer in the slot now expires within the span of the level
+             * below, so none is put back in this slot. */
+            for( uxRemaining = listCURRENT_LIST_LENGTH( pxSlot ); uxRemaining > ( UBaseType_t ) 0U; uxRemaining-- )
+            {
+                pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxSlot ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+                prvInsertTimerInSlot( pxTimer, listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) ) - xTickCount );
+            }
 
-                    if( xTaskResumeAll() == pdFALSE )
-                    {
-                        /* Yield to wait for either a command to arrive, or the
-                         * block time to expire.  If a command arrived between the
-                         * critical section being exited and this yield then the yield
-                         * will not cause the task to block. */
-                        portYIELD_WITHIN_API();
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-                }
+            /* The level above only moves on when this level wraps. */
+            if( xSlot != ( TickType_t ) 0U )
+            {
+                break;
             }
             else
             {
-                ( void ) xTaskResumeAll();
+                mtCOVERAGE_TEST_MARKER();
             }
         }
     }
 /*-----------------------------------------------------------*/
 
-    static TickType_t prvGetNextExpireTime( BaseType_t * const pxListWasEmpty )
+    static void prvInsertTimerInWheel( Timer_t * const pxTimer,
+                                       const TickType_t xCommandTime )
     {
-        TickType_t xNextExpireTime;
-
-        /* Timers are listed in expiry time order, with the head of the list
-         * referencing the task that will expire first.  Obtain the time at which
-         * the timer with the nearest expiry time will expire.  If there are no
-         * active timers then just set the next expire time to 0.  That will cause
-         * this task to unblock when the tick count overflows, at which point the
-         * timer lists will be switched and the next expiry time can be
-         * re-assessed.  */
-        *pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
-
-        if( *pxListWasEmpty == pdFALSE )
+        const TickType_t xExpiryTime = xCommandTime + pxTimer->xTimerPeriodInTicks;
+        TickType_t xTicksToExpiry;
+
+        listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xExpiryTime );
+        listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+
+        /* Has the expiry time already been processed by the wheel, because the
+         * command was issued (or the previous expiry happened) more than a period
+         * before the last tick the wheel processed? */
+        if( ( ( TickType_t ) ( ( xWheelTime - ( TickType_t ) 1U ) - xCommandTime ) ) >= pxTimer->xTimerPeriodInTicks ) /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
         {
-            xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+            xTicksToExpiry = ( TickType_t ) 0U;
         }
         else
         {
-            /* Ensure the task unblocks when the tick count rolls over. */
-            xNextExpireTime = ( TickType_t ) 0U;
+            xTicksToExpiry = xExpiryTime - xWheelTime;
         }
 
-        return xNextExpireTime;
+        prvInsertTimerInSlot( pxTimer, xTicksToExpiry );
     }
 /*-----------------------------------------------------------*/
 
-    static TickType_t prvSampleTimeNow( BaseType_t * const pxTimerListsWereSwitched )
+    static void prvInsertTimerInSlot( Timer_t * const pxTimer,
+                                      TickType_t xTicksToExpiry )
     {
-        TickType_t xTimeNow;
-        PRIVILEGED_DATA static TickType_t xLastTime = ( TickType_t ) 0U; /*lint !e956 Variable is only accessible to one task. */
-
-        xTimeNow = xTaskGetTickCount();
+        UBaseType_t uxLevel;
+        TickType_t xSlot;
 
-        if( xTimeNow < xLastTime )
+        if( xTicksToExpiry > tmrWHEEL_MAX_TICKS )
         {
-            prvSwitchTimerLists();
-            *pxTimerListsWereSwitched = pdTRUE;
+            /* Further away than the wheel can hold.  The timer is cascaded from
+             * the top level until it is close enough. */
+            xTicksToExpiry = tmrWHEEL_MAX_TICKS;
         }
         else
         {
-            *pxTimerListsWereSwitched = pdFALSE;
+            mtCOVERAGE_TEST_MARKER();
         }
 
-        xLastTime = xTimeNow;
+        /* Use the lowest level whose span holds the remaining time. */
+        for( uxLevel = ( UBaseType_t ) 0U; uxLevel < ( UBaseType_t ) ( configTIMER_WHEEL_LEVELS - 1 ); uxLevel++ )
+        {
+            if( ( xTicksToExpiry >> ( configTIMER_WHEEL_SLOT_BITS * ( uxLevel + ( UBaseType_t ) 1U ) ) ) == ( TickType_t ) 0U )
+            {
+                break;
+            }
+        }
 
-        return xTimeNow;
+        xSlot = ( ( xWheelTime + xTicksToExpiry ) >> ( configTIMER_WHEEL_SLOT_BITS * uxLevel ) ) & tmrWHEEL_SLOT_MASK;
+        vListInsertEnd( &( xTimerWheel[ uxLevel ][ xSlot ] ), &( pxTimer->xTimerListItem ) );
     }
 /*-----------------------------------------------------------*/
 
-    static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer,
-                                                  const TickType_t xNextExpiryTime,
-                                                  const TickType_t xTimeNow,
-                                                  const TickType_t xCommandTime )
+    static void prvApplyTimerCommand( Timer_t * const pxTimer,
+                                      const BaseType_t xCommandID,
+                                      const TickType_t xOptionalValue )
     {
-        BaseType_t xProcessTimerNow = pdFALSE;
+        /* Take the timer out of the wheel, or out of xExpiredTimerList if its
+         * callback has not been called yet. */
+        if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE ) /*lint !e961. The cast is only redundant when NULL is passed into the macro. */
+        {
+            ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-        listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xNextExpiryTime );
-        listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+        traceTIMER_COMMAND_RECEIVED( pxTimer, xCommandID, xOptionalValue );
 
-        if( xNextExpiryTime <= xTimeNow )
+        switch( xCommandID )
         {
-            /* Has the expiry time elapsed between the command to start/reset a
-             * timer was issued, and the time the command was processed? */
-            if( ( ( TickType_t ) ( xTimeNow - xCommandTime ) ) >= pxTimer->xTimerPeriodInTicks ) /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-            {
-                /* The time between a command being issued and the command being
-                 * processed actually exceeds the timers period.  */
-                xProcessTimerNow = pdTRUE;
-            }
-            else
-            {
-                vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
-            }
+            case tmrCOMMAND_START:
+            case tmrCOMMAND_START_FROM_ISR:
+            case tmrCOMMAND_RESET:
+            case tmrCOMMAND_RESET_FROM_ISR:
+            case tmrCOMMAND_START_DONT_TRACE:
+                /* Start or restart a timer, one period after the command time. */
+                pxTimer->ucStatus |= tmrSTATUS_IS_ACTIVE;
+                prvInsertTimerInWheel( pxTimer, xOptionalValue );
+                break;
+
+            case tmrCOMMAND_STOP:
+            case tmrCOMMAND_STOP_FROM_ISR:
+            case tmrCOMMAND_DELETE:
+                /* The timer has already been removed from the wheel. */
+                pxTimer->ucStatus &= ~tmrSTATUS_IS_ACTIVE;
+                break;
+
+            case tmrCOMMAND_CHANGE_PERIOD:
+            case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR:
+                pxTimer->ucStatus |= tmrSTATUS_IS_ACTIVE;
+                pxTimer->xTimerPeriodInTicks = xOptionalValue;
+                configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
+
+                /* The new period does not really have a reference, and can be
+                 * longer or shorter than the old one.  The command time is
+                 * therefore the last tick processed by the wheel. */
+                prvInsertTimerInWheel( pxTimer, xWheelTime - ( TickType_t ) 1U );
+                break;
+
+            default:
+                /* Don't expect to get here. */
+                break;
         }
-        else
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvProcessExpiredTimers( void )
+    {
+        Timer_t * pxTimer;
+        TimerCallbackFunction_t pxCallbackFunction;
+
+        for( ; ; )
         {
-            if( ( xTimeNow < xCommandTime ) && ( xNextExpiryTime >= xCommandTime ) )
+            taskENTER_CRITICAL();
             {
-                /* If, since the command was issued, the tick count has overflowed
-                 * but the expiry time has not, then the timer must have already passed
-                 * its expiry time and should be processed immediately. */
-                xProcessTimerNow = pdTRUE;
+                if( listLIST_IS_EMPTY( &xExpiredTimerList ) != pdFALSE )
+                {
+                    /* The tick signals again when the next timer expires. */
+                    xExpiredTimersSignalled = pdFALSE;
+                    pxTimer = NULL;
+                }
+                else
+                {
+                    pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( &xExpiredTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                    ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+
+                    if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
+                    {
+                        /* Reload relative to the expiry time so the period does
+                         * not drift.  If this task is running more than a period
+                         * late the timer expires again on the next tick. */
+                        prvInsertTimerInWheel( pxTimer, listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) ) );
+                    }
+                    else
+                    {
+                        pxTimer->ucStatus &= ~tmrSTATUS_IS_ACTIVE;
+                    }
+
+                    pxCallbackFunction = pxTimer->pxCallbackFunction;
+                }
             }
-            else
+            taskEXIT_CRITICAL();
+
+            if( pxTimer == NULL )
             {
-                vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+                break;
             }
+
+            traceTIMER_EXPIRED( pxTimer );
+
+            /* Call the timer callback. */
+            pxCallbackFunction( ( TimerHandle_t ) pxTimer );
         }
+    }
+/*-----------------------------------------------------------*/
 
-        return xProcessTimerNow;
+    static portTASK_FUNCTION( prvTimerTask, pvParameters )
+    {
+        /* Just to avoid compiler warnings. */
+        ( void ) pvParameters;
+
+        #if ( configUSE_DAEMON_TASK_STARTUP_HOOK == 1 )
+            {
+                extern void vApplicationDaemonTaskStartupHook( void );
+
+                /* Allow the application writer to execute some code in the context of
+                 * this task at the point the task starts executing.  This is useful if the
+                 * application includes initialisation code that would benefit from
+                 * executing after the scheduler has been started. */
+                vApplicationDaemonTaskStartupHook();
+            }
+        #endif /* configUSE_DAEMON_TASK_STARTUP_HOOK */
+
+        for( ; ; )
+        {
+            /* The timers are processed by the tick interrupt, so this task only
+             * has to wait for messages. */
+            prvProcessReceivedCommands();
+        }
     }
 /*-----------------------------------------------------------*/
 
     static void prvProcessReceivedCommands( void )
     {
         DaemonTaskMessage_t xMessage;
-        Timer_t * pxTimer;
-        BaseType_t xTimerListsWereSwitched, xResult;
-        TickType_t xTimeNow;
 
-        while( xQueueReceive( xTimerQueue, &xMessage, tmrNO_DELAY ) != pdFAIL ) /*lint !e603 xMessage does not have to be initialised as it is passed out, not in, and it is not used unless xQueueReceive() returns pdTRUE. */
+        if( xQueueReceive( xTimerQueue, &xMessage, portMAX_DELAY ) != pdFAIL ) /*lint !e603 xMessage does not have to be initialised as it is passed out, not in, and it is not used unless xQueueReceive() returns pdTRUE. */
         {
             #if ( INCLUDE_xTimerPendFunctionCall == 1 )
                 {
@@ -771,182 +1000,34 @@
                 }
             #endif /* INCLUDE_xTimerPendFunctionCall */
 
-            /* Commands that are positive are timer commands rather than pended
-             * function calls. */
-            if( xMessage.xMessageID >= ( BaseType_t ) 0 )
+            if( xMessage.xMessageID == tmrCOMMAND_PROCESS_EXPIRED )
             {
-                /* The messages uses the xTimerParameters member to work on a
-                 * software timer. */
-                pxTimer = xMessage.u.xTimerParameters.pxTimer;
-
-                if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE ) /*lint !e961. The cast is only redundant when NULL is passed into the macro. */
-                {
-                    /* The timer is in a list, remove it. */
-                    ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
-
-                traceTIMER_COMMAND_RECEIVED( pxTimer, xMessage.xMessageID, xMessage.u.xTimerParameters.xMessageValue );
-
-                /* In this case the xTimerListsWereSwitched parameter is not used, but
-                 *  it must be present in the function call.  prvSampleTimeNow() must be
-                 *  called after the message is received from xTimerQueue so there is no
-                 *  possibility of a higher priority task adding a message to the message
-                 *  queue with a time that is ahead of the timer daemon task (because it
-                 *  pre-empted the timer daemon task after the xTimeNow value was set). */
-                xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
-
-                switch( xMessage.xMessageID )
-                {
-                    case tmrCOMMAND_START:
-                    case tmrCOMMAND_START_FROM_ISR:
-                    case tmrCOMMAND_RESET:
-                    case tmrCOMMAND_RESET_FROM_ISR:
-                    case tmrCOMMAND_START_DONT_TRACE:
-                        /* Start or restart a timer. */
-                        pxTimer->ucStatus |= tmrSTATUS_IS_ACTIVE;
-
-                        if( prvInsertTimerInActiveList( pxTimer, xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, xMessage.u.xTimerParameters.xMessageValue ) != pdFALSE )
-                        {
-                            /* The timer expired before it was added to the active
-                             * timer list.  Process it now. */
-                            pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
-                            traceTIMER_EXPIRED( pxTimer );
-
-                            if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
-                            {
-                                xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, NULL, tmrNO_DELAY );
-                                configASSERT( xResult );
-                                ( void ) xResult;
-                            }
-                            else
-                            {
-                                mtCOVERAGE_TEST_MARKER();
-                            }
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
-                        }
-
-                        break;
-
-                    case tmrCOMMAND_STOP:
-                    case tmrCOMMAND_STOP_FROM_ISR:
-                        /* The timer has already been removed from the active list. */
-                        pxTimer->ucStatus &= ~tmrSTATUS_IS_ACTIVE;
-                        break;
-
-                    case tmrCOMMAND_CHANGE_PERIOD:
-                    case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR:
-                        pxTimer->ucStatus |= tmrSTATUS_IS_ACTIVE;
-                        pxTimer->xTimerPeriodInTicks = xMessage.u.xTimerParameters.xMessageValue;
-                        configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
-
-                        /* The new period does not really have a reference, and can
-                         * be longer or shorter than the old one.  The command time is
-                         * therefore set to the current time, and as the period cannot
-                         * be zero the next expiry time can only be in the future,
-                         * meaning (unlike for the xTimerStart() case above) there is
-                         * no fail case that needs to be handled here. */
-                        ( void ) prvInsertTimerInActiveList( pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow );
-                        break;
-
-                    case tmrCOMMAND_DELETE:
-                        #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
-                            {
-                                /* The timer has already been removed from the active list,
-                                 * just free up the memory if the memory was dynamically
-                                 * allocated. */
-                                if( ( pxTimer->ucStatus & tmrSTATUS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
-                                {
-                                    vPortFree( pxTimer );
-                                }
-                                else
-                                {
-                                    pxTimer->ucStatus &= ~tmrSTATUS_IS_ACTIVE;
-                                }
-                            }
-                        #else /* if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) */
-                            {
-                                /* If dynamic allocation is not enabled, the memory
-                                 * could not have been dynamically allocated. So there is
-                                 * no need to free the memory - just mark the timer as
-                                 * "not active". */
-                                pxTimer->ucStatus &= ~tmrSTATUS_IS_ACTIVE;
-                            }
-                        #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
-                        break;
-
-                    default:
-                        /* Don't expect to get here. */
-                        break;
-                }
+                prvProcessExpiredTimers();
             }
-        }
-    }
-/*-----------------------------------------------------------*/
-
-    static void prvSwitchTimerLists( void )
-    {
-        TickType_t xNextExpireTime, xReloadTime;
-        List_t * pxTemp;
-        Timer_t * pxTimer;
-        BaseType_t xResult;
-
-        /* The tick count has overflowed.  The timer lists must be switched.
-         * If there are any timers still referenced from the current timer list
-         * then they must have expired and should be processed before the lists
-         * are switched. */
-        while( listLIST_IS_EMPTY( pxCurrentTimerList ) == pdFALSE )
-        {
-            xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
-
-            /* Remove the timer from the list. */
-            pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-            ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
-            traceTIMER_EXPIRED( pxTimer );
-
-            /* Execute its callback, then send a command to restart the timer if
-             * it is an auto-reload timer.  It cannot be restarted here as the lists
-             * have not yet been switched. */
-            pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
-
-            if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
-            {
-                /* Calculate the reload value, and if the reload value results in
-                 * the timer going into the same timer list then it has already expired
-                 * and the timer should be re-inserted into the current list so it is
-                 * processed again within this loop.  Otherwise a command should be sent
-                 * to restart the timer to ensure it is only inserted into a list after
-                 * the lists have been swapped. */
-                xReloadTime = ( xNextExpireTime + pxTimer->xTimerPeriodInTicks );
-
-                if( xReloadTime > xNextExpireTime )
+            #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+                else if( xMessage.xMessageID == tmrCOMMAND_DELETE )
                 {
-                    listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xReloadTime );
-                    listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
-                    vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
-                }
-                else
-                {
-                    xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xNextExpireTime, NULL, tmrNO_DELAY );
-                    configASSERT( xResult );
-                    ( void ) xResult;
+                    /* The timer is not in the middle of its callback here, as
+                     * callbacks are called by this task.  Take it out of the
+                     * wheel, then free it as it was dynamically allocated. */
+                    taskENTER_CRITICAL();
+                    {
+                        prvApplyTimerCommand( xMessage.u.xTimerParameters.pxTimer, tmrCOMMAND_DELETE, xMessage.u.xTimerParameters.xMessageValue );
+                    }
+                    taskEXIT_CRITICAL();
+
+                    vPortFree( xMessage.u.xTimerParameters.pxTimer );
                 }
-            }
+            #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
         }
-
-        pxTemp = pxCurrentTimerList;
-        pxCurrentTimerList = pxOverflowTimerList;
-        pxOverflowTimerList = pxTemp;
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
     }
 /*-----------------------------------------------------------*/
 
@@ -959,10 +1040,21 @@
         {
             if( xTimerQueue == NULL )
             {
-                vListInitialise( &xActiveTimerList1 );
-                vListInitialise( &xActiveTimerList2 );
-                pxCurrentTimerList = &xActiveTimerList1;
-                pxOverflowTimerList = &xActiveTimerList2;
+                UBaseType_t uxLevel, uxSlot;
+
+                for( uxLevel = ( UBaseType_t ) 0U; uxLevel < ( UBaseType_t ) configTIMER_WHEEL_LEVELS; uxLevel++ )
+                {
+                    for( uxSlot = ( UBaseType_t ) 0U; uxSlot < tmrWHEEL_SLOTS; uxSlot++ )
+                    {
+                        vListInitialise( &( xTimerWheel[ uxLevel ][ uxSlot ] ) );
+                    }
+                }
+
+                vListInitialise( &xExpiredTimerList );
+
+                /* The next tick processed by the wheel is the next increment of
+                 * the tick count. */
+                xWheelTime = xTaskGetTickCount() + ( TickType_t ) 1U;
 
                 #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
                     {
@@ -0,0 +1,15 @@
+/*
+ * FreeRTOSConfig.h of the host tests: the configuration of the target, with
+ * configASSERT() reporting on the console instead of stopping the core.
+ */
+#ifndef HOST_FREERTOS_CONFIG_H
+#define HOST_FREERTOS_CONFIG_H
+
+#include <assert.h>
+
+#include "../Inc_freeRTOS/FreeRTOSConfig.h"
+
+#undef configASSERT
+#define configASSERT( x ) assert( x )
+
+#endif /* HOST_FREERTOS_CONFIG_H */
@@ -0,0 +1,504 @@
+/*
+ * Task API of the host tests, see host_kernel.h.
+ */
+
+#define _GNU_SOURCE
+#include <stdlib.h>
+#include <string.h>
+#include <ucontext.h>
+
+#include "host_kernel.h"
+
+#define hostMAX_TASKS			40
+#define hostSTACK_SIZE			( 64 * 1024 )
+
+/* The tick advances while every task is blocked; a wait longer than this means
+every task is blocked for good. */
+#define hostMAX_IDLE_TICKS		( ( TickType_t ) 1000000 )
+
+typedef struct xHOST_TASK
+{
+	ucontext_t xContext;
+	TaskFunction_t pxCode;
+	void *pvParameters;
+	UBaseType_t uxPriority;
+	BaseType_t xCreated;
+	BaseType_t xDeleted;
+	BaseType_t xBlocked;
+	TickType_t xWakeTime;				/* portMAX_DELAY to wait for a notification only. */
+	UBaseType_t uxWaitIndex;
+	uint32_t ulNotifiedValue[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
+	uint8_t ucNotifyState[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
+	char *pcStack;
+} HostTask_t;
+
+uint32_t SystemCoreClock = 72000000UL;
+volatile uint32_t ulHostYieldRequests;
+volatile uint32_t ulHostStoreExclusiveFailures;
+
+static HostTask_t xTasks[ hostMAX_TASKS ];
+static UBaseType_t uxCreatedTasks;
+static HostTask_t *pxCurrentTask;
+static ucontext_t xSchedulerContext;
+static UBaseType_t uxCriticalNesting;
+static UBaseType_t uxSchedulerSuspended;
+static TickType_t xTickCount;
+static uint32_t ulCycleCounter;
+
+/* The code run before vHostRun(), the test's main(), is a task of its own for
+the functions that need a current task. */
+static HostTask_t xMainTask;
+
+static void prvSwitchOut( void );
+static void prvTaskEntry( int iTask );
+static HostTask_t *prvGetTask( TaskHandle_t xTask );
+
+/*-----------------------------------------------------------*/
+
+void vPortEnterCritical( void )
+{
+	uxCriticalNesting++;
+}
+
+void vPortExitCritical( void )
+{
+	hostCHECK( uxCriticalNesting > 0U );
+	uxCriticalNesting--;
+}
+
+uint32_t ulHostGetCycleCounter( void )
+{
+	return ulCycleCounter++;
+}
+
+void *pvPortMalloc( size_t xSize )
+{
+void *pv;
+
+	if( posix_memalign( &pv, portBYTE_ALIGNMENT, xSize ) != 0 )
+	{
+		pv = NULL;
+	}
+
+	return pv;
+}
+
+void vPortFree( void *pv )
+{
+	free( pv );
+}
+/*-----------------------------------------------------------*/
+
+void vTaskSuspendAll( void )
+{
+	uxSchedulerSuspended++;
+}
+
+BaseType_t xTaskResumeAll( void )
+{
+	hostCHECK( uxSchedulerSuspended > 0U );
+	uxSchedulerSuspended--;
+	return pdFALSE;
+}
+
+TickType_t xTaskGetTickCount( void )
+{
+	return xTickCount;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle( void )
+{
+	return ( pxCurrentTask != NULL ) ? ( TaskHandle_t ) pxCurrentTask : ( TaskHandle_t ) &xMainTask;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskCreate( TaskFunction_t pxTaskCode, const char * const pcName, const configSTACK_DEPTH_TYPE usStackDepth, void * const pvParameters, UBaseType_t uxPriority, TaskHandle_t * const pxCreatedTask )
+{
+HostTask_t *pxTask;
+
+	( void ) pcName;
+	( void ) usStackDepth;
+
+	if( uxCreatedTasks == hostMAX_TASKS )
+	{
+		return errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+	}
+
+	pxTask = &( xTasks[ uxCreatedTasks ] );
+	memset( pxTask, 0, sizeof( *pxTask ) );
+	pxTask->pxCode = pxTaskCode;
+	pxTask->pvParameters = pvParameters;
+	pxTask->uxPriority = uxPriority;
+	pxTask->pcStack = malloc( hostSTACK_SIZE );
+	hostCHECK( pxTask->pcStack != NULL );
+
+	getcontext( &( pxTask->xContext ) );
+	pxTask->xContext.uc_stack.ss_sp = pxTask->pcStack;
+	pxTask->xContext.uc_stack.ss_size = hostSTACK_SIZE;
+	pxTask->xContext.uc_link = NULL;
+	makecontext( &( pxTask->xContext ), ( void ( * )( void ) ) prvTaskEntry, 1, ( int ) uxCreatedTasks );
+
+	pxTask->xCreated = pdTRUE;
+	uxCreatedTasks++;
+
+	if( pxCreatedTask != NULL )
+	{
+		*pxCreatedTask = ( TaskHandle_t ) pxTask;
+	}
+
+	return pdPASS;
+}
+
+TaskHandle_t xTaskCreateStatic( TaskFunction_t pxTaskCode, const char * const pcName, const uint32_t ulStackDepth, void * const pvParameters, UBaseType_t uxPriority, StackType_t * const puxStackBuffer, StaticTask_t * const pxTaskBuffer )
+{
+TaskHandle_t xTask = NULL;
+
+	/* The task runs on a host stack all the same. */
+	( void ) puxStackBuffer;
+	( void ) pxTaskBuffer;
+	( void ) xTaskCreate( pxTaskCode, pcName, ( configSTACK_DEPTH_TYPE ) ulStackDepth, pvParameters, uxPriority, &xTask );
+
+	return xTask;
+}
+
+void vTaskDelete( TaskHandle_t xTaskToDelete )
+{
+HostTask_t * const pxTask = prvGetTask( xTaskToDelete );
+
+	pxTask->xDeleted = pdTRUE;
+
+	if( pxTask == pxCurrentTask )
+	{
+		prvSwitchOut();
+	}
+}
+
+void vTaskPrioritySet( TaskHandle_t xTask, UBaseType_t uxNewPriority )
+{
+	prvGetTask( xTask )->uxPriority = uxNewPriority;
+}
+
+UBaseType_t uxTaskPriorityGet( const TaskHandle_t xTask )
+{
+	return prvGetTask( ( TaskHandle_t ) xTask )->uxPriority;
+}
+
+void vTaskDelay( const TickType_t xTicksToDelay )
+{
+HostTask_t * const pxTask = pxCurrentTask;
+
+	hostCHECK( pxTask != NULL );
+	pxTask->xBlocked = pdTRUE;
+	pxTask->xWakeTime = xTickCount + xTicksToDelay;
+	pxTask->uxWaitIndex = configTASK_NOTIFICATION_ARRAY_ENTRIES;
+	prvSwitchOut();
+}
+
+void vTaskDelayUntil( TickType_t * const pxPreviousWakeTime, const TickType_t xTimeIncrement )
+{
+	*pxPreviousWakeTime += xTimeIncrement;
+	vTaskDelay( *pxPreviousWakeTime - xTickCount );
+}
+/*-----------------------------------------------------------*/
+
+void vTaskSetTimeOutState( TimeOut_t * const pxTimeOut )
+{
+	pxTimeOut->xOverflowCount = 0;
+	pxTimeOut->xTimeOnEntering = xTickCount;
+}
+
+void vTaskInternalSetTimeOutState( TimeOut_t * const pxTimeOut )
+{
+	vTaskSetTimeOutState( pxTimeOut );
+}
+
+BaseType_t xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut, TickType_t * const pxTicksToWait )
+{
+const TickType_t xElapsed = xTickCount - pxTimeOut->xTimeOnEntering;
+
+	if( *pxTicksToWait == portMAX_DELAY )
+	{
+		return pdFALSE;
+	}
+
+	if( xElapsed >= *pxTicksToWait )
+	{
+		*pxTicksToWait = 0;
+		return pdTRUE;
+	}
+
+	*pxTicksToWait -= xElapsed;
+	vTaskSetTimeOutState( pxTimeOut );
+	return pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+/* Notification states, as in tasks.c. */
+#define hostNOT_WAITING_NOTIFICATION	( ( uint8_t ) 0 )
+#define hostWAITING_NOTIFICATION		( ( uint8_t ) 1 )
+#define hostNOTIFICATION_RECEIVED		( ( uint8_t ) 2 )
+
+BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue )
+{
+HostTask_t * const pxTask = prvGetTask( xTaskToNotify );
+BaseType_t xReturn = pdPASS;
+
+	hostCHECK( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
+	if( pulPreviousNotificationValue != NULL )
+	{
+		*pulPreviousNotificationValue = pxTask->ulNotifiedValue[ uxIndexToNotify ];
+	}
+
+	switch( eAction )
+	{
+		case eSetBits:
+			pxTask->ulNotifiedValue[ uxIndexToNotify ] |= ulValue;
+			break;
+
+		case eIncrement:
+			pxTask->ulNotifiedValue[ uxIndexToNotify ]++;
+			break;
+
+		case eSetValueWithOverwrite:
+			pxTask->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
+			break;
+
+		case eSetValueWithoutOverwrite:
+			if( pxTask->ucNotifyState[ uxIndexToNotify ] == hostNOTIFICATION_RECEIVED )
+			{
+				xReturn = pdFAIL;
+			}
+			else
+			{
+				pxTask->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
+			}
+			break;
+
+		default:
+			break;
+	}
+
+	if( xReturn == pdPASS )
+	{
+		pxTask->ucNotifyState[ uxIndexToNotify ] = hostNOTIFICATION_RECEIVED;
+
+		if( ( pxTask->xBlocked != pdFALSE ) && ( pxTask->uxWaitIndex == uxIndexToNotify ) )
+		{
+			pxTask->xBlocked = pdFALSE;
+		}
+	}
+
+	return xReturn;
+}
+
+BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken )
+{
+	if( pxHigherPriorityTaskWoken != NULL )
+	{
+		*pxHigherPriorityTaskWoken = pdTRUE;
+	}
+
+	return xTaskGenericNotify( xTaskToNotify, uxIndexToNotify, ulValue, eAction, pulPreviousNotificationValue );
+}
+
+void vTaskGenericNotifyGiveFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, BaseType_t *pxHigherPriorityTaskWoken )
+{
+	( void ) xTaskGenericNotifyFromISR( xTaskToNotify, uxIndexToNotify, 0, eIncrement, NULL, pxHigherPriorityTaskWoken );
+}
+
+/* Blocks the current task on the notification at uxIndex for up to
+xTicksToWait, unless one is already pending. */
+static void prvWaitNotification( UBaseType_t uxIndex, TickType_t xTicksToWait )
+{
+HostTask_t * const pxTask = prvGetTask( NULL );
+
+	hostCHECK( uxCriticalNesting == 0U );
+
+	if( ( pxTask->ucNotifyState[ uxIndex ] != hostNOTIFICATION_RECEIVED ) && ( xTicksToWait > ( TickType_t ) 0 ) )
+	{
+		hostCHECK( pxTask != &xMainTask );
+		pxTask->ucNotifyState[ uxIndex ] = hostWAITING_NOTIFICATION;
+		pxTask->xBlocked = pdTRUE;
+		pxTask->uxWaitIndex = uxIndex;
+		/* A wake time half the tick range or more ahead would look expired,
+		and is beyond the end of any test, so that is a wait for good. */
+		pxTask->xWakeTime = ( xTicksToWait >= ( portMAX_DELAY / 2U ) ) ? portMAX_DELAY : ( TickType_t ) ( xTickCount + xTicksToWait );
+		prvSwitchOut();
+	}
+}
+
+uint32_t ulTaskGenericNotifyTake( UBaseType_t uxIndexToWait, BaseType_t xClearCountOnExit, TickType_t xTicksToWait )
+{
+HostTask_t * const pxTask = prvGetTask( NULL );
+uint32_t ulReturn;
+
+	hostCHECK( uxIndexToWait < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
+	if( pxTask->ulNotifiedValue[ uxIndexToWait ] == 0UL )
+	{
+		pxTask->ucNotifyState[ uxIndexToWait ] = hostNOT_WAITING_NOTIFICATION;
+		prvWaitNotification( uxIndexToWait, xTicksToWait );
+	}
+
+	ulReturn = pxTask->ulNotifiedValue[ uxIndexToWait ];
+
+	if( ulReturn != 0UL )
+	{
+		pxTask->ulNotifiedValue[ uxIndexToWait ] = ( xClearCountOnExit != pdFALSE ) ? 0UL : ulReturn - 1UL;
+	}
+
+	pxTask->ucNotifyState[ uxIndexToWait ] = hostNOT_WAITING_NOTIFICATION;
+
+	return ulReturn;
+}
+
+BaseType_t xTaskGenericNotifyWait( UBaseType_t uxIndexToWait, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait )
+{
+HostTask_t * const pxTask = prvGetTask( NULL );
+BaseType_t xReturn = pdFALSE;
+
+	hostCHECK( uxIndexToWait < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
+	if( pxTask->ucNotifyState[ uxIndexToWait ] != hostNOTIFICATION_RECEIVED )
+	{
+		pxTask->ulNotifiedValue[ uxIndexToWait ] &= ~ulBitsToClearOnEntry;
+		prvWaitNotification( uxIndexToWait, xTicksToWait );
+	}
+
+	if( pulNotificationValue != NULL )
+	{
+		*pulNotificationValue = pxTask->ulNotifiedValue[ uxIndexToWait ];
+	}
+
+	if( pxTask->ucNotifyState[ uxIndexToWait ] == hostNOTIFICATION_RECEIVED )
+	{
+		pxTask->ulNotifiedValue[ uxIndexToWait ] &= ~ulBitsToClearOnExit;
+		xReturn = pdTRUE;
+	}
+
+	pxTask->ucNotifyState[ uxIndexToWait ] = hostNOT_WAITING_NOTIFICATION;
+
+	return xReturn;
+}
+
+BaseType_t xTaskGenericNotifyStateClear( TaskHandle_t xTask, UBaseType_t uxIndexToClear )
+{
+HostTask_t * const pxTask = prvGetTask( xTask );
+BaseType_t xReturn = pdFAIL;
+
+	if( pxTask->ucNotifyState[ uxIndexToClear ] == hostNOTIFICATION_RECEIVED )
+	{
+		pxTask->ucNotifyState[ uxIndexToClear ] = hostNOT_WAITING_NOTIFICATION;
+		xReturn = pdPASS;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulHostGetNotificationCount( TaskHandle_t xTask, UBaseType_t uxIndex )
+{
+	return prvGetTask( xTask )->ulNotifiedValue[ uxIndex ];
+}
+
+void vHostYield( void )
+{
+	hostCHECK( uxCriticalNesting == 0U );
+
+	if( pxCurrentTask != NULL )
+	{
+		prvSwitchOut();
+	}
+}
+
+void vHostRun( void )
+{
+UBaseType_t uxNext = 0, uxTried, uxLive;
+TickType_t xIdleTicks = 0;
+HostTask_t *pxTask;
+
+	for( ;; )
+	{
+		uxLive = 0;
+		pxTask = NULL;
+
+		for( uxTried = 0; uxTried < uxCreatedTasks; uxTried++ )
+		{
+			HostTask_t * const pxCandidate = &( xTasks[ ( uxNext + uxTried ) % uxCreatedTasks ] );
+
+			if( pxCandidate->xDeleted != pdFALSE )
+			{
+				continue;
+			}
+
+			uxLive++;
+
+			if( ( pxCandidate->xBlocked != pdFALSE ) && ( pxCandidate->xWakeTime != portMAX_DELAY ) && ( ( TickType_t ) ( xTickCount - pxCandidate->xWakeTime ) < ( portMAX_DELAY / 2U ) ) )
+			{
+				/* Timed out. */
+				pxCandidate->xBlocked = pdFALSE;
+			}
+
+			if( pxCandidate->xBlocked == pdFALSE )
+			{
+				pxTask = pxCandidate;
+				uxNext = ( ( UBaseType_t ) ( pxCandidate - xTasks ) + 1U ) % uxCreatedTasks;
+				break;
+			}
+		}
+
+		if( uxLive == 0U )
+		{
+			break;
+		}
+
+		if( pxTask == NULL )
+		{
+			/* Every task is blocked, let time pass. */
+			if( ++xIdleTicks > hostMAX_IDLE_TICKS )
+			{
+				break;
+			}
+
+			xTickCount++;
+			continue;
+		}
+
+		xIdleTicks = 0;
+		pxCurrentTask = pxTask;
+		swapcontext( &xSchedulerContext, &( pxTask->xContext ) );
+		pxCurrentTask = NULL;
+		hostCHECK( uxCriticalNesting == 0U );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvSwitchOut( void )
+{
+HostTask_t * const pxTask = pxCurrentTask;
+
+	hostCHECK( pxTask != NULL );
+	hostCHECK( uxCriticalNesting == 0U );
+	swapcontext( &( pxTask->xContext ), &xSchedulerContext );
+}
+
+static void prvTaskEntry( int iTask )
+{
+HostTask_t * const pxTask = &( xTasks[ iTask ] );
+
+	pxTask->pxCode( pxTask->pvParameters );
+
+	/* Tasks must not return, as on the target. */
+	hostCHECK( pdFALSE );
+}
+
+static HostTask_t *prvGetTask( TaskHandle_t xTask )
+{
+	if( xTask == NULL )
+	{
+		xTask = xTaskGetCurrentTaskHandle();
+	}
+
+	return ( HostTask_t * ) xTask;
+}
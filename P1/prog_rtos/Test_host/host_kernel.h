@@ -0,0 +1,42 @@
+/*
+ * A small cooperative stand-in for the scheduler, for the host tests.
+ *
+ * Tasks created with xTaskCreate() run on their own host stack (ucontext) and
+ * switch only where they block, in ulTaskNotifyTake() and the other waits, or
+ * where the test calls vHostYield().  vHostRun() runs them round robin until
+ * every task is deleted or blocked for good; the tick advances by one whenever
+ * every task is blocked, which is what expires timeouts.  Priorities are
+ * recorded but not used.
+ */
+
+#ifndef HOST_KERNEL_H
+#define HOST_KERNEL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Runs the created tasks, returns once none can run again. */
+void vHostRun( void );
+
+/* Lets the other tasks run.  Must not be called from a critical section. */
+void vHostYield( void );
+
+/* Notifications pending at index uxIndex of xTask. */
+uint32_t ulHostGetNotificationCount( TaskHandle_t xTask, UBaseType_t uxIndex );
+
+/* Stops the test with a message when xCondition is false, also when built
+with NDEBUG. */
+#define hostCHECK( xCondition )																	\
+	do																							\
+	{																							\
+		if( !( xCondition ) )																	\
+		{																						\
+			fprintf( stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #xCondition );	\
+			exit( 1 );																			\
+		}																						\
+	} while( 0 )
+
+#endif /* HOST_KERNEL_H */
@@ -0,0 +1,129 @@
+/*
+ * Port layer of the host tests.  The kernel sources under test are compiled for
+ * the build machine and linked with host_kernel.c, which provides the task API
+ * and the critical sections, or with tasks.c and the port functions of the
+ * test.  Nothing here touches Cortex-M registers.
+ */
+
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Type definitions. */
+#define portCHAR		char
+#define portFLOAT		float
+#define portDOUBLE		double
+#define portLONG		long
+#define portSHORT		short
+#define portSTACK_TYPE	uint32_t
+#define portBASE_TYPE	long
+
+typedef portSTACK_TYPE StackType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+
+#if( configUSE_16_BIT_TICKS == 1 )
+	typedef uint16_t TickType_t;
+	#define portMAX_DELAY ( TickType_t ) 0xffff
+#else
+	typedef uint32_t TickType_t;
+	#define portMAX_DELAY ( TickType_t ) 0xffffffffUL
+	#define portTICK_TYPE_IS_ATOMIC 1
+#endif
+/*-----------------------------------------------------------*/
+
+/* Architecture specifics. */
+#define portSTACK_GROWTH			( -1 )
+#define portTICK_PERIOD_MS			( ( TickType_t ) 1000 / configTICK_RATE_HZ )
+#define portBYTE_ALIGNMENT			8
+#define portPOINTER_SIZE_TYPE		uintptr_t
+/*-----------------------------------------------------------*/
+
+/* Scheduler utilities.  host_kernel.c only switches tasks where they block or
+call vHostYield(), so a yield request is only counted. */
+extern volatile uint32_t ulHostYieldRequests;
+#define portYIELD()									( ulHostYieldRequests++ )
+#define portEND_SWITCHING_ISR( xSwitchRequired )	if( ( xSwitchRequired ) != pdFALSE ) portYIELD()
+#define portYIELD_FROM_ISR( x )						portEND_SWITCHING_ISR( x )
+/*-----------------------------------------------------------*/
+
+/* Critical section management. */
+extern void vPortEnterCritical( void );
+extern void vPortExitCritical( void );
+#define portSET_INTERRUPT_MASK_FROM_ISR()		0UL
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR( x )	( void ) ( x )
+#define portDISABLE_INTERRUPTS()
+#define portENABLE_INTERRUPTS()
+#define portENTER_CRITICAL()					vPortEnterCritical()
+#define portEXIT_CRITICAL()						vPortExitCritical()
+/*-----------------------------------------------------------*/
+
+#define portTASK_FUNCTION_PROTO( vFunction, pvParameters ) void vFunction( void *pvParameters )
+#define portTASK_FUNCTION( vFunction, pvParameters ) void vFunction( void *pvParameters )
+/*-----------------------------------------------------------*/
+
+/* Cycle counter, advanced by one at every read. */
+extern uint32_t ulHostGetCycleCounter( void );
+#define portCONFIGURE_CYCLE_COUNTER()
+#define portGET_CYCLE_COUNTER()		ulHostGetCycleCounter()
+/*-----------------------------------------------------------*/
+
+/* The heap regions of the target, ignored by the host heap. */
+#define portHEAP_REGION_SRAM		0
+#define portHEAP_REGION_CCM			1
+/*-----------------------------------------------------------*/
+
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION 0
+
+#define portNOP()
+#define portINLINE	__inline
+
+#ifndef portFORCE_INLINE
+	#define portFORCE_INLINE inline __attribute__(( always_inline))
+#endif
+
+static inline BaseType_t xPortIsInsideInterrupt( void )
+{
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+/* Exclusive access.  Nothing else runs between a load and a store on the host,
+so the store only fails when a test asks for it: it fails the next
+ulHostStoreExclusiveFailures times, as if an interrupt had come in between. */
+extern volatile uint32_t ulHostStoreExclusiveFailures;
+
+static inline uint32_t ulPortLoadExclusive( volatile uint32_t *pulAddress )
+{
+	return *pulAddress;
+}
+
+static inline uint32_t ulPortStoreExclusive( volatile uint32_t *pulAddress, uint32_t ulValue )
+{
+	if( ulHostStoreExclusiveFailures > 0UL )
+	{
+		ulHostStoreExclusiveFailures--;
+		return 1UL;
+	}
+
+	*pulAddress = ulValue;
+	return 0UL;
+}
+
+static inline void vPortClearExclusive( void )
+{
+}
+
+#define portMEMORY_BARRIER()	__sync_synchronize()
+/*-----------------------------------------------------------*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PORTMACRO_H */
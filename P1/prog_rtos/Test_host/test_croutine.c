@@ -0,0 +1,120 @@
+/*
+ * Co-routines (croutine.c) run by vCoRoutineSchedulerTask(): delays, and a
+ * co-routine waiting for notifications and on a bound poll set, sent by a
+ * task with the handle xCoRoutineCreate() passed back.
+ */
+
+#include "host_kernel.h"
+#include "croutine.h"
+#include "poll_set.h"
+
+#define hostDELAY_ROUNDS	5
+#define hostSET_BIT			5U
+
+static CoRoutineHandle_t xWaiterHandle;
+static PollSetHandle_t xSet;
+
+static UBaseType_t uxDelayRounds[ 2 ];
+static BaseType_t xTimedOut = pdFALSE, xNotified = pdFALSE, xPolled = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+/* Index 0 delays 3 ticks at a time, index 1 5 ticks, then both wait for
+good. */
+static void prvDelayer( CoRoutineHandle_t xHandle, UBaseType_t uxIndex )
+{
+static TickType_t xLastRun[ 2 ];
+static BaseType_t xResult;
+
+	crSTART( xHandle );
+
+	xLastRun[ uxIndex ] = xTaskGetTickCount();
+
+	while( uxDelayRounds[ uxIndex ] < hostDELAY_ROUNDS )
+	{
+		crDELAY( xHandle, 3 + ( uxIndex * 2U ) );
+		hostCHECK( ( xTaskGetTickCount() - xLastRun[ uxIndex ] ) == ( 3 + ( uxIndex * 2U ) ) );
+		xLastRun[ uxIndex ] = xTaskGetTickCount();
+		uxDelayRounds[ uxIndex ]++;
+	}
+
+	for( ;; )
+	{
+		crNOTIFY_WAIT( xHandle, portMAX_DELAY, NULL, &xResult );
+	}
+
+	crEND();
+}
+
+static void prvWaiter( CoRoutineHandle_t xHandle, UBaseType_t uxIndex )
+{
+static TickType_t xStart;
+static uint32_t ulValue;
+static BaseType_t xResult;
+
+	( void ) uxIndex;
+
+	crSTART( xHandle );
+
+	/* Nothing is sent for the first 10 ticks. */
+	xStart = xTaskGetTickCount();
+	crNOTIFY_WAIT( xHandle, 3, &ulValue, &xResult );
+	hostCHECK( xResult == pdFAIL );
+	hostCHECK( ( xTaskGetTickCount() - xStart ) >= 3 );
+	xTimedOut = pdTRUE;
+
+	/* Both notifications are sent before the co-routine runs again. */
+	crNOTIFY_WAIT( xHandle, portMAX_DELAY, &ulValue, &xResult );
+	hostCHECK( xResult == pdPASS );
+	hostCHECK( ulValue == 0x11UL );
+	xNotified = pdTRUE;
+
+	crPOLL_SET_WAIT( xHandle, xSet, portMAX_DELAY, &ulValue );
+	hostCHECK( ulValue == ( 1UL << hostSET_BIT ) );
+	xPolled = pdTRUE;
+
+	for( ;; )
+	{
+		crNOTIFY_WAIT( xHandle, portMAX_DELAY, NULL, &xResult );
+	}
+
+	crEND();
+}
+/*-----------------------------------------------------------*/
+
+static void prvNotifier( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	vTaskDelay( 10 );
+	hostCHECK( xCoRoutineNotify( xWaiterHandle, 0x01UL ) == pdPASS );
+	hostCHECK( xCoRoutineNotify( xWaiterHandle, 0x10UL ) == pdPASS );
+
+	vTaskDelay( 10 );
+	vPollSetSignal( xSet, 1UL << hostSET_BIT );
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xSet = xPollSetCreate();
+	hostCHECK( xSet != NULL );
+	hostCHECK( xPollSetAddBit( xSet, hostSET_BIT ) == pdPASS );
+
+	hostCHECK( xCoRoutineCreate( prvDelayer, 0, 0, NULL ) == pdPASS );
+	hostCHECK( xCoRoutineCreate( prvDelayer, 0, 1, NULL ) == pdPASS );
+	hostCHECK( xCoRoutineCreate( prvWaiter, 1, 0, &xWaiterHandle ) == pdPASS );
+	hostCHECK( xWaiterHandle != NULL );
+	vPollSetBindCoRoutine( xSet, xWaiterHandle );
+
+	hostCHECK( xTaskCreate( vCoRoutineSchedulerTask, "co-routines", configMINIMAL_STACK_SIZE, NULL, 1, NULL ) == pdPASS );
+	hostCHECK( xTaskCreate( prvNotifier, "notifier", configMINIMAL_STACK_SIZE, NULL, 1, NULL ) == pdPASS );
+	vHostRun();
+
+	hostCHECK( ( uxDelayRounds[ 0 ] == hostDELAY_ROUNDS ) && ( uxDelayRounds[ 1 ] == hostDELAY_ROUNDS ) );
+	hostCHECK( ( xTimedOut != pdFALSE ) && ( xNotified != pdFALSE ) && ( xPolled != pdFALSE ) );
+
+	printf( "test_croutine: passed\n" );
+	return 0;
+}
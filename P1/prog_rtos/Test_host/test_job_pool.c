@@ -0,0 +1,200 @@
+/*
+ * Job pools (job_pool.c): flat and nested fan out, full deques, timeouts, jobs
+ * submitted without a counter, and deleting a pool with jobs still running.
+ * Jobs yield at random, so the workers interleave and steal from each other.
+ */
+
+#include "host_kernel.h"
+#include "job_pool.h"
+
+#define hostWORKERS			4
+#define hostDEQUE_LENGTH	8
+
+static JobPoolHandle_t xPool;
+static volatile UBaseType_t uxSum, uxFannedOut, uxSlowDone;
+static BaseType_t xDone = pdFALSE;
+
+static void prvLeaf( void *pvArgument )
+{
+	uxSum += ( UBaseType_t ) ( uintptr_t ) pvArgument;
+
+	if( ( rand() % 3 ) == 0 )
+	{
+		vHostYield();
+	}
+}
+
+/* A job that fans out in turn, and waits for its own jobs. */
+static void prvFanOut( void *pvArgument )
+{
+JobCounter_t xCounter = { 0 };
+UBaseType_t x;
+
+	( void ) pvArgument;
+
+	for( x = 0; x < 4U; x++ )
+	{
+		hostCHECK( xJobPoolSubmit( xPool, prvLeaf, ( void * ) 1, &xCounter ) == pdPASS );
+	}
+
+	hostCHECK( xJobPoolWait( xPool, &xCounter, portMAX_DELAY ) == pdPASS );
+	hostCHECK( xCounter.uxPending == 0U );
+	uxFannedOut++;
+}
+
+static void prvSlow( void *pvArgument )
+{
+UBaseType_t x;
+
+	( void ) pvArgument;
+
+	for( x = 0; x < 50U; x++ )
+	{
+		vHostYield();
+	}
+
+	uxSlowDone++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestFlat( void )
+{
+JobCounter_t xCounter = { 0 };
+UBaseType_t uxRound, uxJobs, uxExpected, x;
+
+	for( uxRound = 0; uxRound < 50U; uxRound++ )
+	{
+		uxSum = 0;
+		uxExpected = 0;
+		uxJobs = 1 + ( ( UBaseType_t ) rand() % 32U );
+
+		for( x = 1; x <= uxJobs; x++ )
+		{
+			if( xJobPoolSubmit( xPool, prvLeaf, ( void * ) ( uintptr_t ) x, &xCounter ) == pdPASS )
+			{
+				uxExpected += x;
+			}
+		}
+
+		hostCHECK( xJobPoolWait( xPool, &xCounter, portMAX_DELAY ) == pdPASS );
+		hostCHECK( xCounter.uxPending == 0U );
+		hostCHECK( uxSum == uxExpected );
+	}
+}
+
+/* Submitting fails once every deque is full, and only then. */
+static void prvTestFullDeques( void )
+{
+JobCounter_t xCounter = { 0 };
+UBaseType_t x;
+
+	for( x = 0; x < 100U; x++ )
+	{
+		if( xJobPoolSubmit( xPool, prvLeaf, NULL, &xCounter ) != pdPASS )
+		{
+			break;
+		}
+	}
+
+	hostCHECK( x == hostWORKERS * hostDEQUE_LENGTH );
+	hostCHECK( xJobPoolWait( xPool, &xCounter, portMAX_DELAY ) == pdPASS );
+}
+
+static void prvTestNested( void )
+{
+JobCounter_t xCounter = { 0 };
+UBaseType_t x;
+
+	uxSum = 0;
+	uxFannedOut = 0;
+
+	for( x = 0; x < 8U; x++ )
+	{
+		hostCHECK( xJobPoolSubmit( xPool, prvFanOut, NULL, &xCounter ) == pdPASS );
+	}
+
+	hostCHECK( xJobPoolWait( xPool, &xCounter, portMAX_DELAY ) == pdPASS );
+	hostCHECK( uxFannedOut == 8U );
+	hostCHECK( uxSum == 32U );
+}
+
+/* A wait that times out leaves the counter usable and no notification
+behind. */
+static void prvTestTimeout( void )
+{
+JobCounter_t xCounter = { 0 };
+
+	hostCHECK( xJobPoolSubmit( xPool, prvSlow, NULL, &xCounter ) == pdPASS );
+	hostCHECK( xJobPoolWait( xPool, &xCounter, 0 ) == pdFAIL );
+	hostCHECK( xCounter.xWaitingTask == NULL );
+
+	hostCHECK( xJobPoolWait( xPool, &xCounter, portMAX_DELAY ) == pdPASS );
+	hostCHECK( ulHostGetNotificationCount( NULL, configJOB_POOL_NOTIFICATION_INDEX ) == 0UL );
+}
+
+static void prvTestNoCounter( void )
+{
+UBaseType_t x;
+
+	uxSum = 0;
+
+	for( x = 0; x < 5U; x++ )
+	{
+		hostCHECK( xJobPoolSubmit( xPool, prvLeaf, ( void * ) 1, NULL ) == pdPASS );
+	}
+
+	for( x = 0; x < 200U; x++ )
+	{
+		vHostYield();
+	}
+
+	hostCHECK( uxSum == 5U );
+}
+
+/* The pool is deleted with jobs running and queued: they complete first. */
+static void prvTestDeleteBusy( void )
+{
+UBaseType_t x;
+
+	uxSlowDone = 0;
+
+	for( x = 0; x < ( hostWORKERS * 2U ); x++ )
+	{
+		hostCHECK( xJobPoolSubmit( xPool, prvSlow, NULL, NULL ) == pdPASS );
+	}
+
+	vHostYield();
+	vJobPoolDelete( xPool );
+	hostCHECK( uxSlowDone == ( hostWORKERS * 2U ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	xPool = xJobPoolCreate( hostWORKERS, hostDEQUE_LENGTH, configMINIMAL_STACK_SIZE, 1 );
+	hostCHECK( xPool != NULL );
+
+	prvTestFlat();
+	hostCHECK( ulJobPoolGetSteals( xPool ) > 0UL );
+	prvTestFullDeques();
+	prvTestNested();
+	prvTestTimeout();
+	prvTestNoCounter();
+	prvTestDeleteBusy();
+	xDone = pdTRUE;
+	vTaskDelete( NULL );
+}
+
+int main( void )
+{
+	srand( 1 );
+
+	hostCHECK( xTaskCreate( prvTestTask, "test", configMINIMAL_STACK_SIZE, NULL, 1, NULL ) == pdPASS );
+	vHostRun();
+	hostCHECK( xDone != pdFALSE );
+
+	printf( "test_job_pool: passed\n" );
+	return 0;
+}
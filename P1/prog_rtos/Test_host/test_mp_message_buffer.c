@@ -0,0 +1,206 @@
+/*
+ * Multi-producer message buffer (mp_message_buffer.c): random interleavings of
+ * reserve, out of order commit and receive, and a reader waiting behind
+ * padding.
+ */
+
+#include <string.h>
+
+#include "host_kernel.h"
+#include "mp_message_buffer.h"
+
+#define hostMAX_PENDING		5
+
+/* Reserved but not committed messages, committed in random order. */
+typedef struct
+{
+	uint8_t *pucMessage;
+	size_t xLength;
+} PendingMessage_t;
+
+/* Messages are filled with their sequence number counting up, so the reader
+can check the order and the content.  Interrupted exclusive stores are
+simulated at random. */
+static void prvTestRandomInterleavings( void )
+{
+MPMessageBufferHandle_t xBuffer;
+PendingMessage_t xPending[ hostMAX_PENDING ];
+UBaseType_t uxPending = 0, uxRound, x;
+uint32_t ulSent = 0, ulReceived = 0, ulDropped = 0;
+uint8_t ucOut[ 64 ], *pucMessage;
+void *pvMessage;
+size_t xLength;
+
+	xBuffer = xMPMessageBufferCreate( 256 );
+	hostCHECK( xBuffer != NULL );
+	srand( 1 );
+
+	for( uxRound = 0; uxRound < 200000UL; uxRound++ )
+	{
+		ulHostStoreExclusiveFailures = ( ( rand() % 3 ) == 0 ) ? 1UL : 0UL;
+
+		switch( rand() % 4 )
+		{
+			case 0:
+			case 1:
+				if( uxPending == hostMAX_PENDING )
+				{
+					break;
+				}
+
+				xLength = 1 + ( rand() % 60 );
+				pucMessage = pvMPMessageBufferReserve( xBuffer, xLength );
+
+				if( pucMessage == NULL )
+				{
+					ulDropped++;
+					break;
+				}
+
+				hostCHECK( ( ( uintptr_t ) pucMessage & 7U ) == 0U );
+
+				for( x = 0; x < xLength; x++ )
+				{
+					pucMessage[ x ] = ( uint8_t ) ( ulSent + x );
+				}
+
+				ulSent++;
+				xPending[ uxPending ].pucMessage = pucMessage;
+				xPending[ uxPending ].xLength = xLength;
+				uxPending++;
+				break;
+
+			case 2:
+				if( uxPending == 0 )
+				{
+					break;
+				}
+
+				x = ( UBaseType_t ) rand() % uxPending;
+
+				if( ( rand() % 2 ) == 0 )
+				{
+					vMPMessageBufferCommit( xBuffer, xPending[ x ].pucMessage );
+				}
+				else
+				{
+					vMPMessageBufferCommitFromISR( xBuffer, xPending[ x ].pucMessage, NULL );
+				}
+
+				uxPending--;
+				xPending[ x ] = xPending[ uxPending ];
+				break;
+
+			default:
+				xLength = xMPMessageBufferPeek( xBuffer, &pvMessage, 0 );
+
+				if( xLength == 0 )
+				{
+					break;
+				}
+
+				/* Messages come out in the order they were reserved. */
+				pucMessage = pvMessage;
+
+				for( x = 0; x < xLength; x++ )
+				{
+					hostCHECK( pucMessage[ x ] == ( uint8_t ) ( ulReceived + x ) );
+				}
+
+				if( ( rand() % 2 ) == 0 )
+				{
+					vMPMessageBufferConsume( xBuffer );
+				}
+				else
+				{
+					hostCHECK( xMPMessageBufferReceive( xBuffer, ucOut, sizeof( ucOut ), 0 ) == xLength );
+					hostCHECK( ucOut[ 0 ] == ( uint8_t ) ulReceived );
+				}
+
+				ulReceived++;
+				break;
+		}
+	}
+
+	ulHostStoreExclusiveFailures = 0;
+	hostCHECK( ulMPMessageBufferGetDropped( xBuffer ) == ulDropped );
+	hostCHECK( ulReceived > 0 );
+
+	vMPMessageBufferDelete( xBuffer );
+}
+/*-----------------------------------------------------------*/
+
+/* The published range holds only the padding in front of a message that is
+still reserved: the reader must wait for that message, not return at once. */
+static MPMessageBufferHandle_t xPaddedBuffer;
+static uint8_t *pucBehindPadding;
+static size_t xTimedOutLength, xLength;
+static TickType_t xTimedOutAfter;
+static uint8_t ucReceived[ 8 ];
+
+static void prvPaddingReader( void *pvParameters )
+{
+TickType_t xStart;
+
+	( void ) pvParameters;
+
+	xStart = xTaskGetTickCount();
+	xTimedOutLength = xMPMessageBufferReceive( xPaddedBuffer, ucReceived, sizeof( ucReceived ), 3 );
+	xTimedOutAfter = xTaskGetTickCount() - xStart;
+
+	xLength = xMPMessageBufferReceive( xPaddedBuffer, ucReceived, sizeof( ucReceived ), portMAX_DELAY );
+	vTaskDelete( NULL );
+}
+
+static void prvPaddingWriter( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	vTaskDelay( 10 );
+	memset( pucBehindPadding, 0x5A, 8 );
+	vMPMessageBufferCommit( xPaddedBuffer, pucBehindPadding );
+	vTaskDelete( NULL );
+}
+
+static void prvTestWaitBehindPadding( void )
+{
+uint8_t ucFill[ 32 ], *pucBefore;
+
+	xPaddedBuffer = xMPMessageBufferCreate( 64 );
+	hostCHECK( xPaddedBuffer != NULL );
+
+	/* 8 + 32 bytes, so the next messages start at 40. */
+	memset( ucFill, 0, sizeof( ucFill ) );
+	hostCHECK( xMPMessageBufferSend( xPaddedBuffer, ucFill, sizeof( ucFill ) ) == sizeof( ucFill ) );
+	hostCHECK( xMPMessageBufferReceive( xPaddedBuffer, ucFill, sizeof( ucFill ), 0 ) == sizeof( ucFill ) );
+
+	/* 40 to 56, then 8 bytes of padding and the second message at 0.
+	Committing the first publishes it and the padding, not the second. */
+	pucBefore = pvMPMessageBufferReserve( xPaddedBuffer, 8 );
+	pucBehindPadding = pvMPMessageBufferReserve( xPaddedBuffer, 8 );
+	hostCHECK( ( pucBefore != NULL ) && ( pucBehindPadding != NULL ) );
+	hostCHECK( pucBehindPadding < pucBefore );
+	vMPMessageBufferCommit( xPaddedBuffer, pucBefore );
+	hostCHECK( xMPMessageBufferReceive( xPaddedBuffer, ucFill, sizeof( ucFill ), 0 ) == 8 );
+
+	hostCHECK( xTaskCreate( prvPaddingReader, "reader", configMINIMAL_STACK_SIZE, NULL, 1, NULL ) == pdPASS );
+	hostCHECK( xTaskCreate( prvPaddingWriter, "writer", configMINIMAL_STACK_SIZE, NULL, 1, NULL ) == pdPASS );
+	vHostRun();
+
+	hostCHECK( xTimedOutLength == 0 );
+	hostCHECK( xTimedOutAfter >= 3 );
+	hostCHECK( xLength == 8 );
+	hostCHECK( ( ucReceived[ 0 ] == 0x5A ) && ( ucReceived[ 7 ] == 0x5A ) );
+
+	vMPMessageBufferDelete( xPaddedBuffer );
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	prvTestRandomInterleavings();
+	prvTestWaitBehindPadding();
+
+	printf( "test_mp_message_buffer: passed\n" );
+	return 0;
+}
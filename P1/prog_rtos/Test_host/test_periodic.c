@@ -0,0 +1,133 @@
+/*
+ * Response time analysis and admission of periodic tasks (periodic.c).
+ */
+
+#include <string.h>
+
+#include "host_kernel.h"
+#include "periodic.h"
+
+static void prvJob( void *pvParameters )
+{
+	( void ) pvParameters;
+}
+
+static PeriodicTaskParameters_t prvTask( TickType_t xPeriod, TickType_t xWCET, TickType_t xDeadline )
+{
+PeriodicTaskParameters_t xTask;
+
+	memset( &xTask, 0, sizeof( xTask ) );
+	xTask.pxJobCode = prvJob;
+	xTask.pcName = "periodic";
+	xTask.usStackDepth = configMINIMAL_STACK_SIZE;
+	xTask.xPeriod = xPeriod;
+	xTask.xWCET = xWCET;
+	xTask.xDeadline = xDeadline;
+
+	return xTask;
+}
+
+/* The textbook set: C = 1, 2, 3 and T = 4, 6, 13 give response times of 1, 3
+and 10 under rate monotonic priorities. */
+static void prvTestResponseTimes( void )
+{
+PeriodicTaskParameters_t xSet[ 4 ];
+UBaseType_t uxPriorities[ 4 ];
+TickType_t xResponseTimes[ 4 ];
+
+	/* Out of order, with an unused entry, to check the ranking. */
+	xSet[ 0 ] = prvTask( 13, 3, 0 );
+	xSet[ 1 ] = prvTask( 0, 0, 0 );
+	xSet[ 2 ] = prvTask( 4, 1, 0 );
+	xSet[ 3 ] = prvTask( 6, 2, 0 );
+
+	hostCHECK( xPeriodicTaskSetAnalyse( xSet, 4, uxPriorities, xResponseTimes ) == pdPASS );
+	hostCHECK( uxPriorities[ 2 ] == configPERIODIC_TASK_HIGHEST_PRIORITY );
+	hostCHECK( uxPriorities[ 3 ] == configPERIODIC_TASK_HIGHEST_PRIORITY - 1 );
+	hostCHECK( uxPriorities[ 0 ] == configPERIODIC_TASK_HIGHEST_PRIORITY - 2 );
+	hostCHECK( xResponseTimes[ 2 ] == 1 );
+	hostCHECK( xResponseTimes[ 3 ] == 3 );
+	hostCHECK( xResponseTimes[ 0 ] == 10 );
+
+	/* A deadline of 9 for the longest task cannot be met. */
+	xSet[ 0 ].xDeadline = 9;
+	hostCHECK( xPeriodicTaskSetAnalyse( xSet, 4, uxPriorities, xResponseTimes ) == pdFAIL );
+	hostCHECK( xResponseTimes[ 0 ] == portMAX_DELAY );
+	hostCHECK( xResponseTimes[ 2 ] == 1 );
+
+	/* Harmonic periods are schedulable up to 100% utilisation, not beyond. */
+	xSet[ 0 ] = prvTask( 4, 2, 0 );
+	xSet[ 2 ] = prvTask( 8, 4, 0 );
+	xSet[ 3 ] = prvTask( 0, 0, 0 );
+	hostCHECK( xPeriodicTaskSetAnalyse( xSet, 4, uxPriorities, xResponseTimes ) == pdPASS );
+	hostCHECK( xResponseTimes[ 2 ] == 8 );
+	xSet[ 3 ] = prvTask( 16, 1, 0 );
+	hostCHECK( xPeriodicTaskSetAnalyse( xSet, 4, uxPriorities, NULL ) == pdFAIL );
+}
+
+/* More tasks than priorities in the band: the last ones share the lowest
+priority, and interfere with each other, the first of them included. */
+static void prvTestBandOverflow( void )
+{
+PeriodicTaskParameters_t xSet[ 10 ];
+UBaseType_t uxPriorities[ 10 ], x;
+TickType_t xResponseTimes[ 10 ];
+const UBaseType_t uxBand = configPERIODIC_TASK_HIGHEST_PRIORITY - configPERIODIC_TASK_LOWEST_PRIORITY + 1;
+
+	for( x = 0; x < 10; x++ )
+	{
+		xSet[ x ] = prvTask( 100 + x, 1, 0 );
+	}
+
+	hostCHECK( xPeriodicTaskSetAnalyse( xSet, 10, uxPriorities, xResponseTimes ) == pdPASS );
+
+	for( x = 0; x < 10; x++ )
+	{
+		if( x < uxBand - 1U )
+		{
+			hostCHECK( uxPriorities[ x ] == configPERIODIC_TASK_HIGHEST_PRIORITY - x );
+			hostCHECK( xResponseTimes[ x ] == x + 1 );
+		}
+		else
+		{
+			hostCHECK( uxPriorities[ x ] == configPERIODIC_TASK_LOWEST_PRIORITY );
+			hostCHECK( xResponseTimes[ x ] == 10 );
+		}
+	}
+}
+
+/* xPeriodicTaskCreate() admits tasks only while the set stays schedulable,
+and leaves the set unchanged when it refuses one. */
+static void prvTestAdmission( void )
+{
+PeriodicTaskParameters_t xTask;
+TaskHandle_t xFirst, xSecond, xRefused = NULL;
+
+	xTask = prvTask( 10, 4, 0 );
+	hostCHECK( xPeriodicTaskCreate( &xTask, &xFirst ) == pdPASS );
+	hostCHECK( uxTaskPriorityGet( xFirst ) == configPERIODIC_TASK_HIGHEST_PRIORITY );
+
+	/* A shorter period takes over the highest priority. */
+	xTask = prvTask( 5, 2, 0 );
+	hostCHECK( xPeriodicTaskCreate( &xTask, &xSecond ) == pdPASS );
+	hostCHECK( uxTaskPriorityGet( xSecond ) == configPERIODIC_TASK_HIGHEST_PRIORITY );
+	hostCHECK( uxTaskPriorityGet( xFirst ) == configPERIODIC_TASK_HIGHEST_PRIORITY - 1 );
+
+	/* Utilisation 0.4 + 0.4 + 0.25: refused, nothing moves. */
+	xTask = prvTask( 4, 1, 0 );
+	hostCHECK( xPeriodicTaskCreate( &xTask, &xRefused ) == errPERIODIC_TASK_NOT_SCHEDULABLE );
+	hostCHECK( xRefused == NULL );
+	hostCHECK( uxTaskPriorityGet( xSecond ) == configPERIODIC_TASK_HIGHEST_PRIORITY );
+	hostCHECK( uxTaskPriorityGet( xFirst ) == configPERIODIC_TASK_HIGHEST_PRIORITY - 1 );
+	hostCHECK( uxPeriodicTaskGetDeadlineMisses( xFirst ) == 0 );
+}
+
+int main( void )
+{
+	prvTestResponseTimes();
+	prvTestBandOverflow();
+	prvTestAdmission();
+
+	printf( "test_periodic: passed\n" );
+	return 0;
+}
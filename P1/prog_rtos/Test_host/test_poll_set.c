@@ -0,0 +1,194 @@
+/*
+ * Poll sets (poll_set.c): bits claimed by the application, queues and stream
+ * buffers as members, and a task blocked on the set, which must wake for the
+ * set only and leave its other notifications alone.
+ *
+ * Queues are only sent to and received from without blocking, so the event
+ * list functions below are never called.
+ */
+
+#include "host_kernel.h"
+#include "poll_set.h"
+
+#define hostQUEUE_BIT		3U
+#define hostBUFFER_BIT		7U
+#define hostAPP_BIT			31U
+
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskGetSchedulerState( void )
+{
+	return taskSCHEDULER_RUNNING;
+}
+
+BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
+{
+	( void ) pxEventList;
+	hostCHECK( pdFALSE );
+	return pdFALSE;
+}
+
+void vTaskPlaceOnEventList( List_t * const pxEventList, const TickType_t xTicksToWait )
+{
+	( void ) pxEventList;
+	( void ) xTicksToWait;
+	hostCHECK( pdFALSE );
+}
+
+void vTaskMissedYield( void )
+{
+}
+
+BaseType_t xTaskPriorityInherit( TaskHandle_t const pxMutexHolder )
+{
+	( void ) pxMutexHolder;
+	return pdFALSE;
+}
+
+BaseType_t xTaskPriorityDisinherit( TaskHandle_t const pxMutexHolder )
+{
+	( void ) pxMutexHolder;
+	return pdFALSE;
+}
+
+void vTaskPriorityDisinheritAfterTimeout( TaskHandle_t const pxMutexHolder, UBaseType_t uxHighestPriorityWaitingTask )
+{
+	( void ) pxMutexHolder;
+	( void ) uxHighestPriorityWaitingTask;
+}
+
+void *pvTaskIncrementMutexHeldCount( void )
+{
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+/* Bits are set once per edge and collected by the wait. */
+static void prvTestBits( void )
+{
+PollSetHandle_t xSet;
+BaseType_t xWoken = pdFALSE;
+
+	xSet = xPollSetCreate();
+	hostCHECK( xSet != NULL );
+
+	hostCHECK( xPollSetAddBit( xSet, 0 ) == pdPASS );
+	hostCHECK( xPollSetAddBit( xSet, hostAPP_BIT ) == pdPASS );
+	hostCHECK( xPollSetAddBit( xSet, 0 ) == pdFAIL );
+
+	hostCHECK( ulPollSetWait( xSet, 0 ) == 0UL );
+
+	vPollSetSignal( xSet, 1UL );
+	vPollSetSignal( xSet, 1UL );
+	vPollSetSignalFromISR( xSet, 1UL << hostAPP_BIT, &xWoken );
+	hostCHECK( ulPollSetGetReady( xSet ) == ( 1UL | ( 1UL << hostAPP_BIT ) ) );
+	hostCHECK( ulPollSetWait( xSet, 0 ) == ( 1UL | ( 1UL << hostAPP_BIT ) ) );
+	hostCHECK( ulPollSetGetReady( xSet ) == 0UL );
+
+	/* Removing a member clears its pending bit. */
+	vPollSetSignal( xSet, 1UL );
+	vPollSetRemoveBit( xSet, 0 );
+	hostCHECK( ulPollSetWait( xSet, 0 ) == 0UL );
+
+	vPollSetRemoveBit( xSet, hostAPP_BIT );
+	vPollSetDelete( xSet );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestMembers( void )
+{
+PollSetHandle_t xSet;
+QueueHandle_t xQueue;
+StreamBufferHandle_t xBuffer;
+uint32_t ulItem = 5;
+uint8_t ucData[ 4 ] = { 1, 2, 3, 4 };
+
+	xSet = xPollSetCreate();
+	xQueue = xQueueCreate( 4, sizeof( uint32_t ) );
+	xBuffer = xStreamBufferCreate( 16, 1 );
+	hostCHECK( ( xSet != NULL ) && ( xQueue != NULL ) && ( xBuffer != NULL ) );
+
+	/* A queue that already holds an item sets its bit when added. */
+	hostCHECK( xQueueSend( xQueue, &ulItem, 0 ) == pdPASS );
+	hostCHECK( xPollSetAddQueue( xSet, xQueue, hostQUEUE_BIT ) == pdPASS );
+	hostCHECK( xPollSetAddStreamBuffer( xSet, xBuffer, hostBUFFER_BIT ) == pdPASS );
+	hostCHECK( xPollSetAddQueue( xSet, xQueue, hostQUEUE_BIT + 1U ) == pdFAIL );
+	hostCHECK( ulPollSetWait( xSet, 0 ) == ( 1UL << hostQUEUE_BIT ) );
+
+	/* Once collected, only new data sets the bit again. */
+	hostCHECK( ulPollSetWait( xSet, 0 ) == 0UL );
+	hostCHECK( xStreamBufferSend( xBuffer, ucData, sizeof( ucData ), 0 ) == sizeof( ucData ) );
+	hostCHECK( xQueueSend( xQueue, &ulItem, 0 ) == pdPASS );
+	hostCHECK( ulPollSetWait( xSet, 0 ) == ( ( 1UL << hostQUEUE_BIT ) | ( 1UL << hostBUFFER_BIT ) ) );
+
+	/* Deleting the members removes them from the set. */
+	vQueueDelete( xQueue );
+	vStreamBufferDelete( xBuffer );
+	vPollSetDelete( xSet );
+}
+/*-----------------------------------------------------------*/
+
+/* The waiter has a notification pending at the default index before it
+blocks on the set: that one neither wakes the wait nor is lost by it. */
+static PollSetHandle_t xWaitSet;
+static QueueHandle_t xWaitQueue;
+static uint32_t ulTimedOutBits, ulBits;
+static TickType_t xTimedOutAfter;
+
+static void prvWaiter( void *pvParameters )
+{
+TickType_t xStart;
+
+	( void ) pvParameters;
+
+	hostCHECK( xTaskNotifyGive( xTaskGetCurrentTaskHandle() ) == pdPASS );
+
+	xStart = xTaskGetTickCount();
+	ulTimedOutBits = ulPollSetWait( xWaitSet, 3 );
+	xTimedOutAfter = xTaskGetTickCount() - xStart;
+
+	ulBits = ulPollSetWait( xWaitSet, portMAX_DELAY );
+	hostCHECK( ulHostGetNotificationCount( NULL, tskDEFAULT_INDEX_TO_NOTIFY ) == 1UL );
+	vTaskDelete( NULL );
+}
+
+static void prvSender( void *pvParameters )
+{
+uint32_t ulItem = 9;
+
+	( void ) pvParameters;
+
+	vTaskDelay( 10 );
+	hostCHECK( xQueueSend( xWaitQueue, &ulItem, 0 ) == pdPASS );
+	vTaskDelete( NULL );
+}
+
+static void prvTestWait( void )
+{
+	xWaitSet = xPollSetCreate();
+	xWaitQueue = xQueueCreate( 1, sizeof( uint32_t ) );
+	hostCHECK( ( xWaitSet != NULL ) && ( xWaitQueue != NULL ) );
+	hostCHECK( xPollSetAddQueue( xWaitSet, xWaitQueue, hostQUEUE_BIT ) == pdPASS );
+
+	hostCHECK( xTaskCreate( prvWaiter, "waiter", configMINIMAL_STACK_SIZE, NULL, 1, NULL ) == pdPASS );
+	hostCHECK( xTaskCreate( prvSender, "sender", configMINIMAL_STACK_SIZE, NULL, 1, NULL ) == pdPASS );
+	vHostRun();
+
+	hostCHECK( ulTimedOutBits == 0UL );
+	hostCHECK( xTimedOutAfter >= 3 );
+	hostCHECK( ulBits == ( 1UL << hostQUEUE_BIT ) );
+
+	vQueueDelete( xWaitQueue );
+	vPollSetDelete( xWaitSet );
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	prvTestBits();
+	prvTestMembers();
+	prvTestWait();
+
+	printf( "test_poll_set: passed\n" );
+	return 0;
+}
@@ -0,0 +1,179 @@
+/*
+ * Item copies of queues (queue.c): every item size up to past the inline
+ * limit goes through send to back and front, receive and peek byte exact,
+ * with the buffer of the caller aligned and not, then messages per second of
+ * a send and receive pair are printed per item size.
+ *
+ * No task ever blocks, so the event list functions below are never called.
+ * To compare the rates with the library copy alone, build once more with
+ * "make clean host-test HOST_DEFS_queue_copy=-DconfigQUEUE_INLINE_COPY_MAX_SIZE=0".
+ * Src/main13_queue_copy.c measures the same on the target, in cycles.
+ */
+
+#include <string.h>
+#include <time.h>
+
+#include "host_kernel.h"
+#include "queue.h"
+
+#define hostMAX_ITEM_SIZE		( configQUEUE_INLINE_COPY_MAX_SIZE + 8 )
+#define hostQUEUE_LENGTH		4
+#define hostBENCHMARK_ITEMS		200000UL
+
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskGetSchedulerState( void )
+{
+	return taskSCHEDULER_RUNNING;
+}
+
+BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
+{
+	( void ) pxEventList;
+	hostCHECK( pdFALSE );
+	return pdFALSE;
+}
+
+void vTaskPlaceOnEventList( List_t * const pxEventList, const TickType_t xTicksToWait )
+{
+	( void ) pxEventList;
+	( void ) xTicksToWait;
+	hostCHECK( pdFALSE );
+}
+
+void vTaskMissedYield( void )
+{
+}
+
+BaseType_t xTaskPriorityInherit( TaskHandle_t const pxMutexHolder )
+{
+	( void ) pxMutexHolder;
+	return pdFALSE;
+}
+
+BaseType_t xTaskPriorityDisinherit( TaskHandle_t const pxMutexHolder )
+{
+	( void ) pxMutexHolder;
+	return pdFALSE;
+}
+
+void vTaskPriorityDisinheritAfterTimeout( TaskHandle_t const pxMutexHolder, UBaseType_t uxHighestPriorityWaitingTask )
+{
+	( void ) pxMutexHolder;
+	( void ) uxHighestPriorityWaitingTask;
+}
+
+void *pvTaskIncrementMutexHeldCount( void )
+{
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+/* Fills xSize bytes with a pattern that depends on the item and the size. */
+static void prvFill( uint8_t *pucItem, size_t xSize, uint8_t ucSeed )
+{
+size_t x;
+
+	for( x = 0; x < xSize; x++ )
+	{
+		pucItem[ x ] = ( uint8_t ) ( ucSeed + ( x * 7U ) + xSize );
+	}
+}
+
+/* The guard bytes on either side of the item are left alone. */
+static void prvCheckReceived( const uint8_t *pucBuffer, const uint8_t *pucExpected, size_t xSize )
+{
+	hostCHECK( pucBuffer[ -1 ] == 0xA5U );
+	hostCHECK( memcmp( pucBuffer, pucExpected, xSize ) == 0 );
+	hostCHECK( pucBuffer[ xSize ] == 0xA5U );
+}
+
+static void prvTestItemSizes( void )
+{
+QueueHandle_t xQueue;
+uint32_t ulIn[ ( hostMAX_ITEM_SIZE / 4 ) + 2 ], ulOut[ ( hostMAX_ITEM_SIZE / 4 ) + 2 ];
+uint8_t ucFirst[ hostMAX_ITEM_SIZE ], ucSecond[ hostMAX_ITEM_SIZE ];
+uint8_t *pucIn, *pucOut;
+size_t xSize, xOffset;
+
+	for( xSize = 1; xSize <= hostMAX_ITEM_SIZE; xSize++ )
+	{
+		xQueue = xQueueCreate( hostQUEUE_LENGTH, xSize );
+		hostCHECK( xQueue != NULL );
+
+		/* The buffers of the caller at each offset within a word. */
+		for( xOffset = 1; xOffset <= 4U; xOffset++ )
+		{
+			pucIn = ( uint8_t * ) ulIn + ( xOffset & 3U );
+			pucOut = ( uint8_t * ) ulOut + ( xOffset & 3U ) + ( ( xOffset == 4U ) ? 4U : 0U );
+			memset( ulOut, 0xA5, sizeof( ulOut ) );
+
+			prvFill( ucFirst, xSize, ( uint8_t ) xOffset );
+			prvFill( ucSecond, xSize, ( uint8_t ) ( xOffset + 100U ) );
+
+			/* Second to the back, first to the front, so the first comes out
+			first. */
+			memcpy( pucIn, ucSecond, xSize );
+			hostCHECK( xQueueSendToBack( xQueue, pucIn, 0 ) == pdPASS );
+			memcpy( pucIn, ucFirst, xSize );
+			hostCHECK( xQueueSendToFront( xQueue, pucIn, 0 ) == pdPASS );
+
+			hostCHECK( xQueuePeek( xQueue, pucOut, 0 ) == pdPASS );
+			prvCheckReceived( pucOut, ucFirst, xSize );
+			memset( ulOut, 0xA5, sizeof( ulOut ) );
+			hostCHECK( xQueueReceive( xQueue, pucOut, 0 ) == pdPASS );
+			prvCheckReceived( pucOut, ucFirst, xSize );
+			memset( ulOut, 0xA5, sizeof( ulOut ) );
+			hostCHECK( xQueueReceive( xQueue, pucOut, 0 ) == pdPASS );
+			prvCheckReceived( pucOut, ucSecond, xSize );
+
+			hostCHECK( uxQueueMessagesWaiting( xQueue ) == 0U );
+		}
+
+		vQueueDelete( xQueue );
+	}
+}
+/*-----------------------------------------------------------*/
+
+/* Not a check: a send and receive pair per message, from word aligned
+buffers, at the sizes that select each copy of prvCopyItem(). */
+static void prvBenchmarkItemSizes( void )
+{
+static const size_t xSizes[] = { 1, 2, 4, 8, 12, 16, 24, 32, 40, 64 };
+QueueHandle_t xQueue;
+uint32_t ulIn[ 16 ], ulOut[ 16 ];
+UBaseType_t x, uxMessage;
+clock_t xStart;
+double dSeconds;
+
+	memset( ulIn, 0x5A, sizeof( ulIn ) );
+
+	for( x = 0; x < ( sizeof( xSizes ) / sizeof( xSizes[ 0 ] ) ); x++ )
+	{
+		xQueue = xQueueCreate( hostQUEUE_LENGTH, xSizes[ x ] );
+		hostCHECK( xQueue != NULL );
+		xStart = clock();
+
+		for( uxMessage = 0; uxMessage < hostBENCHMARK_ITEMS; uxMessage++ )
+		{
+			( void ) xQueueSend( xQueue, ulIn, 0 );
+			( void ) xQueueReceive( xQueue, ulOut, 0 );
+		}
+
+		dSeconds = ( double ) ( clock() - xStart ) / CLOCKS_PER_SEC;
+		printf( "test_queue_copy: %2u bytes %10.0f messages/s\n", ( unsigned ) xSizes[ x ], ( dSeconds > 0.0 ) ? hostBENCHMARK_ITEMS / dSeconds : 0.0 );
+		hostCHECK( memcmp( ulIn, ulOut, xSizes[ x ] ) == 0 );
+
+		vQueueDelete( xQueue );
+	}
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	prvTestItemSizes();
+	prvBenchmarkItemSizes();
+
+	printf( "test_queue_copy: passed\n" );
+	return 0;
+}
@@ -0,0 +1,179 @@
+/*
+ * Zero copy access to stream and message buffers (stream_buffer.c): the read
+ * and write regions, commit, peek and consume.
+ */
+
+#include <string.h>
+
+#include "host_kernel.h"
+#include "stream_buffer.h"
+#include "message_buffer.h"
+
+static StreamBufferHandle_t xStream;
+
+/* Copies the one or two regions to pucOut, returns the bytes copied. */
+static size_t prvGather( const StreamBufferRegions_t *pxRegions, uint8_t *pucOut )
+{
+	memcpy( pucOut, pxRegions->pucFirst, pxRegions->xFirstLength );
+
+	if( pxRegions->xSecondLength != 0 )
+	{
+		memcpy( pucOut + pxRegions->xFirstLength, pxRegions->pucSecond, pxRegions->xSecondLength );
+	}
+
+	return pxRegions->xFirstLength + pxRegions->xSecondLength;
+}
+
+/* Writes xLength bytes counting up from ucFirst in place, across the wrap if
+needed. */
+static void prvWriteInPlace( const StreamBufferRegions_t *pxRegions, uint8_t ucFirst, size_t xLength )
+{
+size_t x;
+
+	for( x = 0; x < xLength; x++ )
+	{
+		if( x < pxRegions->xFirstLength )
+		{
+			pxRegions->pucFirst[ x ] = ( uint8_t ) ( ucFirst + x );
+		}
+		else
+		{
+			pxRegions->pucSecond[ x - pxRegions->xFirstLength ] = ( uint8_t ) ( ucFirst + x );
+		}
+	}
+}
+
+/* 7 bytes in, 3 consumed in place and 4 received, so every wrap position of
+a 10 byte buffer is crossed. */
+static void prvTestStreamRegions( void )
+{
+StreamBufferRegions_t xRegions;
+uint8_t ucIn[ 7 ], ucOut[ 16 ];
+size_t x, xRound;
+
+	xStream = xStreamBufferCreate( 10, 1 );
+	hostCHECK( xStream != NULL );
+
+	for( xRound = 0; xRound < 100; xRound++ )
+	{
+		for( x = 0; x < sizeof( ucIn ); x++ )
+		{
+			ucIn[ x ] = ( uint8_t ) ( xRound * 7 + x );
+		}
+
+		hostCHECK( xStreamBufferGetWriteRegions( xStream, &xRegions ) == 10 );
+		prvWriteInPlace( &xRegions, ucIn[ 0 ], sizeof( ucIn ) );
+		hostCHECK( xStreamBufferCommit( xStream, sizeof( ucIn ) ) == sizeof( ucIn ) );
+
+		hostCHECK( xStreamBufferGetReadRegions( xStream, &xRegions ) == sizeof( ucIn ) );
+		hostCHECK( prvGather( &xRegions, ucOut ) == sizeof( ucIn ) );
+		hostCHECK( memcmp( ucOut, ucIn, sizeof( ucIn ) ) == 0 );
+
+		hostCHECK( xStreamBufferConsume( xStream, 3 ) == 3 );
+		hostCHECK( xStreamBufferReceive( xStream, ucOut, sizeof( ucOut ), 0 ) == 4 );
+		hostCHECK( memcmp( ucOut, ucIn + 3, 4 ) == 0 );
+	}
+
+	/* Consume is capped to the data. */
+	hostCHECK( xStreamBufferCommit( xStream, 10 ) == 10 );
+	hostCHECK( xStreamBufferIsFull( xStream ) == pdTRUE );
+	hostCHECK( xStreamBufferConsume( xStream, 11 ) == 10 );
+	hostCHECK( xStreamBufferIsEmpty( xStream ) == pdTRUE );
+}
+/*-----------------------------------------------------------*/
+
+/* Messages of 1 to 13 bytes, sometimes two at once, read in place. */
+static void prvTestMessagePeek( void )
+{
+MessageBufferHandle_t xMessages;
+StreamBufferRegions_t xRegions;
+uint8_t ucMessage[ 13 ], ucOut[ 16 ];
+size_t x, xLength, xRound;
+
+	xMessages = xMessageBufferCreate( 37 );
+	hostCHECK( xMessages != NULL );
+
+	for( xRound = 0; xRound < 200; xRound++ )
+	{
+		xLength = 1 + ( xRound % 13 );
+
+		for( x = 0; x < xLength; x++ )
+		{
+			ucMessage[ x ] = ( uint8_t ) ( xRound + x );
+		}
+
+		hostCHECK( xMessageBufferSend( xMessages, ucMessage, xLength, 0 ) == xLength );
+
+		if( ( xRound & 1 ) != 0 )
+		{
+			hostCHECK( xMessageBufferSend( xMessages, ucMessage, 2, 0 ) == 2 );
+		}
+
+		hostCHECK( xMessageBufferPeek( xMessages, &xRegions ) == xLength );
+		hostCHECK( prvGather( &xRegions, ucOut ) == xLength );
+		hostCHECK( memcmp( ucOut, ucMessage, xLength ) == 0 );
+		hostCHECK( xMessageBufferConsume( xMessages, xLength ) == xLength );
+
+		if( ( xRound & 1 ) != 0 )
+		{
+			hostCHECK( xMessageBufferPeek( xMessages, &xRegions ) == 2 );
+			hostCHECK( xMessageBufferConsumeFromISR( xMessages, 2, NULL ) == 2 );
+		}
+
+		hostCHECK( xMessageBufferPeek( xMessages, &xRegions ) == 0 );
+		hostCHECK( xMessageBufferIsEmpty( xMessages ) == pdTRUE );
+	}
+
+	vMessageBufferDelete( xMessages );
+}
+/*-----------------------------------------------------------*/
+
+/* A reader blocked in xStreamBufferReceive() is woken by a commit. */
+static size_t xReceived;
+static uint8_t ucReceived[ 4 ];
+
+static void prvReader( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	xReceived = xStreamBufferReceive( xStream, ucReceived, sizeof( ucReceived ), portMAX_DELAY );
+	vTaskDelete( NULL );
+}
+
+static void prvWriter( void *pvParameters )
+{
+StreamBufferRegions_t xRegions;
+
+	( void ) pvParameters;
+
+	/* Let the reader block first. */
+	vTaskDelay( 2 );
+
+	( void ) xStreamBufferGetWriteRegions( xStream, &xRegions );
+	prvWriteInPlace( &xRegions, 0x40, 4 );
+	hostCHECK( xStreamBufferCommit( xStream, 4 ) == 4 );
+	vTaskDelete( NULL );
+}
+
+static void prvTestCommitWakesReader( void )
+{
+	hostCHECK( xTaskCreate( prvReader, "reader", configMINIMAL_STACK_SIZE, NULL, 1, NULL ) == pdPASS );
+	hostCHECK( xTaskCreate( prvWriter, "writer", configMINIMAL_STACK_SIZE, NULL, 1, NULL ) == pdPASS );
+	vHostRun();
+
+	hostCHECK( xReceived == 4 );
+	hostCHECK( ( ucReceived[ 0 ] == 0x40 ) && ( ucReceived[ 3 ] == 0x43 ) );
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	prvTestStreamRegions();
+	prvTestMessagePeek();
+	prvTestCommitWakesReader();
+
+	vStreamBufferDelete( xStream );
+
+	printf( "test_stream_buffer: passed\n" );
+	return 0;
+}
@@ -0,0 +1,253 @@
+/*
+ * Ticks pended while the scheduler is suspended (tasks.c): xTaskResumeAll()
+ * catches them up in steps of many ticks, and must wake the same tasks as the
+ * same ticks processed one at a time by xTaskIncrementTick().  Tasks are
+ * delayed for random times and the ticks are applied either way at random,
+ * across overflows of a 16 bit tick count; after each round a task is blocked
+ * exactly while its wake time is still ahead.
+ *
+ * The test is linked with tasks.c instead of host_kernel.c, with the port
+ * functions below.  xPortStartScheduler() returns at once, so no task code
+ * ever runs: the test picks the running task with vTaskSwitchContext(), as the
+ * PendSV handler does, and delays it from there.  Task budgets are enabled, so
+ * the catch up steps also replenish budgets.
+ */
+
+#include "host_kernel.h"
+#include "portable.h"
+
+#define hostTASKS				10
+#define hostMAX_DELAY			3000U
+#define hostMAX_PENDED_TICKS	2000U
+
+/* Ticks to run.  The tick count is 16 bits wide, so it overflows three
+times. */
+#define hostRUN_TICKS			200000UL
+
+volatile uint32_t ulHostYieldRequests;
+static uint32_t ulCycleCounter;
+
+static TaskHandle_t xTasks[ hostTASKS ];
+static TickType_t xWakeTime[ hostTASKS ];
+static BaseType_t xBlocked[ hostTASKS ];
+
+/*-----------------------------------------------------------*/
+
+StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters )
+{
+	( void ) pxCode;
+	( void ) pvParameters;
+
+	return pxTopOfStack;
+}
+
+BaseType_t xPortStartScheduler( void )
+{
+	return pdFALSE;
+}
+
+void vPortEndScheduler( void )
+{
+}
+
+void vPortEnterCritical( void )
+{
+}
+
+void vPortExitCritical( void )
+{
+}
+
+void *pvPortMalloc( size_t xSize )
+{
+	return malloc( xSize );
+}
+
+void *pvPortMallocIn( BaseType_t xRegion, size_t xSize )
+{
+	( void ) xRegion;
+
+	return malloc( xSize );
+}
+
+void vPortFree( void *pv )
+{
+	free( pv );
+}
+
+uint32_t ulHostGetCycleCounter( void )
+{
+	return ulCycleCounter++;
+}
+
+uint32_t ulPortGetMicrosecondsSinceTick( BaseType_t * const pxTickPending )
+{
+	*pxTickPending = pdFALSE;
+	return 0UL;
+}
+
+/* Only called when a periodic task is deleted. */
+void vPeriodicTaskRemoveEntry( TaskHandle_t xTask )
+{
+	( void ) xTask;
+}
+
+void vApplicationGetIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize )
+{
+static StaticTask_t xIdleTCB;
+static StackType_t uxIdleStack[ configMINIMAL_STACK_SIZE ];
+
+	*ppxIdleTaskTCBBuffer = &xIdleTCB;
+	*ppxIdleTaskStackBuffer = uxIdleStack;
+	*pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+/*-----------------------------------------------------------*/
+
+static void prvNeverRuns( void *pvParameters )
+{
+	( void ) pvParameters;
+	hostCHECK( pdFALSE );
+}
+
+static UBaseType_t prvTaskIndex( TaskHandle_t xTask )
+{
+UBaseType_t x;
+
+	for( x = 0; x < hostTASKS; x++ )
+	{
+		if( xTasks[ x ] == xTask )
+		{
+			break;
+		}
+	}
+
+	return x;
+}
+
+/* Delays every test task that is ready, each for a random time. */
+static void prvDelayReadyTasks( void )
+{
+UBaseType_t x;
+TickType_t xDelay;
+
+	for( ;; )
+	{
+		vTaskSwitchContext();
+		x = prvTaskIndex( xTaskGetCurrentTaskHandle() );
+
+		if( x == hostTASKS )
+		{
+			/* Only the idle task is left to run. */
+			break;
+		}
+
+		hostCHECK( xBlocked[ x ] == pdFALSE );
+		xDelay = 1 + ( ( TickType_t ) rand() % hostMAX_DELAY );
+		xWakeTime[ x ] = ( TickType_t ) ( xTaskGetTickCount() + xDelay );
+		xBlocked[ x ] = pdTRUE;
+		vTaskDelay( xDelay );
+	}
+}
+
+/* Applies xTicks ticks, as tick interrupts with the scheduler running or
+pended while it is suspended. */
+static void prvApplyTicks( TickType_t xTicks, BaseType_t xPended )
+{
+TickType_t x;
+
+	if( xPended != pdFALSE )
+	{
+		vTaskSuspendAll();
+	}
+
+	for( x = 0; x < xTicks; x++ )
+	{
+		( void ) xTaskIncrementTick();
+	}
+
+	if( xPended != pdFALSE )
+	{
+		( void ) xTaskResumeAll();
+	}
+}
+
+/* A task is blocked exactly while its wake time is ahead of the tick count.
+Wake times are never more than hostMAX_DELAY ahead, so a wake time further
+than that has passed. */
+static void prvCheckWoken( void )
+{
+const TickType_t xNow = xTaskGetTickCount();
+TickType_t xRemaining;
+UBaseType_t x;
+eTaskState eState;
+
+	vTaskSwitchContext();
+
+	for( x = 0; x < hostTASKS; x++ )
+	{
+		eState = eTaskGetState( xTasks[ x ] );
+		xRemaining = ( TickType_t ) ( xWakeTime[ x ] - xNow );
+
+		if( ( xBlocked[ x ] != pdFALSE ) && ( xRemaining != 0U ) && ( xRemaining <= hostMAX_DELAY ) )
+		{
+			hostCHECK( eState == eBlocked );
+		}
+		else
+		{
+			hostCHECK( ( eState == eReady ) || ( eState == eRunning ) );
+			xBlocked[ x ] = pdFALSE;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestCatchUp( void )
+{
+TickType_t xTicks;
+UBaseType_t uxElapsed = 0, uxBatched = 0, uxPerTick = 0;
+
+	while( uxElapsed < hostRUN_TICKS )
+	{
+		prvDelayReadyTasks();
+
+		xTicks = 1 + ( ( TickType_t ) rand() % hostMAX_PENDED_TICKS );
+
+		if( ( rand() % 2 ) == 0 )
+		{
+			prvApplyTicks( xTicks, pdTRUE );
+			uxBatched++;
+		}
+		else
+		{
+			prvApplyTicks( xTicks, pdFALSE );
+			uxPerTick++;
+		}
+
+		uxElapsed += ( UBaseType_t ) xTicks;
+		prvCheckWoken();
+	}
+
+	hostCHECK( ( uxBatched > 0U ) && ( uxPerTick > 0U ) );
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+UBaseType_t x;
+
+	srand( 1 );
+
+	for( x = 0; x < hostTASKS; x++ )
+	{
+		hostCHECK( xTaskCreate( prvNeverRuns, "T", configMINIMAL_STACK_SIZE, NULL, 1, &( xTasks[ x ] ) ) == pdPASS );
+	}
+
+	/* A large budget, only so the catch up replenishes one. */
+	hostCHECK( xTaskSetBudget( xTasks[ 0 ], 1000000UL, 7, eBudgetSuspend ) == pdPASS );
+
+	vTaskStartScheduler();
+	prvTestCatchUp();
+
+	printf( "test_tasks: passed\n" );
+	return 0;
+}
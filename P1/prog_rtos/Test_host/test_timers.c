@@ -0,0 +1,223 @@
+/*
+ * Timer wheel (timers.c) under tickless idle.  The tick is suppressed for as
+ * long as xTimerGetExpectedIdleTime() allows, sometimes less as if another
+ * interrupt woke the core, and the suppressed ticks are then stepped through
+ * the wheel as vTaskStepTick() does.  Every timer must still expire on its own
+ * tick, and never in a suppressed one.
+ *
+ * The test is the tick interrupt: no timer service task runs, and the timer
+ * queue is replaced by the stubs below.  All the timers use fast callbacks.
+ */
+
+#include "host_kernel.h"
+#include "queue.h"
+#include "timers.h"
+
+#define hostTIMERS		12
+
+static TimerHandle_t xTimers[ hostTIMERS ];
+static TickType_t xExpected[ hostTIMERS ];
+static BaseType_t xAutoReload[ hostTIMERS ];
+static UBaseType_t uxExpired[ hostTIMERS ];
+
+/* The tick count of the emulated kernel, and whether the tick being processed
+is a suppressed one. */
+static TickType_t xTestTickCount = 0;
+static BaseType_t xStepping = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+QueueHandle_t xQueueGenericCreateStatic( const UBaseType_t uxQueueLength, const UBaseType_t uxItemSize, uint8_t *pucQueueStorage, StaticQueue_t *pxStaticQueue, const uint8_t ucQueueType )
+{
+	( void ) uxQueueLength;
+	( void ) uxItemSize;
+	( void ) pucQueueStorage;
+	( void ) ucQueueType;
+
+	return ( QueueHandle_t ) pxStaticQueue;
+}
+
+BaseType_t xQueueGenericSend( QueueHandle_t xQueue, const void * const pvItemToQueue, TickType_t xTicksToWait, const BaseType_t xCopyPosition )
+{
+	( void ) xQueue;
+	( void ) pvItemToQueue;
+	( void ) xTicksToWait;
+	( void ) xCopyPosition;
+
+	return pdPASS;
+}
+
+BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue, const void * const pvItemToQueue, BaseType_t * const pxHigherPriorityTaskWoken, const BaseType_t xCopyPosition )
+{
+	( void ) xQueue;
+	( void ) pvItemToQueue;
+	( void ) pxHigherPriorityTaskWoken;
+	( void ) xCopyPosition;
+
+	return pdPASS;
+}
+
+BaseType_t xQueueReceive( QueueHandle_t xQueue, void * const pvBuffer, TickType_t xTicksToWait )
+{
+	( void ) xQueue;
+	( void ) pvBuffer;
+	( void ) xTicksToWait;
+
+	return pdFAIL;
+}
+
+void vQueueAddToRegistry( QueueHandle_t xQueue, const char *pcQueueName )
+{
+	( void ) xQueue;
+	( void ) pcQueueName;
+}
+
+BaseType_t xTaskGetSchedulerState( void )
+{
+	return taskSCHEDULER_NOT_STARTED;
+}
+
+/* Only referenced by xTimerCreateTimerTask(), which is not called. */
+void vApplicationGetTimerTaskMemory( StaticTask_t **ppxTimerTaskTCBBuffer, StackType_t **ppxTimerTaskStackBuffer, uint32_t *pulTimerTaskStackSize )
+{
+	( void ) ppxTimerTaskTCBBuffer;
+	( void ) ppxTimerTaskStackBuffer;
+	( void ) pulTimerTaskStackSize;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCallback( TimerHandle_t xTimer )
+{
+const UBaseType_t uxTimer = ( UBaseType_t ) ( uintptr_t ) pvTimerGetTimerID( xTimer );
+
+	hostCHECK( xStepping == pdFALSE );
+	hostCHECK( xTestTickCount == xExpected[ uxTimer ] );
+	uxExpired[ uxTimer ]++;
+
+	if( xAutoReload[ uxTimer ] != pdFALSE )
+	{
+		xExpected[ uxTimer ] += xTimerGetPeriod( xTimer );
+	}
+	else
+	{
+		hostCHECK( xTimerIsTimerActive( xTimer ) == pdFALSE );
+	}
+}
+
+/* Starts the timer with a new period, counted from the current tick. */
+static void prvStart( UBaseType_t uxTimer, TickType_t xPeriod )
+{
+	hostCHECK( xTimerGenericCommand( xTimers[ uxTimer ], tmrCOMMAND_CHANGE_PERIOD, xPeriod, NULL, 0 ) == pdPASS );
+	hostCHECK( xTimerGenericCommand( xTimers[ uxTimer ], tmrCOMMAND_START, xTestTickCount, NULL, 0 ) == pdPASS );
+	xExpected[ uxTimer ] = xTestTickCount + xPeriod;
+}
+
+/* One idle period: suppress the tick for up to xMaxIdle ticks, step the wheel
+through the suppressed ones, then process the tick that ends the period.
+Returns the length of the period. */
+static TickType_t prvIdle( TickType_t xMaxIdle )
+{
+TickType_t xIdle, xTick;
+
+	xIdle = xTimerGetExpectedIdleTime();
+	hostCHECK( xIdle > 0 );
+
+	if( xIdle > xMaxIdle )
+	{
+		xIdle = xMaxIdle;
+	}
+
+	xStepping = pdTRUE;
+
+	for( xTick = 1; xTick < xIdle; xTick++ )
+	{
+		xTestTickCount++;
+		( void ) xTimerIncrementTick( xTestTickCount );
+	}
+
+	xStepping = pdFALSE;
+
+	xTestTickCount++;
+	( void ) xTimerIncrementTick( xTestTickCount );
+
+	return xIdle;
+}
+/*-----------------------------------------------------------*/
+
+/* Periods from a tick to beyond the span of the wheel, restarted at random,
+for more than a full turn of the top level. */
+static void prvTestRandomPeriods( void )
+{
+UBaseType_t x;
+TickType_t xPeriod;
+
+	srand( 1 );
+
+	for( x = 0; x < hostTIMERS; x++ )
+	{
+		xAutoReload[ x ] = ( BaseType_t ) ( x & 1U );
+		xTimers[ x ] = xTimerCreate( "T", 1, ( UBaseType_t ) xAutoReload[ x ], ( void * ) ( uintptr_t ) x, prvCallback );
+		hostCHECK( xTimers[ x ] != NULL );
+		vTimerSetFastCallback( xTimers[ x ], pdTRUE );
+	}
+
+	while( xTestTickCount < 200000UL )
+	{
+		x = ( UBaseType_t ) rand() % hostTIMERS;
+
+		if( ( xTimerIsTimerActive( xTimers[ x ] ) == pdFALSE ) || ( ( rand() % 8 ) == 0 ) )
+		{
+			/* Mostly short periods, some past the 65535 ticks of the wheel. */
+			switch( rand() % 4 )
+			{
+				case 0:		xPeriod = 1 + ( ( TickType_t ) rand() % 16U ); break;
+				case 1:		xPeriod = 1 + ( ( TickType_t ) rand() % 300U ); break;
+				case 2:		xPeriod = 1 + ( ( TickType_t ) rand() % 5000U ); break;
+				default:	xPeriod = 1 + ( ( TickType_t ) rand() % 80000UL ); break;
+			}
+
+			prvStart( x, xPeriod );
+		}
+
+		/* Another interrupt wakes the core early one time in four. */
+		( void ) prvIdle( ( ( rand() % 4 ) == 0 ) ? 1 + ( ( TickType_t ) rand() % 50U ) : portMAX_DELAY );
+	}
+
+	for( x = 0; x < hostTIMERS; x++ )
+	{
+		hostCHECK( uxExpired[ x ] > 0 );
+		hostCHECK( xTimerGenericCommand( xTimers[ x ], tmrCOMMAND_STOP, 0, NULL, 0 ) == pdPASS );
+	}
+}
+
+/* With a single timer the core only wakes when a level of the wheel has work
+on it: at most one cascade per level, then the expiry. */
+static void prvTestFewWakeUps( void )
+{
+UBaseType_t uxWakeUps = 0;
+
+	hostCHECK( xTimerGetExpectedIdleTime() == portMAX_DELAY );
+
+	/* Timer 0 is a one shot timer. */
+	uxExpired[ 0 ] = 0;
+	prvStart( 0, 40000UL );
+
+	while( uxExpired[ 0 ] == 0 )
+	{
+		( void ) prvIdle( portMAX_DELAY );
+		uxWakeUps++;
+	}
+
+	hostCHECK( uxWakeUps <= configTIMER_WHEEL_LEVELS );
+	hostCHECK( xTimerGetExpectedIdleTime() == portMAX_DELAY );
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	prvTestRandomPeriods();
+	prvTestFewWakeUps();
+
+	printf( "test_timers: passed\n" );
+	return 0;
+}
@@ -0,0 +1,109 @@
+/*
+ * BSRR words of the GPIO timing probes (trace_gpio.h), in both encodings.
+ *
+ * trace_gpio.h is included twice, once per value of configTRACE_GPIO_MODE, with
+ * the default GPIOE pins: PE8-PE14 for the tasks and PE15 for interrupts.
+ */
+
+#include "host_kernel.h"
+
+/* trace_gpio.h replaces the empty defaults of FreeRTOS.h. */
+#undef traceTASK_SWITCHED_IN
+#undef traceTASK_SWITCHED_OUT
+#undef traceISR_ENTER
+#undef traceISR_EXIT
+
+/* Last word stored by a trace hook, instead of the port register. */
+static uint32_t ulLastBsrr;
+#define traceGPIO_WRITE( ulBsrr )	( ulLastBsrr = ( uint32_t ) ( ulBsrr ) )
+
+/* The switch hooks read the task number of the running task. */
+static struct
+{
+	UBaseType_t uxTaskNumber;
+} xRunningTask, *pxCurrentTCB = &xRunningTask;
+
+#define hostTASK_PINS	( 0x7F00UL )
+#define hostISR_PIN		( 0x8000UL )
+
+/*-----------------------------------------------------------*/
+
+#define configTRACE_GPIO_MODE	traceGPIO_MODE_PATTERN
+#include "trace_gpio.h"
+
+static void prvTestPattern( void )
+{
+UBaseType_t uxNumber;
+
+	hostCHECK( traceGPIO_TASK_MASK == hostTASK_PINS );
+
+	/* The task number in binary on PE8-PE14, the other task pins cleared. */
+	for( uxNumber = 0; uxNumber < 128UL; uxNumber++ )
+	{
+		hostCHECK( traceGPIO_SWITCHED_IN_BSRR( uxNumber ) == ( ( uxNumber << 8 ) | ( ( hostTASK_PINS & ~( uxNumber << 8 ) ) << 16 ) ) );
+		hostCHECK( traceGPIO_SWITCHED_OUT_BSRR( uxNumber ) == ( hostTASK_PINS << 16 ) );
+	}
+
+	/* Numbers are truncated to the seven pins. */
+	hostCHECK( traceGPIO_SWITCHED_IN_BSRR( 129UL ) == traceGPIO_SWITCHED_IN_BSRR( 1UL ) );
+
+	/* Task 0 drives no pin. */
+	hostCHECK( traceGPIO_SWITCHED_IN_BSRR( 0UL ) == ( hostTASK_PINS << 16 ) );
+
+	xRunningTask.uxTaskNumber = 5;
+	traceTASK_SWITCHED_IN();
+	hostCHECK( ulLastBsrr == ( 0x0500UL | ( 0x7A00UL << 16 ) ) );
+	traceTASK_SWITCHED_OUT();
+	hostCHECK( ulLastBsrr == ( hostTASK_PINS << 16 ) );
+}
+/*-----------------------------------------------------------*/
+
+#undef TRACE_GPIO_H
+#undef configTRACE_GPIO_MODE
+#undef traceGPIO_TASK_SET_BITS
+#define configTRACE_GPIO_MODE	traceGPIO_MODE_PIN_PER_TASK
+#include "trace_gpio.h"
+
+static void prvTestPinPerTask( void )
+{
+UBaseType_t uxNumber;
+uint32_t ulPin;
+
+	/* Task n owns PE(7 + n), the other task pins are cleared. */
+	for( uxNumber = 1; uxNumber <= 7UL; uxNumber++ )
+	{
+		ulPin = 1UL << ( 7UL + uxNumber );
+		hostCHECK( traceGPIO_SWITCHED_IN_BSRR( uxNumber ) == ( ulPin | ( ( hostTASK_PINS & ~ulPin ) << 16 ) ) );
+		hostCHECK( traceGPIO_SWITCHED_OUT_BSRR( uxNumber ) == ( hostTASK_PINS << 16 ) );
+	}
+
+	/* Task 0 and tasks beyond the pins drive no pin. */
+	hostCHECK( traceGPIO_SWITCHED_IN_BSRR( 0UL ) == ( hostTASK_PINS << 16 ) );
+	hostCHECK( traceGPIO_SWITCHED_IN_BSRR( 8UL ) == ( hostTASK_PINS << 16 ) );
+
+	xRunningTask.uxTaskNumber = 7;
+	traceTASK_SWITCHED_IN();
+	hostCHECK( ulLastBsrr == ( 0x4000UL | ( 0x3F00UL << 16 ) ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestIsrPin( void )
+{
+	/* Set on entry, reset on exit, never touching the task pins. */
+	traceISR_ENTER();
+	hostCHECK( ulLastBsrr == hostISR_PIN );
+	traceISR_EXIT();
+	hostCHECK( ulLastBsrr == ( hostISR_PIN << 16 ) );
+	hostCHECK( ( ( traceGPIO_ISR_BSRR( 1 ) | ( traceGPIO_ISR_BSRR( 1 ) << 16 ) ) & ( hostTASK_PINS | ( hostTASK_PINS << 16 ) ) ) == 0UL );
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	prvTestPattern();
+	prvTestPinPerTask();
+	prvTestIsrPin();
+
+	printf( "test_trace_gpio: passed\n" );
+	return 0;
+}
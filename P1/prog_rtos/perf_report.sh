@@ -0,0 +1,112 @@
+#!/bin/sh
+# Compare the -Os baseline firmware with the perf build (see "make perf").
+#
+# usage: perf_report.sh base.elf perf.elf [base_bench.log perf_bench.log]
+#
+# The logs are the semihosting output of Src/main11_ccm_benchmark.c run on
+# each build; without them only the size part of the report is produced.
+# OBJDUMP and NM default to the arm-none-eabi tools.
+
+OBJDUMP=${OBJDUMP:-arm-none-eabi-objdump}
+NM=${NM:-arm-none-eabi-nm}
+
+BASE_ELF=$1
+PERF_ELF=$2
+BASE_LOG=$3
+PERF_LOG=$4
+
+if [ ! -f "$BASE_ELF" ] || [ ! -f "$PERF_ELF" ]; then
+	echo "usage: $0 base.elf perf.elf [base_bench.log perf_bench.log]" >&2
+	exit 1
+fi
+
+# memory use of one image: "flash ram ccm" in bytes, from the section headers
+# rather than from size(1), whose Berkeley format cannot tell SRAM from CCM RAM
+# and whose System V format has no load address to count .data in flash
+# flash: loadable sections (LMA in flash), this includes the .data initialisers
+# ram/ccm: allocated sections whose run address is in SRAM/CCM RAM
+mem_use()
+{
+	$OBJDUMP -h "$1" | awk '
+	function hex(s,    i, c, v) {
+		v = 0
+		s = tolower(s)
+		for (i = 1; i <= length(s); i++) {
+			c = index("0123456789abcdef", substr(s, i, 1)) - 1
+			v = v * 16 + c
+		}
+		return v
+	}
+	$1 ~ /^[0-9]+$/ && NF >= 7 {
+		size = hex($3); vma = hex($4); lma = hex($5)
+		getline flags
+		if (flags ~ /LOAD/ && lma >= 134217728 && lma < 150994944)
+			flash += size
+		if (flags ~ /ALLOC/ && vma >= 536870912 && vma < 553648128)
+			ram += size
+		if (flags ~ /ALLOC/ && vma >= 268435456 && vma < 285212672)
+			ccm += size
+	}
+	END { printf "%d %d %d\n", flash, ram, ccm }'
+}
+
+# size of a function, "-" if the optimiser inlined or removed it; LTO may add
+# a suffix such as .lto_priv.0 or .part.0 to local copies
+func_size()
+{
+	size=$($NM -S "$1" | awk -v f="$2" '$4 == f || index($4, f ".") == 1 { print $2; exit }')
+	if [ -n "$size" ]; then
+		echo $(( 0x$size ))
+	else
+		echo "-"
+	fi
+}
+
+row()
+{
+	if [ "$2" = "-" ] || [ "$3" = "-" ] || [ -z "$2" ] || [ -z "$3" ]; then
+		printf "%-32s %10s %10s %10s\n" "$1" "${2:--}" "${3:--}" ""
+	else
+		printf "%-32s %10s %10s %+10d\n" "$1" "$2" "$3" $(( $3 - $2 ))
+	fi
+}
+
+set -- $(mem_use "$BASE_ELF") $(mem_use "$PERF_ELF")
+
+echo "Firmware report: $BASE_ELF (-Os) vs $PERF_ELF (perf)"
+echo
+printf "%-32s %10s %10s %10s\n" "" "baseline" "perf" "delta"
+row "flash (bytes)" "$1" "$4"
+row "SRAM (bytes)" "$2" "$5"
+row "CCM RAM (bytes)" "$3" "$6"
+echo
+echo "Hot path code size (bytes, - = inlined or removed)"
+for f in PendSV_Handler SysTick_Handler xPortSysTickHandler vTaskSwitchContext \
+	xTaskIncrementTick xTaskResumeAll xQueueGenericSend xQueueGenericSendFromISR \
+	xQueueReceive vListInsert vListInsertEnd uxListRemove; do
+	row "$f" "$(func_size "$BASE_ELF" $f)" "$(func_size "$PERF_ELF" $f)"
+done
+
+if [ -f "$BASE_LOG" ] && [ -f "$PERF_LOG" ]; then
+	# "Context switch (yield to yield): N cycles"
+	switch_cycles()
+	{
+		sed -n 's/^Context switch (yield to yield): \([0-9]*\) cycles.*/\1/p' "$1" | tail -n 1
+	}
+	# "Tick interrupt: min A avg B max C cycles", field selects A, B or C
+	tick_cycles()
+	{
+		sed -n "s/^Tick interrupt: min \([0-9]*\) avg \([0-9]*\) max \([0-9]*\) cycles.*/\\$2/p" "$1" | tail -n 1
+	}
+
+	echo
+	echo "Measured cycles (from $BASE_LOG and $PERF_LOG)"
+	row "context switch" "$(switch_cycles "$BASE_LOG")" "$(switch_cycles "$PERF_LOG")"
+	row "tick interrupt min" "$(tick_cycles "$BASE_LOG" 1)" "$(tick_cycles "$PERF_LOG" 1)"
+	row "tick interrupt avg" "$(tick_cycles "$BASE_LOG" 2)" "$(tick_cycles "$PERF_LOG" 2)"
+	row "tick interrupt max" "$(tick_cycles "$BASE_LOG" 3)" "$(tick_cycles "$PERF_LOG" 3)"
+else
+	echo
+	echo "No benchmark logs given: pass BENCH_BASE_LOG and BENCH_PERF_LOG to"
+	echo "\"make perf-report\" to add the measured cycles."
+fi
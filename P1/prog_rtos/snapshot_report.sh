@@ -0,0 +1,93 @@
+#!/bin/sh
+# Task tables from the snapshots exported by xTaskExportSnapshot().
+#
+# usage: snapshot_report.sh file...
+#
+# A file holds one or more records back to back, as sent by the target or
+# dumped from its memory with gdb, e.g. for Src/main.c built with
+# "make SNAPSHOTS=1":
+#
+#   (gdb) dump binary value snapshot.bin SNAPSHOT_RECORD
+#
+# Zeros after the last record are ignored.  The record format is described
+# next to xTaskExportSnapshot() in task.h.
+#
+# Stack figures are in words.  Free is the least stack the task has ever had
+# free, 0 when the snapshot was taken without measuring the stacks; Use is
+# then left blank.  CPU is the share of the total run time, only known when
+# the target has configGENERATE_RUN_TIME_STATS set to 1.
+
+if [ $# -eq 0 ]; then
+	echo "usage: $0 file..." >&2
+	exit 1
+fi
+
+for f in "$@"; do
+	od -An -v -tu1 "$f" || exit 1
+done | awk '
+function u(i, n,	v, k) {
+	v = 0
+	for (k = n - 1; k >= 0; k--)
+		v = v * 256 + b[i + k]
+	return v
+}
+{
+	for (i = 1; i <= NF; i++)
+		b[n++] = $i
+}
+END {
+	split("X R B S D", state, " ")
+	p = 0
+	while (p + 20 <= n) {
+		if (b[p] != 84 || b[p + 1] != 83) {
+			# Padding after the last record, or garbage.
+			for (i = p; i < n && b[i] == 0; i++)
+				;
+			if (i < n)
+				printf("offset %d: not a snapshot record\n", p)
+			break
+		}
+		if (b[p + 2] != 1) {
+			printf("offset %d: unknown snapshot format %d\n", p, b[p + 2])
+			break
+		}
+		namelen = b[p + 3]
+		entries = u(p + 4, 2)
+		total = u(p + 6, 2)
+		seq = u(p + 8, 4)
+		tick = u(p + 12, 4)
+		runtime = u(p + 16, 4)
+		size = 20 + entries * (20 + namelen)
+		if (p + size > n) {
+			printf("offset %d: snapshot %d is truncated\n", p, seq)
+			break
+		}
+
+		printf("Snapshot %d at tick %d, %d tasks", seq, tick, total)
+		if (entries < total)
+			printf(" (%d left out)", total - entries)
+		printf("\n%-16s %-5s %4s %4s %6s %6s %5s %5s\n", "Task", "State", "Prio", "Base", "Stack", "Free", "Use", "CPU")
+
+		e = p + 20
+		for (t = 0; t < entries; t++) {
+			run = u(e + 4, 4)
+			depth = u(e + 8, 4)
+			free = u(e + 12, 2)
+			name = ""
+			for (i = 0; i < namelen && b[e + 20 + i] != 0; i++)
+				name = name sprintf("%c", b[e + 20 + i])
+
+			use = ""
+			if (free > 0 && depth > free)
+				use = sprintf("%d%%", (depth - free) * 100 / depth)
+			cpu = ""
+			if (runtime > 0)
+				cpu = sprintf("%d%%", run * 100 / runtime)
+
+			printf("%-16s %-5s %4d %4d %6d %6d %5s %5s\n", name, state[b[e + 18] + 1], u(e + 14, 2), u(e + 16, 2), depth, free, use, cpu)
+			e += 20 + namelen
+		}
+		printf("\n")
+		p += size
+	}
+}'
@@ -0,0 +1,175 @@
+#!/bin/sh
+# Worst-case stack of each task function, from the GCC call graph (see
+# "make stack-report").
+#
+# usage: stack_report.sh [task[:words] | function=bytes]... -- file.ci...
+#
+#   task:words      a task function and the stack depth (words) it is created
+#                   with now; the report suggests a new depth for it
+#   function=bytes  the stack of a function without call graph information,
+#                   e.g. printf=600 for the newlib build in use
+#
+# The .ci files are written by -fcallgraph-info=su and hold every function
+# with its frame size and the calls it makes.  The depth of a task is the
+# deepest path from its function, plus OVERHEAD bytes for the context the port
+# saves on the task stack when the task is switched out (104 bytes of
+# exception frame with the FPU state, 100 bytes of r4-r11, lr and s16-s31).
+# Interrupts run on the main stack and are not counted.
+#
+# The result is only a lower bound when the path has recursion, an indirect
+# call, a frame of dynamic size or a call to a function of unknown stack;
+# those are flagged next to the task.  The suggested depth adds MARGIN percent
+# (default 10) and is rounded up to a multiple of 8 words.
+
+OVERHEAD=${OVERHEAD:-204}
+MARGIN=${MARGIN:-10}
+
+TASKS=
+EXTERNS=
+while [ $# -gt 0 ] && [ "$1" != "--" ]; do
+	case "$1" in
+	*=*)	EXTERNS="$EXTERNS $1" ;;
+	*)	TASKS="$TASKS $1" ;;
+	esac
+	shift
+done
+[ "$1" = "--" ] && shift
+
+if [ -z "$TASKS" ] || [ $# -eq 0 ]; then
+	echo "usage: $0 [task[:words] | function=bytes]... -- file.ci..." >&2
+	exit 1
+fi
+
+awk -v tasks="$TASKS" -v externs="$EXTERNS" -v overhead="$OVERHEAD" -v margin="$MARGIN" '
+# node: { title: "f" label: "f\nfile.c:1:2\n24 bytes (static)" }
+# node: { title: "printf" label: "printf\n..." shape : ellipse }
+/^node:/ {
+	t = $0; sub(/^node: \{ title: "/, "", t); sub(/".*/, "", t)
+	if ($0 ~ / bytes \(/) {
+		b = $0; sub(/ bytes \(.*/, "", b); sub(/.*\\n/, "", b)
+		q = $0; sub(/.* bytes \(/, "", q); sub(/\).*/, "", q)
+		frame[t] = b + 0; qual[t] = q; defined[t] = 1
+	}
+	next
+}
+# edge: { sourcename: "f" targetname: "g" label: "file.c:3:4" }
+/^edge:/ {
+	s = $0; sub(/^edge: \{ sourcename: "/, "", s); sub(/".*/, "", s)
+	d = $0; sub(/.*targetname: "/, "", d); sub(/".*/, "", d)
+	if (!((s, d) in seen)) {
+		seen[s, d] = 1
+		ncallee[s]++
+		callee[s, ncallee[s]] = d
+	}
+	next
+}
+
+# deepest path from f in bytes; best[f] is the callee on it, note[f] the
+# reasons it may be deeper
+function depth(f,    i, c, d, m, n) {
+	if (f in memo)
+		return memo[f]
+	if (f == "__indirect_call") {
+		note[f] = "indirect call"
+		return memo[f] = 0
+	}
+	if (!(f in defined)) {
+		if (f in ext)
+			return memo[f] = ext[f]
+		note[f] = "unknown: " f
+		return memo[f] = 0
+	}
+	if (f in active) {
+		note[f] = "recursion: " f
+		return 0
+	}
+	active[f] = 1
+	m = 0; n = ""
+	for (i = 1; i <= ncallee[f]; i++) {
+		c = resolve(callee[f, i])
+		d = depth(c)
+		if (d > m || best[f] == "") {
+			m = d; best[f] = c
+		}
+		n = addnote(n, note[c])
+	}
+	delete active[f]
+	if (qual[f] ~ /dynamic/)
+		n = addnote(n, "dynamic frame: " f)
+	note[f] = n
+	return memo[f] = frame[f] + m
+}
+
+function addnote(n, x,    k, parts, i) {
+	if (x == "")
+		return n
+	k = split(x, parts, "; ")
+	for (i = 1; i <= k; i++)
+		if (index("; " n "; ", "; " parts[i] "; ") == 0)
+			n = (n == "" ? parts[i] : n "; " parts[i])
+	return n
+}
+
+# "name" matches a global function or a static one titled "file.c:name"
+function lookup(name,    t) {
+	if (name in defined)
+		return name
+	for (t in defined)
+		if (substr(t, length(t) - length(name)) == ":" name)
+			return t
+	return ""
+}
+
+# a call to a weak function names it plainly but GCC titles its definition
+# "file.c:name" like a static one
+function resolve(name,    t) {
+	if ((name in defined) || (name in ext) || name == "__indirect_call")
+		return name
+	t = lookup(name)
+	return (t == "") ? name : t
+}
+
+function short(t) {
+	sub(/.*:/, "", t)
+	return t
+}
+
+END {
+	n = split(externs, e, " ")
+	for (i = 1; i <= n; i++) {
+		split(e[i], kv, "=")
+		ext[kv[1]] = kv[2] + 0
+	}
+
+	printf "%-24s %8s %8s %8s %8s\n", "task", "now", "worst", "worst", "suggest"
+	printf "%-24s %8s %8s %8s %8s\n", "", "(words)", "(bytes)", "(words)", "(words)"
+	n = split(tasks, tl, " ")
+	for (i = 1; i <= n; i++) {
+		name = tl[i]; now = "-"
+		if (index(name, ":") > 0) {
+			now = substr(name, index(name, ":") + 1)
+			name = substr(name, 1, index(name, ":") - 1)
+		}
+		f = lookup(name)
+		if (f == "") {
+			printf "%-24s %8s %8s %8s %8s  not found\n", name, now, "-", "-", "-"
+			continue
+		}
+		bytes = depth(f) + overhead
+		words = int((bytes + 3) / 4)
+		suggest = int((words * (100 + margin) + 99) / 100)
+		suggest = int((suggest + 7) / 8) * 8
+		flag = (note[f] == "") ? "" : " *"
+		printf "%-24s %8s %8d %8d %8d%s\n", name, now, bytes, words, suggest, flag
+
+		path = "    " short(f) " " frame[f]
+		split("", onpath); onpath[f] = 1
+		for (c = best[f]; c != "" && !(c in onpath); c = best[c]) {
+			path = path " > " short(c) " " (c in defined ? frame[c] : (c in ext ? ext[c] : "?"))
+			onpath[c] = 1
+		}
+		print path " (+" overhead " context)"
+		if (note[f] != "")
+			print "    * lower bound, " note[f]
+	}
+}' "$@"